@@ -242,7 +242,7 @@ void *ogsHostMallocPinned(occa::device &device, size_t size, void *source, occa:
 
 #define USE_OOGS
 
-enum oogs_mode { OOGS_LOCAL, OOGS_DEFAULT, OOGS_HOSTMPI, OOGS_DEVICEMPI, OOGS_AUTO };
+enum oogs_mode { OOGS_LOCAL, OOGS_DEFAULT, OOGS_HOSTMPI, OOGS_DEVICEMPI, OOGS_HIERARCHICAL, OOGS_AUTO };
 enum oogs_modeExchange { OOGS_EX_PW, OOGS_EX_NBC };
 
 typedef struct {
@@ -253,6 +253,9 @@ typedef struct {
   MPI_Comm comm;
 } nbc_t;
 
+// node-aware exchange state (OOGS_HIERARCHICAL), defined in oogs.cpp
+struct oogsNode_t;
+
 typedef struct {
 
   ogs_t *ogs;
@@ -275,6 +278,8 @@ typedef struct {
 
   nbc_t nbc;
 
+  oogsNode_t *node;
+
 } oogs_t;
 
 namespace oogs{
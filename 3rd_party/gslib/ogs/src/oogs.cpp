@@ -1,5 +1,10 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <limits>
 #include <list>
+#include <map>
+#include <vector>
 #include <occa.hpp>
 
 #include "ogstypes.h"
@@ -192,6 +197,307 @@ static void pairwiseExchange(int unit_size, oogs_t *gs)
 
   MPI_CHECK(MPI_Waitall(pwd->comm[send].n + pwd->comm[recv].n, pwd->req, MPI_STATUSES_IGNORE));
 }
+
+// Ranks sharing memory with each other (a node) exchange their messages
+// through an MPI-3 shared window: every rank owns a segment holding its send
+// buffer followed by its receive buffer. On-node messages are copied straight
+// from the sender's segment, off-node messages are aggregated per node pair by
+// the node leaders (node rank 0) and deposited into the receivers' segments.
+struct oogsBlock_t {
+  int nodeRank;    // owner of the segment read from (send) or written to (recv)
+  int srcOffset;   // in units, relative to the send buffer of the source
+  int dstOffset;   // in units, relative to the receive buffer of the destination
+  int size;        // in units
+};
+
+struct oogsPeer_t {
+  int leader;      // rank of the remote node leader in leaderComm
+  int sendTotal = 0, recvTotal = 0;
+  std::vector<oogsBlock_t> send, recv;
+};
+
+struct oogsNode_t {
+  MPI_Comm comm;
+  MPI_Comm leaderComm; // MPI_COMM_NULL on non-leaders
+  int rank, size;
+
+  MPI_Win win;
+  int unitCapacity;
+  std::vector<unsigned char *> base; // segment of each node rank
+  std::vector<int> sendTotal;        // send buffer size of each node rank
+
+  std::vector<oogsBlock_t> localRecv;
+
+  // leader only
+  std::vector<oogsPeer_t> peers;
+  std::vector<unsigned char> bufSend, bufRecv;
+  std::vector<MPI_Request> req;
+};
+
+static void nodeSync(oogsNode_t *node)
+{
+  MPI_CHECK(MPI_Win_sync(node->win));
+  MPI_CHECK(MPI_Barrier(node->comm));
+  MPI_CHECK(MPI_Win_sync(node->win));
+}
+
+// Note: collective on the node, unit_size has to match across node ranks
+static void reallocWindow(int unit_size, oogs_t *gs)
+{
+  ogs_t *ogs = gs->ogs;
+  struct gs_data *hgs = (gs_data *)ogs->haloGshSym;
+  const void *execdata = hgs->r.data;
+  const struct pw_data *pwd = (pw_data *)execdata;
+  oogsNode_t *node = gs->node;
+
+  if (unit_size <= node->unitCapacity)
+    return;
+
+  if (node->unitCapacity) {
+    MPI_CHECK(MPI_Win_unlock_all(node->win));
+    MPI_CHECK(MPI_Win_free(&node->win));
+  }
+
+  MPI_Info info;
+  MPI_Info_create(&info);
+  MPI_Info_set(info, "alloc_shared_noncontig", "true"); // keep segments local to their owner
+
+  const MPI_Aint bytes = (MPI_Aint)(pwd->comm[send].total + pwd->comm[recv].total) * unit_size;
+  unsigned char *segment;
+  MPI_CHECK(MPI_Win_allocate_shared(bytes, 1, info, node->comm, &segment, &node->win));
+  MPI_Info_free(&info);
+
+  for (int r = 0; r < node->size; r++) {
+    MPI_Aint segmentBytes;
+    int dispUnit;
+    MPI_CHECK(MPI_Win_shared_query(node->win, r, &segmentBytes, &dispUnit, &node->base[r]));
+  }
+  MPI_CHECK(MPI_Win_lock_all(MPI_MODE_NOCHECK, node->win));
+
+  node->unitCapacity = unit_size;
+}
+
+// Note: collective
+static void setupNode(int unit_size, oogs_t *gs)
+{
+  ogs_t *ogs = gs->ogs;
+  struct gs_data *hgs = (gs_data *)ogs->haloGshSym;
+  const void *execdata = hgs->r.data;
+  const struct pw_data *pwd = (pw_data *)execdata;
+
+  oogsNode_t *node = new oogsNode_t();
+  gs->node = node;
+
+  MPI_Comm_split_type(gs->comm, MPI_COMM_TYPE_SHARED, gs->rank, MPI_INFO_NULL, &node->comm);
+  MPI_Comm_rank(node->comm, &node->rank);
+  MPI_Comm_size(node->comm, &node->size);
+  MPI_Comm_split(gs->comm, (node->rank == 0) ? 0 : MPI_UNDEFINED, gs->rank, &node->leaderComm);
+
+  int nodeId;
+  if (node->rank == 0)
+    MPI_Comm_rank(node->leaderComm, &nodeId);
+  MPI_Bcast(&nodeId, 1, MPI_INT, 0, node->comm);
+
+  int commSize;
+  MPI_Comm_size(gs->comm, &commSize);
+  std::vector<int> rankInfo(2 * commSize); // (node, node rank) of every rank
+  {
+    const int info[2] = {nodeId, node->rank};
+    MPI_Allgather(info, 2, MPI_INT, rankInfo.data(), 2, MPI_INT, gs->comm);
+  }
+  auto onNode = [&](int r) { return rankInfo[2 * r] == nodeId; };
+
+  node->sendTotal.resize(node->size);
+  {
+    const int sendTotal = pwd->comm[send].total;
+    MPI_Allgather(&sendTotal, 1, MPI_INT, node->sendTotal.data(), 1, MPI_INT, node->comm);
+  }
+  node->base.resize(node->size);
+
+  // on-node receivers read from the sender's segment and need to know where
+  // their message is located
+  std::vector<int> sendOffsets, recvOffsets;
+  {
+    std::vector<MPI_Request> req;
+    int offset = 0;
+    const struct pw_comm_data *c = &pwd->comm[send];
+    sendOffsets.resize(c->n);
+    for (int i = 0; i < c->n; i++) {
+      sendOffsets[i] = offset;
+      offset += c->size[i];
+      if (onNode(c->p[i])) {
+        req.emplace_back();
+        MPI_Isend(&sendOffsets[i], 1, MPI_INT, c->p[i], gs->rank, gs->comm, &req.back());
+      }
+    }
+    offset = 0;
+    c = &pwd->comm[recv];
+    recvOffsets.resize(c->n);
+    std::vector<int> srcOffsets(c->n);
+    for (int i = 0; i < c->n; i++) {
+      recvOffsets[i] = offset;
+      offset += c->size[i];
+      if (onNode(c->p[i])) {
+        req.emplace_back();
+        MPI_Irecv(&srcOffsets[i], 1, MPI_INT, c->p[i], c->p[i], gs->comm, &req.back());
+      }
+    }
+    MPI_Waitall(req.size(), req.data(), MPI_STATUSES_IGNORE);
+
+    for (int i = 0; i < c->n; i++) {
+      if (onNode(c->p[i]))
+        node->localRecv.push_back({rankInfo[2 * c->p[i] + 1], srcOffsets[i], recvOffsets[i], (int)c->size[i]});
+    }
+  }
+
+  // off-node messages as (src, dst, offset, size) records gathered on the leader
+  std::vector<int> records[2];
+  for (int dir : {send, recv}) {
+    const struct pw_comm_data *c = &pwd->comm[dir];
+    const auto &offsets = (dir == send) ? sendOffsets : recvOffsets;
+    for (int i = 0; i < c->n; i++) {
+      if (onNode(c->p[i]))
+        continue;
+      const int src = (dir == send) ? gs->rank : (int)c->p[i];
+      const int dst = (dir == send) ? (int)c->p[i] : gs->rank;
+      records[dir].insert(records[dir].end(), {src, dst, offsets[i], (int)c->size[i]});
+    }
+  }
+
+  std::map<int, oogsPeer_t> peers;
+  for (int dir : {send, recv}) {
+    const int count = records[dir].size();
+    std::vector<int> counts(node->size), displs(node->size);
+    MPI_Gather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, 0, node->comm);
+
+    int total = 0;
+    for (int r = 0; r < node->size; r++) {
+      displs[r] = total;
+      total += counts[r];
+    }
+    std::vector<int> nodeRecords(total);
+    MPI_Gatherv(records[dir].data(),
+                count,
+                MPI_INT,
+                nodeRecords.data(),
+                counts.data(),
+                displs.data(),
+                MPI_INT,
+                0,
+                node->comm);
+    if (node->rank)
+      continue;
+
+    // both leaders of a node pair see the same messages, ordering them by
+    // (src, dst) lets the receiving one split the aggregate without metadata
+    std::vector<std::array<int, 5>> entries; // src, dst, node rank, offset, size
+    for (int r = 0; r < node->size; r++) {
+      for (int i = displs[r]; i < displs[r] + counts[r]; i += 4)
+        entries.push_back({nodeRecords[i], nodeRecords[i + 1], r, nodeRecords[i + 2], nodeRecords[i + 3]});
+    }
+    std::sort(entries.begin(), entries.end());
+
+    for (auto &&e : entries) {
+      const int remote = (dir == send) ? e[1] : e[0];
+      auto &peer = peers[rankInfo[2 * remote]];
+      peer.leader = rankInfo[2 * remote];
+      if (dir == send) {
+        peer.send.push_back({e[2], e[3], 0, e[4]});
+        peer.sendTotal += e[4];
+      } else {
+        peer.recv.push_back({e[2], 0, e[3], e[4]});
+        peer.recvTotal += e[4];
+      }
+    }
+  }
+  for (auto &&entry : peers)
+    node->peers.push_back(entry.second);
+  node->req.resize(2 * node->peers.size());
+
+  reallocWindow(unit_size, gs);
+}
+
+// Note: collective
+static void nodeExchange(int unit_size, oogs_t *gs)
+{
+  oogsNode_t *node = gs->node;
+
+  auto sendBuf = [&](int r) { return node->base[r]; };
+  auto recvBuf = [&](int r) { return node->base[r] + (size_t)node->sendTotal[r] * unit_size; };
+
+  nodeSync(node); // send buffers of all node ranks are filled
+
+  MPI_Request *req = node->req.data();
+  if (node->leaderComm != MPI_COMM_NULL) {
+    int sendTotal = 0, recvTotal = 0;
+    for (auto &&peer : node->peers) {
+      sendTotal += peer.sendTotal;
+      recvTotal += peer.recvTotal;
+    }
+    if (node->bufSend.size() < (size_t)sendTotal * unit_size)
+      node->bufSend.resize((size_t)sendTotal * unit_size);
+    if (node->bufRecv.size() < (size_t)recvTotal * unit_size)
+      node->bufRecv.resize((size_t)recvTotal * unit_size);
+
+    unsigned char *buf = node->bufRecv.data();
+    for (auto &&peer : node->peers) {
+      const int len = peer.recvTotal * unit_size;
+      if (len)
+        MPI_CHECK(MPI_Irecv(buf, len, MPI_UNSIGNED_CHAR, peer.leader, 0, node->leaderComm, req++));
+      buf += len;
+    }
+
+    buf = node->bufSend.data();
+    for (auto &&peer : node->peers) {
+      unsigned char *aggregate = buf;
+      for (auto &&b : peer.send) {
+        memcpy(buf, sendBuf(b.nodeRank) + (size_t)b.srcOffset * unit_size, (size_t)b.size * unit_size);
+        buf += (size_t)b.size * unit_size;
+      }
+      const int len = peer.sendTotal * unit_size;
+      if (len)
+        MPI_CHECK(MPI_Isend(aggregate, len, MPI_UNSIGNED_CHAR, peer.leader, 0, node->leaderComm, req++));
+    }
+  }
+
+  for (auto &&b : node->localRecv) {
+    memcpy(recvBuf(node->rank) + (size_t)b.dstOffset * unit_size,
+           sendBuf(b.nodeRank) + (size_t)b.srcOffset * unit_size,
+           (size_t)b.size * unit_size);
+  }
+
+  if (node->leaderComm != MPI_COMM_NULL) {
+    MPI_CHECK(MPI_Waitall(req - node->req.data(), node->req.data(), MPI_STATUSES_IGNORE));
+
+    const unsigned char *buf = node->bufRecv.data();
+    for (auto &&peer : node->peers) {
+      for (auto &&b : peer.recv) {
+        memcpy(recvBuf(b.nodeRank) + (size_t)b.dstOffset * unit_size, buf, (size_t)b.size * unit_size);
+        buf += (size_t)b.size * unit_size;
+      }
+    }
+  }
+
+  nodeSync(node); // receive buffers are filled, send buffers can be reused
+}
+
+static void freeNode(oogs_t *gs)
+{
+  oogsNode_t *node = gs->node;
+  if (!node)
+    return;
+
+  if (node->unitCapacity) {
+    MPI_Win_unlock_all(node->win);
+    MPI_Win_free(&node->win);
+  }
+  if (node->leaderComm != MPI_COMM_NULL)
+    MPI_Comm_free(&node->leaderComm);
+  MPI_Comm_free(&node->comm);
+
+  delete node;
+  gs->node = nullptr;
+}
 void occaGatherScatterLocal(const dlong NlocalGather,
                             const dlong NrowBlocks,
                             occa::memory &o_bstart,
@@ -254,6 +560,12 @@ void occaGatherScatterLocal(const dlong NlocalGather,
 #endif
 }
 
+// device memory is host memory for the CPU backends
+static bool hostBackend(occa::device &device)
+{
+  return device.mode() == "Serial" || device.mode() == "OpenMP";
+}
+
 void oogs::gpu_mpi(int val) { OGS_MPI_SUPPORT = val; }
 
 void oogs::overlap(int val) { OGS_OVERLAP = val; }
@@ -344,6 +656,8 @@ oogs_t *oogs::setup(ogs_t *ogs,
 
   oogs_t *gs = new oogs_t[1];
   gs->ogs = ogs;
+  gs->node = nullptr;
+  gs->nbc = {nullptr, nullptr, nullptr, nullptr, MPI_COMM_NULL};
 
   occa::device device = gs->ogs->device;
   const auto oklpath = std::string(getenv("OGS_HOME")) + "/okl/"; 
@@ -434,10 +748,20 @@ oogs_t *oogs::setup(ogs_t *ogs,
 
     oogs_mode_list.push_back(OOGS_DEFAULT);
     oogs_mode_list.push_back(OOGS_HOSTMPI);
-    if (ogs->device.mode() != "Serial") {
+    if (!hostBackend(ogs->device)) {
       if(OGS_MPI_SUPPORT) oogs_mode_list.push_back(OOGS_DEVICEMPI);
     }
     oogs_modeExchange_list.push_back(OOGS_EX_NBC);
+
+    if (gsMode == OOGS_AUTO || gsMode == OOGS_HIERARCHICAL) {
+      setupNode(nVec * sizeof(double), gs);
+
+      // nothing to share with a single rank per node
+      int maxNodeSize = gs->node->size;
+      MPI_Allreduce(MPI_IN_PLACE, &maxNodeSize, 1, MPI_INT, MPI_MAX, gs->comm);
+      if (maxNodeSize > 1)
+        oogs_mode_list.push_back(OOGS_HIERARCHICAL);
+    }
   }
 
   if (gsMode == OOGS_AUTO) {
@@ -475,7 +799,7 @@ oogs_t *oogs::setup(ogs_t *ogs,
           // skip invalid combinations
           if (gs->modeExchange != OOGS_EX_PW && gs->earlyPrepostRecv)
             continue;
-          if (gs->mode == OOGS_DEFAULT || gs->mode == OOGS_LOCAL) {
+          if (gs->mode == OOGS_DEFAULT || gs->mode == OOGS_LOCAL || gs->mode == OOGS_HIERARCHICAL) {
             if (gs->modeExchange != OOGS_EX_PW)
               continue;
             if (gs->earlyPrepostRecv)
@@ -521,6 +845,9 @@ oogs_t *oogs::setup(ogs_t *ogs,
     gs->modeExchange = fastestModeExchange;
     gs->earlyPrepostRecv = fastestPrepostRecv;
     o_q.free();
+
+    if (gs->mode != OOGS_HIERARCHICAL)
+      freeNode(gs);
   }
   else {
     gs->mode = gsMode;
@@ -540,12 +867,16 @@ oogs_t *oogs::setup(ogs_t *ogs,
 
     const size_t unit_size = nVec * Nbytes;
     reallocBuffers(unit_size, gs);
+    if (gs->node)
+      reallocWindow(unit_size, gs);
 
     for (int test = 0; test < Ntests; ++test) {
       device.finish();
       MPI_Barrier(gs->comm);
       const double tStart = MPI_Wtime();
-      if (gs->modeExchange == OOGS_EX_NBC)
+      if (gs->mode == OOGS_HIERARCHICAL && gs->node)
+        nodeExchange(unit_size, gs);
+      else if (gs->modeExchange == OOGS_EX_NBC)
         neighborAllToAll(unit_size, gs);
       else
         pairwiseExchange(unit_size, gs);
@@ -572,14 +903,18 @@ oogs_t *oogs::setup(ogs_t *ogs,
           break;
         case OOGS_AUTO:
         case OOGS_DEFAULT:
-          if (ogs->device.mode() != "Serial") configStr += "+host";
+          if (!hostBackend(ogs->device)) configStr += "+host";
           break;
         case OOGS_HOSTMPI:
-          if (ogs->device.mode() != "Serial")  configStr += "+hybrid"; 
+          if (!hostBackend(ogs->device)) configStr += "+hybrid";
           break;
         case OOGS_DEVICEMPI:
            configStr += "+device";
           break;
+        case OOGS_HIERARCHICAL:
+          configStr = "node";
+          if (!hostBackend(ogs->device)) configStr += "+hybrid";
+          break;
         }
         printf("\nused config: %s ", configStr.c_str());
         if (tavg/size > MPI_Wtick())
@@ -700,6 +1035,8 @@ void oogs::start(occa::memory &o_v,
 
   if (gs->mode != OOGS_LOCAL) {
     reallocBuffers(unit_size, gs);
+    if (gs->mode == OOGS_HIERARCHICAL && gs->node)
+      reallocWindow(unit_size, gs);
 
     packBuf(gs,
             ogs->NhaloGather,
@@ -796,6 +1133,33 @@ void oogs::finish(occa::memory &o_v,
     ogs->device.setStream(ogs::defaultStream);
   }
 
+  if (gs->mode == OOGS_HIERARCHICAL && gs->node) {
+    ogs->device.setStream(ogs::dataStream);
+
+    struct gs_data *hgs = (gs_data *)ogs->haloGshSym;
+    const void *execdata = hgs->r.data;
+    const struct pw_data *pwd = (pw_data *)execdata;
+
+    // stage directly through this rank's segment of the shared window
+    oogsNode_t *node = gs->node;
+    unsigned char *bufSend = node->base[node->rank];
+    unsigned char *bufRecv = bufSend + (size_t)pwd->comm[send].total * unit_size;
+
+    if(pwd->comm[send].total)
+      gs->o_bufSend.copyTo(bufSend, pwd->comm[send].total * unit_size, 0, "async: true");
+    ogs->device.finish();
+
+    ogsHostTic(gs->comm, 1);
+    nodeExchange(unit_size, gs);
+    ogsHostToc();
+
+    if(pwd->comm[recv].total)
+      gs->o_bufRecv.copyFrom(bufRecv, pwd->comm[recv].total * unit_size, 0, "async: true");
+
+    ogs->device.finish();
+    ogs->device.setStream(ogs::defaultStream);
+  }
+
   if (gs->mode == OOGS_DEVICEMPI) {
     ogsHostTic(gs->comm, 1);
     if (gs->modeExchange == OOGS_EX_NBC)
@@ -852,5 +1216,14 @@ void oogs::destroy(oogs_t *gs)
   gs->o_bufRecv.free();
   gs->o_bufSend.free();
 
-  free(gs);
+  if (gs->nbc.comm != MPI_COMM_NULL)
+    MPI_Comm_free(&gs->nbc.comm);
+  free(gs->nbc.sendcounts);
+  free(gs->nbc.senddispls);
+  free(gs->nbc.recvcounts);
+  free(gs->nbc.recvdispls);
+
+  freeNode(gs);
+
+  delete[] gs;
 }
@@ -45,6 +45,8 @@ set(SRC
     src/setup/configReader.cpp
     src/core/timer.cpp
     src/core/platform.cpp
+    src/core/memoryArena.cpp
+    src/core/lagHistory.cpp
     src/core/comm.cpp
     src/core/flopCounter.cpp
     src/core/kernelRequestManager.cpp
@@ -126,6 +128,7 @@ target_include_directories(nekrs-lib
   PRIVATE
   ${ELLIPTIC_SOURCE_DIR}/amgSolver/hypre
   ${ELLIPTIC_SOURCE_DIR}/amgSolver/amgx
+  ${ELLIPTIC_SOURCE_DIR}/amgSolver/saamg
   ${ELLIPTIC_SOURCE_DIR}/MG
 )
 
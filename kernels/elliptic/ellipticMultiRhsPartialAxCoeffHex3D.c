@@ -0,0 +1,95 @@
+extern "C" void FUNC(ellipticMultiRhsPartialAxCoeffHex3D)(const dlong & Nelements,
+                                const dlong & offset,
+                                const dlong & loffset,
+                                const dlong* __restrict__ elementList,
+                                const dfloat* __restrict__ ggeo,
+                                const dfloat* __restrict__ D,
+                                const dfloat* __restrict__ S,
+                                const dfloat* __restrict__ lambda0,
+                                const dfloat* __restrict__ lambda1,
+                                const dfloat* __restrict__ q,
+                                dfloat* __restrict__ Aq )
+{
+  dfloat s_q[p_Nfields][p_Nq][p_Nq][p_Nq];
+  dfloat s_Gqr[p_Nfields][p_Nq][p_Nq][p_Nq];
+  dfloat s_Gqs[p_Nfields][p_Nq][p_Nq][p_Nq];
+  dfloat s_Gqt[p_Nfields][p_Nq][p_Nq][p_Nq];
+
+  dfloat s_D[p_Nq][p_Nq];
+  dfloat s_S[p_Nq][p_Nq];
+
+  for(int j = 0; j < p_Nq; ++j)
+    for(int i = 0; i < p_Nq; ++i) {
+      s_D[j][i] = D[j * p_Nq + i];
+      s_S[j][i] = S[j * p_Nq + i];
+    }
+
+#ifdef __NEKRS__OMP__
+  #pragma omp parallel for private(s_q, s_Gqr, s_Gqs, s_Gqt)
+#endif
+  for(dlong e = 0; e < Nelements; ++e) {
+    const dlong element = elementList[e];
+
+    for(int fld = 0; fld < p_Nfields; fld++)
+      for(int k = 0; k < p_Nq; k++)
+        for(int j = 0; j < p_Nq; ++j)
+          for(int i = 0; i < p_Nq; ++i) {
+            const dlong base = i + j * p_Nq + k * p_Nq * p_Nq + element * p_Np;
+            s_q[fld][k][j][i] = q[base + fld * offset];
+          }
+
+    for(int k = 0; k < p_Nq; ++k)
+      for(int j = 0; j < p_Nq; ++j)
+        for(int i = 0; i < p_Nq; ++i) {
+          const dlong gbase = element * p_Nggeo * p_Np + k * p_Nq * p_Nq + j * p_Nq + i;
+          const dfloat r_G00 = ggeo[gbase + p_G00ID * p_Np];
+          const dfloat r_G01 = ggeo[gbase + p_G01ID * p_Np];
+          const dfloat r_G11 = ggeo[gbase + p_G11ID * p_Np];
+          const dfloat r_G12 = ggeo[gbase + p_G12ID * p_Np];
+          const dfloat r_G02 = ggeo[gbase + p_G02ID * p_Np];
+          const dfloat r_G22 = ggeo[gbase + p_G22ID * p_Np];
+
+          const dlong id = element * p_Np + k * p_Nq * p_Nq + j * p_Nq + i;
+
+          for(int fld = 0; fld < p_Nfields; fld++) {
+            const dfloat r_lam0 = lambda0[p_lambda*id + fld * loffset];
+
+            dfloat qr = 0, qs = 0, qt = 0;
+            for(int m = 0; m < p_Nq; m++) {
+              qr += s_S[m][i] * s_q[fld][k][j][m];
+              qs += s_S[m][j] * s_q[fld][k][m][i];
+              qt += s_S[m][k] * s_q[fld][m][j][i];
+            }
+
+            s_Gqr[fld][k][j][i] = r_lam0 * (r_G00 * qr + r_G01 * qs + r_G02 * qt);
+            s_Gqs[fld][k][j][i] = r_lam0 * (r_G01 * qr + r_G11 * qs + r_G12 * qt);
+            s_Gqt[fld][k][j][i] = r_lam0 * (r_G02 * qr + r_G12 * qs + r_G22 * qt);
+          }
+        }
+
+    for(int k = 0; k < p_Nq; k++)
+      for(int j = 0; j < p_Nq; ++j)
+        for(int i = 0; i < p_Nq; ++i) {
+          const dlong gbase = element * p_Nggeo * p_Np + k * p_Nq * p_Nq + j * p_Nq + i;
+#ifndef p_poisson
+          const dfloat r_GwJ = ggeo[gbase + p_GWJID * p_Np];
+#endif
+          const dlong id = element * p_Np + k * p_Nq * p_Nq + j * p_Nq + i;
+
+          for(int fld = 0; fld < p_Nfields; fld++) {
+            dfloat r_Aq = 0;
+#ifndef p_poisson
+            r_Aq = r_GwJ * lambda1[p_lambda*id + fld * loffset] * s_q[fld][k][j][i];
+#endif
+            dfloat r_Aqr = 0, r_Aqs = 0, r_Aqt = 0;
+            for(int m = 0; m < p_Nq; m++) {
+              r_Aqr += s_D[m][i] * s_Gqr[fld][k][j][m];
+              r_Aqs += s_D[m][j] * s_Gqs[fld][k][m][i];
+              r_Aqt += s_D[m][k] * s_Gqt[fld][m][j][i];
+            }
+
+            Aq[id + fld * offset] = r_Aqr + r_Aqs + r_Aqt + r_Aq;
+          }
+        }
+  }
+}
@@ -0,0 +1,30 @@
+extern "C" void FUNC(ellipticMultiRhsUpdatePCG)(const dlong & N,
+                       const dlong & Nblock,
+                       const dlong & offset,
+                       const dfloat* __restrict__ cpu_invDegree,
+                       const dfloat* __restrict__ cpu_alpha,
+                       const dfloat* __restrict__ cpu_p,
+                       const dfloat* __restrict__ cpu_Ap,
+                       dfloat* __restrict__ cpu_x,
+                       dfloat* __restrict__ cpu_r,
+                       dfloat* __restrict__ cpu_rdotr)
+{
+  for(int fld = 0; fld < p_Nfields; fld++) {
+    const dfloat alpha = cpu_alpha[fld];
+    dfloat rdotr = 0;
+
+#ifdef __NEKRS__OMP__
+  #pragma omp parallel for reduction(+:rdotr)
+#endif
+    for(int i = 0; i < N; ++i) {
+      const dlong n = i + fld * offset;
+
+      const dfloat rn = cpu_r[n] - alpha * cpu_Ap[n];
+      cpu_x[n] += alpha * cpu_p[n];
+      cpu_r[n] = rn;
+      rdotr += rn * rn * cpu_invDegree[i];
+    }
+
+    cpu_rdotr[fld] = rdotr;
+  }
+}
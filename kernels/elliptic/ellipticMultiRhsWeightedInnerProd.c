@@ -0,0 +1,22 @@
+extern "C" void FUNC(ellipticMultiRhsWeightedInnerProd)(const dlong & N,
+                       const dlong & Nblock,
+                       const dlong & offset,
+                       const dfloat* __restrict__ cpu_w,
+                       const dfloat* __restrict__ cpu_x,
+                       const dfloat* __restrict__ cpu_y,
+                       dfloat* __restrict__ cpu_wxy)
+{
+  for(int fld = 0; fld < p_Nfields; fld++) {
+    dfloat wxy = 0;
+
+#ifdef __NEKRS__OMP__
+  #pragma omp parallel for reduction(+:wxy)
+#endif
+    for(int i = 0; i < N; ++i) {
+      const dlong n = i + fld * offset;
+      wxy += cpu_w[i] * cpu_x[n] * cpu_y[n];
+    }
+
+    cpu_wxy[fld] = wxy;
+  }
+}
@@ -96,3 +96,294 @@ extern "C" void FUNC(ellipticPartialAxCoeffHex3D_v0)(const dlong & Nelements,
   }
 }
 #endif
+
+#if p_knl == 1 || p_knl == 2
+#include <stdlib.h>
+
+// One element per SIMD lane. The vector width follows the target ISA of the JIT
+// compiler flags, interleaved geometric factors fix it to the width of their element groups.
+#if p_knl == 2
+#define p_simdBytes p_aosoaBytes
+#elif defined(__AVX512F__)
+#define p_simdBytes 64
+#elif defined(__AVX__)
+#define p_simdBytes 32
+#else
+#define p_simdBytes 16
+#endif
+#define p_Nlanes (p_simdBytes / (int) sizeof(dfloat))
+
+typedef dfloat simd_t __attribute__((vector_size(p_simdBytes), may_alias));
+#define SIMD(a) (*(simd_t*) (a))
+#endif
+
+#if p_knl == 1
+// A batch of elements is interleaved into local scratch, the tensor
+// contractions then vectorize across the batch for any p_Nq.
+#ifdef p_poisson
+#define p_NggeoBatch 6
+#else
+#define p_NggeoBatch 7
+#endif
+
+extern "C" void FUNC(ellipticPartialAxCoeffHex3D_v1)(const dlong & Nelements,
+                        const dlong & offset,
+                        const dlong & loffset,
+                        const dlong* __restrict__ elementList,
+                        const dfloat* __restrict__ ggeo,
+                        const dfloat* __restrict__ D,
+                        const dfloat* __restrict__ S,
+                        const dfloat* __restrict__ lambda0,
+                        const dfloat* __restrict__ lambda1,
+                        const dfloat* __restrict__ q,
+                        dfloat* __restrict__ Aq )
+{
+  const int ggeoIds[7] = {p_G00ID, p_G01ID, p_G02ID, p_G11ID, p_G12ID, p_G22ID, p_GWJID};
+  const dlong Nbatches = (Nelements + p_Nlanes - 1) / p_Nlanes;
+
+  // [node][lane], too large for a (thread) stack at high order
+  struct scratch_t {
+    alignas(p_simdBytes) dfloat q[p_Np][p_Nlanes];
+    alignas(p_simdBytes) dfloat G[p_NggeoBatch][p_Np][p_Nlanes];
+    alignas(p_simdBytes) dfloat lam[2][p_Np][p_Nlanes];
+    alignas(p_simdBytes) dfloat Gqr[p_Np][p_Nlanes];
+    alignas(p_simdBytes) dfloat Gqs[p_Np][p_Nlanes];
+    alignas(p_simdBytes) dfloat Gqt[p_Np][p_Nlanes];
+  };
+
+#ifdef __NEKRS__OMP__
+  #pragma omp parallel
+#endif
+  {
+  scratch_t *scratch = static_cast<scratch_t *>(aligned_alloc(p_simdBytes, sizeof(scratch_t)));
+  auto &s_q = scratch->q;
+  auto &s_G = scratch->G;
+  auto &s_lam = scratch->lam;
+  auto &s_Gqr = scratch->Gqr;
+  auto &s_Gqs = scratch->Gqs;
+  auto &s_Gqt = scratch->Gqt;
+
+#ifdef __NEKRS__OMP__
+  #pragma omp for
+#endif
+  for(dlong batch = 0; batch < Nbatches; ++batch) {
+    // a partial last batch repeats its last element in the unused lanes
+    const int Nactive = (Nelements - batch * p_Nlanes < p_Nlanes) ? Nelements - batch * p_Nlanes : p_Nlanes;
+
+    dlong element[p_Nlanes];
+    for(int l = 0; l < p_Nlanes; ++l)
+      element[l] = elementList[batch * p_Nlanes + (l < Nactive ? l : Nactive - 1)];
+
+    // interleave, one field at a time keeps the number of concurrent streams at p_Nlanes
+    for(int n = 0; n < p_Np; ++n)
+      for(int l = 0; l < p_Nlanes; ++l)
+        s_q[n][l] = q[n + element[l] * p_Np];
+    for(int g = 0; g < p_NggeoBatch; ++g)
+      for(int n = 0; n < p_Np; ++n)
+        for(int l = 0; l < p_Nlanes; ++l)
+          s_G[g][n][l] = ggeo[n + ggeoIds[g] * p_Np + element[l] * p_Nggeo * p_Np];
+    for(int n = 0; n < p_Np; ++n)
+      for(int l = 0; l < p_Nlanes; ++l)
+        s_lam[0][n][l] = lambda0[p_lambda * (n + element[l] * p_Np) + 0 * loffset];
+#ifndef p_poisson
+    for(int n = 0; n < p_Np; ++n)
+      for(int l = 0; l < p_Nlanes; ++l)
+        s_lam[1][n][l] = lambda1[p_lambda * (n + element[l] * p_Np) + 0 * loffset];
+#endif
+
+    for(int k = 0; k < p_Nq; ++k)
+      for(int j = 0; j < p_Nq; ++j)
+        for(int i = 0; i < p_Nq; ++i) {
+          const int n = k * p_Nq * p_Nq + j * p_Nq + i;
+
+          simd_t qr = {0};
+          simd_t qs = {0};
+          simd_t qt = {0};
+
+          for(int m = 0; m < p_Nq; m++){
+            qr += S[m*p_Nq + i] * SIMD(s_q[m + j * p_Nq + k * p_Nq * p_Nq]);
+            qs += S[m*p_Nq + j] * SIMD(s_q[i + m * p_Nq + k * p_Nq * p_Nq]);
+            qt += S[m*p_Nq + k] * SIMD(s_q[i + j * p_Nq + m * p_Nq * p_Nq]);
+          }
+
+          const simd_t G00 = SIMD(s_G[0][n]), G01 = SIMD(s_G[1][n]), G02 = SIMD(s_G[2][n]);
+          const simd_t G11 = SIMD(s_G[3][n]), G12 = SIMD(s_G[4][n]), G22 = SIMD(s_G[5][n]);
+          const simd_t lam0 = SIMD(s_lam[0][n]);
+
+          SIMD(s_Gqr[n]) = lam0 * (G00 * qr + G01 * qs + G02 * qt);
+          SIMD(s_Gqs[n]) = lam0 * (G01 * qr + G11 * qs + G12 * qt);
+          SIMD(s_Gqt[n]) = lam0 * (G02 * qr + G12 * qs + G22 * qt);
+        }
+
+    // s_q is overwritten by the result, every node reads only its own value
+    for(int k = 0; k < p_Nq; k++)
+      for(int j = 0; j < p_Nq; ++j)
+        for(int i = 0; i < p_Nq; ++i) {
+          const int n = k * p_Nq * p_Nq + j * p_Nq + i;
+
+          simd_t r_Aq = {0};
+#ifndef p_poisson
+          r_Aq = SIMD(s_G[6][n]) * SIMD(s_lam[1][n]) * SIMD(s_q[n]);
+#endif
+          simd_t r_Aqr = {0}, r_Aqs = {0}, r_Aqt = {0};
+
+          for(int m = 0; m < p_Nq; m++){
+            r_Aqr += D[m*p_Nq+i] * SIMD(s_Gqr[m + j * p_Nq + k * p_Nq * p_Nq]);
+            r_Aqs += D[m*p_Nq+j] * SIMD(s_Gqs[i + m * p_Nq + k * p_Nq * p_Nq]);
+            r_Aqt += D[m*p_Nq+k] * SIMD(s_Gqt[i + j * p_Nq + m * p_Nq * p_Nq]);
+          }
+
+          SIMD(s_q[n]) = r_Aqr + r_Aqs + r_Aqt + r_Aq;
+        }
+
+    for(int n = 0; n < p_Np; ++n)
+      for(int l = 0; l < Nactive; ++l)
+        Aq[n + element[l] * p_Np] = s_q[n][l];
+  }
+
+  free(scratch);
+  }
+}
+#endif
+
+#if p_knl == 2
+// Interleaved (AoSoA) geometric factors, p_Nlanes consecutive elements
+// are interleaved node by node: ggeo[((group * p_Nggeo + g) * p_Np + n) * p_Nlanes + lane].
+// A batch covering a full group reads them in place, other batches gather.
+// Fields and coefficients are E-vectors and get interleaved per batch.
+typedef dfloat simdu_t __attribute__((vector_size(p_simdBytes), aligned(sizeof(dfloat)), may_alias));
+#define SIMDU(a) (*(const simdu_t*) (a))
+
+extern "C" void FUNC(ellipticPartialAxCoeffHex3D_v2)(const dlong & Nelements,
+                        const dlong & offset,
+                        const dlong & loffset,
+                        const dlong* __restrict__ elementList,
+                        const dfloat* __restrict__ ggeo,
+                        const dfloat* __restrict__ D,
+                        const dfloat* __restrict__ S,
+                        const dfloat* __restrict__ lambda0,
+                        const dfloat* __restrict__ lambda1,
+                        const dfloat* __restrict__ q,
+                        dfloat* __restrict__ Aq )
+{
+  const dlong Nbatches = (Nelements + p_Nlanes - 1) / p_Nlanes;
+
+  // [node][lane], too large for a (thread) stack at high order
+  struct scratch_t {
+    alignas(p_simdBytes) dfloat q[p_Np][p_Nlanes];
+    alignas(p_simdBytes) dfloat G[p_Nggeo][p_Np][p_Nlanes];
+    alignas(p_simdBytes) dfloat lam[2][p_Np][p_Nlanes];
+    alignas(p_simdBytes) dfloat Gqr[p_Np][p_Nlanes];
+    alignas(p_simdBytes) dfloat Gqs[p_Np][p_Nlanes];
+    alignas(p_simdBytes) dfloat Gqt[p_Np][p_Nlanes];
+  };
+
+#ifdef __NEKRS__OMP__
+  #pragma omp parallel
+#endif
+  {
+  scratch_t *scratch = static_cast<scratch_t *>(aligned_alloc(p_simdBytes, sizeof(scratch_t)));
+  auto &s_q = scratch->q;
+  auto &s_G = scratch->G;
+  auto &s_lam = scratch->lam;
+  auto &s_Gqr = scratch->Gqr;
+  auto &s_Gqs = scratch->Gqs;
+  auto &s_Gqt = scratch->Gqt;
+
+#ifdef __NEKRS__OMP__
+  #pragma omp for
+#endif
+  for(dlong batch = 0; batch < Nbatches; ++batch) {
+    // a partial last batch repeats its last element in the unused lanes
+    const int Nactive = (Nelements - batch * p_Nlanes < p_Nlanes) ? Nelements - batch * p_Nlanes : p_Nlanes;
+
+    dlong element[p_Nlanes];
+    for(int l = 0; l < p_Nlanes; ++l)
+      element[l] = elementList[batch * p_Nlanes + (l < Nactive ? l : Nactive - 1)];
+
+    bool fullGroup = (element[0] % p_Nlanes == 0);
+    for(int l = 1; l < p_Nlanes; ++l)
+      fullGroup = fullGroup && (element[l] == element[0] + l);
+
+    const dfloat* G = &s_G[0][0][0];
+    if(fullGroup) {
+      G = ggeo + (element[0] / p_Nlanes) * p_Nggeo * p_Np * p_Nlanes;
+    } else {
+      for(int l = 0; l < p_Nlanes; ++l) {
+        const dfloat* Gl = ggeo + (element[l] / p_Nlanes) * p_Nggeo * p_Np * p_Nlanes + element[l] % p_Nlanes;
+        for(int g = 0; g < p_Nggeo; ++g)
+          for(int n = 0; n < p_Np; ++n)
+            s_G[g][n][l] = Gl[(g * p_Np + n) * p_Nlanes];
+      }
+    }
+
+    for(int n = 0; n < p_Np; ++n)
+      for(int l = 0; l < p_Nlanes; ++l)
+        s_q[n][l] = q[n + element[l] * p_Np];
+    for(int n = 0; n < p_Np; ++n)
+      for(int l = 0; l < p_Nlanes; ++l)
+        s_lam[0][n][l] = lambda0[p_lambda * (n + element[l] * p_Np) + 0 * loffset];
+#ifndef p_poisson
+    for(int n = 0; n < p_Np; ++n)
+      for(int l = 0; l < p_Nlanes; ++l)
+        s_lam[1][n][l] = lambda1[p_lambda * (n + element[l] * p_Np) + 0 * loffset];
+#endif
+
+    for(int k = 0; k < p_Nq; ++k)
+      for(int j = 0; j < p_Nq; ++j)
+        for(int i = 0; i < p_Nq; ++i) {
+          const int n = k * p_Nq * p_Nq + j * p_Nq + i;
+
+          simd_t qr = {0};
+          simd_t qs = {0};
+          simd_t qt = {0};
+
+          for(int m = 0; m < p_Nq; m++){
+            qr += S[m*p_Nq + i] * SIMD(s_q[m + j * p_Nq + k * p_Nq * p_Nq]);
+            qs += S[m*p_Nq + j] * SIMD(s_q[i + m * p_Nq + k * p_Nq * p_Nq]);
+            qt += S[m*p_Nq + k] * SIMD(s_q[i + j * p_Nq + m * p_Nq * p_Nq]);
+          }
+
+          const simd_t G00 = SIMDU(G + (p_G00ID * p_Np + n) * p_Nlanes);
+          const simd_t G01 = SIMDU(G + (p_G01ID * p_Np + n) * p_Nlanes);
+          const simd_t G02 = SIMDU(G + (p_G02ID * p_Np + n) * p_Nlanes);
+          const simd_t G11 = SIMDU(G + (p_G11ID * p_Np + n) * p_Nlanes);
+          const simd_t G12 = SIMDU(G + (p_G12ID * p_Np + n) * p_Nlanes);
+          const simd_t G22 = SIMDU(G + (p_G22ID * p_Np + n) * p_Nlanes);
+          const simd_t lam0 = SIMD(s_lam[0][n]);
+
+          SIMD(s_Gqr[n]) = lam0 * (G00 * qr + G01 * qs + G02 * qt);
+          SIMD(s_Gqs[n]) = lam0 * (G01 * qr + G11 * qs + G12 * qt);
+          SIMD(s_Gqt[n]) = lam0 * (G02 * qr + G12 * qs + G22 * qt);
+        }
+
+    // s_q is overwritten by the result, every node reads only its own value
+    for(int k = 0; k < p_Nq; k++)
+      for(int j = 0; j < p_Nq; ++j)
+        for(int i = 0; i < p_Nq; ++i) {
+          const int n = k * p_Nq * p_Nq + j * p_Nq + i;
+
+          simd_t r_Aq = {0};
+#ifndef p_poisson
+          r_Aq = SIMDU(G + (p_GWJID * p_Np + n) * p_Nlanes) * SIMD(s_lam[1][n]) * SIMD(s_q[n]);
+#endif
+          simd_t r_Aqr = {0}, r_Aqs = {0}, r_Aqt = {0};
+
+          for(int m = 0; m < p_Nq; m++){
+            r_Aqr += D[m*p_Nq+i] * SIMD(s_Gqr[m + j * p_Nq + k * p_Nq * p_Nq]);
+            r_Aqs += D[m*p_Nq+j] * SIMD(s_Gqs[i + m * p_Nq + k * p_Nq * p_Nq]);
+            r_Aqt += D[m*p_Nq+k] * SIMD(s_Gqt[i + j * p_Nq + m * p_Nq * p_Nq]);
+          }
+
+          SIMD(s_q[n]) = r_Aqr + r_Aqs + r_Aqt + r_Aq;
+        }
+
+    for(int n = 0; n < p_Np; ++n)
+      for(int l = 0; l < Nactive; ++l)
+        Aq[n + element[l] * p_Np] = s_q[n][l];
+  }
+
+  free(scratch);
+  }
+}
+#endif
@@ -0,0 +1,154 @@
+// Geometric factors are recomputed from the element nodes at the GLL points of
+// order p_Nq_g - 1, xyz is [element][dim][p_Np_g].
+// geomBasis = [gllw (p_Nq) | I (p_Nq x p_Nq_g) | DI (p_Nq x p_Nq_g)] where I
+// interpolates from the low-order to the p_Nq GLL points and DI = D I.
+
+#if p_knl == 0
+extern "C" void FUNC(ellipticPartialAxNgeomHex3D_v0)(const dlong & Nelements,
+                        const dlong & offset,
+                        const dlong & loffset,
+                        const dlong* __restrict__ elementList,
+                        const dfloat* __restrict__ xyz,
+                        const dfloat* __restrict__ geomBasis,
+                        const dfloat* __restrict__ D,
+                        const dfloat* __restrict__ S,
+                        const dfloat* __restrict__ lambda0,
+                        const dfloat* __restrict__ lambda1,
+                        const dfloat* __restrict__ q,
+                        dfloat* __restrict__ Aq )
+{
+  const dfloat* gllw = geomBasis;
+  const dfloat* I = geomBasis + p_Nq;
+  const dfloat* DI = geomBasis + p_Nq + p_Nq * p_Nq_g;
+
+  dfloat s_q[p_Nq][p_Nq][p_Nq];
+  dfloat s_Gqr[p_Nq][p_Nq][p_Nq];
+  dfloat s_Gqs[p_Nq][p_Nq][p_Nq];
+  dfloat s_Gqt[p_Nq][p_Nq][p_Nq];
+  dfloat s_GwJ[p_Nq][p_Nq][p_Nq];
+
+  // partial contractions, [0]: d/dr, [1]: interpolated in r
+  dfloat s_xr[2][p_dim][p_Nq_g][p_Nq_g][p_Nq];
+  // [0]: d/dr, [1]: d/ds, [2]: interpolated in r and s
+  dfloat s_xrs[3][p_dim][p_Nq_g][p_Nq][p_Nq];
+
+#ifdef __NEKRS__OMP__
+  #pragma omp parallel for private(s_q, s_Gqr, s_Gqs, s_Gqt, s_GwJ, s_xr, s_xrs)
+#endif
+  for(dlong e = 0; e < Nelements; ++e) {
+    const dlong element = elementList[e];
+    const dfloat* xe = xyz + element * p_dim * p_Np_g;
+
+    for(int d = 0; d < p_dim; ++d)
+      for(int c = 0; c < p_Nq_g; ++c)
+        for(int b = 0; b < p_Nq_g; ++b)
+          for(int i = 0; i < p_Nq; ++i) {
+            dfloat xr = 0, x = 0;
+            for(int a = 0; a < p_Nq_g; ++a) {
+              const dfloat xn = xe[d * p_Np_g + c * p_Nq_g * p_Nq_g + b * p_Nq_g + a];
+              xr += DI[i * p_Nq_g + a] * xn;
+              x += I[i * p_Nq_g + a] * xn;
+            }
+            s_xr[0][d][c][b][i] = xr;
+            s_xr[1][d][c][b][i] = x;
+          }
+
+    for(int d = 0; d < p_dim; ++d)
+      for(int c = 0; c < p_Nq_g; ++c)
+        for(int j = 0; j < p_Nq; ++j)
+          for(int i = 0; i < p_Nq; ++i) {
+            dfloat xr = 0, xs = 0, x = 0;
+            for(int b = 0; b < p_Nq_g; ++b) {
+              xr += I[j * p_Nq_g + b] * s_xr[0][d][c][b][i];
+              xs += DI[j * p_Nq_g + b] * s_xr[1][d][c][b][i];
+              x += I[j * p_Nq_g + b] * s_xr[1][d][c][b][i];
+            }
+            s_xrs[0][d][c][j][i] = xr;
+            s_xrs[1][d][c][j][i] = xs;
+            s_xrs[2][d][c][j][i] = x;
+          }
+
+    for(int k = 0; k < p_Nq; k++)
+      for(int j = 0; j < p_Nq; ++j)
+        for(int i = 0; i < p_Nq; ++i) {
+          const dlong base = i + j * p_Nq + k * p_Nq * p_Nq + element * p_Np;
+          s_q[k][j][i] = q[base];
+        }
+
+    for(int k = 0; k < p_Nq; ++k)
+      for(int j = 0; j < p_Nq; ++j)
+        for(int i = 0; i < p_Nq; ++i) {
+          dfloat dr[p_dim], ds[p_dim], dt[p_dim];
+          for(int d = 0; d < p_dim; ++d) {
+            dr[d] = 0;
+            ds[d] = 0;
+            dt[d] = 0;
+            for(int c = 0; c < p_Nq_g; ++c) {
+              dr[d] += I[k * p_Nq_g + c] * s_xrs[0][d][c][j][i];
+              ds[d] += I[k * p_Nq_g + c] * s_xrs[1][d][c][j][i];
+              dt[d] += DI[k * p_Nq_g + c] * s_xrs[2][d][c][j][i];
+            }
+          }
+
+          const dfloat xr = dr[0], yr = dr[1], zr = dr[2];
+          const dfloat xs = ds[0], ys = ds[1], zs = ds[2];
+          const dfloat xt = dt[0], yt = dt[1], zt = dt[2];
+
+          const dfloat J = xr * (ys * zt - zs * yt) - yr * (xs * zt - zs * xt) + zr * (xs * yt - ys * xt);
+
+          const dfloat rx = (ys * zt - zs * yt), ry = -(xs * zt - zs * xt), rz = (xs * yt - ys * xt);
+          const dfloat sx = -(yr * zt - zr * yt), sy = (xr * zt - zr * xt), sz = -(xr * yt - yr * xt);
+          const dfloat tx = (yr * zs - zr * ys), ty = -(xr * zs - zr * xs), tz = (xr * ys - yr * xs);
+
+          const dfloat W = gllw[i] * gllw[j] * gllw[k];
+          const dfloat sc = W / J;
+
+          const dfloat r_G00 = sc * (rx * rx + ry * ry + rz * rz);
+          const dfloat r_G01 = sc * (rx * sx + ry * sy + rz * sz);
+          const dfloat r_G02 = sc * (rx * tx + ry * ty + rz * tz);
+          const dfloat r_G11 = sc * (sx * sx + sy * sy + sz * sz);
+          const dfloat r_G12 = sc * (sx * tx + sy * ty + sz * tz);
+          const dfloat r_G22 = sc * (tx * tx + ty * ty + tz * tz);
+
+          s_GwJ[k][j][i] = W * J;
+
+          const dlong id = element * p_Np + k * p_Nq * p_Nq + j * p_Nq + i;
+          const dfloat r_lam0 = lambda0[p_lambda * id];
+
+          dfloat qr = 0;
+          dfloat qs = 0;
+          dfloat qt = 0;
+
+          for(int m = 0; m < p_Nq; m++){
+            qr += S[m*p_Nq + i] * s_q[k][j][m];
+            qs += S[m*p_Nq + j] * s_q[k][m][i];
+            qt += S[m*p_Nq + k] * s_q[m][j][i];
+          }
+
+          s_Gqr[k][j][i] = r_lam0 * (r_G00 * qr + r_G01 * qs + r_G02 * qt);
+          s_Gqs[k][j][i] = r_lam0 * (r_G01 * qr + r_G11 * qs + r_G12 * qt);
+          s_Gqt[k][j][i] = r_lam0 * (r_G02 * qr + r_G12 * qs + r_G22 * qt);
+        }
+
+    for(int k = 0; k < p_Nq; k++)
+      for(int j = 0; j < p_Nq; ++j)
+        for(int i = 0; i < p_Nq; ++i) {
+          const dlong id = element * p_Np + k * p_Nq * p_Nq + j * p_Nq + i;
+
+          dfloat r_Aq = 0;
+#ifndef p_poisson
+          r_Aq = s_GwJ[k][j][i] * lambda1[p_lambda * id] * s_q[k][j][i];
+#endif
+          dfloat r_Aqr = 0, r_Aqs = 0, r_Aqt = 0;
+
+          for(int m = 0; m < p_Nq; m++){
+            r_Aqr += D[m*p_Nq+i] * s_Gqr[k][j][m];
+            r_Aqs += D[m*p_Nq+j] * s_Gqs[k][m][i];
+            r_Aqt += D[m*p_Nq+k] * s_Gqt[m][j][i];
+          }
+
+          Aq[id] = r_Aqr + r_Aqs + r_Aqt + r_Aq;
+        }
+  }
+}
+#endif
@@ -0,0 +1,134 @@
+#define p_eighth ((dfloat)0.125)
+
+#if p_knl == 0
+extern "C" void FUNC(ellipticPartialAxTrilinearHex3D_v0)(const dlong & Nelements,
+                        const dlong & offset,
+                        const dlong & loffset,
+                        const dlong* __restrict__ elementList,
+                        const dfloat* __restrict__ EXYZ,
+                        const dfloat* __restrict__ gllzw,
+                        const dfloat* __restrict__ D,
+                        const dfloat* __restrict__ S,
+                        const dfloat* __restrict__ lambda0,
+                        const dfloat* __restrict__ lambda1,
+                        const dfloat* __restrict__ q,
+                        dfloat* __restrict__ Aq )
+{
+  dfloat s_q[p_Nq][p_Nq][p_Nq];
+  dfloat s_Gqr[p_Nq][p_Nq][p_Nq];
+  dfloat s_Gqs[p_Nq][p_Nq][p_Nq];
+  dfloat s_Gqt[p_Nq][p_Nq][p_Nq];
+  dfloat s_GwJ[p_Nq][p_Nq][p_Nq];
+
+#ifdef __NEKRS__OMP__
+  #pragma omp parallel for private(s_q, s_Gqr, s_Gqs, s_Gqt, s_GwJ)
+#endif
+  for(dlong e = 0; e < Nelements; ++e) {
+    const dlong element = elementList[e];
+
+    const dfloat* xe = EXYZ + element * p_Nverts * p_dim;
+    const dfloat* ye = xe + p_Nverts;
+    const dfloat* ze = ye + p_Nverts;
+
+    for(int k = 0; k < p_Nq; k++)
+      for(int j = 0; j < p_Nq; ++j)
+        for(int i = 0; i < p_Nq; ++i) {
+          const dlong base = i + j * p_Nq + k * p_Nq * p_Nq + element * p_Np;
+          s_q[k][j][i] = q[base];
+        }
+
+    for(int k = 0; k < p_Nq; ++k)
+      for(int j = 0; j < p_Nq; ++j)
+        for(int i = 0; i < p_Nq; ++i) {
+          const dfloat rn = gllzw[i];
+          const dfloat sn = gllzw[j];
+          const dfloat tn = gllzw[k];
+
+          const dfloat xr =
+              p_eighth * ((1 - tn) * (1 - sn) * (xe[1] - xe[0]) + (1 - tn) * (1 + sn) * (xe[2] - xe[3]) +
+                          (1 + tn) * (1 - sn) * (xe[5] - xe[4]) + (1 + tn) * (1 + sn) * (xe[6] - xe[7]));
+          const dfloat xs =
+              p_eighth * ((1 - tn) * (1 - rn) * (xe[3] - xe[0]) + (1 - tn) * (1 + rn) * (xe[2] - xe[1]) +
+                          (1 + tn) * (1 - rn) * (xe[7] - xe[4]) + (1 + tn) * (1 + rn) * (xe[6] - xe[5]));
+          const dfloat xt =
+              p_eighth * ((1 - rn) * (1 - sn) * (xe[4] - xe[0]) + (1 + rn) * (1 - sn) * (xe[5] - xe[1]) +
+                          (1 + rn) * (1 + sn) * (xe[6] - xe[2]) + (1 - rn) * (1 + sn) * (xe[7] - xe[3]));
+
+          const dfloat yr =
+              p_eighth * ((1 - tn) * (1 - sn) * (ye[1] - ye[0]) + (1 - tn) * (1 + sn) * (ye[2] - ye[3]) +
+                          (1 + tn) * (1 - sn) * (ye[5] - ye[4]) + (1 + tn) * (1 + sn) * (ye[6] - ye[7]));
+          const dfloat ys =
+              p_eighth * ((1 - tn) * (1 - rn) * (ye[3] - ye[0]) + (1 - tn) * (1 + rn) * (ye[2] - ye[1]) +
+                          (1 + tn) * (1 - rn) * (ye[7] - ye[4]) + (1 + tn) * (1 + rn) * (ye[6] - ye[5]));
+          const dfloat yt =
+              p_eighth * ((1 - rn) * (1 - sn) * (ye[4] - ye[0]) + (1 + rn) * (1 - sn) * (ye[5] - ye[1]) +
+                          (1 + rn) * (1 + sn) * (ye[6] - ye[2]) + (1 - rn) * (1 + sn) * (ye[7] - ye[3]));
+
+          const dfloat zr =
+              p_eighth * ((1 - tn) * (1 - sn) * (ze[1] - ze[0]) + (1 - tn) * (1 + sn) * (ze[2] - ze[3]) +
+                          (1 + tn) * (1 - sn) * (ze[5] - ze[4]) + (1 + tn) * (1 + sn) * (ze[6] - ze[7]));
+          const dfloat zs =
+              p_eighth * ((1 - tn) * (1 - rn) * (ze[3] - ze[0]) + (1 - tn) * (1 + rn) * (ze[2] - ze[1]) +
+                          (1 + tn) * (1 - rn) * (ze[7] - ze[4]) + (1 + tn) * (1 + rn) * (ze[6] - ze[5]));
+          const dfloat zt =
+              p_eighth * ((1 - rn) * (1 - sn) * (ze[4] - ze[0]) + (1 + rn) * (1 - sn) * (ze[5] - ze[1]) +
+                          (1 + rn) * (1 + sn) * (ze[6] - ze[2]) + (1 - rn) * (1 + sn) * (ze[7] - ze[3]));
+
+          const dfloat J = xr * (ys * zt - zs * yt) - yr * (xs * zt - zs * xt) + zr * (xs * yt - ys * xt);
+
+          const dfloat rx = (ys * zt - zs * yt), ry = -(xs * zt - zs * xt), rz = (xs * yt - ys * xt);
+          const dfloat sx = -(yr * zt - zr * yt), sy = (xr * zt - zr * xt), sz = -(xr * yt - yr * xt);
+          const dfloat tx = (yr * zs - zr * ys), ty = -(xr * zs - zr * xs), tz = (xr * ys - yr * xs);
+
+          const dfloat W = gllzw[p_Nq + i] * gllzw[p_Nq + j] * gllzw[p_Nq + k];
+          const dfloat sc = W / J;
+
+          const dfloat r_G00 = sc * (rx * rx + ry * ry + rz * rz);
+          const dfloat r_G01 = sc * (rx * sx + ry * sy + rz * sz);
+          const dfloat r_G02 = sc * (rx * tx + ry * ty + rz * tz);
+          const dfloat r_G11 = sc * (sx * sx + sy * sy + sz * sz);
+          const dfloat r_G12 = sc * (sx * tx + sy * ty + sz * tz);
+          const dfloat r_G22 = sc * (tx * tx + ty * ty + tz * tz);
+
+          s_GwJ[k][j][i] = W * J;
+
+          const dlong id = element * p_Np + k * p_Nq * p_Nq + j * p_Nq + i;
+          const dfloat r_lam0 = lambda0[p_lambda * id];
+
+          dfloat qr = 0;
+          dfloat qs = 0;
+          dfloat qt = 0;
+
+          for(int m = 0; m < p_Nq; m++){
+            qr += S[m*p_Nq + i] * s_q[k][j][m];
+            qs += S[m*p_Nq + j] * s_q[k][m][i];
+            qt += S[m*p_Nq + k] * s_q[m][j][i];
+          }
+
+          s_Gqr[k][j][i] = r_lam0 * (r_G00 * qr + r_G01 * qs + r_G02 * qt);
+          s_Gqs[k][j][i] = r_lam0 * (r_G01 * qr + r_G11 * qs + r_G12 * qt);
+          s_Gqt[k][j][i] = r_lam0 * (r_G02 * qr + r_G12 * qs + r_G22 * qt);
+        }
+
+    for(int k = 0; k < p_Nq; k++)
+      for(int j = 0; j < p_Nq; ++j)
+        for(int i = 0; i < p_Nq; ++i) {
+          const dlong id = element * p_Np + k * p_Nq * p_Nq + j * p_Nq + i;
+
+          dfloat r_Aq = 0;
+#ifndef p_poisson
+          r_Aq = s_GwJ[k][j][i] * lambda1[p_lambda * id] * s_q[k][j][i];
+#endif
+          dfloat r_Aqr = 0, r_Aqs = 0, r_Aqt = 0;
+
+          for(int m = 0; m < p_Nq; m++){
+            r_Aqr += D[m*p_Nq+i] * s_Gqr[k][j][m];
+            r_Aqs += D[m*p_Nq+j] * s_Gqs[k][m][i];
+            r_Aqt += D[m*p_Nq+k] * s_Gqt[m][j][i];
+          }
+
+          Aq[id] = r_Aqr + r_Aqs + r_Aqt + r_Aq;
+        }
+  }
+}
+#endif
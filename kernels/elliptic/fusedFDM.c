@@ -29,7 +29,7 @@ extern "C" void FUNC(fusedFDM)(
   #pragma omp parallel for private(S_x_e, S_y_e, S_z_e, S_x_eT, S_y_eT, S_z_eT, tmp, work2)
 #endif
   for (dlong my_elem = 0; my_elem < Nelements; ++my_elem) {
-    const dlong element = my_elem;
+    const dlong element = elementList[my_elem];
     const dlong elem = element;
     for(int j = 1; j < p_Nq_e-1; ++j){
       for(int k = 1; k < p_Nq_e-1; ++k){
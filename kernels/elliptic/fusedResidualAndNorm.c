@@ -35,6 +35,9 @@ extern "C" void FUNC(fusedResidualAndNorm)(const dlong & Nblocks, const dlong &
                                     dfloat* __restrict__ reduction)
 {
   dfloat rdotr = 0.0;
+#ifdef __NEKRS__OMP__
+  #pragma omp parallel for collapse(2) reduction(+:rdotr)
+#endif
   for(int fld = 0 ; fld < p_Nfields; ++fld){
     for(int id = 0 ; id < N; ++id){
       const dfloat rnew = b_vec[id + fld * offset] - Ax[id + fld * offset];
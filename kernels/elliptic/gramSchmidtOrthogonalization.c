@@ -35,23 +35,19 @@ extern "C" void FUNC(gramSchmidtOrthogonalization)(const dlong & Nblock, const d
                                     dfloat*  __restrict__ w,
                                     dfloat*  __restrict__ reduction)
 {
-  for(int j = 0; j < gmresSize; ++j){
-    const dfloat yj = y[j];
-    #pragma unroll
-    for(int fld = 0; fld < p_Nfields; fld++){
-      for(dlong n = 0; n < N; ++n) {
-        const dfloat Vnj = V[n + fld * offset + j * offset * p_Nfields];
-        w[n + fld * offset] -= yj * Vnj;
-      }
-    }
-  }
   dfloat sum = 0.0;
-  #pragma unroll
+#ifdef __NEKRS__OMP__
+  #pragma omp parallel for collapse(2) reduction(+:sum)
+#endif
   for(int fld = 0; fld < p_Nfields; fld++){
-    for(dlong n = 0 ; n < N; ++n){
-      const dfloat weight = weights[n];
-      const dfloat w_curr = w[n + fld * offset];
-      sum += w_curr * w_curr * weight;
+    for(dlong n = 0; n < N; ++n) {
+      dfloat w_curr = w[n + fld * offset];
+      for(int j = 0; j < gmresSize; ++j){
+        const dfloat Vnj = V[n + fld * offset + j * offset * p_Nfields];
+        w_curr -= y[j] * Vnj;
+      }
+      w[n + fld * offset] = w_curr;
+      sum += w_curr * w_curr * weights[n];
     }
   }
   reduction[0] = sum;
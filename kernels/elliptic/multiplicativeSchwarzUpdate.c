@@ -0,0 +1,18 @@
+// y += alpha * x, x = 0 on the elements of the list
+extern "C" void FUNC(multiplicativeSchwarzUpdate)(const dlong& Nelements,
+                                                  const dlong* __restrict__ elementList,
+                                                  const pfloat& alpha,
+                                                  pfloat* __restrict__ x,
+                                                  pfloat* __restrict__ y)
+{
+#ifdef __NEKRS__OMP__
+  #pragma omp parallel for
+#endif
+  for (dlong n = 0; n < Nelements; ++n) {
+    const dlong offset = elementList[n] * p_Np;
+    for (int i = 0; i < p_Np; ++i) {
+      y[offset + i] += alpha * x[offset + i];
+      x[offset + i] = 0;
+    }
+  }
+}
@@ -1,6 +1,7 @@
 
 
 extern "C" void FUNC(preFDM)(const dlong& Nelements,
+                    const dlong* __restrict__ elementList,
                     const pfloat* __restrict__ u,
                     pfloat* __restrict__ work1)
 {
@@ -12,7 +13,8 @@ extern "C" void FUNC(preFDM)(const dlong& Nelements,
 #ifdef __NEKRS__OMP__
   #pragma omp parallel for
 #endif
-  for (dlong elem = 0; elem < Nelements; elem++) {
+  for (dlong n = 0; n < Nelements; n++) {
+    const dlong elem = elementList[n];
     #pragma unroll 
     for(int k = 0; k < p_Nq_e; ++k){
       #pragma unroll 
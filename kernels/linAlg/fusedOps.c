@@ -0,0 +1,109 @@
+/*
+The MIT License (MIT)
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Fused elementwise pipeline generated by linAlg_t::fusedKernel, see fusedOps.okl.
+
+extern "C" void FUNC(fusedOps)(
+            const dlong & Nblock,
+            const dlong & N,
+            const dlong & Nfields,
+            const dlong & fieldOffset,
+            const dfloat & a0,
+            const dfloat & a1,
+            const dfloat & a2,
+            const dfloat & a3,
+            const dfloat & a4,
+            const dfloat & a5,
+            const dfloat & a6,
+            const dfloat & a7,
+            dfloat * __restrict__ v0,
+            dfloat * __restrict__ v1,
+            dfloat * __restrict__ v2,
+            dfloat * __restrict__ v3,
+            dfloat * __restrict__ v4,
+            dfloat * __restrict__ v5,
+            dfloat * __restrict__ v6,
+            dfloat * __restrict__ v7,
+            const dfloat * __restrict__ w,
+            dfloat * __restrict__ red){
+
+  dfloat red0 = 0, red1 = 0, red2 = 0, red3 = 0;
+
+#ifdef __NEKRS__OMP__
+  #pragma omp parallel for collapse(2) reduction(+:red0,red1,red2,red3)
+#endif
+  for(dlong fld=0;fld<Nfields;fld++) {
+    for(dlong n=0;n<N;++n){
+      const dlong id = n + fld*fieldOffset;
+
+      dfloat r_v0 = (p_loadMask & 1) ? v0[id] : 0;
+      dfloat r_v1 = (p_loadMask & 2) ? v1[id] : 0;
+      dfloat r_v2 = (p_loadMask & 4) ? v2[id] : 0;
+      dfloat r_v3 = (p_loadMask & 8) ? v3[id] : 0;
+      dfloat r_v4 = (p_loadMask & 16) ? v4[id] : 0;
+      dfloat r_v5 = (p_loadMask & 32) ? v5[id] : 0;
+      dfloat r_v6 = (p_loadMask & 64) ? v6[id] : 0;
+      dfloat r_v7 = (p_loadMask & 128) ? v7[id] : 0;
+
+      p_update;
+
+      if (p_storeMask & 1) v0[id] = r_v0;
+      if (p_storeMask & 2) v1[id] = r_v1;
+      if (p_storeMask & 4) v2[id] = r_v2;
+      if (p_storeMask & 8) v3[id] = r_v3;
+      if (p_storeMask & 16) v4[id] = r_v4;
+      if (p_storeMask & 32) v5[id] = r_v5;
+      if (p_storeMask & 64) v6[id] = r_v6;
+      if (p_storeMask & 128) v7[id] = r_v7;
+
+#if p_weighted
+      const dfloat wn = w[n];
+#else
+      const dfloat wn = 1;
+#endif
+#if p_Nred > 0
+      red0 += wn * (p_reduce0);
+#endif
+#if p_Nred > 1
+      red1 += wn * (p_reduce1);
+#endif
+#if p_Nred > 2
+      red2 += wn * (p_reduce2);
+#endif
+#if p_Nred > 3
+      red3 += wn * (p_reduce3);
+#endif
+    }
+  }
+
+#if p_Nred > 0
+  red[0] = red0;
+#endif
+#if p_Nred > 1
+  red[Nblock] = red1;
+#endif
+#if p_Nred > 2
+  red[2 * Nblock] = red2;
+#endif
+#if p_Nred > 3
+  red[3 * Nblock] = red3;
+#endif
+
+}
@@ -0,0 +1,51 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// Groups of p_Nlanes consecutive elements interleaved node by node,
+// unused lanes of the last group are zero.
+extern "C" void FUNC(interleaveElements) (const dlong & Nelements,
+  const int & Nfields,
+  const int & Np,
+  const p_float * __restrict__ x,
+  p_float * __restrict__ y){
+
+  const dlong Ngroups = (Nelements + p_Nlanes - 1) / p_Nlanes;
+
+#ifdef __NEKRS__OMP__
+  #pragma omp parallel for
+#endif
+  for(dlong group=0;group<Ngroups;++group){
+    for(int fld=0;fld<Nfields;++fld){
+      for(int n=0;n<Np;++n){
+        p_float *yn = y + ((group*Nfields + fld)*Np + n)*p_Nlanes;
+        for(int lane=0;lane<p_Nlanes;++lane){
+          const dlong e = group*p_Nlanes + lane;
+          yn[lane] = (e < Nelements) ? x[(e*Nfields + fld)*Np + n] : 0;
+        }
+      }
+    }
+  }
+}
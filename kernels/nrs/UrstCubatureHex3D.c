@@ -25,6 +25,9 @@ extern "C" void FUNC(UrstCubatureHex3D)(const dlong &Nelements,
     }
   }
 
+#ifdef __NEKRS__OMP__
+  #pragma omp parallel for private(s_U, s_V, s_W, s_U1, s_V1, s_W1, r_U, r_V, r_W)
+#endif
   for (dlong element = 0; element < Nelements; ++element) {
     for (dlong c = 0; c < p_Nq; ++c) {
       for (dlong b = 0; b < p_cubNq; ++b) {
@@ -149,7 +149,7 @@ occa::kernel benchmarkAdvsub(int Nfields,
     kernelName = "subCycleStrongVolumeHex3D";
   }
 
-  const std::string ext = (platform->device.mode() == "Serial") ? ".c" : ".okl";
+  const std::string ext = platform->serial ? ".c" : ".okl";
   fileName = oklpath + "/nrs/" + kernelName + ext;
 
   if (isScalar) {
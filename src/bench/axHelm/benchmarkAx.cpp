@@ -2,6 +2,8 @@
 #include <vector>
 #include <iostream>
 #include <numeric>
+#include <cmath>
+#include <algorithm>
 #include "nrs.hpp"
 
 #include "kernelBenchmarker.hpp"
@@ -51,8 +53,111 @@ template <> struct less<CallParameters> {
 
 namespace {
 std::map<CallParameters, occa::kernel> cachedResults;
+
+// smooth, non-polynomial element map for --computeGeom, element e is shifted by 2e in x
+void curvedElementMap(dfloat r, dfloat s, dfloat t, int e, dfloat *x)
+{
+  x[0] = r + 2 * e + 0.1 * std::sin(M_PI * s / 2);
+  x[1] = s + 0.1 * std::sin(M_PI * t / 2);
+  x[2] = t + 0.1 * std::sin(M_PI * r / 2);
+}
+
+// element nodes at the GLL points of order Ng, [e][dim][Np_g] (vertex ordered for Ng = 1)
+std::vector<dfloat> curvedElementNodes(int Ng, int Nelements)
+{
+  const int Nq_g = Ng + 1;
+  const int Np_g = Nq_g * Nq_g * Nq_g;
+  std::vector<dfloat> r(Nq_g);
+  JacobiGLL(Ng, r.data());
+
+  const int vertexId[8] = {0, 1, 3, 2, 4, 5, 7, 6};
+  std::vector<dfloat> xyz(3 * Np_g * Nelements);
+  for (int e = 0; e < Nelements; e++) {
+    for (int n = 0; n < Np_g; n++) {
+      const int id = (Ng == 1) ? vertexId[n] : n;
+      dfloat x[3];
+      curvedElementMap(r[id % Nq_g], r[(id / Nq_g) % Nq_g], r[id / (Nq_g * Nq_g)], e, x);
+      for (int d = 0; d < 3; d++)
+        xyz[(e * 3 + d) * Np_g + n] = x[d];
+    }
+  }
+  return xyz;
+}
+
+// second argument of the Trilinear and Ngeom kernels
+std::vector<dfloat> geomBasis(int N, int Ng)
+{
+  const int Nq = N + 1;
+  const int Nq_g = Ng + 1;
+  std::vector<dfloat> z(Nq), w(Nq), r(Nq_g);
+  JacobiGLL(N, z.data(), w.data());
+  JacobiGLL(Ng, r.data());
+
+  std::vector<dfloat> basis;
+  if (Ng == 1) {
+    basis.insert(basis.end(), z.begin(), z.end());
+    basis.insert(basis.end(), w.begin(), w.end());
+  }
+  else {
+    std::vector<dfloat> I(Nq * Nq_g), DI(Nq * Nq_g);
+    InterpolationMatrix1D(Ng, Nq_g, r.data(), Nq, z.data(), I.data());
+    Dmatrix1D(Ng, Nq_g, r.data(), Nq, z.data(), DI.data());
+    basis.insert(basis.end(), w.begin(), w.end());
+    basis.insert(basis.end(), I.begin(), I.end());
+    basis.insert(basis.end(), DI.begin(), DI.end());
+  }
+  return basis;
 }
 
+// stored geometric factors of the order N curved geometry
+std::vector<dfloat> curvedGeometricFactors(int N, int Nelements)
+{
+  constexpr int Nggeo{7};
+  const int Nq = N + 1;
+  const int Np = Nq * Nq * Nq;
+  std::vector<dfloat> z(Nq), w(Nq), D(Nq * Nq);
+  JacobiGLL(N, z.data(), w.data());
+  Dmatrix1D(N, Nq, z.data(), Nq, z.data(), D.data());
+
+  const auto xyz = curvedElementNodes(N, Nelements);
+  std::vector<dfloat> ggeo(Nggeo * Np * Nelements);
+  for (int e = 0; e < Nelements; e++) {
+    for (int k = 0; k < Nq; k++)
+      for (int j = 0; j < Nq; j++)
+        for (int i = 0; i < Nq; i++) {
+          dfloat dr[3] = {0}, ds[3] = {0}, dt[3] = {0};
+          for (int d = 0; d < 3; d++) {
+            const dfloat *x = xyz.data() + (e * 3 + d) * Np;
+            for (int m = 0; m < Nq; m++) {
+              dr[d] += D[i * Nq + m] * x[k * Nq * Nq + j * Nq + m];
+              ds[d] += D[j * Nq + m] * x[k * Nq * Nq + m * Nq + i];
+              dt[d] += D[k * Nq + m] * x[m * Nq * Nq + j * Nq + i];
+            }
+          }
+          const dfloat xr = dr[0], yr = dr[1], zr = dr[2];
+          const dfloat xs = ds[0], ys = ds[1], zs = ds[2];
+          const dfloat xt = dt[0], yt = dt[1], zt = dt[2];
+
+          const dfloat J = xr * (ys * zt - zs * yt) - yr * (xs * zt - zs * xt) + zr * (xs * yt - ys * xt);
+          const dfloat rx = (ys * zt - zs * yt) / J, ry = -(xs * zt - zs * xt) / J, rz = (xs * yt - ys * xt) / J;
+          const dfloat sx = -(yr * zt - zr * yt) / J, sy = (xr * zt - zr * xt) / J, sz = -(xr * yt - yr * xt) / J;
+          const dfloat tx = (yr * zs - zr * ys) / J, ty = -(xr * zs - zr * xs) / J, tz = (xr * ys - yr * xs) / J;
+          const dfloat JW = J * w[i] * w[j] * w[k];
+
+          dfloat *G = ggeo.data() + e * Nggeo * Np + k * Nq * Nq + j * Nq + i;
+          G[G00ID * Np] = JW * (rx * rx + ry * ry + rz * rz);
+          G[G01ID * Np] = JW * (rx * sx + ry * sy + rz * sz);
+          G[G02ID * Np] = JW * (rx * tx + ry * ty + rz * tz);
+          G[G11ID * Np] = JW * (sx * sx + sy * sy + sz * sz);
+          G[G12ID * Np] = JW * (sx * tx + sy * ty + sz * tz);
+          G[G22ID * Np] = JW * (tx * tx + ty * ty + tz * tz);
+          G[GWJID * Np] = JW;
+        }
+  }
+  return ggeo;
+}
+} // namespace
+
 template <typename T>
 occa::kernel benchmarkAx(int Nelements,
                          int Nq,
@@ -88,10 +193,6 @@ occa::kernel benchmarkAx(int Nelements,
   occa::properties props = platform->kernelInfo + meshKernelProperties(N);
   if (wordSize == 4)
     props["defines/dfloat"] = "float";
-  if (Ng != N) {
-    props["defines/p_Nq_g"] = Nq_g;
-    props["defines/p_Np_g"] = Np_g;
-  }
   if (poisson)
     props["defines/p_poisson"] = 1;
 
@@ -100,17 +201,29 @@ occa::kernel benchmarkAx(int Nelements,
   else
     props["defines/p_lambda"] = 1;
 
+  // stored geometric factors of the order N geometry, reference for --computeGeom
+  const occa::properties isoProps = props;
+
+  if (Ng != N) {
+    props["defines/p_Nq_g"] = Nq_g;
+    props["defines/p_Np_g"] = Np_g;
+  }
+
   std::string kernelName = "elliptic";
   if (Ndim > 1) {
     kernelName += stressForm ? "Stress" : "Block";
   }
   kernelName += "PartialAx";
-  kernelName += "Coeff";
   if (Ng != N) {
     if (computeGeom) {
-      if (Ng == 1) {
+      if (Ng == 1 && Ndim == 1) {
+        // geometric factors are computed on the fly from the element vertices
         kernelName += "Trilinear";
       }
+      else if (Ng < N && Ndim == 1) {
+        // geometric factors are computed on the fly from the element nodes of order Ng
+        kernelName += "Ngeom";
+      }
       else {
         printf("Unsupported g-order=%d\n", Ng);
         exit(1);
@@ -122,6 +235,9 @@ occa::kernel benchmarkAx(int Nelements,
       kernelName += "Ngeom";
     }
   }
+  else {
+    kernelName += "Coeff";
+  }
   kernelName += "Hex3D";
 
   auto benchmarkAxWithPrecision = [&](auto sampleWord) {
@@ -132,9 +248,16 @@ occa::kernel benchmarkAx(int Nelements,
     std::vector<int> kernelVariants;
 
     if (platform->serial) {
-      const int Nkernels = 1;
+      // variant 1 vectorizes across elements (one element per SIMD lane)
+      const int Nkernels = (kernelName == "ellipticPartialAxCoeffHex3D") ? 2 : 1;
       for (int knl = 0; knl < Nkernels; ++knl)
         kernelVariants.push_back(knl);
+
+      // variant 2 reads the interleaved geometric factors (p_aosoaBytes), they are only
+      // created if it wins
+      if (kernelName == "ellipticPartialAxCoeffHex3D" &&
+          platform->options.compareArgs("INTERLEAVE GEOMETRIC FACTORS", "TRUE"))
+        kernelVariants.push_back(2);
     }
     else {
       if (kernelName == "ellipticPartialAxCoeffHex3D") {
@@ -144,6 +267,9 @@ occa::kernel benchmarkAx(int Nelements,
 
         kernelVariants.erase(kernelVariants.begin() + 3); // correctness check is off
       }
+      if (kernelName == "ellipticPartialAxTrilinearHex3D" || kernelName == "ellipticPartialAxNgeomHex3D") {
+        kernelVariants.push_back(0);
+      }
       if (kernelName == "ellipticStressPartialAxCoeffHex3D") {
         const int Nkernels = 2;
         for (int knl = 0; knl < Nkernels; ++knl)
@@ -201,7 +327,8 @@ occa::kernel benchmarkAx(int Nelements,
     const std::string oklpath(getenv("NEKRS_KERNEL_DIR"));
 
     // only a single choice, no need to run benchmark
-    if (kernelVariants.size() == 1 || !requiresBenchmark) {
+    // (on-the-fly geometry is still timed, its throughput is what a lower geometry order buys)
+    if ((kernelVariants.size() == 1 && !computeGeom) || !requiresBenchmark) {
 
       auto newProps = props;
       newProps["defines/p_knl"] = kernelVariants.front();
@@ -217,8 +344,11 @@ occa::kernel benchmarkAx(int Nelements,
     auto vgeo = randomVector<FPType>(Np * Nelements * p_Nvgeo);
     auto q = randomVector<FPType>((Ndim * Np) * Nelements);
     auto Aq = randomVector<FPType>((Ndim * Np) * Nelements);
-    auto exyz = randomVector<FPType>((3 * Np_g) * Nelements);
-    auto gllwz = randomVector<FPType>(2 * Nq_g);
+    // the geometry is recomputed from nodes of a valid curved mesh
+    const auto xyzGeom = curvedElementNodes(Ng, Nelements);
+    const auto basis = geomBasis(N, Ng);
+    std::vector<FPType> exyz(xyzGeom.begin(), xyzGeom.end());
+    std::vector<FPType> gllwz(basis.begin(), basis.end());
     auto lambda0 = randomVector<FPType>(Np * Nelements);
     auto lambda1 = randomVector<FPType>(Np * Nelements);
 
@@ -230,11 +360,24 @@ occa::kernel benchmarkAx(int Nelements,
     auto o_D = platform->device.malloc(Nq * Nq * wordSize, DrV.data());
     auto o_S = o_D;
     auto o_ggeo = platform->device.malloc(Np_g * Nelements * p_Nggeo * wordSize, ggeo.data());
+
+    occa::memory o_ggeoAoSoA;
+    if (std::find(kernelVariants.begin(), kernelVariants.end(), 2) != kernelVariants.end()) {
+      const int Nlanes = mesh_t::aosoaBytes / wordSize;
+      const dlong Ngroups = (Nelements + Nlanes - 1) / Nlanes;
+      std::vector<FPType> ggeoAoSoA(Ngroups * Nlanes * p_Nggeo * Np_g, 0);
+      for (dlong e = 0; e < Nelements; e++) {
+        for (int n = 0; n < p_Nggeo * Np_g; n++) {
+          ggeoAoSoA[((e / Nlanes) * p_Nggeo * Np_g + n) * Nlanes + e % Nlanes] = ggeo[e * p_Nggeo * Np_g + n];
+        }
+      }
+      o_ggeoAoSoA = platform->device.malloc(ggeoAoSoA.size() * wordSize, ggeoAoSoA.data());
+    }
     auto o_vgeo = platform->device.malloc(Np * Nelements * p_Nvgeo * wordSize, vgeo.data());    
     auto o_q = platform->device.malloc((Ndim * Np) * Nelements * wordSize, q.data());
     auto o_Aq = platform->device.malloc((Ndim * Np) * Nelements * wordSize, Aq.data());
     auto o_exyz = platform->device.malloc((3 * Np_g) * Nelements * wordSize, exyz.data());
-    auto o_gllwz = platform->device.malloc(2 * Nq_g * wordSize, gllwz.data());
+    auto o_gllwz = platform->device.malloc(gllwz.size() * wordSize, gllwz.data());
 
     auto o_lambda0 = platform->device.malloc(Np * Nelements * wordSize, lambda0.data());
     auto o_lambda1 = platform->device.malloc(Np * Nelements * wordSize, lambda1.data());
@@ -258,7 +401,8 @@ occa::kernel benchmarkAx(int Nelements,
       }
       else {
         if (!stressForm) {
-          kernel(Nelements, offset, loffset, o_elementList, o_ggeo, o_D, o_S, o_lambda0, o_lambda1, o_q, o_Aq);
+          auto &o_G = kernel.properties().has("defines/p_aosoaBytes") ? o_ggeoAoSoA : o_ggeo;
+          kernel(Nelements, offset, loffset, o_elementList, o_G, o_D, o_S, o_lambda0, o_lambda1, o_q, o_Aq);
         } else {
           kernel(Nelements, offset, loffset, o_elementList, o_vgeo, o_D, o_S, o_lambda0, o_lambda1, o_q, o_Aq);
         }
@@ -268,6 +412,8 @@ occa::kernel benchmarkAx(int Nelements,
     auto axKernelBuilder = [&](int kernelVariant) {
       auto newProps = props;
       newProps["defines/p_knl"] = kernelVariant;
+      if (kernelVariant == 2)
+        newProps["defines/p_aosoaBytes"] = mesh_t::aosoaBytes;
 
       const std::string ext = platform->serial ? ".c" : ".okl";
       const std::string fileName = oklpath + "/elliptic/" + kernelName + ext;
@@ -312,9 +458,12 @@ occa::kernel benchmarkAx(int Nelements,
       const dfloat GDOFPerSecond = (Nelements * Ndim * (N * N * N) / elapsed) / 1.e9;
 
       size_t bytesMoved = Ndim * 2 * Np * wordSize; // x, Ax
-      bytesMoved += 6 * Np_g * wordSize;            // geo
+      if (computeGeom)
+        bytesMoved += 3 * Np_g * wordSize; // element nodes
+      else
+        bytesMoved += 6 * Np_g * wordSize; // geo
 
-      if(!poisson || stressForm)
+      if((!poisson || stressForm) && !computeGeom)
         bytesMoved += 1 * Np * wordSize; // Jw
 
       if (!constCoeff) {
@@ -392,6 +541,47 @@ occa::kernel benchmarkAx(int Nelements,
       }
     }
 
+    // accuracy of the recomputed low-order geometry against the stored factors of the order N geometry
+    if (computeGeom && Ng != N && verbosity > 1 && kernelAndTime.first.isInitialized() &&
+        platform->options.compareArgs("BUILD ONLY", "FALSE")) {
+      auto isoKernelProps = isoProps;
+      isoKernelProps["defines/p_knl"] = 0;
+      const std::string ext = platform->serial ? ".c" : ".okl";
+      auto isoKernel = platform->device.buildKernel(oklpath + "/elliptic/ellipticPartialAxCoeffHex3D" + ext,
+                                                    isoKernelProps,
+                                                    suffix,
+                                                    true);
+
+      const auto ggeoN = curvedGeometricFactors(N, Nelements);
+      const std::vector<FPType> ggeoIso(ggeoN.begin(), ggeoN.end());
+      auto o_ggeoIso = platform->device.malloc(ggeoIso.size() * wordSize, ggeoIso.data());
+
+      const int loffset = 0;
+      const int offset = Nelements * Np;
+      std::vector<FPType> refResults(Np * Nelements);
+      std::vector<FPType> results(Np * Nelements);
+      isoKernel(Nelements, offset, loffset, o_elementList, o_ggeoIso, o_D, o_S, o_lambda0, o_lambda1, o_q, o_Aq);
+      o_Aq.copyTo(refResults.data(), refResults.size() * sizeof(FPType));
+      kernelRunner(kernelAndTime.first);
+      o_Aq.copyTo(results.data(), results.size() * sizeof(FPType));
+
+      double errMax = 0.0, refMax = 0.0;
+      for (int i = 0; i < refResults.size(); ++i) {
+        errMax = std::max(errMax, (double) std::abs(refResults[i] - results[i]));
+        refMax = std::max(refMax, (double) std::abs(refResults[i]));
+      }
+      MPI_Allreduce(MPI_IN_PLACE, &errMax, 1, MPI_DOUBLE, MPI_MAX, platform->comm.mpiComm);
+      MPI_Allreduce(MPI_IN_PLACE, &refMax, 1, MPI_DOUBLE, MPI_MAX, platform->comm.mpiComm);
+
+      if (platform->comm.mpiRank == 0) {
+        std::cout << "Ax: N=" << N << " Ng=" << Ng
+                  << " max relative deviation from the order N geometry on a curved mesh=" << errMax / refMax
+                  << "\n";
+      }
+
+      free(o_ggeoIso);
+    }
+
     free(o_D);
     free(o_S);
     free(o_ggeo);
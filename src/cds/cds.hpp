@@ -11,6 +11,7 @@
 #include "elliptic.h"
 #include "neknek.hpp"
 #include "cvode.hpp"
+#include "lagHistory.hpp"
 
 struct cds_t
 {
@@ -24,6 +25,10 @@ struct cds_t
   dlong fieldOffsetSum;
   mesh_t* meshV;
   elliptic_t* solver[NSCALAR_MAX];
+
+  // range of each scalar in the mask ids of its (possibly shared) solver
+  dlong maskIdsStart[NSCALAR_MAX];
+  dlong Nmasked[NSCALAR_MAX];
   neknek_t* neknek;
   cvode_t* cvode;
 
@@ -104,6 +109,7 @@ struct cds_t
 
   occa::memory o_U;
   occa::memory o_S, o_Se;
+  lagHistory_t SHistory, FSHistory;
 
   occa::memory o_coeffEXT, o_coeffBDF;
 
@@ -127,4 +133,8 @@ struct cds_t
 
 occa::memory cdsSolve(int i, cds_t* cds, dfloat time, int stage);
 
+// scalars solved together by pcg+multiRHS
+int cdsMultiRhsGroupLeader(int is);
+int cdsMultiRhsGroupSize(int is);
+
 #endif
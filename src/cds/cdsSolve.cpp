@@ -2,6 +2,45 @@
 #include "nrs.hpp"
 #include "linAlg.hpp"
 
+namespace {
+
+// max number of fields of a block solver
+constexpr int maxMultiRhsGroupSize = 3;
+
+bool multiRhs(int is)
+{
+  return platform->options.compareArgs("SCALAR" + scalarDigitStr(is) + " SOLVER", "MULTIRHS");
+}
+
+} // namespace
+
+int cdsMultiRhsGroupLeader(int is)
+{
+  if (!multiRhs(is))
+    return is;
+
+  int first = is;
+  while (first > 0 && multiRhs(first - 1))
+    first--;
+
+  return first + ((is - first) / maxMultiRhsGroupSize) * maxMultiRhsGroupSize;
+}
+
+int cdsMultiRhsGroupSize(int is)
+{
+  const int leader = cdsMultiRhsGroupLeader(is);
+  if (!multiRhs(leader))
+    return 1;
+
+  int Nscalar = 0;
+  platform->options.getArgs("NUMBER OF SCALARS", Nscalar);
+
+  int n = 1;
+  while (n < maxMultiRhsGroupSize && leader + n < Nscalar && multiRhs(leader + n))
+    n++;
+  return n;
+}
+
 occa::memory cdsSolve(const int is, cds_t* cds, dfloat time, int stage)
 {
   std::string sid = scalarDigitStr(is);
@@ -12,40 +51,43 @@ occa::memory cdsSolve(const int is, cds_t* cds, dfloat time, int stage)
     mesh = cds->meshV;
   }
 
-  platform->o_mempool.slice1.copyFrom(cds->o_BF, cds->fieldOffset[is] * sizeof(dfloat), 0,  
-                                      cds->fieldOffsetScan[is] * sizeof(dfloat));
-
-  cds->neumannBCKernel(mesh->Nelements,
-                       1,
-                       mesh->o_sgeo,
-                       mesh->o_vmapM,
-                       mesh->o_EToB,
-                       is,
-                       time,
-                       cds->fieldOffset[is],
-                       cds->EToBOffset,
-                       mesh->o_x,
-                       mesh->o_y,
-                       mesh->o_z,
-                       cds->o_Ue,
-                       cds->o_S,
-                       cds->o_EToB,
-                       cds->o_diff,
-                       cds->o_rho,
-                       *(cds->o_usrwrk),
-                       cds->o_BF);
+  // a multiRHS group is solved at once by the solver of its leader (is)
+  const int Nfields = cds->solver[is]->Nfields;
+
+  for (int fld = 0; fld < Nfields; fld++) {
+    cds->neumannBCKernel(mesh->Nelements,
+                         1,
+                         mesh->o_sgeo,
+                         mesh->o_vmapM,
+                         mesh->o_EToB,
+                         is + fld,
+                         time,
+                         cds->fieldOffset[is + fld],
+                         cds->EToBOffset,
+                         mesh->o_x,
+                         mesh->o_y,
+                         mesh->o_z,
+                         cds->o_Ue,
+                         cds->o_S,
+                         cds->o_EToB,
+                         cds->o_diff,
+                         cds->o_rho,
+                         *(cds->o_usrwrk),
+                         cds->o_BF);
+  }
 
   platform->timer.toc("scalar rhs");
 
+  // fields of a group are contiguous in o_S, o_Se and o_BF
   const occa::memory &o_S0 =
       (platform->options.compareArgs("SCALAR" + sid + " INITIAL GUESS", "EXTRAPOLATION") && stage == 1)
-          ? cds->o_Se.slice(cds->fieldOffsetScan[is] * sizeof(dfloat), cds->fieldOffset[is] * sizeof(dfloat))
-          : cds->o_S.slice(cds->fieldOffsetScan[is] * sizeof(dfloat), cds->fieldOffset[is] * sizeof(dfloat));
-  platform->o_mempool.slice0.copyFrom(o_S0, mesh->Nlocal * sizeof(dfloat));
-  auto o_BF_i = cds->o_BF.slice(cds->fieldOffsetScan[is] * sizeof(dfloat), cds->fieldOffset[is] * sizeof(dfloat));
-  ellipticSolve(cds->solver[is], o_BF_i, platform->o_mempool.slice0);
+          ? cds->o_Se.slice(cds->fieldOffsetScan[is] * sizeof(dfloat), Nfields * cds->fieldOffset[is] * sizeof(dfloat))
+          : cds->o_S.slice(cds->fieldOffsetScan[is] * sizeof(dfloat), Nfields * cds->fieldOffset[is] * sizeof(dfloat));
+  // the solution is handed back in the caller's scope
+  auto o_Snew = platform->memoryArena.allocate<dfloat>("S", Nfields * cds->fieldOffset[is]);
+  o_Snew.copyFrom(o_S0, Nfields * cds->fieldOffset[is] * sizeof(dfloat));
+  auto o_BF_i = cds->o_BF.slice(cds->fieldOffsetScan[is] * sizeof(dfloat), Nfields * cds->fieldOffset[is] * sizeof(dfloat));
+  ellipticSolve(cds->solver[is], o_BF_i, o_Snew);
 
-  return platform->o_mempool.slice0;
+  return o_Snew;
 }
-
-
@@ -35,21 +35,26 @@ scalarSubCycleMovingMesh(cds_t *cds, int nEXT, dfloat time, int is, occa::memory
 
   linAlg_t *linAlg = platform->linAlg;
 
-  occa::memory &o_r1 = platform->o_mempool.slice2;
-  occa::memory &o_r2 = platform->o_mempool.slice3;
-  occa::memory &o_r3 = platform->o_mempool.slice4;
-  occa::memory &o_r4 = platform->o_mempool.slice5;
+  const auto N = cds->fieldOffset[is];
 
-  occa::memory &o_p0 = platform->o_mempool.slice0;
-  occa::memory &o_u1 = platform->o_mempool.slice6;
+  // the subcycled field is handed back in the caller's scope
+  occa::memory o_p0 = platform->memoryArena.allocate<dfloat>("subcycled S", N);
 
-  occa::memory &o_LMMe = platform->o_mempool.slice1;
+  auto scope = platform->memoryArena.scope("subCycling");
+  occa::memory o_r1 = scope.allocate<dfloat>("r1", N);
+  occa::memory o_r2 = scope.allocate<dfloat>("r2", N);
+  occa::memory o_r3 = scope.allocate<dfloat>("r3", N);
+  occa::memory o_r4 = scope.allocate<dfloat>("r4", N);
+
+  occa::memory o_u1 = scope.allocate<dfloat>("u1", N);
+
+  occa::memory o_LMMe = scope.allocate<dfloat>("LMMe", N);
 
   // Solve for Each SubProblem
   for (int torder = (nEXT - 1); torder >= 0; torder--) {
     // Initialize SubProblem Velocity i.e. Ud = U^(t-torder*dt)
     const dlong toffset =
-        cds->fieldOffsetScan[is] + torder * cds->fieldOffsetSum;
+        cds->fieldOffsetScan[is] + cds->SHistory.slot(torder) * cds->fieldOffsetSum;
     const dlong offset = torder * cds->fieldOffset[is];
     cds->subCycleInitU0Kernel(cds->mesh[0]->Nlocal,
         1,
@@ -219,11 +224,21 @@ occa::memory scalarSubCycle(cds_t *cds, int nEXT, dfloat time, int is, occa::mem
 
   linAlg_t *linAlg = platform->linAlg;
 
+  const auto N = cds->fieldOffset[is];
+
+  // the subcycled field is handed back in the caller's scope
+  occa::memory o_p0 = platform->memoryArena.allocate<dfloat>("subcycled S", N);
+
+  // field at the beginning of a substep and the right-hand sides of all RK stages
+  auto scope = platform->memoryArena.scope("subCycling");
+  occa::memory o_u1 = scope.allocate<dfloat>("u1", N);
+  occa::memory o_rhsRK = scope.allocate<dfloat>("rhsRK", cds->nRK * N);
+
   // Solve for Each SubProblem
   for (int torder = (nEXT - 1); torder >= 0; torder--) {
     // Initialize SubProblem Velocity i.e. Ud = U^(t-torder*dt)
     const dlong toffset =
-        cds->fieldOffsetScan[is] + torder * cds->fieldOffsetSum;
+        cds->fieldOffsetScan[is] + cds->SHistory.slot(torder) * cds->fieldOffsetSum;
     cds->subCycleInitU0Kernel(cds->mesh[0]->Nlocal,
         1,
         cds->fieldOffset[is],
@@ -234,7 +249,7 @@ occa::memory scalarSubCycle(cds_t *cds, int nEXT, dfloat time, int is, occa::mem
         cds->coeffBDF[torder],
         cds->mesh[0]->o_LMM,
         o_S,
-        platform->o_mempool.slice0);
+        o_p0);
 
     // Advance SubProblem to t^(n-torder+1)
     dfloat tsub = time;
@@ -245,10 +260,7 @@ occa::memory scalarSubCycle(cds_t *cds, int nEXT, dfloat time, int is, occa::mem
     for (int ststep = 0; ststep < cds->Nsubsteps; ++ststep) {
       const dfloat tstage = tsub + ststep * sdt;
 
-      platform->o_mempool.slice0.copyFrom(platform->o_mempool.slice0,
-          cds->fieldOffset[is] * sizeof(dfloat),
-          cds->fieldOffset[is] * sizeof(dfloat),
-          0);
+      o_u1.copyFrom(o_p0, N * sizeof(dfloat));
 
       for (int rk = 0; rk < cds->nRK; ++rk) {
         // Extrapolate velocity to subProblem stage time
@@ -291,8 +303,8 @@ occa::memory scalarSubCycle(cds_t *cds, int nEXT, dfloat time, int is, occa::mem
                 extC[1],
                 extC[2],
                 cds->o_Urst,
-                platform->o_mempool.slice0,
-                platform->o_mempool.slice2);
+                o_p0,
+                o_rhsRK);
           else
             cds->subCycleStrongVolumeKernel(cds->meshV->NglobalGatherElements,
                 cds->meshV->o_globalGatherElementList,
@@ -305,19 +317,11 @@ occa::memory scalarSubCycle(cds_t *cds, int nEXT, dfloat time, int is, occa::mem
                 extC[1],
                 extC[2],
                 cds->o_Urst,
-                platform->o_mempool.slice0,
-                platform->o_mempool.slice2);
+                o_p0,
+                o_rhsRK);
         }
 
-        occa::memory o_rhs;
-        if (rk == 0)
-          o_rhs = platform->o_mempool.slice2;
-        if (rk == 1)
-          o_rhs = platform->o_mempool.slice3;
-        if (rk == 2)
-          o_rhs = platform->o_mempool.slice4;
-        if (rk == 3)
-          o_rhs = platform->o_mempool.slice5;
+        occa::memory o_rhs = o_rhsRK + (rk * sizeof(dfloat)) * N;
 
         oogs::start(
             o_rhs, 1, cds->fieldOffset[is], ogsDfloat, ogsAdd, cds->gsh);
@@ -338,8 +342,8 @@ occa::memory scalarSubCycle(cds_t *cds, int nEXT, dfloat time, int is, occa::mem
                 extC[1],
                 extC[2],
                 cds->o_Urst,
-                platform->o_mempool.slice0,
-                platform->o_mempool.slice2);
+                o_p0,
+                o_rhsRK);
           else
             cds->subCycleStrongVolumeKernel(cds->meshV->NlocalGatherElements,
                 cds->meshV->o_localGatherElementList,
@@ -352,8 +356,8 @@ occa::memory scalarSubCycle(cds_t *cds, int nEXT, dfloat time, int is, occa::mem
                 extC[1],
                 extC[2],
                 cds->o_Urst,
-                platform->o_mempool.slice0,
-                platform->o_mempool.slice2);
+                o_p0,
+                o_rhsRK);
         }
 
         oogs::finish(
@@ -367,15 +371,15 @@ occa::memory scalarSubCycle(cds_t *cds, int nEXT, dfloat time, int is, occa::mem
             cds->fieldOffset[is],
             cds->o_coeffsfRK,
             cds->o_weightsRK,
-            platform->o_mempool.slice1,
-            platform->o_mempool.slice2,
-            platform->o_mempool.slice0);
+            o_u1,
+            o_rhsRK,
+            o_p0);
       }
     }
   }
   linAlg->axmy(cds->mesh[0]->Nlocal,
       1.0,
       cds->mesh[0]->o_LMM,
-      platform->o_mempool.slice0);
-  return platform->o_mempool.slice0;
+      o_p0);
+  return o_p0;
 }
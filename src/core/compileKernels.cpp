@@ -9,6 +9,7 @@
 #include <vector>
 #include <tuple>
 #include "findpts.hpp"
+#include "cds.hpp"
 #include "fileUtils.hpp"
 
 
@@ -60,6 +61,10 @@ void compileKernels() {
       const std::string section = "scalar" + sid;
       const int poisson = 0;
 
+      // multiRHS group members share the solver of the group leader
+      if (cdsMultiRhsGroupLeader(is) != is)
+        continue;
+
       if(!platform->options.compareArgs("SCALAR" + sid + " SOLVER", "NONE")){
         registerEllipticKernels(section, poisson);
         registerEllipticPreconditionerKernels(section, poisson);
@@ -1,5 +1,6 @@
 #include <unistd.h>
 #include <regex>
+#include <algorithm>
 #include "nrssys.hpp"
 #include "device.hpp"
 #include "platform.hpp"
@@ -275,6 +276,88 @@ device_t::buildKernel(const std::string &fullPath, const occa::properties &props
   return this->buildKernel(fullPath, props, noSuffix, buildRank0);
 }
 
+device_t::memoryOwner_t::~memoryOwner_t() { device.closeMemoryOwner(); }
+
+device_t::memoryOwner_t device_t::memoryOwner(const std::string &name)
+{
+  ownerFrames.push_back({name, static_cast<long long>(_device.memoryAllocated()), 0});
+  return memoryOwner_t(*this);
+}
+
+void device_t::closeMemoryOwner()
+{
+  const auto frame = ownerFrames.back();
+  ownerFrames.pop_back();
+
+  const auto bytes = static_cast<long long>(_device.memoryAllocated()) - frame.bytesAtOpen;
+  ownerStats[frame.name].bytes += bytes - frame.nestedBytes;
+  if (ownerFrames.size())
+    ownerFrames.back().nestedBytes += bytes;
+}
+
+void device_t::countAllocation()
+{
+  const std::string owner = ownerFrames.size() ? ownerFrames.back().name : "other";
+  ownerStats[owner].allocations++;
+}
+
+void device_t::printMemoryOwners(MPI_Comm comm) const
+{
+  int rank;
+  MPI_Comm_rank(comm, &rank);
+
+  // whatever is not covered by an owner (including frees of memory owned by someone else)
+  auto stats = ownerStats;
+  long long ownedBytes = 0;
+  for (auto &&entry : stats) {
+    if (entry.first != "other")
+      ownedBytes += entry.second.bytes;
+  }
+  stats["other"].bytes = static_cast<long long>(_device.memoryAllocated()) - ownedBytes;
+
+  std::vector<long long> values;
+  for (auto &&entry : stats) {
+    values.push_back(entry.second.bytes);
+    values.push_back(entry.second.allocations);
+  }
+
+  // owners are expected to match across ranks, otherwise the local breakdown is printed
+  int nEntries[2] = {static_cast<int>(values.size()), -static_cast<int>(values.size())};
+  MPI_Allreduce(MPI_IN_PLACE, nEntries, 2, MPI_INT, MPI_MIN, comm);
+  const bool reduced = (nEntries[0] == -nEntries[1]);
+  if (reduced)
+    MPI_Allreduce(MPI_IN_PLACE, values.data(), values.size(), MPI_LONG_LONG, MPI_MAX, comm);
+
+  if (rank)
+    return;
+
+  struct row_t {
+    std::string name;
+    long long bytes;
+    long long allocations;
+  };
+  std::vector<row_t> rows;
+  long long totalBytes = 0;
+  int i = 0;
+  for (auto &&entry : stats) {
+    rows.push_back({entry.first, values[i], values[i + 1]});
+    totalBytes += std::max(values[i], 0LL);
+    i += 2;
+  }
+  std::sort(rows.begin(), rows.end(), [](const row_t &a, const row_t &b) { return a.bytes > b.bytes; });
+
+  printf("  device by owner%s\n", reduced ? "" : " (rank 0)");
+  for (auto &&row : rows) {
+    if (row.bytes <= 0)
+      continue;
+    printf("    %-28s %9.4f GB %5.1f%% %8lld allocations\n",
+           row.name.c_str(),
+           row.bytes / 1e9,
+           100. * row.bytes / std::max(totalBytes, 1LL),
+           row.allocations);
+  }
+}
+
 occa::memory device_t::mallocHost(size_t Nbytes)
 {
   occa::properties props;
@@ -291,6 +374,7 @@ occa::memory device_t::malloc(size_t Nbytes, const occa::properties &properties)
   void *buffer = std::calloc(Nbytes, 1);
   occa::memory o_returnValue = _device.malloc(Nbytes, buffer, properties);
   std::free(buffer);
+  countAllocation();
   return o_returnValue;
 }
 
@@ -301,11 +385,13 @@ occa::memory device_t::malloc(size_t Nbytes, const void *src, const occa::proper
   const void *init_ptr = (src) ? src : buffer;
   occa::memory o_returnValue = _device.malloc(Nbytes, init_ptr, properties);
   std::free(buffer);
+  countAllocation();
   return o_returnValue;
 }
 
 occa::memory device_t::malloc(size_t Nword, size_t wordSize, occa::memory src)
 {
+  countAllocation();
   return _device.malloc(Nword * wordSize, src);
 }
 
@@ -314,6 +400,7 @@ occa::memory device_t::malloc(size_t Nword, size_t wordSize)
   void *buffer = std::calloc(Nword, wordSize);
   occa::memory o_returnValue = _device.malloc(Nword * wordSize, buffer);
   std::free(buffer);
+  countAllocation();
   return o_returnValue;
 }
 
@@ -355,8 +442,6 @@ device_t::device_t(setupAide &options, comm_t &comm) : _comm(comm)
     sprintf(deviceConfig, "{mode: 'OpenCL', device_id: %d, platform_id: %d}", device_id, plat);
   }
   else if (strcasecmp(requestedOccaMode.c_str(), "OPENMP") == 0) {
-    nrsCheck(true, _comm.mpiComm, EXIT_FAILURE,
-             "%s\n", "OpenMP backend currently not supported!"); 
     sprintf(deviceConfig, "{mode: 'OpenMP'}");
   }
   else if (strcasecmp(requestedOccaMode.c_str(), "CPU") == 0 ||
@@ -383,10 +468,21 @@ device_t::device_t(setupAide &options, comm_t &comm) : _comm(comm)
 
   if (worldRank == 0)
     printf("Initializing device \n");
-  this->_device.setup((std::string)deviceConfig);
-
-  if (worldRank == 0)
-    std::cout << "active occa mode: " << this->mode() << "\n\n";
+  deviceProps = occa::json::parse(deviceConfig);
+  // OCCA's OpenMP mode appends its flag to compiler_flags, which would otherwise
+  // shadow OCCA_CXXFLAGS and build the kernels unoptimized
+  if (strcasecmp(requestedOccaMode.c_str(), "OPENMP") == 0 && getenv("OCCA_CXXFLAGS"))
+    deviceProps["kernel/compiler_flags"] = std::string(getenv("OCCA_CXXFLAGS"));
+  this->_device.setup(deviceProps);
+
+  if (worldRank == 0) {
+    std::cout << "active occa mode: " << this->mode() << "\n";
+#ifdef _OPENMP
+    if (this->mode() == "OpenMP")
+      std::cout << "OpenMP threads per rank: " << omp_get_max_threads() << "\n";
+#endif
+    std::cout << "\n";
+  }
 
   nrsCheck(strcasecmp(requestedOccaMode.c_str(), this->mode().c_str()) != 0, 
            _comm.mpiComm, EXIT_FAILURE,
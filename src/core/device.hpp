@@ -1,6 +1,8 @@
 #ifndef device_hpp_
 #define device_hpp_
 #include <string>
+#include <map>
+#include <vector>
 #include <occa.hpp>
 #include <mpi.h>
 #include "nrssys.hpp"
@@ -10,7 +12,33 @@ class comm_t;
 
 class device_t {
   public:
+    // Device memory allocated while an owner is open is attributed to the
+    // innermost one, e.g.
+    //
+    //   auto memoryOwner = platform->device.memoryOwner("elliptic " + elliptic->name);
+    //
+    // An owner accounts the net amount (allocations minus frees) it leaves
+    // behind, excluding what nested owners account for.
+    class memoryOwner_t {
+    public:
+      ~memoryOwner_t();
+      memoryOwner_t(const memoryOwner_t &) = delete;
+      memoryOwner_t &operator=(const memoryOwner_t &) = delete;
+
+    private:
+      friend class device_t;
+      memoryOwner_t(device_t &_device) : device(_device) {}
+      device_t &device;
+    };
+
     device_t(setupAide& options, comm_t& comm);
+
+    // Not collective, closed in reverse order of opening
+    memoryOwner_t memoryOwner(const std::string &name);
+
+    // Note: must be called collectively
+    void printMemoryOwners(MPI_Comm comm) const;
+
     occa::memory
     malloc(size_t Nbytes, const void *src = nullptr, const occa::properties &properties = occa::properties());
     occa::memory malloc(size_t Nbytes, const occa::properties &properties);
@@ -41,6 +69,22 @@ class device_t {
     bool deviceAtomic;
 
   private:
+    struct ownerFrame_t {
+      std::string name;
+      long long bytesAtOpen;
+      long long nestedBytes;
+    };
+
+    struct ownerStat_t {
+      long long bytes = 0;
+      long long allocations = 0;
+    };
+
+    void countAllocation();
+    void closeMemoryOwner();
+
+    std::vector<ownerFrame_t> ownerFrames;
+    std::map<std::string, ownerStat_t> ownerStats;
 
     // non-collective
     occa::kernel buildKernel(const std::string &fullPath,
@@ -0,0 +1,53 @@
+#include <algorithm>
+#include <vector>
+
+#include "lagHistory.hpp"
+#include "platform.hpp"
+
+lagHistory_t::lagHistory_t(int _nLevels, bool _pinNewest)
+    : nLevels(std::max(_nLevels, 1)), pinNewest(_pinNewest), head(0)
+{
+  // one row per rotation, o_slot() just picks the current one
+  std::vector<int> table;
+  for (head = 0; head < nRotations(); head++) {
+    for (int level = 0; level < nLevels; level++)
+      table.push_back(slot(level));
+  }
+  head = 0;
+
+  o_slotTable = platform->device.malloc(table.size() * sizeof(int), table.data());
+}
+
+int lagHistory_t::nRotations() const
+{
+  if (pinNewest)
+    return std::max(nLevels - 1, 1);
+  return nLevels;
+}
+
+int lagHistory_t::slot(int level) const
+{
+  if (pinNewest) {
+    if (level == 0)
+      return 0;
+    return 1 + (head + level - 1) % nRotations();
+  }
+  return (head + level) % nRotations();
+}
+
+occa::memory lagHistory_t::o_slot() const
+{
+  return o_slotTable + (head * nLevels) * sizeof(int);
+}
+
+void lagHistory_t::rotate()
+{
+  head = (head + nRotations() - 1) % nRotations();
+}
+
+void lagHistory_t::lag(occa::memory &o_buffer, size_t levelBytes)
+{
+  rotate();
+  if (pinNewest && nLevels > 1)
+    o_buffer.copyFrom(o_buffer, levelBytes, slot(1) * levelBytes, 0);
+}
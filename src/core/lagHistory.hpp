@@ -0,0 +1,45 @@
+#if !defined(nekrs_lagHistory_hpp_)
+#define nekrs_lagHistory_hpp_
+#include <occa.hpp>
+
+// Time history of nLevels equally sized blocks stored in one buffer, level 0
+// being the most recent one. Lagging rotates the slots instead of shifting the
+// blocks, kernels reading older levels take the slot table o_slot() and address
+// level s at slot[s] * levelSize, e.g.
+//
+//   nrs->extrapolateKernel(..., nrs->UHistory.o_slot(), nrs->o_U, nrs->o_Ue);
+//
+// With pinNewest level 0 always lives in slot 0 (the buffer is addressed
+// directly as the current state elsewhere) and only the older levels rotate,
+// lagging then copies a single block.
+class lagHistory_t {
+public:
+  lagHistory_t() = default;
+  lagHistory_t(int nLevels, bool pinNewest);
+
+  int size() const { return nLevels; }
+  int slot(int level) const;
+
+  // device table of slot(level) for level = 0, ..., size() - 1
+  occa::memory o_slot() const;
+
+  occa::memory level(const occa::memory &o_buffer, size_t levelBytes, int level) const
+  {
+    return o_buffer + slot(level) * levelBytes;
+  }
+
+  // drops the oldest level and reuses its slot for level 0 (level 1 if pinned)
+  void rotate();
+
+  // rotate and, if pinned, copy level 0 into level 1
+  void lag(occa::memory &o_buffer, size_t levelBytes);
+
+private:
+  int nRotations() const;
+
+  int nLevels = 0;
+  bool pinNewest = false;
+  int head = 0;
+  occa::memory o_slotTable;
+};
+#endif
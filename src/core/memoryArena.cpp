@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+#include "memoryArena.hpp"
+#include "platform.hpp"
+
+namespace {
+
+// allocations start on the same boundary as the ones made by the device
+size_t alignBytes(size_t bytes) { return ((bytes + ALIGN_SIZE - 1) / ALIGN_SIZE) * ALIGN_SIZE; }
+
+} // namespace
+
+memoryArena_t::scope_t::~scope_t() { arena.release(level); }
+
+memoryArena_t::scope_t memoryArena_t::scope(const std::string &subsystem)
+{
+  frames.push_back({subsystem, top, 0, {}});
+  return scope_t(*this, static_cast<int>(frames.size()) - 1);
+}
+
+occa::memory memoryArena_t::allocate(int level, const std::string &name, size_t bytes)
+{
+  nrsCheck(level < 0, MPI_COMM_SELF, EXIT_FAILURE,
+           "memoryArena: allocation of %s outside of any scope!\n", name.c_str());
+  nrsCheck(level != static_cast<int>(frames.size()) - 1, MPI_COMM_SELF, EXIT_FAILURE,
+           "memoryArena: allocation of %s in %s which is not the innermost scope!\n",
+           name.c_str(), frames.at(level).subsystem.c_str());
+
+  auto &frame = frames.back();
+  const auto alignedBytes = alignBytes(std::max(bytes, size_t(1)));
+
+  // the offset keeps advancing past the end of the buffer so the peak tells
+  // how large it has to be
+  occa::memory o_mem;
+  if (top + alignedBytes <= capacity()) {
+    o_mem = o_buffer.slice(top, alignedBytes);
+  } else {
+    if (platform->verbose)
+      std::cout << "memoryArena: " << name << " (" << frame.subsystem << ", " << alignedBytes
+                << " bytes) does not fit, allocating separately\n";
+    o_mem = platform->device.malloc(alignedBytes);
+    frame.spills.push_back(o_mem);
+  }
+
+  top += alignedBytes;
+  frame.bytes += alignedBytes;
+  peakBytes = std::max(peakBytes, top);
+
+  auto &subsystemBytes = liveBytesSubsystem[frame.subsystem];
+  subsystemBytes += alignedBytes;
+  peakBytesSubsystem[frame.subsystem] = std::max(peakBytesSubsystem[frame.subsystem], subsystemBytes);
+
+  return o_mem;
+}
+
+void memoryArena_t::release(int level)
+{
+  nrsCheck(level != static_cast<int>(frames.size()) - 1, MPI_COMM_SELF, EXIT_FAILURE,
+           "memoryArena: scope %s released out of order!\n", frames.at(level).subsystem.c_str());
+
+  auto &frame = frames.back();
+  for (auto &o_mem : frame.spills)
+    o_mem.free();
+  liveBytesSubsystem[frame.subsystem] -= frame.bytes;
+  top = frame.base;
+  frames.pop_back();
+
+  if (frames.empty() && peakBytes > capacity())
+    reserve(peakBytes);
+}
+
+void memoryArena_t::reserve(size_t bytes)
+{
+  nrsCheck(frames.size(), MPI_COMM_SELF, EXIT_FAILURE,
+           "%s\n", "memoryArena: cannot grow while a scope is open!");
+
+  bytes = alignBytes(bytes);
+  if (bytes <= capacity())
+    return;
+
+  if (platform->comm.mpiRank == 0 && platform->verbose)
+    std::cout << "memoryArena: reserving " << bytes << " bytes\n";
+
+  auto memoryOwner = platform->device.memoryOwner("scratch arena");
+  o_buffer.free();
+  o_buffer = platform->device.malloc(bytes);
+
+  platform->o_mempool.bind(o_buffer);
+}
+
+void memoryArena_t::printStat(MPI_Comm comm) const
+{
+  int rank;
+  MPI_Comm_rank(comm, &rank);
+
+  std::vector<unsigned long long> bytes = {capacity(), peakBytes};
+  for (auto &&entry : peakBytesSubsystem)
+    bytes.push_back(entry.second);
+
+  // subsystems are expected to match across ranks, otherwise only the totals are reduced
+  int nEntries[2] = {static_cast<int>(bytes.size()), -static_cast<int>(bytes.size())};
+  MPI_Allreduce(MPI_IN_PLACE, nEntries, 2, MPI_INT, MPI_MIN, comm);
+  const bool reduceSubsystems = (nEntries[0] == -nEntries[1]);
+  MPI_Allreduce(MPI_IN_PLACE,
+                bytes.data(),
+                reduceSubsystems ? bytes.size() : 2,
+                MPI_UNSIGNED_LONG_LONG,
+                MPI_MAX,
+                comm);
+
+  if (rank)
+    return;
+
+  std::cout << "  scratch arena       capacity " << bytes[0] / 1e9 << " GB  peak " << bytes[1] / 1e9 << " GB\n";
+  if (reduceSubsystems) {
+    int i = 2;
+    for (auto &&entry : peakBytesSubsystem) {
+      std::cout << "    " << std::left << std::setw(18) << entry.first << std::right << bytes[i++] / 1e9
+                << " GB\n";
+    }
+  }
+}
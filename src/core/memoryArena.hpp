@@ -0,0 +1,80 @@
+#if !defined(nekrs_memoryArena_hpp_)
+#define nekrs_memoryArena_hpp_
+#include <occa.hpp>
+#include <mpi.h>
+#include <map>
+#include <string>
+#include <vector>
+
+// Scratch device memory handed out by bumping an offset into a single buffer.
+// Allocations are named, belong to the innermost open scope and are released
+// when that scope is destroyed, e.g.
+//
+//   auto scope = platform->memoryArena.scope("tombo");
+//   auto o_rhs = scope.allocate<dfloat>("pressure rhs", nrs->fieldOffset);
+//
+// Requests not fitting into the buffer are served by separate allocations until
+// the outermost scope closes, the buffer is then grown to the observed peak.
+class memoryArena_t {
+public:
+  class scope_t {
+  public:
+    ~scope_t();
+    scope_t(const scope_t &) = delete;
+    scope_t &operator=(const scope_t &) = delete;
+
+    // Not collective, scope has to be the innermost one
+    template <typename T> occa::memory allocate(const std::string &name, size_t N)
+    {
+      return arena.allocate(level, name, N * sizeof(T));
+    }
+
+  private:
+    friend class memoryArena_t;
+    scope_t(memoryArena_t &_arena, int _level) : arena(_arena), level(_level) {}
+    memoryArena_t &arena;
+    const int level;
+  };
+
+  // Not collective, subsystem is used to attribute the high-water mark
+  scope_t scope(const std::string &subsystem);
+
+  // Not collective, allocates in the innermost open scope, e.g. for results
+  // handed back to the caller of a function opening its own scope
+  template <typename T> occa::memory allocate(const std::string &name, size_t N)
+  {
+    return allocate(static_cast<int>(frames.size()) - 1, name, N * sizeof(T));
+  }
+
+  // Not collective, grows the buffer (no scope may be open)
+  void reserve(size_t bytes);
+
+  size_t capacity() const { return o_buffer.isInitialized() ? o_buffer.size() : 0; }
+  size_t peak() const { return peakBytes; }
+
+  // the whole buffer, only meant for the deprecated platform->o_mempool views
+  const occa::memory &buffer() const { return o_buffer; }
+
+  // Note: must be called collectively
+  void printStat(MPI_Comm comm) const;
+
+private:
+  struct frame_t {
+    std::string subsystem;
+    size_t base;
+    size_t bytes;
+    std::vector<occa::memory> spills;
+  };
+
+  occa::memory allocate(int level, const std::string &name, size_t bytes);
+  void release(int level);
+
+  occa::memory o_buffer;
+  size_t top = 0;
+  size_t liveBytes = 0;
+  size_t peakBytes = 0;
+  std::vector<frame_t> frames;
+  std::map<std::string, size_t> liveBytesSubsystem;
+  std::map<std::string, size_t> peakBytesSubsystem;
+};
+#endif
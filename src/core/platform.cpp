@@ -1,5 +1,6 @@
 #include <cstdlib>
 #include <strings.h>
+#include <sys/resource.h>
 
 #include "nrs.hpp"
 #include "platform.hpp"
@@ -198,45 +199,56 @@ platform_t::platform_t(setupAide &_options, MPI_Comm _commg, MPI_Comm _comm)
   this->kernels.add(kernelName, fileName, this->kernelInfo);
 }
 
-void deviceMemPool_t::allocate(const dlong offset, const dlong fields)
+void deviceMemPool_t::bind(const occa::memory &o_buffer)
 {
-  bytesAllocated = (fields * sizeof(dfloat)) * offset;
-
-  if (platform->comm.mpiRank == 0 && platform->verbose)
-    printf("deviceMemPool_t::allocate %ld bytes\n", bytesAllocated);
-
-  o_ptr.free();
-  o_ptr = platform->device.malloc(bytesAllocated);
-  if (fields > 0)
-    slice0 = o_ptr.slice((0 * sizeof(dfloat)) * offset);
-  if (fields > 1)
-    slice1 = o_ptr.slice((1 * sizeof(dfloat)) * offset);
-  if (fields > 2)
-    slice2 = o_ptr.slice((2 * sizeof(dfloat)) * offset);
-  if (fields > 3)
-    slice3 = o_ptr.slice((3 * sizeof(dfloat)) * offset);
-  if (fields > 4)
-    slice4 = o_ptr.slice((4 * sizeof(dfloat)) * offset);
-  if (fields > 5)
-    slice5 = o_ptr.slice((5 * sizeof(dfloat)) * offset);
-  if (fields > 6)
-    slice6 = o_ptr.slice((6 * sizeof(dfloat)) * offset);
-  if (fields > 7)
-    slice7 = o_ptr.slice((7 * sizeof(dfloat)) * offset);
-  if (fields > 9)
-    slice9 = o_ptr.slice((9 * sizeof(dfloat)) * offset);
-  if (fields > 12)
-    slice12 = o_ptr.slice((12 * sizeof(dfloat)) * offset);
-  if (fields > 15)
-    slice15 = o_ptr.slice((15 * sizeof(dfloat)) * offset);
-  if (fields > 18)
-    slice18 = o_ptr.slice((18 * sizeof(dfloat)) * offset);
-  if (fields > 19)
-    slice19 = o_ptr.slice((19 * sizeof(dfloat)) * offset);
+  if (offset <= 0)
+    return;
+
+  o_ptr = o_buffer;
+  bytesAllocated = o_buffer.size();
+
+  const size_t fields = bytesAllocated / (offset * sizeof(dfloat));
+  auto slice = [&](size_t field) {
+    return (fields > field) ? o_ptr.slice((field * sizeof(dfloat)) * offset) : occa::memory();
+  };
+  slice0 = slice(0);
+  slice1 = slice(1);
+  slice2 = slice(2);
+  slice3 = slice(3);
+  slice4 = slice(4);
+  slice5 = slice(5);
+  slice6 = slice(6);
+  slice7 = slice(7);
+  slice9 = slice(9);
+  slice12 = slice(12);
+  slice15 = slice(15);
+  slice18 = slice(18);
+  slice19 = slice(19);
 }
 
 void platform_t::create_mempool(const dlong offset, const dlong fields)
 {
-  if (platform->o_mempool.o_ptr.size() < ((fields * sizeof(dfloat)) * offset))
-    o_mempool.allocate(offset, fields);
+  o_mempool.offset = offset;
+  memoryArena.reserve((fields * sizeof(dfloat)) * offset);
+  o_mempool.bind(memoryArena.buffer());
+}
+
+void platform_t::printMemoryUsage()
+{
+  // the host high-water mark is reported in kilobytes
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+
+  unsigned long long bytes[3] = {device.occaDevice().memoryAllocated(),
+                                 device.occaDevice().maxMemoryAllocated(),
+                                 static_cast<unsigned long long>(usage.ru_maxrss) * 1024};
+  MPI_Allreduce(MPI_IN_PLACE, bytes, 3, MPI_UNSIGNED_LONG_LONG, MPI_MAX, comm.mpiComm);
+
+  if (comm.mpiRank == 0) {
+    std::cout << "memory usage (max over ranks):\n";
+    std::cout << "  device              " << bytes[0] / 1e9 << " GB  peak " << bytes[1] / 1e9 << " GB\n";
+    std::cout << "  host                peak " << bytes[2] / 1e9 << " GB\n";
+  }
+  device.printMemoryOwners(comm.mpiComm);
+  memoryArena.printStat(comm.mpiComm);
 }
@@ -9,6 +9,7 @@
 #include "inipp.hpp"
 #include "device.hpp"
 #include "kernelRequestManager.hpp"
+#include "memoryArena.hpp"
 #include <set>
 #include <map>
 #include <vector>
@@ -34,28 +35,32 @@ private:
   const std::string vectorName;
 };
 
+// Deprecated, will be removed in the next release. Views of fieldOffset words
+// into the scratch arena buffer for user code written against the old mempool,
+// e.g. platform->o_mempool.slice0. They alias all arena allocations and are
+// only valid as scratch within a single udf call, use memoryArena.scope() instead.
 struct deviceMemPool_t{
-  void allocate(const dlong offset, const dlong fields);
+  void bind(const occa::memory &o_buffer);
   occa::memory slice0;
-  occa::memory slice1; 
-  occa::memory slice2; 
-  occa::memory slice3; 
-  occa::memory slice4; 
-  occa::memory slice5; 
-  occa::memory slice6; 
+  occa::memory slice1;
+  occa::memory slice2;
+  occa::memory slice3;
+  occa::memory slice4;
+  occa::memory slice5;
+  occa::memory slice6;
   occa::memory slice7;
   occa::memory slice9;
-  occa::memory slice12; 
-  occa::memory slice15; 
-  occa::memory slice18; 
+  occa::memory slice12;
+  occa::memory slice15;
+  occa::memory slice18;
   occa::memory slice19;
   occa::memory o_ptr;
-  size_t bytesAllocated;
+  size_t bytesAllocated = 0;
+  dlong offset = 0;
 };
 
 struct platform_t{
 public:
-  void create_mempool(const dlong offset, const dlong fields);
   platform_t(setupAide& _options, MPI_Comm _commg, MPI_Comm _comm);
 
   static platform_t* getInstance(setupAide& _options, MPI_Comm _commg, MPI_Comm _comm){
@@ -76,7 +81,8 @@ public:
   device_t device;
   occa::properties kernelInfo;
   timer::timer_t timer;
-  deviceMemPool_t o_mempool;
+  memoryArena_t memoryArena;
+  deviceMemPool_t o_mempool; // deprecated
   kernelRequestManager_t kernels;
   inipp::Ini *par;
   bool serial;
@@ -88,6 +94,12 @@ public:
   bool cacheLocal;
   bool cacheBcast; 
 
+  // deprecated, use memoryArena.reserve() instead
+  void create_mempool(const dlong offset, const dlong fields);
+
+  // Note: must be called collectively
+  void printMemoryUsage();
+
   occa::kernel copyDfloatToPfloatKernel;
   occa::kernel copyPfloatToDfloatKernel;
 };
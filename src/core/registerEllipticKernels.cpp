@@ -1,6 +1,8 @@
 #include <compileKernels.hpp>
 #include "re2Reader.hpp"
 #include "benchmarkAx.hpp"
+#include "cds.hpp"
+#include "ellipticFusedOps.hpp"
 
 namespace {
 
@@ -59,7 +61,14 @@ void registerEllipticKernels(std::string section, int poissonEquation)
     return false;
   }();
 
-  const int Nfields = (blockSolver) ? 3 : 1;
+  // consecutive scalars using multiRHS are solved by one solver instance
+  const int Nfields = [&]() {
+    if (blockSolver)
+      return 3;
+    if (section.find("scalar") == 0)
+      return cdsMultiRhsGroupSize(std::stoi(section.substr(std::string("scalar").size())));
+    return 1;
+  }();
 
   const bool stressForm = [&section]() {
     if (section == "velocity" && platform->options.compareArgs("VELOCITY STRESSFORMULATION", "TRUE"))
@@ -116,9 +125,6 @@ void registerEllipticKernels(std::string section, int poissonEquation)
   kernelInfo["defines/p_Nfields"] = Nfields;
 
   occa::properties dfloatKernelInfo = kernelInfo;
-  occa::properties floatKernelInfo = kernelInfo;
-  floatKernelInfo["defines/pfloat"] = pfloatString;
-  floatKernelInfo["defines/dfloat"] = pfloatString;
 
   const std::string suffix = "Hex3D";
 
@@ -149,12 +155,14 @@ void registerEllipticKernels(std::string section, int poissonEquation)
     platform->options.setArgs(optionsPrefix + "ELLIPTIC PRECO COEFF FIELD", "TRUE");
   }
 
+  const bool mixedPrecision = platform->options.compareArgs(optionsPrefix + "SOLVER", "MIXEDPRECISION");
+
   for (auto &&coeffField : {true, false}) {
     if (platform->options.compareArgs(optionsPrefix + "ELLIPTIC COEFF FIELD", "TRUE") != coeffField)
       continue;
 
     std::string kernelNamePrefix = "elliptic";
-    if (blockSolver)
+    if (Nfields > 1)
       kernelNamePrefix += (stressForm) ? "Stress" : "Block";
 
     kernelName = "Ax";
@@ -163,16 +171,35 @@ void registerEllipticKernels(std::string section, int poissonEquation)
       kernelName += "Trilinear";
     kernelName += suffix;
 
+    if (Nfields > 1 && Nfields != 3 && !stressForm) {
+      occa::properties props = AxKernelInfo;
+      props["defines/p_lambda"] = (coeffField) ? 1 : 0;
+      const std::string _kernelName = "ellipticMultiRhsPartial" + kernelName;
+      fileName = oklpath + _kernelName + fileNameExtension;
+      platform->kernels.add(sectionIdentifier + _kernelName, fileName, props);
+      if (mixedPrecision) {
+        props["defines/dfloat"] = pfloatString;
+        platform->kernels.add(sectionIdentifier + _kernelName + "Pfloat", fileName, props);
+      }
+      continue;
+    }
+
     const std::string _kernelName = kernelNamePrefix + "Partial" + kernelName;
     const std::string prefix = (poissonEquation) ? "poisson-" : "";
     fileName = oklpath + _kernelName + fileNameExtension;
 
+    // the scalar operator can recompute its geometric factors from a lower order geometry
+    const bool subparametric = Nfields == 1 && platform->options.compareArgs("ELEMENT MAP", "SUBPARAMETRIC");
+    int Ng = N;
+    if (subparametric)
+      platform->options.getArgs("GEOMETRIC ORDER", Ng);
+
     auto axKernel = benchmarkAx(NelemBenchmark,
                                 N + 1,
-                                N,
+                                Ng,
                                 !coeffField,
                                 poissonEquation,
-                                false,
+                                subparametric,
                                 sizeof(dfloat),
                                 Nfields,
                                 stressForm,
@@ -181,6 +208,25 @@ void registerEllipticKernels(std::string section, int poissonEquation)
                                 platform->options.compareArgs("KERNEL AUTOTUNING", "FALSE") ? false : true,
                                 "");
     platform->kernels.add(prefix + _kernelName, axKernel);
+
+    // inner iterations of mixed-precision iterative refinement
+    if (mixedPrecision) {
+      auto axKernelPfloat =
+          benchmarkAx(NelemBenchmark,
+                      N + 1,
+                      Ng,
+                      !coeffField,
+                      poissonEquation,
+                      subparametric,
+                      sizeof(pfloat),
+                      Nfields,
+                      stressForm,
+                      verbosity,
+                      elliptic_t::targetTimeBenchmark,
+                      platform->options.compareArgs("KERNEL AUTOTUNING", "FALSE") ? false : true,
+                      "_" + std::to_string(N) + "pfloat");
+      platform->kernels.add(prefix + _kernelName + "Pfloat", axKernelPfloat);
+    }
   }
 
   kernelName = "ellipticBlockBuildDiagonal" + suffix;
@@ -190,7 +236,20 @@ void registerEllipticKernels(std::string section, int poissonEquation)
   platform->kernels.add(sectionIdentifier + kernelName, fileName, dfloatKernelInfo);
   dfloatKernelInfo["defines/pfloat"] = dfloatString;
 
-  // PCG update
-  fileName = oklpath + "ellipticBlockUpdatePCG" + fileNameExtension;
-  platform->kernels.add(sectionIdentifier + "ellipticBlockUpdatePCG", fileName, kernelInfo);
+  if (platform->options.compareArgs(optionsPrefix + "SOLVER", "MULTIRHS")) {
+    kernelName = "ellipticMultiRhsUpdatePCG";
+    fileName = oklpath + kernelName + fileNameExtension;
+    platform->kernels.add(sectionIdentifier + kernelName, fileName, kernelInfo);
+
+    kernelName = "ellipticMultiRhsWeightedInnerProd";
+    fileName = oklpath + kernelName + fileNameExtension;
+    platform->kernels.add(sectionIdentifier + kernelName, fileName, kernelInfo);
+
+    kernelName = "ellipticMultiRhsUpdateP";
+    fileName = oklpath + kernelName + ".okl";
+    platform->kernels.add(sectionIdentifier + kernelName, fileName, kernelInfo);
+  }
+
+  for (auto &&ops : ellipticFusedOps::all())
+    linAlg_t::registerFusedKernel(*ops);
 }
@@ -1,8 +1,11 @@
+#include <set>
+
 #include <compileKernels.hpp>
 #include "nrs.hpp"
 #include "benchmarkFDM.hpp"
 #include "benchmarkAx.hpp"
 #include "ellipticPrecon.h" 
+#include "ellipticMultiGridAutotune.hpp"
 
 #include "re2Reader.hpp"
 
@@ -141,14 +144,6 @@ void registerCommonMGPreconditionerKernels(int N, occa::properties kernelInfo, i
 
     oklpath = getenv("NEKRS_KERNEL_DIR") + std::string("/elliptic/");
 
-    kernelName = "updateChebyshev";
-    fileName = oklpath + kernelName + ".okl";
-    platform->kernels.add(kernelName + orderSuffix, fileName, kernelInfo, orderSuffix);
-
-    kernelName = "updateFourthKindChebyshev";
-    fileName = oklpath + kernelName + ".okl";
-    platform->kernels.add(kernelName + orderSuffix, fileName, kernelInfo, orderSuffix);
-
     occa::properties buildDiagInfo = kernelInfo;
     if (poissonEquation)
       buildDiagInfo["defines/p_poisson"] = 1;
@@ -179,16 +174,22 @@ void registerSchwarzKernels(const std::string &section, int N)
   std::string fileName, kernelName;
   const std::string extension = serial ? ".c" : ".okl";
 
-  {
+  // the autotuner may switch between ASM and RAS
+  const bool autotune = platform->options.getArgs(optionsPrefix + "MULTIGRID AUTOTUNE").size();
+  // multiplicative Schwarz uses the restricted kernels
+  const bool useRAS = platform->options.compareArgs(optionsPrefix + "MULTIGRID SMOOTHER", "RAS") ||
+                      platform->options.compareArgs(optionsPrefix + "MULTIGRID SMOOTHER", "MSM");
+
+  for (auto &&ras : {false, true}) {
+    if (!autotune && ras != useRAS)
+      continue;
+
     occa::properties properties = platform->kernelInfo;
     properties["defines/p_Nq"] = Nq;
     properties["defines/p_Nq_e"] = Nq_e;
-    properties["defines/p_restrict"] = 0;
-    bool useRAS = platform->options.compareArgs(optionsPrefix + "MULTIGRID SMOOTHER", "RAS");
-    const std::string suffix = std::string("_") + std::to_string(Nq_e - 1) + std::string("pfloat");
-    if (useRAS) {
-      properties["defines/p_restrict"] = 1;
-    }
+    properties["defines/p_restrict"] = ras ? 1 : 0;
+    const std::string suffix =
+        std::string("_") + std::to_string(Nq_e - 1) + std::string("pfloat") + (ras ? "RAS" : "");
 
     fileName = oklpath + "preFDM" + extension;
     platform->kernels.add("preFDM" + suffix, fileName, properties, suffix);
@@ -203,7 +204,7 @@ void registerSchwarzKernels(const std::string &section, int N)
     auto fdmKernel = benchmarkFDM(NelemBenchmark,
                                   Nq_e,
                                   sizeof(pfloat),
-                                  useRAS,
+                                  ras,
                                   verbosity,
                                   elliptic_t::targetTimeBenchmark,
                                   platform->options.compareArgs("KERNEL AUTOTUNING", "FALSE") ? false : true,
@@ -213,6 +214,16 @@ void registerSchwarzKernels(const std::string &section, int N)
     fileName = oklpath + "postFDM" + extension;
     platform->kernels.add("postFDM" + suffix, fileName, properties, suffix);
   }
+
+  if (autotune || platform->options.compareArgs(optionsPrefix + "MULTIGRID SMOOTHER", "MSM")) {
+    occa::properties properties = platform->kernelInfo;
+    properties["defines/p_Nq"] = Nq;
+    properties["defines/p_Np"] = Np;
+    const std::string suffix = std::string("_") + std::to_string(N) + std::string("pfloat");
+
+    fileName = oklpath + "multiplicativeSchwarzUpdate" + extension;
+    platform->kernels.add("multiplicativeSchwarzUpdate" + suffix, fileName, properties, suffix);
+  }
 }
 void registerFineLevelKernels(const std::string &section, int N, int poissonEquation)
 {
@@ -303,6 +314,9 @@ void registerMultiGridKernels(const std::string &section, int poissonEquation)
   platform->options.getArgs("POLYNOMIAL DEGREE", N);
   const std::string optionsPrefix = createOptionsPrefix(section);
 
+  // settings of a previous autotuning run determine the levels
+  multigridAutotuneLoad(section);
+
   registerFineLevelKernels(section, N, poissonEquation);
 
   std::vector<int> levels = determineMGLevels(section);
@@ -310,15 +324,26 @@ void registerMultiGridKernels(const std::string &section, int poissonEquation)
   if (levels.empty())
     return;
 
-  for (unsigned levelIndex = 1U; levelIndex < levels.size(); ++levelIndex) {
-    const int levelFine = levels[levelIndex - 1];
-    const int levelCoarse = levels[levelIndex];
-    registerMultigridLevelKernels(section, levelFine, levelCoarse, poissonEquation);
+  // the autotuner probes additional schedules
+  std::vector<std::vector<int>> schedules = {levels};
+  if (platform->options.getArgs(optionsPrefix + "MULTIGRID AUTOTUNE").size()) {
+    for (auto &&candidate : multigridAutotuneLevels(N))
+      schedules.push_back(candidate);
+  }
+
+  std::set<std::pair<int, int>> levelPairs;
+  for (auto &&schedule : schedules) {
+    for (unsigned levelIndex = 1U; levelIndex < schedule.size(); ++levelIndex)
+      levelPairs.insert({schedule[levelIndex - 1], schedule[levelIndex]});
   }
-  const int coarseLevel = levels.back();
+
+  for (auto &&[levelFine, levelCoarse] : levelPairs)
+    registerMultigridLevelKernels(section, levelFine, levelCoarse, poissonEquation);
+
   if (platform->options.compareArgs(optionsPrefix + "MULTIGRID COARSE SOLVE", "TRUE")) {
     if (platform->options.compareArgs(optionsPrefix + "MULTIGRID SEMFEM", "TRUE")) {
-      registerSEMFEMKernels(section, coarseLevel, poissonEquation);
+      // SEMFEM kernels are not order specific, the autotuner keeps the coarse level
+      registerSEMFEMKernels(section, levels.back(), poissonEquation);
     }
     else {
       {
@@ -354,7 +379,7 @@ void registerSEMFEMKernels(const std::string &section, int N, int poissonEquatio
   stiffnessKernelInfo["defines/p_Nq"] = Nq;
   stiffnessKernelInfo["defines/p_Np"] = Np;
   stiffnessKernelInfo["defines/p_rows_sorted"] = 1;
-  stiffnessKernelInfo["defines/p_cols_sorted"] = 0;
+  stiffnessKernelInfo["defines/p_cols_sorted"] = 1;
 
   const bool constructOnHost = !platform->device.deviceAtomic;
 
@@ -55,8 +55,10 @@ void registerLinAlgKernels()
       {"innerProd", true},
       {"weightedInnerProd", true},
       {"weightedInnerProdMany", true},
+      {"pweightedInnerProdMany", true},
       {"weightedInnerProdMulti", false},
       {"weightedInnerProdMultiDevice", false},
+      {"weightedInnerProdMultiNorm", false},
       {"crossProduct", false},
       {"unitVector", false},
       {"entrywiseMag", false},
@@ -79,4 +81,14 @@ void registerLinAlgKernels()
       platform->kernels.add(kernelName, oklDir + kernelName + extension, kernelInfo);
     }
   }
+
+  // second reduction stage, the partials of p-kernels are pfloat
+  {
+    occa::properties props = kernelInfo;
+    props["defines/p_partialType"] = dfloatString;
+    platform->kernels.add("sumBlocks", oklDir + "sumBlocks.okl", props);
+
+    props["defines/p_partialType"] = pfloatString;
+    platform->kernels.add("psumBlocks", oklDir + "sumBlocks.okl", props);
+  }
 }
@@ -60,4 +60,19 @@ void registerMeshKernels(occa::properties kernelInfoBC)
       platform->kernels.add(meshPrefix + kernelName, fileName, meshKernelInfo);
     }
   }
+
+  if (platform->serial && platform->options.compareArgs("INTERLEAVE GEOMETRIC FACTORS", "TRUE")) {
+    const std::string oklpath = getenv("NEKRS_KERNEL_DIR");
+    const std::string kernelName = "interleaveElements";
+    const std::string fileName = oklpath + "/mesh/" + kernelName + ".c";
+
+    auto kernelInfo = platform->kernelInfo;
+    kernelInfo["defines/p_float"] = dfloatString;
+    kernelInfo["defines/p_Nlanes"] = mesh_t::aosoaBytes / sizeof(dfloat);
+    platform->kernels.add("mesh-" + kernelName, fileName, kernelInfo);
+
+    kernelInfo["defines/p_float"] = pfloatString;
+    kernelInfo["defines/p_Nlanes"] = mesh_t::aosoaBytes / sizeof(pfloat);
+    platform->kernels.add("mesh-" + kernelName + "Pfloat", fileName, kernelInfo);
+  }
 }
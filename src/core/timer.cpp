@@ -526,6 +526,8 @@ void timer_t::printRunStat(int step)
   }
 
   printStatEntry("        coarse grid     ", "coarseSolve", "DEVICE:MAX", tPressurePreco);
+  const double tCoarse = query("coarseSolve", "DEVICE:MAX");
+  printStatEntry("          overlapped    ", "coarseSolve overlapped", "DEVICE:MAX", tCoarse);
   printStatEntry("      initial guess     ", "pressure proj", "DEVICE:MAX", tPressure);
 
   int nScalar = 0;
@@ -581,6 +583,11 @@ void timer_t::printRunStat(int step)
 
   printStatEntry("    dotp multi          ", "dotpMulti", "DEVICE:MAX", tElapsedTimeSolve);
 
+  if (rank == 0)
+    std::cout << std::endl;
+
+  platform->printMemoryUsage();
+
   if (rank == 0)
     std::cout << std::endl;
 
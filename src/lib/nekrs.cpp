@@ -198,9 +198,8 @@ void setup(MPI_Comm commg_in,
   const double setupTime = platform->timer.query("setup", "DEVICE:MAX");
   if (rank == 0) {
     std::cout << "\nsettings:\n" << std::endl << options << std::endl;
-    std::cout << "occa memory usage: " << platform->device.occaDevice().memoryAllocated() / 1e9 << " GB"
-              << std::endl;
   }
+  platform->printMemoryUsage();
   fflush(stdout);
 
   platform->flopCounter->clear();
@@ -536,8 +535,9 @@ int nrsFinalize(nrs_t *nrs)
       delete nrs->uvwSolver;
     if (nrs->pSolver)
       delete nrs->pSolver;
-    for (int is; is < nrs->Nscalar; is++) {
-      if (nrs->cds->solver[is])
+    for (int is = 0; is < nrs->Nscalar; is++) {
+      // multiRHS group members share the solver of their leader
+      if (nrs->cds->solver[is] && cdsMultiRhsGroupLeader(is) == is)
         delete nrs->cds->solver[is];
     }
     if (nrs->cvode)
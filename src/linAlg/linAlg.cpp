@@ -27,6 +27,8 @@ SOFTWARE.
 #include "linAlg.hpp"
 #include "platform.hpp"
 #include "re2Reader.hpp"
+#include <regex>
+#include <set>
 
 linAlg_t *linAlg_t::singleton = nullptr;
 
@@ -191,8 +193,12 @@ void linAlg_t::setup()
     innerProdKernel = kernels.get("innerProd");
     weightedInnerProdKernel = kernels.get("weightedInnerProd");
     weightedInnerProdManyKernel = kernels.get("weightedInnerProdMany");
+    pweightedInnerProdManyKernel = kernels.get("pweightedInnerProdMany");
     weightedInnerProdMultiKernel = kernels.get("weightedInnerProdMulti");
     weightedInnerProdMultiDeviceKernel = kernels.get("weightedInnerProdMultiDevice");
+    weightedInnerProdMultiNormKernel = kernels.get("weightedInnerProdMultiNorm");
+    sumBlocksKernel = kernels.get("sumBlocks");
+    psumBlocksKernel = kernels.get("psumBlocks");
     crossProductKernel = kernels.get("crossProduct");
     unitVectorKernel = kernels.get("unitVector");
     entrywiseMagKernel = kernels.get("entrywiseMag");
@@ -241,7 +247,11 @@ linAlg_t::~linAlg_t()
   innerProdKernel.free();
   weightedInnerProdKernel.free();
   weightedInnerProdManyKernel.free();
+  pweightedInnerProdManyKernel.free();
   weightedInnerProdMultiKernel.free();
+  weightedInnerProdMultiNormKernel.free();
+  sumBlocksKernel.free();
+  psumBlocksKernel.free();
 }
 
 /*********************/
@@ -474,17 +484,13 @@ dfloat linAlg_t::sum(const dlong N, occa::memory &o_a, MPI_Comm _comm, const dlo
   if (o_scratch.size() < Nbytes)
     reallocScratch(Nbytes);
 
+  dfloat sum = 0;
   if (N > 1) {
     sumKernel(Nblock, N, offset, o_a, o_scratch);
-    o_scratch.copyTo(scratch, Nbytes);
+    reduceBlocks(Nblock, 1, &sum);
   }
   else {
-    o_a.copyTo(scratch, Nbytes);
-  }
-
-  dfloat sum = 0;
-  for (dlong n = 0; n < Nblock; ++n) {
-    sum += scratch[n];
+    o_a.copyTo(&sum, Nbytes);
   }
 
   if (_comm != MPI_COMM_SELF)
@@ -503,18 +509,13 @@ dfloat linAlg_t::sumMany(const dlong N,
   if (o_scratch.size() < Nbytes)
     reallocScratch(Nbytes);
 
+  dfloat sum = 0;
   if (N > 1 || Nfields > 1) {
     sumManyKernel(Nblock, N, Nfields, fieldOffset, o_a, o_scratch);
-
-    o_scratch.copyTo(scratch, Nbytes);
+    reduceBlocks(Nblock, 1, &sum);
   }
   else {
-    o_a.copyTo(scratch, Nbytes);
-  }
-
-  dfloat sum = 0;
-  for (dlong n = 0; n < Nblock; ++n) {
-    sum += scratch[n];
+    o_a.copyTo(&sum, Nbytes);
   }
 
   if (_comm != MPI_COMM_SELF)
@@ -657,15 +658,7 @@ dfloat linAlg_t::norm2(const dlong N, occa::memory &o_x, MPI_Comm _comm)
   if (N > 1) {
     norm2Kernel(Nblock, N, o_x, o_scratch);
 
-    if (serial) {
-      norm = *((dfloat *)o_scratch.ptr());
-    }
-    else {
-      o_scratch.copyTo(scratch, Nbytes);
-      for (dlong n = 0; n < Nblock; ++n) {
-        norm += scratch[n];
-      }
-    }
+    reduceBlocks(serial ? 1 : Nblock, 1, &norm);
   }
   else {
     dfloat x;
@@ -698,15 +691,7 @@ dfloat linAlg_t::norm2Many(const dlong N,
   dfloat norm = 0;
   if (N > 1 || Nfields > 1) {
     norm2ManyKernel(Nblock, N, Nfields, fieldOffset, o_x, o_scratch);
-    if (serial) {
-      norm = *((dfloat *)o_scratch.ptr());
-    }
-    else {
-      o_scratch.copyTo(scratch, Nbytes);
-      for (dlong n = 0; n < Nblock; ++n) {
-        norm += scratch[n];
-      }
-    }
+    reduceBlocks(serial ? 1 : Nblock, 1, &norm);
   }
   else {
     dfloat x;
@@ -736,15 +721,7 @@ dfloat linAlg_t::norm1(const dlong N, occa::memory &o_x, MPI_Comm _comm)
   dfloat norm = 0;
   if (N > 1) {
     norm1Kernel(Nblock, N, o_x, o_scratch);
-    if (serial) {
-      norm = *((dfloat *)o_scratch.ptr());
-    }
-    else {
-      o_scratch.copyTo(scratch, Nbytes);
-      for (dlong n = 0; n < Nblock; ++n) {
-        norm += scratch[n];
-      }
-    }
+    reduceBlocks(serial ? 1 : Nblock, 1, &norm);
   }
   else {
     dfloat x;
@@ -778,15 +755,7 @@ dfloat linAlg_t::norm1Many(const dlong N,
   if (N > 1 || Nfields > 1) {
     norm1ManyKernel(Nblock, N, Nfields, fieldOffset, o_x, o_scratch);
 
-    if (serial) {
-      norm = *((dfloat *)o_scratch.ptr());
-    }
-    else {
-      o_scratch.copyTo(scratch, Nbytes);
-      for (dlong n = 0; n < Nblock; ++n) {
-        norm += scratch[n];
-      }
-    }
+    reduceBlocks(serial ? 1 : Nblock, 1, &norm);
   }
   else {
     dfloat x;
@@ -804,43 +773,33 @@ dfloat linAlg_t::norm1Many(const dlong N,
 }
 
 // o_x.o_y
-dfloat
-linAlg_t::innerProd(const dlong N, occa::memory &o_x, occa::memory &o_y, MPI_Comm _comm, const dlong offset)
+linAlg_t::reduction_t
+linAlg_t::innerProdStart(const dlong N, occa::memory &o_x, occa::memory &o_y, MPI_Comm _comm, const dlong offset)
 {
-
-  if (timer)
-    platform->timer.tic("dotp", 1);
-
   int Nblock = (N + blocksize - 1) / blocksize;
   const size_t Nbytes = Nblock * sizeof(dfloat);
   if (o_scratch.size() < Nbytes)
     reallocScratch(Nbytes);
 
-  dfloat dot = 0;
   if (N > 1) {
     innerProdKernel(Nblock, N, offset, o_x, o_y, o_scratch);
+    return reduceStart(serial ? 1 : Nblock, 1, _comm);
+  }
 
-    if (serial) {
-      dot = *((dfloat *)o_scratch.ptr());
-    }
-    else {
-
-      o_scratch.copyTo(scratch, Nbytes);
+  dfloat x = 0, y = 0;
+  o_x.copyTo(&x, Nbytes);
+  o_y.copyTo(&y, Nbytes);
+  return allreduceStart({x * y}, _comm);
+}
 
-      for (dlong n = 0; n < Nblock; ++n) {
-        dot += scratch[n];
-      }
-    }
-  }
-  else {
-    dfloat x, y;
-    o_x.copyTo(&x, Nbytes);
-    o_y.copyTo(&y, Nbytes);
-    dot = x * y;
-  }
+dfloat
+linAlg_t::innerProd(const dlong N, occa::memory &o_x, occa::memory &o_y, MPI_Comm _comm, const dlong offset)
+{
+  if (timer)
+    platform->timer.tic("dotp", 1);
 
-  if (_comm != MPI_COMM_SELF)
-    MPI_Allreduce(MPI_IN_PLACE, &dot, 1, MPI_DFLOAT, MPI_SUM, _comm);
+  auto request = innerProdStart(N, o_x, o_y, _comm, offset);
+  const dfloat dot = finish(request);
 
   if (timer)
     platform->timer.toc("dotp");
@@ -868,15 +827,7 @@ dfloat linAlg_t::weightedInnerProd(const dlong N,
   if (N > 1) {
     weightedInnerProdKernel(Nblock, N, o_w, o_x, o_y, o_scratch);
 
-    if (serial) {
-      dot = *((dfloat *)o_scratch.ptr());
-    }
-    else {
-      o_scratch.copyTo(scratch, Nbytes);
-      for (dlong n = 0; n < Nblock; ++n) {
-        dot += scratch[n];
-      }
-    }
+    reduceBlocks(serial ? 1 : Nblock, 1, &dot);
   }
   else {
     dfloat w, x, y;
@@ -895,6 +846,35 @@ dfloat linAlg_t::weightedInnerProd(const dlong N,
   platform->flopCounter->add("weightedInnerProd", 3 * static_cast<double>(N));
   return dot;
 }
+linAlg_t::reduction_t linAlg_t::weightedInnerProdMultiStart(const dlong N,
+                                                            const dlong NVec,
+                                                            const dlong Nfields,
+                                                            const dlong fieldOffset,
+                                                            occa::memory &o_w,
+                                                            occa::memory &o_x,
+                                                            occa::memory &o_y,
+                                                            MPI_Comm _comm,
+                                                            const dlong offset)
+{
+  int Nblock = (N + blocksize - 1) / blocksize;
+  const size_t Nbytes = NVec * Nblock * sizeof(dfloat);
+  if (o_scratch.size() < Nbytes)
+    reallocScratch(Nbytes);
+
+  platform->flopCounter->add("weightedInnerProdMulti", NVec * static_cast<double>(N) * (2 * Nfields + 1));
+
+  if (N > 1 || NVec > 1 || Nfields > 1) {
+    weightedInnerProdMultiKernel(Nblock, N, Nfields, fieldOffset, NVec, offset, o_w, o_x, o_y, o_scratch);
+    return reduceStart(Nblock, NVec, _comm);
+  }
+
+  dfloat w = 0, x = 0, y = 0;
+  o_w.copyTo(&w, Nbytes);
+  o_x.copyTo(&x, Nbytes);
+  o_y.copyTo(&y, Nbytes);
+  return allreduceStart({w * x * y}, _comm);
+}
+
 void linAlg_t::weightedInnerProdMulti(const dlong N,
                                       const dlong NVec,
                                       const dlong Nfields,
@@ -909,39 +889,11 @@ void linAlg_t::weightedInnerProdMulti(const dlong N,
   if (timer)
     platform->timer.tic("dotpMulti", 1);
 
-  int Nblock = (N + blocksize - 1) / blocksize;
-  const size_t Nbytes = NVec * Nblock * sizeof(dfloat);
-  if (o_scratch.size() < Nbytes)
-    reallocScratch(Nbytes);
-
-  if (N > 1 || NVec > 1 || Nfields > 1) {
-    weightedInnerProdMultiKernel(Nblock, N, Nfields, fieldOffset, NVec, offset, o_w, o_x, o_y, o_scratch);
-
-    o_scratch.copyTo(scratch, Nbytes);
-
-    for (int field = 0; field < NVec; ++field) {
-      dfloat dot = 0;
-      for (dlong n = 0; n < Nblock; ++n) {
-        dot += scratch[n + field * Nblock];
-      }
-      result[field] = dot;
-    }
-  }
-  else {
-    dfloat w, x, y;
-    o_w.copyTo(&w, Nbytes);
-    o_x.copyTo(&x, Nbytes);
-    o_y.copyTo(&y, Nbytes);
-    result[0] = w * x * y;
-  }
-
-  if (_comm != MPI_COMM_SELF)
-    MPI_Allreduce(MPI_IN_PLACE, result, NVec, MPI_DFLOAT, MPI_SUM, _comm);
+  auto request = weightedInnerProdMultiStart(N, NVec, Nfields, fieldOffset, o_w, o_x, o_y, _comm, offset);
+  finish(request, result);
 
   if (timer)
     platform->timer.toc("dotpMulti");
-
-  platform->flopCounter->add("weightedInnerProdMulti", NVec * static_cast<double>(N) * (2 * Nfields + 1));
 }
 
 void linAlg_t::weightedInnerProdMulti(const dlong N,
@@ -983,6 +935,64 @@ void linAlg_t::weightedInnerProdMulti(const dlong N,
   platform->flopCounter->add("weightedInnerProdMulti", NVec * static_cast<double>(N) * (2 * Nfields + 1));
 }
 
+void linAlg_t::weightedInnerProdMultiNorm(const dlong N,
+                                          const dlong NVec,
+                                          const dlong Nfields,
+                                          const dlong fieldOffset,
+                                          occa::memory &o_w,
+                                          occa::memory &o_x,
+                                          occa::memory &o_y,
+                                          MPI_Comm _comm,
+                                          dfloat *result,
+                                          const dlong offset)
+{
+  if (timer)
+    platform->timer.tic("dotpMulti", 1);
+
+  const int Nblock = (N + blocksize - 1) / blocksize;
+  const size_t Nbytes = (NVec + 1) * Nblock * sizeof(dfloat);
+  if (o_scratch.size() < Nbytes)
+    reallocScratch(Nbytes);
+
+  weightedInnerProdMultiNormKernel(Nblock, N, Nfields, fieldOffset, NVec, offset, o_w, o_x, o_y, o_scratch);
+  reduceBlocks(Nblock, NVec + 1, result);
+
+  if (_comm != MPI_COMM_SELF)
+    MPI_Allreduce(MPI_IN_PLACE, result, NVec + 1, MPI_DFLOAT, MPI_SUM, _comm);
+
+  if (timer)
+    platform->timer.toc("dotpMulti");
+
+  platform->flopCounter->add("weightedInnerProdMulti", (NVec + 1) * static_cast<double>(N) * (2 * Nfields + 1));
+}
+
+linAlg_t::reduction_t linAlg_t::weightedInnerProdManyStart(const dlong N,
+                                                           const dlong Nfields,
+                                                           const dlong fieldOffset,
+                                                           occa::memory &o_w,
+                                                           occa::memory &o_x,
+                                                           occa::memory &o_y,
+                                                           MPI_Comm _comm)
+{
+  int Nblock = (N + blocksize - 1) / blocksize;
+  const size_t Nbytes = Nblock * sizeof(dfloat);
+  if (o_scratch.size() < Nbytes)
+    reallocScratch(Nbytes);
+
+  platform->flopCounter->add("weightedInnerProdMany", 3 * static_cast<double>(N) * Nfields);
+
+  if (N > 1 || Nfields > 1) {
+    weightedInnerProdManyKernel(Nblock, N, Nfields, fieldOffset, o_w, o_x, o_y, o_scratch);
+    return reduceStart(serial ? 1 : Nblock, 1, _comm);
+  }
+
+  dfloat w = 0, x = 0, y = 0;
+  o_w.copyTo(&w, Nbytes);
+  o_x.copyTo(&x, Nbytes);
+  o_y.copyTo(&y, Nbytes);
+  return allreduceStart({w * x * y}, _comm);
+}
+
 dfloat linAlg_t::weightedInnerProdMany(const dlong N,
                                        const dlong Nfields,
                                        const dlong fieldOffset,
@@ -994,32 +1004,35 @@ dfloat linAlg_t::weightedInnerProdMany(const dlong N,
   if (timer)
     platform->timer.tic("dotp", 1);
 
+  auto request = weightedInnerProdManyStart(N, Nfields, fieldOffset, o_w, o_x, o_y, _comm);
+  const dfloat dot = finish(request);
+
+  if (timer)
+    platform->timer.toc("dotp");
+
+  return dot;
+}
+
+dfloat linAlg_t::pweightedInnerProdMany(const dlong N,
+                                        const dlong Nfields,
+                                        const dlong fieldOffset,
+                                        occa::memory &o_w,
+                                        occa::memory &o_x,
+                                        occa::memory &o_y,
+                                        MPI_Comm _comm)
+{
+  if (timer)
+    platform->timer.tic("dotp", 1);
+
   int Nblock = (N + blocksize - 1) / blocksize;
-  const size_t Nbytes = Nblock * sizeof(dfloat);
+  const size_t Nbytes = Nblock * sizeof(pfloat);
   if (o_scratch.size() < Nbytes)
     reallocScratch(Nbytes);
 
   dfloat dot = 0;
-  if (N > 1 || Nfields > 1) {
-    weightedInnerProdManyKernel(Nblock, N, Nfields, fieldOffset, o_w, o_x, o_y, o_scratch);
+  pweightedInnerProdManyKernel(Nblock, N, Nfields, fieldOffset, o_w, o_x, o_y, o_scratch);
 
-    if (serial) {
-      dot = *((dfloat *)o_scratch.ptr());
-    }
-    else {
-      o_scratch.copyTo(scratch, Nbytes);
-      for (dlong n = 0; n < Nblock; ++n) {
-        dot += scratch[n];
-      }
-    }
-  }
-  else {
-    dfloat w, x, y;
-    o_w.copyTo(&w, Nbytes);
-    o_x.copyTo(&x, Nbytes);
-    o_y.copyTo(&y, Nbytes);
-    dot = w * x * y;
-  }
+  reduceBlocks(serial ? 1 : Nblock, 1, &dot, true);
 
   if (_comm != MPI_COMM_SELF)
     MPI_Allreduce(MPI_IN_PLACE, &dot, 1, MPI_DFLOAT, MPI_SUM, _comm);
@@ -1027,7 +1040,7 @@ dfloat linAlg_t::weightedInnerProdMany(const dlong N,
   if (timer)
     platform->timer.toc("dotp");
 
-  platform->flopCounter->add("weightedInnerProdMany", 3 * static_cast<double>(N) * Nfields);
+  platform->flopCounter->add("weightedInnerProdMany", 0.5 * 3 * static_cast<double>(N) * Nfields);
 
   return dot;
 }
@@ -1047,15 +1060,7 @@ dfloat linAlg_t::weightedNorm2(const dlong N, occa::memory &o_w, occa::memory &o
   if (N > 1) {
     weightedNorm2Kernel(Nblock, N, o_w, o_a, o_scratch);
 
-    if (serial) {
-      norm = *((dfloat *)o_scratch.ptr());
-    }
-    else {
-      o_scratch.copyTo(scratch, Nbytes);
-      for (dlong n = 0; n < Nblock; ++n) {
-        norm += scratch[n];
-      }
-    }
+    reduceBlocks(serial ? 1 : Nblock, 1, &norm);
   }
   else {
     dfloat w, a;
@@ -1074,49 +1079,47 @@ dfloat linAlg_t::weightedNorm2(const dlong N, occa::memory &o_w, occa::memory &o
 
   return sqrt(norm);
 }
-dfloat linAlg_t::weightedNorm2Many(const dlong N,
-                                   const dlong Nfields,
-                                   const dlong fieldOffset,
-                                   occa::memory &o_w,
-                                   occa::memory &o_a,
-                                   MPI_Comm _comm)
+linAlg_t::reduction_t linAlg_t::weightedNorm2ManyStart(const dlong N,
+                                                       const dlong Nfields,
+                                                       const dlong fieldOffset,
+                                                       occa::memory &o_w,
+                                                       occa::memory &o_a,
+                                                       MPI_Comm _comm)
 {
-  if (timer)
-    platform->timer.tic("dotp", 1);
-
   int Nblock = (N + blocksize - 1) / blocksize;
   const size_t Nbytes = Nblock * sizeof(dfloat);
   if (o_scratch.size() < Nbytes)
     reallocScratch(Nbytes);
 
-  dfloat norm = 0;
+  platform->flopCounter->add("weightedNorm2Many", 3 * static_cast<double>(N) * Nfields);
+
   if (N > 1 || Nfields > 1) {
     weightedNorm2ManyKernel(Nblock, N, Nfields, fieldOffset, o_w, o_a, o_scratch);
-
-    if (serial) {
-      norm = *((dfloat *)o_scratch.ptr());
-    }
-    else {
-      o_scratch.copyTo(scratch, Nbytes);
-      for (dlong n = 0; n < Nblock; ++n) {
-        norm += scratch[n];
-      }
-    }
-  }
-  else {
-    dfloat w, a;
-    o_w.copyTo(&w, Nbytes);
-    o_a.copyTo(&a, Nbytes);
-    norm = w * a * a;
+    return reduceStart(serial ? 1 : Nblock, 1, _comm);
   }
 
-  if (_comm != MPI_COMM_SELF)
-    MPI_Allreduce(MPI_IN_PLACE, &norm, 1, MPI_DFLOAT, MPI_SUM, _comm);
+  dfloat w = 0, a = 0;
+  o_w.copyTo(&w, Nbytes);
+  o_a.copyTo(&a, Nbytes);
+  return allreduceStart({w * a * a}, _comm);
+}
+
+dfloat linAlg_t::weightedNorm2Many(const dlong N,
+                                   const dlong Nfields,
+                                   const dlong fieldOffset,
+                                   occa::memory &o_w,
+                                   occa::memory &o_a,
+                                   MPI_Comm _comm)
+{
+  if (timer)
+    platform->timer.tic("dotp", 1);
+
+  auto request = weightedNorm2ManyStart(N, Nfields, fieldOffset, o_w, o_a, _comm);
+  const dfloat norm = finish(request);
 
   if (timer)
     platform->timer.toc("dotp");
 
-  platform->flopCounter->add("weightedNorm2Many", 3 * static_cast<double>(N) * Nfields);
   return sqrt(norm);
 }
 
@@ -1135,15 +1138,7 @@ dfloat linAlg_t::weightedNorm1(const dlong N, occa::memory &o_w, occa::memory &o
   if (N > 1) {
     weightedNorm1Kernel(Nblock, N, o_w, o_a, o_scratch);
 
-    if (serial) {
-      norm = *((dfloat *)o_scratch.ptr());
-    }
-    else {
-      o_scratch.copyTo(scratch, Nbytes);
-      for (dlong n = 0; n < Nblock; ++n) {
-        norm += scratch[n];
-      }
-    }
+    reduceBlocks(serial ? 1 : Nblock, 1, &norm);
   }
   else {
     dfloat w, a;
@@ -1178,15 +1173,7 @@ dfloat linAlg_t::weightedNorm1Many(const dlong N,
   if (N > 1 || Nfields > 1) {
     weightedNorm1ManyKernel(Nblock, N, Nfields, fieldOffset, o_w, o_a, o_scratch);
 
-    if (serial) {
-      norm = *((dfloat *)o_scratch.ptr());
-    }
-    else {
-      o_scratch.copyTo(scratch, Nbytes);
-      for (dlong n = 0; n < Nblock; ++n) {
-        norm += scratch[n];
-      }
-    }
+    reduceBlocks(serial ? 1 : Nblock, 1, &norm);
   }
   else {
     dfloat w, a;
@@ -1225,4 +1212,249 @@ void linAlg_t::entrywiseMag(const dlong N,
                   occa::memory &o_b)
 {
   entrywiseMagKernel(N, Nfields, fieldOffset, o_a, o_b);
-}
\ No newline at end of file
+}
+/*********************/
+/* fused pipelines   */
+/*********************/
+
+std::string linAlg_t::fusedOps_t::key() const
+{
+  std::string txt = pfloatType ? "pfloat" : "dfloat";
+  txt += weighted ? "|w|" : "|";
+  for (auto &&list : {vectors, scalars, updates, reductions}) {
+    for (auto &&entry : list)
+      txt += entry + ";";
+    txt += "|";
+  }
+  return txt;
+}
+
+std::string linAlg_t::fusedKernelName(const fusedOps_t &ops)
+{
+  return "fusedOps-" + std::to_string(std::hash<std::string>{}(ops.key()));
+}
+
+void linAlg_t::registerFusedKernel(const fusedOps_t &ops)
+{
+  const std::string key = ops.key();
+
+  nrsCheck(ops.vectors.size() > 8 || ops.scalars.size() > 8 || ops.reductions.size() > 4,
+           MPI_COMM_SELF,
+           EXIT_FAILURE,
+           "fused pipeline %s exceeds 8 vectors, 8 scalars or 4 reductions!\n",
+           key.c_str());
+
+  const std::set<std::string> reserved{"N", "Nblock", "Nfields", "fieldOffset", "n", "id", "fld",
+                                       "t", "b", "j", "w", "wn", "red", "dfloat", "dlong"};
+  const std::regex internalName(R"((v|a|r_v)[0-9]+|(p_|r_red|s_red).*)");
+  for (auto &&list : {ops.vectors, ops.scalars}) {
+    for (auto &&name : list) {
+      nrsCheck(reserved.count(name) || std::regex_match(name, internalName),
+               MPI_COMM_SELF,
+               EXIT_FAILURE,
+               "fused pipeline uses reserved name %s!\n",
+               name.c_str());
+    }
+  }
+
+  // a vector is loaded if it is read before being assigned and stored if it is assigned
+  const std::regex identifier(R"([A-Za-z_]\w*)");
+  const std::regex assignment(R"(^\s*([A-Za-z_]\w*)\s*([-+*/]?)=([^=].*)$)");
+  auto vectorId = [&](const std::string &name) {
+    auto v = std::find(ops.vectors.begin(), ops.vectors.end(), name);
+    return (v == ops.vectors.end()) ? -1 : static_cast<int>(v - ops.vectors.begin());
+  };
+  std::set<int> assigned;
+  int loadMask = 0;
+  int storeMask = 0;
+  auto addReads = [&](const std::string &expr) {
+    for (std::sregex_iterator m(expr.begin(), expr.end(), identifier), end; m != end; ++m) {
+      const int v = vectorId(m->str());
+      if (v >= 0 && !assigned.count(v))
+        loadMask |= 1 << v;
+    }
+  };
+  for (auto &&update : ops.updates) {
+    std::smatch match;
+    nrsCheck(!std::regex_match(update, match, assignment),
+             MPI_COMM_SELF,
+             EXIT_FAILURE,
+             "fused pipeline update <%s> is not an assignment!\n",
+             update.c_str());
+    addReads(match[3].str());
+    const int lhs = vectorId(match[1].str());
+    if (lhs < 0)
+      continue;
+    if (match[2].length() && !assigned.count(lhs))
+      loadMask |= 1 << lhs;
+    assigned.insert(lhs);
+    storeMask |= 1 << lhs;
+  }
+  for (auto &&reduction : ops.reductions)
+    addReads(reduction);
+
+  occa::properties props = platform->kernelInfo;
+  if (ops.pfloatType)
+    props["defines/dfloat"] = pfloatString;
+  props["defines/p_loadMask"] = loadMask;
+  props["defines/p_storeMask"] = storeMask;
+  props["defines/p_weighted"] = ops.weighted ? 1 : 0;
+  props["defines/p_Nred"] = static_cast<int>(ops.reductions.size());
+  for (size_t v = 0; v < ops.vectors.size(); ++v)
+    props["defines/" + ops.vectors[v]] = "r_v" + std::to_string(v);
+  for (size_t s = 0; s < ops.scalars.size(); ++s)
+    props["defines/" + ops.scalars[s]] = "a" + std::to_string(s);
+
+  std::string update;
+  for (auto &&entry : ops.updates)
+    update += (update.empty() ? "" : "; ") + entry;
+  props["defines/p_update"] = update.empty() ? std::string("0") : update;
+  for (size_t r = 0; r < ops.reductions.size(); ++r)
+    props["defines/p_reduce" + std::to_string(r)] = ops.reductions[r];
+
+  const std::string oklDir = getenv("NEKRS_KERNEL_DIR") + std::string("/linAlg/");
+  const std::string fileName = oklDir + "fusedOps" + (platform->serial ? ".c" : ".okl");
+
+  // pipelines shared by several solvers are requested more than once
+  const bool checkUnique = false;
+  platform->kernels.add(fusedKernelName(ops), fileName, props, "", checkUnique);
+}
+
+occa::kernel linAlg_t::fusedKernel(const fusedOps_t &ops)
+{
+  const std::string key = ops.key();
+  auto it = fusedKernels.find(key);
+  if (it != fusedKernels.end())
+    return it->second;
+
+  occa::kernel kernel = platform->kernels.get(fusedKernelName(ops));
+  fusedKernels[key] = kernel;
+
+  return kernel;
+}
+
+linAlg_t::reduction_t linAlg_t::fusedStart(const fusedOps_t &ops,
+                                           const dlong N,
+                                           const dlong Nfields,
+                                           const dlong fieldOffset,
+                                           const std::vector<dfloat> &scalars,
+                                           const std::vector<occa::memory> &vectors,
+                                           MPI_Comm _comm,
+                                           occa::memory o_w)
+{
+  nrsCheck(scalars.size() != ops.scalars.size() || vectors.size() != ops.vectors.size(),
+           MPI_COMM_SELF,
+           EXIT_FAILURE,
+           "%s\n",
+           "fused pipeline called with wrong number of arguments!");
+
+  occa::kernel kernel = fusedKernel(ops);
+
+  const int Nred = ops.reductions.size();
+  const dlong Nblock = serial ? 1 : (N + blocksize - 1) / blocksize;
+  const size_t wordSize = ops.pfloatType ? sizeof(pfloat) : sizeof(dfloat);
+  const size_t Nbytes = std::max(Nred, 1) * Nblock * wordSize;
+  if (o_scratch.size() < Nbytes)
+    reallocScratch(Nbytes);
+
+  kernel.clearArgs();
+  kernel.pushArg(Nblock);
+  kernel.pushArg(N);
+  kernel.pushArg(Nfields);
+  kernel.pushArg(fieldOffset);
+  for (size_t s = 0; s < 8; ++s) {
+    const dfloat a = (s < scalars.size()) ? scalars[s] : 0.0;
+    if (ops.pfloatType)
+      kernel.pushArg(static_cast<pfloat>(a));
+    else
+      kernel.pushArg(a);
+  }
+  for (size_t v = 0; v < 8; ++v)
+    kernel.pushArg((v < vectors.size()) ? vectors[v] : o_scratch);
+  kernel.pushArg(ops.weighted ? o_w : o_scratch);
+  kernel.pushArg(o_scratch);
+  kernel.run();
+
+  if (Nred == 0)
+    return reduction_t();
+
+  return reduceStart(Nblock, Nred, _comm, ops.pfloatType);
+}
+
+void linAlg_t::fused(const fusedOps_t &ops,
+                     const dlong N,
+                     const dlong Nfields,
+                     const dlong fieldOffset,
+                     const std::vector<dfloat> &scalars,
+                     const std::vector<occa::memory> &vectors,
+                     MPI_Comm _comm,
+                     dfloat *result,
+                     occa::memory o_w)
+{
+  if (timer)
+    platform->timer.tic("fused", 1);
+
+  auto request = fusedStart(ops, N, Nfields, fieldOffset, scalars, vectors, _comm, o_w);
+  if (ops.reductions.size())
+    finish(request, result);
+
+  if (timer)
+    platform->timer.toc("fused");
+}
+
+/*********************/
+/* reductions        */
+/*********************/
+
+void linAlg_t::reduceBlocks(const dlong Nblock, const int Nred, dfloat *result, const bool pfloatPartials)
+{
+  if (Nred == 0)
+    return;
+
+  if (Nblock == 1 && !pfloatPartials) {
+    o_scratch.copyTo(result, Nred * sizeof(dfloat));
+    return;
+  }
+
+  if (o_reduction.size() < Nred * sizeof(dfloat))
+    o_reduction = platform->device.malloc(Nred * sizeof(dfloat));
+
+  if (pfloatPartials)
+    psumBlocksKernel(Nblock, Nred, o_scratch, o_reduction);
+  else
+    sumBlocksKernel(Nblock, Nred, o_scratch, o_reduction);
+
+  o_reduction.copyTo(result, Nred * sizeof(dfloat));
+}
+
+linAlg_t::reduction_t
+linAlg_t::reduceStart(const dlong Nblock, const int Nred, MPI_Comm _comm, const bool pfloatPartials)
+{
+  std::vector<dfloat> values(Nred);
+  reduceBlocks(Nblock, Nred, values.data(), pfloatPartials);
+  return allreduceStart(std::move(values), _comm);
+}
+
+linAlg_t::reduction_t linAlg_t::allreduceStart(std::vector<dfloat> &&values, MPI_Comm _comm)
+{
+  reduction_t request;
+  request.values = std::move(values);
+  if (_comm != MPI_COMM_SELF) {
+    MPI_Iallreduce(MPI_IN_PLACE,
+                   request.values.data(),
+                   request.values.size(),
+                   MPI_DFLOAT,
+                   MPI_SUM,
+                   _comm,
+                   &request.request);
+  }
+  return request;
+}
+
+dfloat linAlg_t::finish(reduction_t &request, dfloat *result)
+{
+  MPI_Wait(&request.request, MPI_STATUS_IGNORE);
+  if (result)
+    std::copy(request.values.begin(), request.values.end(), result);
+  return request.values.empty() ? 0 : request.values[0];
+}
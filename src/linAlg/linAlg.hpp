@@ -50,9 +50,37 @@ private:
 
   void runTimers();
 
+  std::map<std::string, occa::kernel> fusedKernels;
+
+  // one value per reduction, result of the second reduction stage
+  occa::memory o_reduction;
+  occa::kernel sumBlocksKernel;
+  occa::kernel psumBlocksKernel;
+
   ~linAlg_t();
   linAlg_t();
   static linAlg_t* singleton;
+public:
+  // Handle of a split-phase reduction. The local values are summed up on the device
+  // when the ...Start call returns, the global sum (MPI_Iallreduce) is complete after
+  // finish. Callers can overlap other work with the pending communication.
+  struct reduction_t {
+    reduction_t() = default;
+    reduction_t(const reduction_t&) = delete;
+    reduction_t& operator=(const reduction_t&) = delete;
+    reduction_t(reduction_t&&) = default;
+    reduction_t& operator=(reduction_t&&) = default;
+
+    std::vector<dfloat> values;
+    MPI_Request request = MPI_REQUEST_NULL;
+  };
+
+private:
+  // sums the [Nred][Nblock] partials in o_scratch on the device and copies the Nred results
+  void reduceBlocks(const dlong Nblock, const int Nred, dfloat* result, const bool pfloatPartials = false);
+  reduction_t reduceStart(const dlong Nblock, const int Nred, MPI_Comm _comm, const bool pfloatPartials = false);
+  reduction_t allreduceStart(std::vector<dfloat>&& values, MPI_Comm _comm);
+
 public:
   static linAlg_t* getInstance();
 
@@ -179,6 +207,8 @@ public:
   // o_x.o_y
   dfloat innerProd(const dlong N, occa::memory& o_x, occa::memory& o_y,
                     MPI_Comm _comm, const dlong offset = 0);
+  reduction_t innerProdStart(const dlong N, occa::memory& o_x, occa::memory& o_y,
+                             MPI_Comm _comm, const dlong offset = 0);
 
   // ||o_a||_w1
   dfloat weightedNorm1(const dlong N, occa::memory& o_w, occa::memory& o_a,
@@ -196,6 +226,12 @@ public:
                            const dlong fieldOffset,
                            occa::memory& o_w, occa::memory& o_a,
                            MPI_Comm _comm);
+  // finish returns the squared norm
+  reduction_t weightedNorm2ManyStart(const dlong N,
+                                     const dlong Nfields,
+                                     const dlong fieldOffset,
+                                     occa::memory& o_w, occa::memory& o_a,
+                                     MPI_Comm _comm);
 
   // o_w.o_x.o_y
   dfloat weightedInnerProd(const dlong N, occa::memory& o_w, occa::memory& o_x,
@@ -204,14 +240,29 @@ public:
                               const dlong fieldOffset, occa::memory& o_w, occa::memory& o_x,
                               occa::memory& o_y, MPI_Comm _comm,
                               dfloat* result, const dlong offset = 0);
+  reduction_t weightedInnerProdMultiStart(const dlong N, const dlong NVec, const dlong Nfields,
+                                          const dlong fieldOffset, occa::memory& o_w, occa::memory& o_x,
+                                          occa::memory& o_y, MPI_Comm _comm, const dlong offset = 0);
   void weightedInnerProdMulti(const dlong N, const dlong NVec, const dlong Nfields, 
                               const dlong fieldOffset, occa::memory& o_w, occa::memory& o_x,
                               occa::memory& o_y, MPI_Comm _comm,
                               occa::memory& o_result, const dlong offset = 0);
+  // result[0:NVec] = o_w.o_x[v].o_y, result[NVec] = o_w.o_y.o_y (NVec + 1 values, single reduction)
+  void weightedInnerProdMultiNorm(const dlong N, const dlong NVec, const dlong Nfields,
+                                  const dlong fieldOffset, occa::memory& o_w, occa::memory& o_x,
+                                  occa::memory& o_y, MPI_Comm _comm,
+                                  dfloat* result, const dlong offset = 0);
 
   dfloat weightedInnerProdMany(const dlong N,
                                const dlong Nfields, const dlong fieldOffset, occa::memory& o_w, occa::memory& o_x,
                             occa::memory& o_y, MPI_Comm _comm);
+  reduction_t weightedInnerProdManyStart(const dlong N,
+                                         const dlong Nfields, const dlong fieldOffset, occa::memory& o_w,
+                                         occa::memory& o_x, occa::memory& o_y, MPI_Comm _comm);
+  // block partials are computed in pfloat, the final sum is accumulated in dfloat
+  dfloat pweightedInnerProdMany(const dlong N,
+                                const dlong Nfields, const dlong fieldOffset, occa::memory& o_w, occa::memory& o_x,
+                                occa::memory& o_y, MPI_Comm _comm);
 
   // z = x \cross y
   void crossProduct(const dlong N,
@@ -225,6 +276,56 @@ public:
   // o_b[n] = \sqrt{\sum_{i=0}^{Nfields-1} o_a[n+i*fieldOffset]^2}
   void entrywiseMag(const dlong N, const dlong Nfields, const dlong fieldOffset, occa::memory& o_a, occa::memory& o_b);
 
+  /*********************/
+  /* fused pipelines   */
+  /*********************/
+
+  // A pipeline applies its updates in order to every entry n + fld*fieldOffset
+  // (n < N, fld < Nfields) of the bound vectors in a single pass, the reductions are
+  // evaluated after the updates and summed over all entries (times o_w[n] if weighted).
+  // Updates are C statements, e.g. "r -= alpha * Ap", where the vector names denote
+  // the entry values. Bound vectors must not alias each other.
+  struct fusedOps_t {
+    std::vector<std::string> vectors;    // at most 8
+    std::vector<std::string> scalars;    // at most 8
+    std::vector<std::string> updates;
+    std::vector<std::string> reductions; // at most 4
+    bool weighted = false;
+    bool pfloatType = false;             // vectors and scalars are pfloat
+
+    std::string key() const;
+  };
+
+  // adds the kernel request of a pipeline, call before the kernels are compiled
+  // (e.g. in UDF_LoadKernels) so --build-only covers it
+  static void registerFusedKernel(const fusedOps_t& ops);
+  static std::string fusedKernelName(const fusedOps_t& ops);
+
+  // kernel of a registered pipeline (collective on first use)
+  occa::kernel fusedKernel(const fusedOps_t& ops);
+
+  // result[0:Nreductions] holds the (weighted) reductions
+  void fused(const fusedOps_t& ops,
+             const dlong N,
+             const dlong Nfields,
+             const dlong fieldOffset,
+             const std::vector<dfloat>& scalars,
+             const std::vector<occa::memory>& vectors,
+             MPI_Comm _comm = MPI_COMM_SELF,
+             dfloat* result = nullptr,
+             occa::memory o_w = occa::memory());
+  reduction_t fusedStart(const fusedOps_t& ops,
+                         const dlong N,
+                         const dlong Nfields,
+                         const dlong fieldOffset,
+                         const std::vector<dfloat>& scalars,
+                         const std::vector<occa::memory>& vectors,
+                         MPI_Comm _comm = MPI_COMM_SELF,
+                         occa::memory o_w = occa::memory());
+
+  // completes a split-phase reduction, result receives all values, returns the first one
+  dfloat finish(reduction_t& request, dfloat* result = nullptr);
+
   occa::kernel fillKernel;
   occa::kernel pfillKernel;
 
@@ -272,8 +373,10 @@ public:
   occa::kernel innerProdKernel;
   occa::kernel weightedInnerProdKernel;
   occa::kernel weightedInnerProdManyKernel;
+  occa::kernel pweightedInnerProdManyKernel;
   occa::kernel weightedInnerProdMultiKernel;
   occa::kernel weightedInnerProdMultiDeviceKernel;
+  occa::kernel weightedInnerProdMultiNormKernel;
   occa::kernel crossProductKernel;
   occa::kernel unitVectorKernel;
   occa::kernel entrywiseMagKernel;
@@ -30,6 +30,7 @@
 #include "nrssys.hpp"
 #include "ogs.hpp"
 #include "linAlg.hpp"
+#include "lagHistory.hpp"
 
 #define TRIANGLES 3
 #define QUADRILATERALS 4
@@ -51,6 +52,14 @@ struct mesh_t
   void geometricFactors();
   void surfaceGeometricFactors();
 
+  // creates or refreshes (on the device) the AoSoA copy of o_ggeo or o_ggeoPfloat,
+  // no-op unless INTERLEAVE GEOMETRIC FACTORS
+  void interleaveGeometricFactors(bool pfloatCopy);
+
+  // refreshes o_geomXYZ and o_geomBasis, no-op unless ELEMENT MAP is SUBPARAMETRIC
+  // (read by the fine level scalar Ax only, o_ggeo/o_vgeo stay order N)
+  void lowOrderGeometry();
+
   void computeInvLMM();
 
   int nAB;
@@ -180,6 +189,7 @@ struct mesh_t
 
   // mesh velocity
   occa::memory o_U;
+  lagHistory_t UHistory;
   occa::memory o_Ue;
   dfloat* U; // host shadow of mesh velocity
 
@@ -191,6 +201,7 @@ struct mesh_t
   occa::memory o_DTPfloat;
 
   occa::memory o_vgeo, o_sgeo;
+  occa::memory o_vgeoPfloat;
   occa::memory o_vmapM, o_vmapP, o_mapP;
 
   occa::memory o_EToB, o_x, o_y, o_z;
@@ -212,6 +223,21 @@ struct mesh_t
   occa::memory o_ggeo; // second order geometric factors
   occa::memory o_ggeoPfloat; // second order geometric factors
 
+  // full second copy of o_ggeo(Pfloat) read by the Ax kernel (CPU backends), element groups
+  // of aosoaBytes / wordSize interleaved node by node, the fields stay in the E-vector layout.
+  // Only created for meshes whose Ax kernel reads it (see ellipticSetup).
+  static constexpr int aosoaBytes = 64;
+  occa::memory o_ggeoAoSoA;
+  occa::memory o_ggeoPfloatAoSoA;
+
+  // element nodes at the GLL points of order geomOrder and the matrices to recompute
+  // geometric factors from them (trilinear vertices and gllzw for geomOrder = 1)
+  int geomOrder = 0;
+  occa::memory o_geomXYZ;
+  occa::memory o_geomXYZPfloat;
+  occa::memory o_geomBasis;
+  occa::memory o_geomBasisPfloat;
+
   occa::memory o_gllz;
   occa::memory o_gllw;
   occa::memory o_cubw;
@@ -233,6 +259,7 @@ struct mesh_t
 
 mesh_t *createMesh(MPI_Comm comm, int N, int cubN, bool cht, occa::properties &kernelInfo);
 mesh_t *createMeshMG(mesh_t* _mesh, int Nc);
+void freeMeshMG(mesh_t* mesh);
 
 occa::properties meshKernelProperties(int N);
 // serial sort
@@ -321,6 +348,7 @@ void dgetrf_(int* M, int* N, double* A, int* lda, int* IPIV, int* INFO);
 void dgetri_(int* N, double* A, int* lda, int* IPIV, double* WORK, int* lwork, int* INFO);
 void dgeev_(char* JOBVL, char* JOBVR, int* N, double* A, int* LDA, double* WR, double* WI,
             double* VL, int* LDVL, double* VR, int* LDVR, double* WORK, int* LWORK, int* INFO );
+void dstev_(char* JOBZ, int* N, double* D, double* E, double* Z, int* LDZ, double* WORK, int* INFO);
 
 double dlange_(char* NORM, int* M, int* N, double* A, int* LDA, double* WORK);
 void dgecon_(char* NORM, int* N, double* A, int* LDA, double* ANORM,
@@ -26,16 +26,115 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <vector>
 #include "mesh3D.h"
 #include "platform.hpp"
 #include "linAlg.hpp"
 
+void mesh_t::interleaveGeometricFactors(bool pfloatCopy)
+{
+  if (!platform->serial || !platform->options.compareArgs("INTERLEAVE GEOMETRIC FACTORS", "TRUE"))
+    return;
+
+  // pfloat == dfloat builds keep a single copy in o_ggeo
+  pfloatCopy = pfloatCopy && !strstr(pfloatString, dfloatString);
+
+  occa::memory &o_src = pfloatCopy ? o_ggeoPfloat : o_ggeo;
+  occa::memory &o_dst = pfloatCopy ? o_ggeoPfloatAoSoA : o_ggeoAoSoA;
+  if (!o_src.isInitialized())
+    return;
+
+  const size_t wordSize = pfloatCopy ? sizeof(pfloat) : sizeof(dfloat);
+  const int Nlanes = mesh_t::aosoaBytes / wordSize;
+  const dlong Ngroups = (Nelements + Nlanes - 1) / Nlanes;
+  if (!o_dst.isInitialized())
+    o_dst = platform->device.malloc(Ngroups * Nlanes * Nggeo * Np * wordSize);
+
+  auto kernel = platform->kernels.get(pfloatCopy ? "mesh-interleaveElementsPfloat" : "mesh-interleaveElements");
+  kernel(Nelements, Nggeo, Np, o_src, o_dst);
+}
+
+void mesh_t::lowOrderGeometry()
+{
+  int Nfine = -1;
+  platform->options.getArgs("POLYNOMIAL DEGREE", Nfine);
+  platform->options.getArgs("GEOMETRIC ORDER", geomOrder);
+
+  // multigrid levels keep their stored geometric factors
+  if (!platform->options.compareArgs("ELEMENT MAP", "SUBPARAMETRIC") || N != Nfine || geomOrder >= N)
+    return;
+
+  const int Nq_g = geomOrder + 1;
+  const int Np_g = Nq_g * Nq_g * Nq_g;
+
+  std::vector<dfloat> r_g(Nq_g);
+  JacobiGLL(geomOrder, r_g.data());
+
+  // sample the element nodes at the low-order points
+  std::vector<dfloat> Idown(Nq_g * Nq);
+  InterpolationMatrix1D(N, Nq, gllz, Nq_g, r_g.data(), Idown.data());
+
+  std::vector<dfloat> xyz(3 * Nlocal);
+  o_x.copyTo(xyz.data() + 0 * Nlocal, Nlocal * sizeof(dfloat));
+  o_y.copyTo(xyz.data() + 1 * Nlocal, Nlocal * sizeof(dfloat));
+  o_z.copyTo(xyz.data() + 2 * Nlocal, Nlocal * sizeof(dfloat));
+
+  std::vector<dfloat> xyzGeom(Nelements * 3 * Np_g);
+  for (dlong e = 0; e < Nelements; e++) {
+    for (int d = 0; d < 3; d++) {
+      interpolateHex3D(Idown.data(), xyz.data() + d * Nlocal + e * Np, Nq, xyzGeom.data() + (e * 3 + d) * Np_g, Nq_g);
+    }
+  }
+
+  std::vector<dfloat> basis;
+  if (geomOrder == 1) {
+    // the trilinear kernel expects the vertices in counter-clockwise order per face
+    const int tensorId[8] = {0, 1, 3, 2, 4, 5, 7, 6};
+    for (dlong e = 0; e < Nelements; e++) {
+      for (int d = 0; d < 3; d++) {
+        dfloat *xe = xyzGeom.data() + (e * 3 + d) * Np_g;
+        const std::vector<dfloat> tensor(xe, xe + Np_g);
+        for (int v = 0; v < Np_g; v++)
+          xe[v] = tensor[tensorId[v]];
+      }
+    }
+    basis.insert(basis.end(), gllz, gllz + Nq);
+    basis.insert(basis.end(), gllw, gllw + Nq);
+  }
+  else {
+    std::vector<dfloat> I(Nq * Nq_g), DI(Nq * Nq_g);
+    InterpolationMatrix1D(geomOrder, Nq_g, r_g.data(), Nq, gllz, I.data());
+    Dmatrix1D(geomOrder, Nq_g, r_g.data(), Nq, gllz, DI.data());
+    basis.insert(basis.end(), gllw, gllw + Nq);
+    basis.insert(basis.end(), I.begin(), I.end());
+    basis.insert(basis.end(), DI.begin(), DI.end());
+  }
+
+  if (!o_geomXYZ.isInitialized()) {
+    o_geomXYZ = platform->device.malloc(xyzGeom.size() * sizeof(dfloat));
+    o_geomBasis = platform->device.malloc(basis.size() * sizeof(dfloat), basis.data());
+  }
+  o_geomXYZ.copyFrom(xyzGeom.data(), xyzGeom.size() * sizeof(dfloat));
+
+  if (!strstr(pfloatString, dfloatString)) {
+    const std::vector<pfloat> xyzGeomPfloat(xyzGeom.begin(), xyzGeom.end());
+    if (!o_geomXYZPfloat.isInitialized()) {
+      const std::vector<pfloat> basisPfloat(basis.begin(), basis.end());
+      o_geomXYZPfloat = platform->device.malloc(xyzGeomPfloat.size() * sizeof(pfloat));
+      o_geomBasisPfloat = platform->device.malloc(basisPfloat.size() * sizeof(pfloat), basisPfloat.data());
+    }
+    o_geomXYZPfloat.copyFrom(xyzGeomPfloat.data(), xyzGeomPfloat.size() * sizeof(pfloat));
+  }
+  else {
+    o_geomXYZPfloat = o_geomXYZ;
+    o_geomBasisPfloat = o_geomBasis;
+  }
+}
+
 void mesh_t::geometricFactors()
 {
-  const auto tmpSize = Nlocal * sizeof(dfloat);
-  occa::memory o_tmp = (platform->o_mempool.o_ptr.size() >= tmpSize) ?
-                       platform->o_mempool.slice0 : 
-                       platform->device.malloc(tmpSize); 
+  auto scope = platform->memoryArena.scope("mesh");
+  occa::memory o_tmp = scope.allocate<dfloat>("J", Nlocal);
 
   geometricFactorsKernel(Nelements,
                          o_D,
@@ -57,6 +156,11 @@ void mesh_t::geometricFactors()
   nrsCheck(minJ < 0 || maxJ < 0, platform->comm.mpiComm, EXIT_FAILURE,
            "%s\n", "Invalid element Jacobian < 0 found!");
 
+  // the interleaved copy only exists if an Ax kernel reads it
+  if (o_ggeoAoSoA.isInitialized())
+    interleaveGeometricFactors(false);
+  lowOrderGeometry();
+
   double flopsCubatureGeometricFactors = 0.0;
   if (cubNq > 1) {
     cubatureGeometricFactorsKernel(Nelements, o_cubD, o_x, o_y, o_z, o_cubInterpT, o_cubw, o_cubvgeo);
@@ -11,6 +11,7 @@ void mesh_t::move()
       fieldOffset,
       nAB,
       o_coeffAB,
+      UHistory.o_slot(),
       o_U,
       o_x,
       o_y,
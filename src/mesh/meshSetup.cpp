@@ -1,3 +1,5 @@
+#include <array>
+
 #include "nrs.hpp"
 #include "nekInterfaceAdapter.hpp"
 #include "meshNekReader.hpp"
@@ -290,23 +292,42 @@ mesh_t *createMesh(MPI_Comm comm, int N, int cubN, bool cht, occa::properties &k
   return mesh;
 }
 
+namespace
+{
+// kernels (re)assigned by a multigrid mesh
+std::array<occa::kernel *, 8> kernelsMG(mesh_t *mesh)
+{
+  return {&mesh->maskKernel,
+          &mesh->maskPfloatKernel,
+          &mesh->geometricFactorsKernel,
+          &mesh->surfaceGeometricFactorsKernel,
+          &mesh->cubatureGeometricFactorsKernel,
+          &mesh->nStagesSumVectorKernel,
+          &mesh->velocityDirichletKernel,
+          &mesh->surfaceIntegralKernel};
+}
+} // namespace
+
 mesh_t *createMeshMG(mesh_t *_mesh, int Nc)
 {
   mesh_t *mesh = new mesh_t();
   memcpy(mesh, _mesh, sizeof(mesh_t));
 
+  // copied handles are not registered with their kernels, start from empty ones
+  for (auto &&kernel : kernelsMG(mesh))
+    new (kernel) occa::kernel();
+
+  // interleaved geometric factors are per level, not a view of the fine level's
+  new (&mesh->o_ggeoAoSoA) occa::memory();
+  new (&mesh->o_ggeoPfloatAoSoA) occa::memory();
+
   const int cubN = 0;
   meshLoadReferenceNodesHex3D(mesh, Nc, cubN);
 
   const std::string meshPrefix = "pMGmesh-";
   const std::string orderSuffix =  "_" + std::to_string(mesh->N);
 
-  mesh->surfaceIntegralKernel = nullptr;
-  mesh->velocityDirichletKernel = nullptr;
   mesh->geometricFactorsKernel = platform->kernels.get(meshPrefix + "geometricFactorsHex3D" + orderSuffix);
-  mesh->surfaceGeometricFactorsKernel = nullptr;
-  mesh->cubatureGeometricFactorsKernel = nullptr;
-  mesh->nStagesSumVectorKernel = nullptr;
 
   mesh->o_D = platform->device.malloc(mesh->Nq * mesh->Nq * sizeof(dfloat), mesh->D);
 
@@ -375,6 +396,64 @@ mesh_t *createMeshMG(mesh_t *_mesh, int Nc)
   return mesh;
 }
 
+// releases what createMeshMG allocated, everything else is shared with the mesh it was derived from
+void freeMeshMG(mesh_t *mesh)
+{
+  ogsFree(mesh->ogs);
+
+  free(mesh->r);
+  free(mesh->s);
+  free(mesh->t);
+  free(mesh->faceNodes);
+  free(mesh->gllz);
+  free(mesh->gllw);
+  free(mesh->D);
+  free(mesh->DW);
+  free(mesh->interpRaise);
+  free(mesh->interpLower);
+  free(mesh->vertexNodes);
+  free(mesh->edgeNodes);
+
+  free(mesh->x);
+  free(mesh->y);
+  free(mesh->z);
+  free(mesh->vmapM);
+  free(mesh->globalIds);
+  free(mesh->elementList);
+  free(mesh->globalGatherElementList);
+  free(mesh->localGatherElementList);
+
+  mesh->o_D.free();
+  mesh->o_DT.free();
+  mesh->o_gllw.free();
+  mesh->o_faceNodes.free();
+  mesh->o_ggeo.free();
+  mesh->o_ggeoAoSoA.free();
+  mesh->o_x.free();
+  mesh->o_y.free();
+  mesh->o_z.free();
+  mesh->o_elementList.free();
+
+  // empty lists keep the handles of the derived-from mesh
+  if (mesh->NglobalGatherElements)
+    mesh->o_globalGatherElementList.free();
+  if (mesh->NlocalGatherElements)
+    mesh->o_localGatherElementList.free();
+
+  if (!strstr(pfloatString, dfloatString)) {
+    mesh->o_ggeoPfloat.free();
+    mesh->o_ggeoPfloatAoSoA.free();
+    mesh->o_DPfloat.free();
+    mesh->o_DTPfloat.free();
+  }
+
+  for (auto &&kernel : kernelsMG(mesh))
+    *kernel = occa::kernel();
+
+  // shallow copy, members must not be destructed
+  ::operator delete(mesh);
+}
+
 mesh_t *createMeshV(MPI_Comm comm, int N, int cubN, mesh_t *meshT, occa::properties &kernelInfo)
 {
   mesh_t *mesh = new mesh_t();
@@ -17,17 +17,22 @@ void meshSolve(nrs_t* nrs, dfloat time, occa::memory o_U, int stage)
     o_NULL,
     nrs->o_ellipticCoeff);
 
+  auto scope = platform->memoryArena.scope("meshSolve");
+
   occa::memory o_Unew = [&](nrs_t* nrs, dfloat time, int stage) {
     mesh_t *meshT = nrs->_mesh;
 
-    platform->linAlg->fill(nrs->NVfields * nrs->fieldOffset, 0, platform->o_mempool.slice3);
+    auto o_Unew = scope.allocate<dfloat>("Unew", nrs->NVfields * nrs->fieldOffset);
+    auto o_rhs = scope.allocate<dfloat>("rhs", nrs->NVfields * nrs->fieldOffset);
+
+    platform->linAlg->fill(nrs->NVfields * nrs->fieldOffset, 0, o_rhs);
 
     const occa::memory &o_U0 =
         platform->options.compareArgs("MESH INITIAL GUESS", "EXTRAPOLATION") && stage == 1 ? mesh->o_Ue
                                                                                            : mesh->o_U;
-    platform->o_mempool.slice0.copyFrom(o_U0, nrs->NVfields * nrs->fieldOffset * sizeof(dfloat));
-    ellipticSolve(nrs->meshSolver, platform->o_mempool.slice3, platform->o_mempool.slice0);
-    return platform->o_mempool.slice0;
+    o_Unew.copyFrom(o_U0, nrs->NVfields * nrs->fieldOffset * sizeof(dfloat));
+    ellipticSolve(nrs->meshSolver, o_rhs, o_Unew);
+    return o_Unew;
   }(nrs, time, stage);
 
   o_U.copyFrom(o_Unew, nrs->NVfields * nrs->fieldOffset * sizeof(dfloat));
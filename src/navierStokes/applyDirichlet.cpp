@@ -9,7 +9,8 @@ void createZeroNormalMask(nrs_t *nrs, mesh_t *mesh, occa::memory &o_EToB, occa::
   nrs->initializeZeroNormalMaskKernel(mesh->Nlocal, nrs->fieldOffset, o_EToBV, o_mask);
 
   // normal + count (4 fields)
-  auto o_avgNormal = platform->o_mempool.slice0;
+  auto scope = platform->memoryArena.scope("applyDirichlet");
+  auto o_avgNormal = scope.allocate<dfloat>("avgNormal", (nrs->NVfields + 1) * nrs->fieldOffset);
   int bcType = ZERO_NORMAL;
   nrs->averageNormalBcTypeKernel(mesh->Nelements,
                                  nrs->fieldOffset,
@@ -74,7 +75,12 @@ void applyDirichletVelocity(nrs_t *nrs, double time, occa::memory& o_U,occa::mem
 
   mesh_t *mesh = nrs->meshV;
 
-  platform->linAlg->fill((1 + nrs->NVfields) * nrs->fieldOffset, TINY, platform->o_mempool.slice0);
+  // pressure followed by the velocity components
+  auto scope = platform->memoryArena.scope("applyDirichlet");
+  auto o_bcP = scope.allocate<dfloat>("bc", (1 + nrs->NVfields) * nrs->fieldOffset);
+  auto o_bcU = o_bcP + nrs->fieldOffset * sizeof(dfloat);
+
+  platform->linAlg->fill((1 + nrs->NVfields) * nrs->fieldOffset, TINY, o_bcP);
 
   for (int sweep = 0; sweep < 2; sweep++) {
     nrs->pressureDirichletBCKernel(mesh->Nelements,
@@ -91,7 +97,7 @@ void applyDirichletVelocity(nrs_t *nrs, double time, occa::memory& o_U,occa::mem
                                    nrs->o_mue,
                                    nrs->o_usrwrk,
                                    o_Ue,
-                                   platform->o_mempool.slice0);
+                                   o_bcP);
 
     nrs->velocityDirichletBCKernel(mesh->Nelements,
                                    nrs->fieldOffset,
@@ -110,17 +116,17 @@ void applyDirichletVelocity(nrs_t *nrs, double time, occa::memory& o_U,occa::mem
                                    nrs->neknek ? nrs->neknek->o_U : o_NULL,
                                    nrs->o_usrwrk,
                                    o_U,
-                                   platform->o_mempool.slice1);
+                                   o_bcU);
 
     if (sweep == 0)
-      oogs::startFinish(platform->o_mempool.slice0,
+      oogs::startFinish(o_bcP,
                         1 + nrs->NVfields,
                         nrs->fieldOffset,
                         ogsDfloat,
                         ogsMax,
                         nrs->gsh);
     if (sweep == 1)
-      oogs::startFinish(platform->o_mempool.slice0,
+      oogs::startFinish(o_bcP,
                         1 + nrs->NVfields,
                         nrs->fieldOffset,
                         ogsDfloat,
@@ -133,7 +139,7 @@ void applyDirichletVelocity(nrs_t *nrs, double time, occa::memory& o_U,occa::mem
                         0,
                         0,
                         nrs->pSolver->o_maskIds,
-                        platform->o_mempool.slice0,
+                        o_bcP,
                         o_P);
 
   if (nrs->uvwSolver) {
@@ -142,7 +148,7 @@ void applyDirichletVelocity(nrs_t *nrs, double time, occa::memory& o_U,occa::mem
                           0 * nrs->fieldOffset,
                           0 * nrs->fieldOffset,
                           nrs->uvwSolver->o_maskIds,
-                          platform->o_mempool.slice1,
+                          o_bcU,
                           o_U, o_Ue);
     }
   } else {
@@ -151,7 +157,7 @@ void applyDirichletVelocity(nrs_t *nrs, double time, occa::memory& o_U,occa::mem
                           0 * nrs->fieldOffset,
                           0 * nrs->fieldOffset,
                           nrs->uSolver->o_maskIds,
-                          platform->o_mempool.slice1,
+                          o_bcU,
                           o_U, o_Ue);
     }
     if (nrs->vSolver->Nmasked) {
@@ -159,7 +165,7 @@ void applyDirichletVelocity(nrs_t *nrs, double time, occa::memory& o_U,occa::mem
                           1 * nrs->fieldOffset,
                           1 * nrs->fieldOffset,
                           nrs->vSolver->o_maskIds,
-                          platform->o_mempool.slice1,
+                          o_bcU,
                           o_U, o_Ue);
     }
     if (nrs->wSolver->Nmasked) {
@@ -167,7 +173,7 @@ void applyDirichletVelocity(nrs_t *nrs, double time, occa::memory& o_U,occa::mem
                           2 * nrs->fieldOffset,
                           2 * nrs->fieldOffset,
                           nrs->wSolver->o_maskIds,
-                          platform->o_mempool.slice1,
+                          o_bcU,
                           o_U, o_Ue);
     }
   }
@@ -191,7 +197,9 @@ void applyDirichletScalars(nrs_t *nrs, double time, occa::memory& o_S, occa::mem
     auto o_diff_i = cds->o_diff + cds->fieldOffsetScan[is] * sizeof(dfloat);
     auto o_rho_i = cds->o_rho + cds->fieldOffsetScan[is] * sizeof(dfloat);
 
-    platform->linAlg->fill(cds->fieldOffset[is], TINY, platform->o_mempool.slice0);
+    auto scope = platform->memoryArena.scope("applyDirichlet");
+    auto o_bcS = scope.allocate<dfloat>("bc", cds->fieldOffset[is]);
+    platform->linAlg->fill(cds->fieldOffset[is], TINY, o_bcS);
 
     for (int sweep = 0; sweep < 2; sweep++) {
       cds->dirichletBCKernel(mesh->Nelements,
@@ -212,34 +220,39 @@ void applyDirichletScalars(nrs_t *nrs, double time, occa::memory& o_S, occa::mem
                              cds->neknek ? cds->neknek->o_U : o_NULL,
                              cds->neknek ? cds->neknek->o_S : o_NULL,
                              *(cds->o_usrwrk),
-                             platform->o_mempool.slice0);
+                             o_bcS);
 
       if (sweep == 0)
-        oogs::startFinish(platform->o_mempool.slice0, 1, cds->fieldOffset[is], ogsDfloat, ogsMax, gsh);
+        oogs::startFinish(o_bcS, 1, cds->fieldOffset[is], ogsDfloat, ogsMax, gsh);
       if (sweep == 1)
-        oogs::startFinish(platform->o_mempool.slice0, 1, cds->fieldOffset[is], ogsDfloat, ogsMin, gsh);
+        oogs::startFinish(o_bcS, 1, cds->fieldOffset[is], ogsDfloat, ogsMin, gsh);
     }
     occa::memory o_Si =
         o_S.slice(cds->fieldOffsetScan[is] * sizeof(dfloat), cds->fieldOffset[is] * sizeof(dfloat));
     
+
+    // solver may be shared by a multiRHS group where mask ids are ordered by field
+    const dlong maskOffset = -(is - cdsMultiRhsGroupLeader(is)) * cds->solver[is]->fieldOffset;
+    auto o_maskIds = cds->solver[is]->o_maskIds + cds->maskIdsStart[is] * sizeof(dlong);
+
     if(o_Se.isInitialized()){
       occa::memory o_Si_e =
           o_Se.slice(cds->fieldOffsetScan[is] * sizeof(dfloat), cds->fieldOffset[is] * sizeof(dfloat));
 
-      if (cds->solver[is]->Nmasked)
-        cds->maskCopy2Kernel(cds->solver[is]->Nmasked,
-                            0,
-                            0,
-                            cds->solver[is]->o_maskIds,
-                            platform->o_mempool.slice0,
+      if (cds->Nmasked[is])
+        cds->maskCopy2Kernel(cds->Nmasked[is],
+                            maskOffset,
+                            maskOffset,
+                            o_maskIds,
+                            o_bcS,
                             o_Si, o_Si_e);
     } else {
-      if (cds->solver[is]->Nmasked)
-        cds->maskCopyKernel(cds->solver[is]->Nmasked,
-                            0,
-                            0,
-                            cds->solver[is]->o_maskIds,
-                            platform->o_mempool.slice0,
+      if (cds->Nmasked[is])
+        cds->maskCopyKernel(cds->Nmasked[is],
+                            maskOffset,
+                            maskOffset,
+                            o_maskIds,
+                            o_bcS,
                             o_Si);
     }
   }
@@ -253,7 +266,9 @@ void applyDirichletMesh(nrs_t *nrs, double time, occa::memory& o_UM, occa::memor
     applyZeroNormalMask(nrs, mesh, nrs->meshSolver->o_EToB, nrs->o_zeroNormalMaskMeshVelocity, o_UMe);
   }
 
-  platform->linAlg->fill(nrs->NVfields * nrs->fieldOffset, TINY, platform->o_mempool.slice0);
+  auto scope = platform->memoryArena.scope("applyDirichlet");
+  auto o_bcUM = scope.allocate<dfloat>("bc", nrs->NVfields * nrs->fieldOffset);
+  platform->linAlg->fill(nrs->NVfields * nrs->fieldOffset, TINY, o_bcUM);
 
   for (int sweep = 0; sweep < 2; sweep++) {
     mesh->velocityDirichletKernel(mesh->Nelements,
@@ -272,17 +287,17 @@ void applyDirichletMesh(nrs_t *nrs, double time, occa::memory& o_UM, occa::memor
                                   nrs->o_meshMue,
                                   nrs->o_usrwrk,
                                   o_U,
-                                  platform->o_mempool.slice0);
+                                  o_bcUM);
 
     if (sweep == 0)
-      oogs::startFinish(platform->o_mempool.slice0,
+      oogs::startFinish(o_bcUM,
                         nrs->NVfields,
                         nrs->fieldOffset,
                         ogsDfloat,
                         ogsMax,
                         nrs->gshMesh);
     if (sweep == 1)
-      oogs::startFinish(platform->o_mempool.slice0,
+      oogs::startFinish(o_bcUM,
                         nrs->NVfields,
                         nrs->fieldOffset,
                         ogsDfloat,
@@ -295,7 +310,7 @@ void applyDirichletMesh(nrs_t *nrs, double time, occa::memory& o_UM, occa::memor
                         0 * nrs->fieldOffset,
                         0 * nrs->fieldOffset,
                         nrs->meshSolver->o_maskIds,
-                        platform->o_mempool.slice0,
+                        o_bcUM,
                         o_UM, o_UMe);
 }
 
@@ -40,6 +40,9 @@ dfloat computeCFL(nrs_t *nrs)
   if (firstTime)
     setup(nrs);
 
+  auto scope = platform->memoryArena.scope("cfl");
+  auto o_cfl = scope.allocate<dfloat>("cfl", mesh->Nelements);
+
   nrs->cflKernel(mesh->Nelements,
                  nrs->dt[0],
                  mesh->o_vgeo,
@@ -47,10 +50,10 @@ dfloat computeCFL(nrs_t *nrs)
                  nrs->fieldOffset,
                  nrs->o_U,
                  mesh->o_U,
-                 platform->o_mempool.slice0);
+                 o_cfl);
 
   auto scratch = (dfloat *) h_scratch.ptr();
-  platform->o_mempool.slice0.copyTo(scratch, mesh->Nelements * sizeof(dfloat));
+  o_cfl.copyTo(scratch, mesh->Nelements * sizeof(dfloat));
 
   dfloat cfl = 0;
   for (dlong n = 0; n < mesh->Nelements; ++n) {
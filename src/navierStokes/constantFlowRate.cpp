@@ -54,9 +54,11 @@ void compute(nrs_t *nrs, dfloat time) {
 
   double flops = 0.0;
 
+  auto scope = platform->memoryArena.scope("constantFlowRate");
+
   platform->timer.tic("pressure rhs", 1);
-  occa::memory &o_gradPCoeff = platform->o_mempool.slice0;
-  occa::memory &o_Prhs = platform->o_mempool.slice3;
+  occa::memory o_gradPCoeff = scope.allocate<dfloat>("gradPCoeff", nrs->NVfields * nrs->fieldOffset);
+  occa::memory o_Prhs = scope.allocate<dfloat>("Prhs", nrs->fieldOffset);
 
   nrs->setEllipticCoeffPressureKernel(
       mesh->Nlocal, nrs->fieldOffset, nrs->o_rho, nrs->o_ellipticCoeff);
@@ -89,7 +91,7 @@ void compute(nrs_t *nrs, dfloat time) {
 
   // solve homogenous Stokes problem
   platform->timer.tic("velocity rhs", 1);
-  occa::memory &o_RhsVel = platform->o_mempool.slice0;
+  occa::memory o_RhsVel = o_gradPCoeff;
   nrs->gradientVolumeKernel(mesh->Nelements,
       mesh->o_vgeo,
       mesh->o_D,
@@ -104,7 +106,7 @@ void compute(nrs_t *nrs, dfloat time) {
   platform->linAlg->scaleMany(
       mesh->Nlocal, nrs->NVfields, nrs->fieldOffset, -1.0, o_RhsVel);
 
-  occa::memory &o_BF = platform->o_mempool.slice3;
+  occa::memory o_BF = scope.allocate<dfloat>("BF", nrs->NVfields * nrs->fieldOffset);
   o_BF.copyFrom(mesh->o_LMM,
       mesh->Nlocal * sizeof(dfloat),
       0 * nrs->fieldOffset * sizeof(dfloat),
@@ -144,9 +146,12 @@ void compute(nrs_t *nrs, dfloat time) {
     occa::memory o_Ucx = nrs->o_Uc + (0 * sizeof(dfloat)) * nrs->fieldOffset;
     occa::memory o_Ucy = nrs->o_Uc + (1 * sizeof(dfloat)) * nrs->fieldOffset;
     occa::memory o_Ucz = nrs->o_Uc + (2 * sizeof(dfloat)) * nrs->fieldOffset;
-    ellipticSolve(nrs->uSolver, platform->o_mempool.slice0, o_Ucx);
-    ellipticSolve(nrs->vSolver, platform->o_mempool.slice1, o_Ucy);
-    ellipticSolve(nrs->wSolver, platform->o_mempool.slice2, o_Ucz);
+    occa::memory o_RhsVelx = o_RhsVel + (0 * sizeof(dfloat)) * nrs->fieldOffset;
+    occa::memory o_RhsVely = o_RhsVel + (1 * sizeof(dfloat)) * nrs->fieldOffset;
+    occa::memory o_RhsVelz = o_RhsVel + (2 * sizeof(dfloat)) * nrs->fieldOffset;
+    ellipticSolve(nrs->uSolver, o_RhsVelx, o_Ucx);
+    ellipticSolve(nrs->vSolver, o_RhsVely, o_Ucy);
+    ellipticSolve(nrs->wSolver, o_RhsVelz, o_Ucz);
   }
   platform->timer.toc("velocitySolve");
 
@@ -162,6 +167,9 @@ bool checkIfRecompute(nrs_t *nrs, int tstep) {
 
   bool adjustFlowRate = false;
 
+  auto scope = platform->memoryArena.scope("constantFlowRate");
+  occa::memory o_deltaProp = scope.allocate<dfloat>("deltaProp", nPropertyFields * nrs->fieldOffset);
+
   platform->linAlg->axpbyzMany(mesh->Nlocal,
       nPropertyFields,
       nrs->fieldOffset,
@@ -169,12 +177,12 @@ bool checkIfRecompute(nrs_t *nrs, int tstep) {
       nrs->o_prop,
       -1.0,
       nrs->o_prevProp,
-      platform->o_mempool.slice0);
+      o_deltaProp);
 
   const dfloat delta = platform->linAlg->norm2Many(mesh->Nlocal,
       nPropertyFields,
       nrs->fieldOffset,
-      platform->o_mempool.slice0,
+      o_deltaProp,
       platform->comm.mpiComm);
 
   if (delta > TOL) {
@@ -255,8 +263,9 @@ bool adjust(nrs_t *nrs, int tstep, dfloat time) {
       platform->options.getArgs("CONSTANT FLOW FROM BID", fromBID);
       platform->options.getArgs("CONSTANT FLOW TO BID", toBID);
 
-      occa::memory o_centroid = platform->o_mempool.slice0;
-      occa::memory o_counts = platform->o_mempool.slice3;
+      auto scope = platform->memoryArena.scope("constantFlowRate");
+      occa::memory o_centroid = scope.allocate<dfloat>("centroid", mesh->Nelements * mesh->Nfaces * 3);
+      occa::memory o_counts = scope.allocate<dfloat>("counts", mesh->Nelements * mesh->Nfaces);
       platform->linAlg->fill(
           mesh->Nelements * mesh->Nfaces * 3, 0.0, o_centroid);
       platform->linAlg->fill(mesh->Nelements * mesh->Nfaces, 0.0, o_counts);
@@ -408,8 +417,9 @@ bool adjust(nrs_t *nrs, int tstep, dfloat time) {
     nrs->pSolver->resNorm = resNormP;
   }
 
-  occa::memory &o_currentFlowRate = platform->o_mempool.slice0;
-  occa::memory &o_baseFlowRate = platform->o_mempool.slice1;
+  auto scope = platform->memoryArena.scope("constantFlowRate");
+  occa::memory o_currentFlowRate = scope.allocate<dfloat>("currentFlowRate", nrs->fieldOffset);
+  occa::memory o_baseFlowRate = scope.allocate<dfloat>("baseFlowRate", nrs->fieldOffset);
 
   nrs->computeFieldDotNormalKernel(mesh->Nlocal,
       nrs->fieldOffset,
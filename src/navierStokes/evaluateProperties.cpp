@@ -15,8 +15,9 @@ void evaluateProperties(nrs_t *nrs, const double timeNew)
   cds_t *cds = nrs->cds;
 
   if (udf.properties) {
-    occa::memory o_S = platform->o_mempool.slice0;
-    occa::memory o_SProp = platform->o_mempool.slice0;
+    auto scope = platform->memoryArena.scope("properties");
+    occa::memory o_S = scope.allocate<dfloat>("S", nrs->fieldOffset);
+    occa::memory o_SProp = o_S;
     if (nrs->Nscalar) {
       o_S = cds->o_S;
       o_SProp = cds->o_prop;
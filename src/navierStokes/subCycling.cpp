@@ -33,20 +33,25 @@ occa::memory velocitySubCycleMovingMesh(nrs_t* nrs, int nEXT, dfloat time, occa:
   mesh_t* mesh = nrs->meshV;
   linAlg_t* linAlg = platform->linAlg;
 
-  occa::memory &o_p0 = platform->o_mempool.slice0;
-  occa::memory &o_u1 = platform->o_mempool.slice3;
+  const auto N = nrs->NVfields * nrs->fieldOffset;
 
-  occa::memory &o_r1 = platform->o_mempool.slice6;
-  occa::memory &o_r2 = platform->o_mempool.slice9;
-  occa::memory &o_r3 = platform->o_mempool.slice12;
-  occa::memory &o_r4 = platform->o_mempool.slice15;
+  // the subcycled velocity is handed back in the caller's scope
+  occa::memory o_p0 = platform->memoryArena.allocate<dfloat>("subcycled U", N);
 
-  occa::memory &o_LMMe = platform->o_mempool.slice18;
+  auto scope = platform->memoryArena.scope("subCycling");
+  occa::memory o_u1 = scope.allocate<dfloat>("u1", N);
+
+  occa::memory o_r1 = scope.allocate<dfloat>("r1", N);
+  occa::memory o_r2 = scope.allocate<dfloat>("r2", N);
+  occa::memory o_r3 = scope.allocate<dfloat>("r3", N);
+  occa::memory o_r4 = scope.allocate<dfloat>("r4", N);
+
+  occa::memory o_LMMe = scope.allocate<dfloat>("LMMe", nrs->fieldOffset);
 
   // Solve for Each SubProblem
   for (int torder = nEXT - 1; torder >= 0; torder--) {
     // Initialize SubProblem Velocity i.e. Ud = U^(t-torder*dt)
-    dlong toffset = torder * nrs->NVfields * nrs->fieldOffset;
+    dlong toffset = nrs->UHistory.slot(torder) * nrs->NVfields * nrs->fieldOffset;
     const dlong offset = torder * nrs->fieldOffset;
     nrs->subCycleInitU0Kernel(mesh->Nlocal,
         nrs->NVfields,
@@ -241,10 +246,20 @@ occa::memory velocitySubCycle(
   mesh_t *mesh = nrs->meshV;
   linAlg_t *linAlg = platform->linAlg;
 
+  const auto N = nrs->NVfields * nrs->fieldOffset;
+
+  // the subcycled velocity is handed back in the caller's scope
+  occa::memory o_p0 = platform->memoryArena.allocate<dfloat>("subcycled U", N);
+
+  // velocity at the beginning of a substep and the right-hand sides of all RK stages
+  auto scope = platform->memoryArena.scope("subCycling");
+  occa::memory o_u1 = scope.allocate<dfloat>("u1", N);
+  occa::memory o_rhsRK = scope.allocate<dfloat>("rhsRK", nrs->nRK * N);
+
   // Solve for Each SubProblem
   for (int torder = nEXT - 1; torder >= 0; torder--) {
     // Initialize SubProblem Velocity i.e. Ud = U^(t-torder*dt)
-    dlong toffset = torder * nrs->NVfields * nrs->fieldOffset;
+    dlong toffset = nrs->UHistory.slot(torder) * nrs->NVfields * nrs->fieldOffset;
     nrs->subCycleInitU0Kernel(mesh->Nlocal,
         nrs->NVfields,
         nrs->fieldOffset,
@@ -255,7 +270,7 @@ occa::memory velocitySubCycle(
         nrs->coeffBDF[torder],
         mesh->o_LMM,
         o_U,
-        platform->o_mempool.slice0);
+        o_p0);
 
     // Advance subproblem from here from t^(n-torder) to t^(n-torder+1)
     dfloat tsub = time;
@@ -266,10 +281,7 @@ occa::memory velocitySubCycle(
     for (int ststep = 0; ststep < nrs->Nsubsteps; ++ststep) {
       const dfloat tstage = tsub + ststep * sdt;
 
-      platform->o_mempool.slice0.copyFrom(platform->o_mempool.slice0,
-          nrs->NVfields * nrs->fieldOffset * sizeof(dfloat),
-          nrs->NVfields * nrs->fieldOffset * sizeof(dfloat),
-          0);
+      o_u1.copyFrom(o_p0, N * sizeof(dfloat));
 
       for (int rk = 0; rk < nrs->nRK; ++rk) {
         // Extrapolate velocity to subProblem stage time
@@ -311,8 +323,8 @@ occa::memory velocitySubCycle(
                                                     extC[1],
                                                     extC[2],
                                                     nrs->o_Urst,
-                                                    platform->o_mempool.slice0,
-                                                    platform->o_mempool.slice6);
+                                                    o_p0,
+                                                    o_rhsRK);
           else
             nrs->subCycleStrongVolumeKernel(mesh->NglobalGatherElements,
                 mesh->o_globalGatherElementList,
@@ -325,19 +337,11 @@ occa::memory velocitySubCycle(
                 extC[1],
                 extC[2],
                 nrs->o_Urst,
-                platform->o_mempool.slice0,
-                platform->o_mempool.slice6);
+                o_p0,
+                o_rhsRK);
         }
 
-        occa::memory o_rhs;
-        if (rk == 0)
-          o_rhs = platform->o_mempool.slice6;
-        if (rk == 1)
-          o_rhs = platform->o_mempool.slice9;
-        if (rk == 2)
-          o_rhs = platform->o_mempool.slice12;
-        if (rk == 3)
-          o_rhs = platform->o_mempool.slice15;
+        occa::memory o_rhs = o_rhsRK + (rk * sizeof(dfloat)) * N;
 
         oogs::start(o_rhs,
             nrs->NVfields,
@@ -361,8 +365,8 @@ occa::memory velocitySubCycle(
                                                     extC[1],
                                                     extC[2],
                                                     nrs->o_Urst,
-                                                    platform->o_mempool.slice0,
-                                                    platform->o_mempool.slice6);
+                                                    o_p0,
+                                                    o_rhsRK);
           else
             nrs->subCycleStrongVolumeKernel(mesh->NlocalGatherElements,
                 mesh->o_localGatherElementList,
@@ -375,8 +379,8 @@ occa::memory velocitySubCycle(
                 extC[1],
                 extC[2],
                 nrs->o_Urst,
-                platform->o_mempool.slice0,
-                platform->o_mempool.slice6);
+                o_p0,
+                o_rhsRK);
         }
 
         oogs::finish(o_rhs,
@@ -394,9 +398,9 @@ occa::memory velocitySubCycle(
             nrs->fieldOffset,
             nrs->o_coeffsfRK,
             nrs->o_weightsRK,
-            platform->o_mempool.slice3,
-            platform->o_mempool.slice6,
-            platform->o_mempool.slice0);
+            o_u1,
+            o_rhsRK,
+            o_p0);
       }
     }
   }
@@ -406,6 +410,6 @@ occa::memory velocitySubCycle(
       0,
       1.0,
       mesh->o_LMM,
-      platform->o_mempool.slice0);
-  return platform->o_mempool.slice0;
+      o_p0);
+  return o_p0;
 }
@@ -15,19 +15,13 @@
 static void lagFields(nrs_t *nrs)
 {
   // lag velocity
-  for (int s = std::max(nrs->nBDF, nrs->nEXT); s > 1; s--) {
-    const auto Nbyte = (nrs->NVfields * sizeof(dfloat)) * nrs->fieldOffset;
-    nrs->o_U.copyFrom(nrs->o_U, Nbyte, (s - 1) * Nbyte, (s - 2) * Nbyte);
-  }
+  nrs->UHistory.lag(nrs->o_U, (nrs->NVfields * sizeof(dfloat)) * nrs->fieldOffset);
 
   // lag scalars
   if (nrs->Nscalar) {
     auto cds = nrs->cds;
     if(cds->anyEllipticSolver){
-      for (int s = std::max(cds->nBDF, cds->nEXT); s > 1; s--) {
-        const auto Nbyte = cds->fieldOffsetSum * sizeof(dfloat);
-        cds->o_S.copyFrom(cds->o_S, Nbyte, (s - 1) * Nbyte, (s - 2) * Nbyte);
-      }
+      cds->SHistory.lag(cds->o_S, cds->fieldOffsetSum * sizeof(dfloat));
     }
   }
 
@@ -35,10 +29,7 @@ static void lagFields(nrs_t *nrs)
   const bool movingMesh = platform->options.compareArgs("MOVING MESH", "TRUE");
   if (movingMesh) {
     auto mesh = nrs->_mesh;
-    for (int s = std::max(nrs->nEXT, mesh->nAB); s > 1; s--) {
-      const auto Nbyte = (nrs->NVfields * sizeof(dfloat)) * nrs->fieldOffset;
-      mesh->o_U.copyFrom(mesh->o_U, Nbyte, (s - 1) * Nbyte, (s - 2) * Nbyte);
-    }
+    mesh->UHistory.lag(mesh->o_U, (nrs->NVfields * sizeof(dfloat)) * nrs->fieldOffset);
   }
 }
 
@@ -52,6 +43,7 @@ static void extrapolate(nrs_t *nrs)
                            nrs->nEXT,
                            nrs->fieldOffset,
                            nrs->o_coeffEXT,
+                           nrs->UHistory.o_slot(),
                            nrs->o_U,
                            nrs->o_Ue);
 
@@ -73,6 +65,7 @@ static void extrapolate(nrs_t *nrs)
                            nrs->nEXT,
                            nrs->fieldOffset,
                            nrs->o_coeffEXT,
+                           mesh->UHistory.o_slot(),
                            mesh->o_U,
                            mesh->o_Ue);
   }
@@ -85,6 +78,7 @@ static void extrapolate(nrs_t *nrs)
                            cds->nEXT,
                            cds->fieldOffset[0],
                            cds->o_coeffEXT,
+                           cds->SHistory.o_slot(),
                            cds->o_S,
                            cds->o_Se);
   }
@@ -93,36 +87,139 @@ static void extrapolate(nrs_t *nrs)
 static void computeDivUErr(nrs_t *nrs, dfloat &divUErrVolAvg, dfloat &divUErrL2)
 {
   mesh_t *mesh = nrs->meshV;
+
+  auto scope = platform->memoryArena.scope("timeStepper");
+  auto o_divErr = scope.allocate<dfloat>("divErr", nrs->fieldOffset);
+
   nrs->divergenceVolumeKernel(mesh->Nelements,
                               mesh->o_vgeo,
                               mesh->o_D,
                               nrs->fieldOffset,
                               nrs->o_U,
-                              platform->o_mempool.slice0);
+                              o_divErr);
 
   double flops = 18 * (mesh->Np * mesh->Nq + mesh->Np);
   flops *= static_cast<double>(mesh->Nelements);
 
   platform->flopCounter->add("divergenceVolumeKernel", flops);
 
-  oogs::startFinish(platform->o_mempool.slice0, 1, nrs->fieldOffset, ogsDfloat, ogsAdd, nrs->gsh);
-  platform->linAlg->axmy(mesh->Nlocal, 1.0, mesh->o_invLMM, platform->o_mempool.slice0);
+  oogs::startFinish(o_divErr, 1, nrs->fieldOffset, ogsDfloat, ogsAdd, nrs->gsh);
+  platform->linAlg->axmy(mesh->Nlocal, 1.0, mesh->o_invLMM, o_divErr);
 
-  platform->linAlg->axpby(mesh->Nlocal, 1.0, nrs->o_div, -1.0, platform->o_mempool.slice0);
+  platform->linAlg->axpby(mesh->Nlocal, 1.0, nrs->o_div, -1.0, o_divErr);
   divUErrL2 = platform->linAlg->weightedNorm2(mesh->Nlocal,
                                               mesh->o_LMM,
-                                              platform->o_mempool.slice0,
+                                              o_divErr,
                                               platform->comm.mpiComm) /
               sqrt(mesh->volume);
 
   divUErrVolAvg = platform->linAlg->innerProd(mesh->Nlocal,
                                               mesh->o_LMM,
-                                              platform->o_mempool.slice0,
+                                              o_divErr,
                                               platform->comm.mpiComm) /
                   mesh->volume;
   divUErrVolAvg = std::abs(divUErrVolAvg);
 }
 
+// Milne-type estimate of the temporal truncation error: the difference between the BDFk solution
+// and its EXTk predictor scaled by the BDF error constant. The norm matches the residual norm
+// used by the elliptic solvers (invDegree weighted, volume normalized).
+static void estimateTruncationError(nrs_t *nrs)
+{
+  const dfloat errorConstant[] = {1.0 / 2, 2.0 / 9, 3.0 / 22};
+
+  auto adaptive = [](elliptic_t *solver) {
+    return solver && solver->options.compareArgs("LINEAR SOLVER ADAPTIVE TOLERANCE", "TRUE");
+  };
+
+  auto errorNorm = [&](elliptic_t *solver, int order, occa::memory o_u, occa::memory o_ue, dfloat &uNorm) {
+    mesh_t *mesh = solver->mesh;
+    const auto Nfields = solver->Nfields;
+    const auto offset = solver->fieldOffset;
+    auto scope = platform->memoryArena.scope("timeStepper");
+    auto o_err = scope.allocate<dfloat>("err", Nfields * offset);
+
+    platform->linAlg->axpbyzMany(mesh->Nlocal, Nfields, offset, 1.0, o_u, -1.0, o_ue, o_err);
+    const dfloat err = platform->linAlg->weightedNorm2Many(mesh->Nlocal,
+                                                           Nfields,
+                                                           offset,
+                                                           solver->o_invDegree,
+                                                           o_err,
+                                                           platform->comm.mpiComm);
+    uNorm = platform->linAlg->weightedNorm2Many(mesh->Nlocal,
+                                                Nfields,
+                                                offset,
+                                                solver->o_invDegree,
+                                                o_u,
+                                                platform->comm.mpiComm) /
+            sqrt(mesh->volume);
+
+    return errorConstant[std::min(order, 3) - 1] * err / sqrt(mesh->volume);
+  };
+
+  if (nrs->flow) {
+    const int order = std::min(nrs->tstep, nrs->nBDF);
+    dfloat errU2 = 0;
+    dfloat normU2 = 0;
+
+    if (nrs->uvwSolver) {
+      if (adaptive(nrs->uvwSolver) || adaptive(nrs->pSolver)) {
+        dfloat uNorm;
+        const dfloat err = errorNorm(nrs->uvwSolver, order, nrs->o_U, nrs->o_Ue, uNorm);
+        nrs->uvwSolver->truncationError = err;
+        errU2 = err * err;
+        normU2 = uNorm * uNorm;
+      }
+    }
+    else {
+      elliptic_t *solvers[] = {nrs->uSolver, nrs->vSolver, nrs->wSolver};
+      for (int fld = 0; fld < nrs->NVfields; fld++) {
+        if (!adaptive(solvers[fld]) && !adaptive(nrs->pSolver))
+          continue;
+        const auto offset = fld * nrs->fieldOffset * sizeof(dfloat);
+        dfloat uNorm;
+        const dfloat err = errorNorm(solvers[fld], order, nrs->o_U + offset, nrs->o_Ue + offset, uNorm);
+        solvers[fld]->truncationError = err;
+        errU2 += err * err;
+        normU2 += uNorm * uNorm;
+      }
+    }
+
+    // no pressure history, apply the relative velocity error to the pressure magnitude
+    if (adaptive(nrs->pSolver) && normU2 > 0) {
+      mesh_t *mesh = nrs->pSolver->mesh;
+      const dfloat pNorm = platform->linAlg->weightedNorm2(mesh->Nlocal,
+                                                           nrs->pSolver->o_invDegree,
+                                                           nrs->o_P,
+                                                           platform->comm.mpiComm) /
+                           sqrt(mesh->volume);
+      nrs->pSolver->truncationError = sqrt(errU2 / normU2) * pNorm;
+    }
+  }
+
+  if (nrs->Nscalar) {
+    cds_t *cds = nrs->cds;
+    if (!cds->o_Se.isInitialized())
+      return;
+
+    const int order = std::min(nrs->tstep, cds->nBDF);
+    for (int is = 0; is < cds->NSfields; is++) {
+      if (!cds->compute[is] || cds->cvodeSolve[is])
+        continue;
+      elliptic_t *solver = cds->solver[is];
+      // multiRHS groups share one solver
+      if (is > 0 && solver == cds->solver[is - 1])
+        continue;
+      if (!adaptive(solver))
+        continue;
+
+      const auto offset = cds->fieldOffsetScan[is] * sizeof(dfloat);
+      dfloat sNorm;
+      solver->truncationError = errorNorm(solver, order, cds->o_S + offset, cds->o_Se + offset, sNorm);
+    }
+  }
+}
+
 namespace timeStepper {
 
 void advectionFlops(mesh_t *mesh, int Nfields)
@@ -365,6 +462,8 @@ void initStep(nrs_t *nrs, dfloat time, dfloat dt, int tstep)
 
 void finishStep(nrs_t *nrs)
 {
+  estimateTruncationError(nrs);
+
   nrs->dt[2] = nrs->dt[1];
   nrs->dt[1] = nrs->dt[0];
 
@@ -538,7 +637,8 @@ void makeq(nrs_t *nrs, dfloat time, int tstep, occa::memory o_FS, occa::memory o
       platform->flopCounter->add("scalar advectMeshVelocity", flops);
     }
 
-    occa::memory o_Usubcycling = platform->o_mempool.slice0;
+    auto scope = platform->memoryArena.scope("makeq");
+    occa::memory o_Usubcycling;
     if (platform->options.compareArgs("ADVECTION", "TRUE")) {
       if (cds->Nsubsteps) {
         if (movingMesh)
@@ -584,7 +684,8 @@ void makeq(nrs_t *nrs, dfloat time, int tstep, occa::memory o_FS, occa::memory o
       }
     }
     else {
-      platform->linAlg->fill(cds->fieldOffsetSum, 0.0, o_Usubcycling);
+      o_Usubcycling = scope.allocate<dfloat>("Usubcycling", cds->fieldOffset[is]);
+      platform->linAlg->fill(cds->fieldOffset[is], 0.0, o_Usubcycling);
     }
 
     cds->sumMakefKernel(mesh->Nlocal,
@@ -595,6 +696,8 @@ void makeq(nrs_t *nrs, dfloat time, int tstep, occa::memory o_FS, occa::memory o
                         cds->fieldOffsetSum,
                         cds->fieldOffset[is],
                         isOffset,
+                        cds->SHistory.o_slot(),
+                        cds->FSHistory.o_slot(),
                         cds->o_S,
                         o_Usubcycling,
                         o_FS,
@@ -606,10 +709,7 @@ void makeq(nrs_t *nrs, dfloat time, int tstep, occa::memory o_FS, occa::memory o
     platform->flopCounter->add("scalarSumMakef", scalarSumMakef);
   }
 
-  for (int s = std::max(cds->nBDF, cds->nEXT); s > 1; s--) {
-    const auto Nbyte = cds->fieldOffsetSum * sizeof(dfloat);
-    o_FS.copyFrom(o_FS, Nbyte, (s - 1) * Nbyte, (s - 2) * Nbyte);
-  }
+  cds->FSHistory.lag(o_FS, cds->fieldOffsetSum * sizeof(dfloat));
 }
 
 void scalarSolve(nrs_t *nrs, dfloat time, occa::memory o_S, int stage)
@@ -625,21 +725,29 @@ void scalarSolve(nrs_t *nrs, dfloat time, occa::memory o_S, int stage)
     if (!cds->compute[is] || cds->cvodeSolve[is])
       continue;
 
+    // multiRHS group members are solved together with their leader
+    if (cdsMultiRhsGroupLeader(is) != is)
+      continue;
+
     mesh_t *mesh;
     (is) ? mesh = cds->meshV : mesh = cds->mesh[0];
 
-    cds->setEllipticCoeffKernel(mesh->Nlocal,
-                                cds->g0 * cds->idt,
-                                cds->fieldOffsetScan[is],
-                                nrs->fieldOffset,
-                                (cds->o_BFDiag.size()) ? 1 : 0,
-                                cds->o_diff,
-                                cds->o_rho,
-                                cds->o_BFDiag,
-                                cds->o_ellipticCoeff);
+    const int Nfields = cds->solver[is]->Nfields;
+    for (int fld = 0; fld < Nfields; fld++) {
+      cds->setEllipticCoeffKernel(mesh->Nlocal,
+                                  cds->g0 * cds->idt,
+                                  cds->fieldOffsetScan[is + fld],
+                                  Nfields * nrs->fieldOffset,
+                                  (cds->o_BFDiag.size()) ? 1 : 0,
+                                  cds->o_diff,
+                                  cds->o_rho,
+                                  cds->o_BFDiag,
+                                  cds->solver[is]->o_lambda0 + fld * nrs->fieldOffset * sizeof(dfloat));
+    }
 
+    auto scope = platform->memoryArena.scope("scalarSolve");
     occa::memory o_Snew = cdsSolve(is, cds, time, stage);
-    o_Snew.copyTo(o_S, cds->fieldOffset[is] * sizeof(dfloat), cds->fieldOffsetScan[is] * sizeof(dfloat));
+    o_Snew.copyTo(o_S, Nfields * cds->fieldOffset[is] * sizeof(dfloat), cds->fieldOffsetScan[is] * sizeof(dfloat));
   }
   platform->timer.toc("scalarSolve");
 }
@@ -685,7 +793,8 @@ void makef(
     platform->flopCounter->add("velocity advectMeshVelocity", flops);
   }
 
-  occa::memory o_Usubcycling = platform->o_mempool.slice0;
+  auto scope = platform->memoryArena.scope("makef");
+  occa::memory o_Usubcycling;
   if (platform->options.compareArgs("ADVECTION", "TRUE")) {
     if (nrs->Nsubsteps) {
       if (movingMesh)
@@ -694,6 +803,7 @@ void makef(
         o_Usubcycling = velocitySubCycle(nrs, std::min(tstep, nrs->nEXT), time, nrs->o_U);
     }
     else {
+      o_Usubcycling = scope.allocate<dfloat>("advection", nrs->NVfields * nrs->fieldOffset);
       if (platform->options.compareArgs("ADVECTION TYPE", "CUBATURE"))
         nrs->strongAdvectionCubatureVolumeKernel(mesh->Nelements,
                                                  mesh->o_vgeo,
@@ -704,7 +814,7 @@ void makef(
                                                  nrs->cubatureOffset,
                                                  nrs->o_U,
                                                  nrs->o_Urst,
-                                                 platform->o_mempool.slice0);
+                                                 o_Usubcycling);
       else
         nrs->strongAdvectionVolumeKernel(mesh->Nelements,
                                          mesh->o_vgeo,
@@ -712,16 +822,18 @@ void makef(
                                          nrs->fieldOffset,
                                          nrs->o_U,
                                          nrs->o_Urst,
-                                         platform->o_mempool.slice0);
+                                         o_Usubcycling);
 
-      platform->linAlg->axpby(nrs->NVfields * nrs->fieldOffset, -1.0, platform->o_mempool.slice0, 1.0, o_FU);
+      platform->linAlg->axpby(nrs->NVfields * nrs->fieldOffset, -1.0, o_Usubcycling, 1.0, o_FU);
 
       advectionFlops(nrs->meshV, nrs->NVfields);
     }
   }
   else {
-    if (nrs->Nsubsteps)
+    if (nrs->Nsubsteps) {
+      o_Usubcycling = scope.allocate<dfloat>("Usubcycling", nrs->NVfields * nrs->fieldOffset);
       platform->linAlg->fill(nrs->fieldOffset * nrs->NVfields, 0.0, o_Usubcycling);
+    }
   }
 
   nrs->sumMakefKernel(mesh->Nlocal,
@@ -730,6 +842,8 @@ void makef(
                       nrs->o_coeffEXT,
                       nrs->o_coeffBDF,
                       nrs->fieldOffset,
+                      nrs->UHistory.o_slot(),
+                      nrs->FUHistory.o_slot(),
                       nrs->o_U,
                       o_Usubcycling,
                       o_FU,
@@ -756,10 +870,7 @@ void makef(
       printf("BF norm: %.15e\n", debugNorm);
   }
 
-  for (int s = std::max(nrs->nBDF, nrs->nEXT); s > 1; s--) {
-    const auto Nbyte = (nrs->NVfields * sizeof(dfloat)) * nrs->fieldOffset;
-    o_FU.copyFrom(o_FU, Nbyte, (s - 1) * Nbyte, (s - 2) * Nbyte);
-  }
+  nrs->FUHistory.lag(o_FU, (nrs->NVfields * sizeof(dfloat)) * nrs->fieldOffset);
 }
 
 void fluidSolve(nrs_t *nrs, dfloat time, occa::memory o_P, occa::memory o_U, int stage, int tstep)
@@ -767,9 +878,12 @@ void fluidSolve(nrs_t *nrs, dfloat time, occa::memory o_P, occa::memory o_U, int
   mesh_t *mesh = nrs->meshV;
 
   platform->timer.tic("pressureSolve", 1);
-  nrs->setEllipticCoeffPressureKernel(mesh->Nlocal, nrs->fieldOffset, nrs->o_rho, nrs->o_ellipticCoeff);
-  occa::memory o_Pnew = tombo::pressureSolve(nrs, time, stage);
-  o_P.copyFrom(o_Pnew, nrs->fieldOffset * sizeof(dfloat));
+  {
+    auto scope = platform->memoryArena.scope("pressureSolve");
+    nrs->setEllipticCoeffPressureKernel(mesh->Nlocal, nrs->fieldOffset, nrs->o_rho, nrs->o_ellipticCoeff);
+    occa::memory o_Pnew = tombo::pressureSolve(nrs, time, stage);
+    o_P.copyFrom(o_Pnew, nrs->fieldOffset * sizeof(dfloat));
+  }
   platform->timer.toc("pressureSolve");
 
   platform->timer.tic("velocitySolve", 1);
@@ -783,8 +897,11 @@ void fluidSolve(nrs_t *nrs, dfloat time, occa::memory o_P, occa::memory o_U, int
                               o_NULL,
                               nrs->o_ellipticCoeff);
 
-  occa::memory o_Unew = tombo::velocitySolve(nrs, time, stage);
-  o_U.copyFrom(o_Unew, nrs->NVfields * nrs->fieldOffset * sizeof(dfloat));
+  {
+    auto scope = platform->memoryArena.scope("velocitySolve");
+    occa::memory o_Unew = tombo::velocitySolve(nrs, time, stage);
+    o_U.copyFrom(o_Unew, nrs->NVfields * nrs->fieldOffset * sizeof(dfloat));
+  }
 
   platform->timer.toc("velocitySolve");
 
@@ -806,6 +923,17 @@ void printInfo(nrs_t *nrs, dfloat time, int tstep, bool printStepInfo, bool prin
   if (verboseInfo) {
     computeDivUErr(nrs, divUErrVolAvg, divUErrL2);
   }
+
+  auto printAdaptiveTolInfo = [](const std::string &label, elliptic_t *solver) {
+    if (!solver->options.compareArgs("LINEAR SOLVER ADAPTIVE TOLERANCE", "TRUE"))
+      return;
+    printf("%-9s: tol %.2e  truncErr %.2e  iterSaved %d/%lld\n",
+           label.c_str(),
+           solver->tol,
+           solver->truncationError,
+           solver->NiterSaved,
+           solver->NiterSavedSum);
+  };
   if (platform->comm.mpiRank == 0) {
     if (verboseInfo && printVerboseInfo) {
       bool cvodePrinted = false;
@@ -830,6 +958,7 @@ void printInfo(nrs_t *nrs, dfloat time, int tstep, bool printStepInfo, bool prin
                  solver->Niter,
                  solver->res0Norm,
                  solver->resNorm);
+          printAdaptiveTolInfo("tolS" + scalarDigitStr(is), solver);
         } else if (cds->cvodeSolve[is] && !cvodePrinted) {
           nrs->cvode->printInfo(true);
           cvodePrinted = true;
@@ -857,6 +986,7 @@ void printInfo(nrs_t *nrs, dfloat time, int tstep, bool printStepInfo, bool prin
                solver->Niter,
                solver->res0Norm,
                solver->resNorm);
+        printAdaptiveTolInfo("tolP", solver);
 
         if (nrs->uvwSolver) {
           solver = nrs->uvwSolver;
@@ -878,6 +1008,7 @@ void printInfo(nrs_t *nrs, dfloat time, int tstep, bool printStepInfo, bool prin
                  solver->resNorm,
                  divUErrVolAvg,
                  divUErrL2);
+          printAdaptiveTolInfo("tolUVW", solver);
         }
         else {
           solver = nrs->uSolver;
@@ -899,6 +1030,7 @@ void printInfo(nrs_t *nrs, dfloat time, int tstep, bool printStepInfo, bool prin
                  solver->resNorm,
                  divUErrVolAvg,
                  divUErrL2);
+          printAdaptiveTolInfo("tolU", solver);
           solver = nrs->vSolver;
           if (solver->solutionProjection) {
             const int prevVecs = solver->solutionProjection->getPrevNumVecsProjection();
@@ -916,6 +1048,7 @@ void printInfo(nrs_t *nrs, dfloat time, int tstep, bool printStepInfo, bool prin
                  solver->Niter,
                  solver->res0Norm,
                  solver->resNorm);
+          printAdaptiveTolInfo("tolV", solver);
           solver = nrs->wSolver;
           if (solver->solutionProjection) {
             const int prevVecs = solver->solutionProjection->getPrevNumVecsProjection();
@@ -933,6 +1066,7 @@ void printInfo(nrs_t *nrs, dfloat time, int tstep, bool printStepInfo, bool prin
                  solver->Niter,
                  solver->res0Norm,
                  solver->resNorm);
+          printAdaptiveTolInfo("tolW", solver);
         }
       }
 
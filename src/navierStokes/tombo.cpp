@@ -14,16 +14,25 @@ occa::memory pressureSolve(nrs_t* nrs, dfloat time, int stage)
   double flopCount = 0.0;
   mesh_t* mesh = nrs->meshV;
 
+  // the pressure is handed back in the caller's scope
+  occa::memory o_Pnew = platform->memoryArena.allocate<dfloat>("P", nrs->fieldOffset);
+
+  const auto NV = nrs->NVfields * nrs->fieldOffset;
+  auto scope = platform->memoryArena.scope("tombo");
+  occa::memory o_curl = scope.allocate<dfloat>("curl", NV);
+  occa::memory o_rhs = scope.allocate<dfloat>("rhs", NV);
+  occa::memory o_wrk = scope.allocate<dfloat>("wrk", NV);
+
   nrs->curlKernel(mesh->Nelements,
 	                1,
                   mesh->o_vgeo,
                   mesh->o_D,
                   nrs->fieldOffset,
                   nrs->o_Ue,
-                  platform->o_mempool.slice0);
+                  o_curl);
   flopCount += static_cast<double>(mesh->Nelements) * (18 * mesh->Np * mesh->Nq + 36 * mesh->Np);
 
-  oogs::startFinish(platform->o_mempool.slice0, nrs->NVfields, nrs->fieldOffset,ogsDfloat, ogsAdd, nrs->gsh);
+  oogs::startFinish(o_curl, nrs->NVfields, nrs->fieldOffset,ogsDfloat, ogsAdd, nrs->gsh);
 
   platform->linAlg->axmyVector(
     mesh->Nlocal,
@@ -31,7 +40,7 @@ occa::memory pressureSolve(nrs_t* nrs, dfloat time, int stage)
     0,
     1.0,
     nrs->meshV->o_invLMM,
-    platform->o_mempool.slice0
+    o_curl
   );
   flopCount += mesh->Nlocal;
 
@@ -41,8 +50,8 @@ occa::memory pressureSolve(nrs_t* nrs, dfloat time, int stage)
     mesh->o_vgeo,
     mesh->o_D,
     nrs->fieldOffset,
-    platform->o_mempool.slice0,
-    platform->o_mempool.slice3);
+    o_curl,
+    o_rhs);
   flopCount += static_cast<double>(mesh->Nelements) * (18 * mesh->Np * mesh->Nq + 36 * mesh->Np);
 
   nrs->gradientVolumeKernel(
@@ -51,7 +60,7 @@ occa::memory pressureSolve(nrs_t* nrs, dfloat time, int stage)
     mesh->o_D,
     nrs->fieldOffset,
     nrs->o_div,
-    platform->o_mempool.slice0);
+    o_curl);
   flopCount += static_cast<double>(mesh->Nelements) * (6 * mesh->Np * mesh->Nq + 18 * mesh->Np);
 
   if (platform->options.compareArgs("VELOCITY STRESSFORMULATION", "TRUE")) {
@@ -63,7 +72,7 @@ occa::memory pressureSolve(nrs_t* nrs, dfloat time, int stage)
          nrs->o_mue,
          nrs->o_Ue,
          nrs->o_div,
-         platform->o_mempool.slice3);
+         o_rhs);
     flopCount += static_cast<double>(mesh->Nelements) * (18 * mesh->Nq * mesh->Np + 100 * mesh->Np);
   }
 
@@ -76,12 +85,12 @@ occa::memory pressureSolve(nrs_t* nrs, dfloat time, int stage)
     nrs->o_mue,
     o_irho,
     nrs->o_BF,
-    platform->o_mempool.slice3,
-    platform->o_mempool.slice0,
-    platform->o_mempool.slice6);
+    o_rhs,
+    o_curl,
+    o_wrk);
   flopCount += 12 * static_cast<double>(mesh->Nlocal);
 
-  oogs::startFinish(platform->o_mempool.slice6, nrs->NVfields, nrs->fieldOffset,ogsDfloat, ogsAdd, nrs->gsh);
+  oogs::startFinish(o_wrk, nrs->NVfields, nrs->fieldOffset,ogsDfloat, ogsAdd, nrs->gsh);
 
   platform->linAlg->axmyVector(
     mesh->Nlocal,
@@ -89,7 +98,7 @@ occa::memory pressureSolve(nrs_t* nrs, dfloat time, int stage)
     0,
     1.0,
     nrs->meshV->o_invLMM,
-    platform->o_mempool.slice6
+    o_wrk
   );
 
   nrs->wDivergenceVolumeKernel(
@@ -97,8 +106,8 @@ occa::memory pressureSolve(nrs_t* nrs, dfloat time, int stage)
     mesh->o_vgeo,
     mesh->o_D,
     nrs->fieldOffset,
-    platform->o_mempool.slice6,
-    platform->o_mempool.slice3);
+    o_wrk,
+    o_rhs);
   flopCount += static_cast<double>(mesh->Nelements) * (6 * mesh->Np * mesh->Nq + 18 * mesh->Np);
 
   nrs->pressureAddQtlKernel(
@@ -106,7 +115,7 @@ occa::memory pressureSolve(nrs_t* nrs, dfloat time, int stage)
     mesh->o_LMM,
     nrs->g0 * nrs->idt,
     nrs->o_div,
-    platform->o_mempool.slice3);
+    o_rhs);
   flopCount += 3 * mesh->Nlocal;
 
   nrs->divergenceSurfaceKernel(
@@ -116,19 +125,19 @@ occa::memory pressureSolve(nrs_t* nrs, dfloat time, int stage)
     nrs->o_EToB,
     nrs->g0 * nrs->idt,
     nrs->fieldOffset,
-    platform->o_mempool.slice6,
+    o_wrk,
     nrs->o_U,
-    platform->o_mempool.slice3);
+    o_rhs);
   flopCount += 25 * static_cast<double>(mesh->Nelements) * mesh->Nq * mesh->Nq;
 
   platform->timer.toc("pressure rhs");
 
-  platform->o_mempool.slice1.copyFrom(nrs->o_P, mesh->Nlocal * sizeof(dfloat));
-  ellipticSolve(nrs->pSolver, platform->o_mempool.slice3, platform->o_mempool.slice1);
+  o_Pnew.copyFrom(nrs->o_P, mesh->Nlocal * sizeof(dfloat));
+  ellipticSolve(nrs->pSolver, o_rhs, o_Pnew);
 
   platform->flopCounter->add("pressure RHS", flopCount);
 
-  return platform->o_mempool.slice1;
+  return o_Pnew;
 }
 
 occa::memory velocitySolve(nrs_t* nrs, dfloat time, int stage)
@@ -137,18 +146,25 @@ occa::memory velocitySolve(nrs_t* nrs, dfloat time, int stage)
   double flopCount = 0.0;
   mesh_t* mesh = nrs->meshV;
 
+  // the velocity is handed back in the caller's scope
+  const auto NV = nrs->NVfields * nrs->fieldOffset;
+  occa::memory o_Unew = platform->memoryArena.allocate<dfloat>("U", NV);
+
+  auto scope = platform->memoryArena.scope("tombo");
+  occa::memory o_rhs = scope.allocate<dfloat>("rhs", NV);
+
   platform->linAlg->axmyz(mesh->Nlocal,
                           (platform->options.compareArgs("VELOCITY STRESSFORMULATION", "TRUE")) ? -2. / 3
                                                                                                 : 1. / 3,
                           nrs->o_mue,
                           nrs->o_div,
-                          platform->o_mempool.slice3);
+                          o_rhs);
   nrs->gradientVolumeKernel(mesh->Nelements,
                             mesh->o_vgeo,
                             mesh->o_D,
                             nrs->fieldOffset,
-                            platform->o_mempool.slice3,
-                            platform->o_mempool.slice0);
+                            o_rhs,
+                            o_Unew);
   flopCount += static_cast<double>(mesh->Nelements) * (6 * mesh->Np * mesh->Nq + 18 * mesh->Np);
 
   bool weakPressure = true;
@@ -159,13 +175,13 @@ occa::memory velocitySolve(nrs_t* nrs, dfloat time, int stage)
                                mesh->o_D,
                                nrs->fieldOffset,
                                nrs->o_P,
-                               platform->o_mempool.slice3);
+                               o_rhs);
 
     platform->linAlg->axpby(nrs->NVfields * nrs->fieldOffset,
                             1.0,
-                            platform->o_mempool.slice3,
+                            o_rhs,
                             1.0,
-                            platform->o_mempool.slice0);
+                            o_Unew);
   }
   else {
     nrs->gradientVolumeKernel(mesh->Nelements,
@@ -173,13 +189,13 @@ occa::memory velocitySolve(nrs_t* nrs, dfloat time, int stage)
                               mesh->o_D,
                               nrs->fieldOffset,
                               nrs->o_P,
-                              platform->o_mempool.slice3);
+                              o_rhs);
 
     platform->linAlg->axpby(nrs->NVfields * nrs->fieldOffset,
                             -1.0,
-                            platform->o_mempool.slice3,
+                            o_rhs,
                             1.0,
-                            platform->o_mempool.slice0);
+                            o_Unew);
   }
   flopCount += static_cast<double>(mesh->Nelements) * 18 * (mesh->Np * mesh->Nq + mesh->Np);
 
@@ -197,7 +213,7 @@ occa::memory velocitySolve(nrs_t* nrs, dfloat time, int stage)
                                nrs->o_mue,
                                nrs->o_usrwrk,
                                nrs->o_Ue,
-                               platform->o_mempool.slice0);
+                               o_Unew);
 
   flopCount += static_cast<double>(mesh->Nelements) * (3 * mesh->Np + 36 * mesh->Nq * mesh->Nq);
 
@@ -205,32 +221,37 @@ occa::memory velocitySolve(nrs_t* nrs, dfloat time, int stage)
     mesh->Nlocal,
     nrs->fieldOffset,
     nrs->o_BF,
-    platform->o_mempool.slice0,
+    o_Unew,
     nrs->o_rho,
-    platform->o_mempool.slice3);
+    o_rhs);
 
   flopCount += 6 * mesh->Nlocal;
 
   platform->timer.toc("velocity rhs");
-  platform->o_mempool.slice0.copyFrom(nrs->o_U, nrs->NVfields * nrs->fieldOffset * sizeof(dfloat));
+  o_Unew.copyFrom(nrs->o_U, nrs->NVfields * nrs->fieldOffset * sizeof(dfloat));
 
   occa::memory o_U0;
   o_U0 = platform->options.compareArgs("VELOCITY INITIAL GUESS", "EXTRAPOLATION") && stage == 1 ? nrs->o_Ue
                                                                                                 : nrs->o_U;
 
-  platform->o_mempool.slice0.copyFrom(o_U0, nrs->NVfields * nrs->fieldOffset * sizeof(dfloat));
+  o_Unew.copyFrom(o_U0, nrs->NVfields * nrs->fieldOffset * sizeof(dfloat));
 
   if(nrs->uvwSolver) {
-    ellipticSolve(nrs->uvwSolver, platform->o_mempool.slice3, platform->o_mempool.slice0);
+    ellipticSolve(nrs->uvwSolver, o_rhs, o_Unew);
   } else {
-    ellipticSolve(nrs->uSolver, platform->o_mempool.slice3, platform->o_mempool.slice0);
-    ellipticSolve(nrs->vSolver, platform->o_mempool.slice4, platform->o_mempool.slice1);
-    ellipticSolve(nrs->wSolver, platform->o_mempool.slice5, platform->o_mempool.slice2);
+    const auto fieldOffsetByte = nrs->fieldOffset * sizeof(dfloat);
+    ellipticSolve(nrs->uSolver, o_rhs, o_Unew);
+    occa::memory o_rhsV = o_rhs + 1 * fieldOffsetByte;
+    occa::memory o_V = o_Unew + 1 * fieldOffsetByte;
+    ellipticSolve(nrs->vSolver, o_rhsV, o_V);
+    occa::memory o_rhsW = o_rhs + 2 * fieldOffsetByte;
+    occa::memory o_W = o_Unew + 2 * fieldOffsetByte;
+    ellipticSolve(nrs->wSolver, o_rhsW, o_W);
   }
 
   platform->flopCounter->add("velocity RHS", flopCount);
 
-  return platform->o_mempool.slice0;
+  return o_Unew;
 }
 
 } // namespace
@@ -938,16 +938,16 @@ void copyToNek(dfloat time)
 
 void ocopyToNek(void)
 {
-  nrs->o_U.copyTo(nrs->U);
+  nrs->o_U.copyTo(nrs->U, (nrs->NVfields * sizeof(dfloat)) * nrs->fieldOffset);
   nrs->o_P.copyTo(nrs->P);
   if (nrs->Nscalar) {
-    nrs->cds->o_S.copyTo(nrs->cds->S);
+    nrs->cds->o_S.copyTo(nrs->cds->S, nrs->cds->fieldOffsetSum * sizeof(dfloat));
   }
   if (platform->options.compareArgs("MOVING MESH", "TRUE")) {
     mesh_t *mesh = nrs->meshV;
     if (nrs->cht)
       mesh = nrs->cds->mesh[0];
-    mesh->o_U.copyTo(mesh->U);
+    mesh->o_U.copyTo(mesh->U, (nrs->NVfields * sizeof(dfloat)) * nrs->fieldOffset);
     mesh->o_x.copyTo(mesh->x);
     mesh->o_y.copyTo(mesh->y);
     mesh->o_z.copyTo(mesh->z);
@@ -964,16 +964,16 @@ void ocopyToNek(dfloat time, int tstep)
     mesh->o_z.copyTo(mesh->z);
   }
 
-  nrs->o_U.copyTo(nrs->U);
+  nrs->o_U.copyTo(nrs->U, (nrs->NVfields * sizeof(dfloat)) * nrs->fieldOffset);
   nrs->o_P.copyTo(nrs->P);
   if (nrs->Nscalar) {
-    nrs->cds->o_S.copyTo(nrs->cds->S);
+    nrs->cds->o_S.copyTo(nrs->cds->S, nrs->cds->fieldOffsetSum * sizeof(dfloat));
   }
   if (platform->options.compareArgs("MOVING MESH", "TRUE")) {
     mesh_t *mesh = nrs->meshV;
     if (nrs->cht)
       mesh = nrs->cds->mesh[0];
-    mesh->o_U.copyTo(mesh->U);
+    mesh->o_U.copyTo(mesh->U, (nrs->NVfields * sizeof(dfloat)) * nrs->fieldOffset);
     mesh->o_x.copyTo(mesh->x);
     mesh->o_y.copyTo(mesh->y);
     mesh->o_z.copyTo(mesh->z);
@@ -991,9 +991,9 @@ void ocopyFromNek(dfloat &time)
 {
   copyFromNek(time);
   nrs->o_P.copyFrom(nrs->P);
-  nrs->o_U.copyFrom(nrs->U);
+  nrs->o_U.copyFrom(nrs->U, (nrs->NVfields * sizeof(dfloat)) * nrs->fieldOffset);
   if (nrs->Nscalar) {
-    nrs->cds->o_S.copyFrom(nrs->cds->S);
+    nrs->cds->o_S.copyFrom(nrs->cds->S, nrs->cds->fieldOffsetSum * sizeof(dfloat));
   }
   if (platform->options.compareArgs("MOVING MESH", "TRUE")) {
     mesh_t *mesh = nrs->meshV;
@@ -1002,7 +1002,7 @@ void ocopyFromNek(dfloat &time)
     mesh->o_x.copyFrom(mesh->x);
     mesh->o_y.copyFrom(mesh->y);
     mesh->o_z.copyFrom(mesh->z);
-    mesh->o_U.copyFrom(mesh->U);
+    mesh->o_U.copyFrom(mesh->U, (nrs->NVfields * sizeof(dfloat)) * nrs->fieldOffset);
   }
 }
 
@@ -371,6 +371,7 @@ neknek_t::neknek_t(nrs_t *nrs, dlong _nsessions, dlong _sessionID)
 
   this->coeffEXT.resize(this->nEXT);
   this->o_coeffEXT = platform->device.malloc(this->nEXT * sizeof(dfloat));
+  this->history = lagHistory_t(this->nEXT + 1, true);
 
   neknekSetup(nrs);
 
@@ -406,17 +407,26 @@ void neknek_t::updateBoundary(nrs_t *nrs, int tstep, int stage)
 
   platform->timer.tic("neknek exchange", 1);
 
-  this->interpolator->eval(nrs->NVfields, nrs->fieldOffset, nrs->o_U, this->fieldOffset, this->o_U);
+  // lag state by interpolating into the slot of the oldest level
+  if (stage == 1)
+    this->history.rotate();
+  const int level = (stage == 1) ? 1 : 0;
+
+  const auto NbyteU = nrs->NVfields * this->fieldOffset * sizeof(dfloat);
+  auto o_Unew = this->history.level(this->o_U, NbyteU, level);
+  this->interpolator->eval(nrs->NVfields, nrs->fieldOffset, nrs->o_U, this->fieldOffset, o_Unew);
 
   if (this->Nscalar) {
+    const auto NbyteS = this->Nscalar * this->fieldOffset * sizeof(dfloat);
+    auto o_Snew = this->history.level(this->o_S, NbyteS, level);
     this->interpolator->eval(this->Nscalar,
       nrs->fieldOffset,
       nrs->cds->o_S,
       this->fieldOffset,
-      this->o_S);
+      o_Snew);
   }
 
-  // lag state, update timestepper coefficients and compute extrapolated state
+  // update timestepper coefficients and compute extrapolated state
   if (stage == 1) {
     auto *mesh = nrs->meshV;
     int extOrder = std::min(tstep, this->nEXT);
@@ -428,16 +438,8 @@ void neknek_t::updateBoundary(nrs_t *nrs, int tstep, int stage)
 
     this->o_coeffEXT.copyFrom(this->coeffEXT.data(), this->nEXT * sizeof(dfloat));
 
-    for (int s = this->nEXT + 1; s > 1; s--) {
-      auto Nbyte = nrs->NVfields * this->fieldOffset * sizeof(dfloat);
-      this->o_U.copyFrom(this->o_U, Nbyte, (s - 1) * Nbyte, (s - 2) * Nbyte);
-
-      Nbyte = this->Nscalar * this->fieldOffset * sizeof(dfloat);
-      this->o_S.copyFrom(this->o_S, Nbyte, (s - 1) * Nbyte, (s - 2) * Nbyte);
-    }
-
-    auto o_Uold = this->o_U + this->fieldOffset * nrs->NVfields * sizeof(dfloat);
-    auto o_Sold = this->o_S + this->fieldOffset * this->Nscalar * sizeof(dfloat);
+    // slots of levels 1, ..., nEXT
+    auto o_slotOld = this->history.o_slot() + sizeof(int);
 
     if(this->npt){
       nrs->extrapolateKernel(this->npt,
@@ -445,7 +447,8 @@ void neknek_t::updateBoundary(nrs_t *nrs, int tstep, int stage)
                              this->nEXT,
                              this->fieldOffset,
                              this->o_coeffEXT,
-                             o_Uold,
+                             o_slotOld,
+                             this->o_U,
                              this->o_U);
     }
 
@@ -455,7 +458,8 @@ void neknek_t::updateBoundary(nrs_t *nrs, int tstep, int stage)
                              this->nEXT,
                              this->fieldOffset,
                              this->o_coeffEXT,
-                             o_Sold,
+                             o_slotOld,
+                             this->o_S,
                              this->o_S);
     }
   }
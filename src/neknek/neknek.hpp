@@ -5,6 +5,7 @@
 #include "nrssys.hpp"
 #include "findpts.hpp"
 #include "pointInterpolation.hpp"
+#include "lagHistory.hpp"
 #include <vector>
 #include <memory>
 
@@ -31,8 +32,10 @@ public:
   std::vector<dlong> pointMap;
   occa::memory o_pointMap;
 
+  // level 0 holds the boundary values, levels 1..nEXT the interpolated history
   occa::memory o_U;
   occa::memory o_S;
+  lagHistory_t history;
 
   occa::memory o_x;
   occa::memory o_y;
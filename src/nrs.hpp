@@ -78,6 +78,7 @@ struct nrs_t {
 
   dfloat *U, *P;
   occa::memory o_U, o_P;
+  lagHistory_t UHistory;
 
   occa::memory o_Ue;
 
@@ -93,6 +94,7 @@ struct nrs_t {
 
   occa::memory o_BF;
   occa::memory o_FU;
+  lagHistory_t FUHistory;
 
   occa::memory o_prop, o_ellipticCoeff;
 
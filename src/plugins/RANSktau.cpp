@@ -142,9 +142,10 @@ void RANSktau::updateSourceTerms()
   mesh_t *mesh = nrs->meshV;
   cds_t *cds = nrs->cds;
 
-  occa::memory o_OiOjSk = platform->o_mempool.slice0;
-  occa::memory o_SijMag2 = platform->o_mempool.slice1;
-  occa::memory o_SijOij = platform->o_mempool.slice2;
+  auto scope = platform->memoryArena.scope("RANSktau");
+  occa::memory o_OiOjSk = scope.allocate<dfloat>("OiOjSk", nrs->fieldOffset);
+  occa::memory o_SijMag2 = scope.allocate<dfloat>("SijMag2", nrs->fieldOffset);
+  occa::memory o_SijOij = scope.allocate<dfloat>("SijOij", 3 * nrs->NVfields * nrs->fieldOffset);
 
   occa::memory o_FS = cds->o_FS + cds->fieldOffsetScan[kFieldIndex] * sizeof(dfloat);
   occa::memory o_BFDiag = cds->o_BFDiag + cds->fieldOffsetScan[kFieldIndex] * sizeof(dfloat);
@@ -88,25 +88,29 @@ void lowMach::qThermalSingleComponent(dfloat time, occa::memory& o_div)
     }
   }
 
+  auto arenaScope = platform->memoryArena.scope("lowMach");
+  occa::memory o_gradS = arenaScope.allocate<dfloat>("gradS", nrs->NVfields * nrs->fieldOffset);
+  occa::memory o_src = arenaScope.allocate<dfloat>("sEqnSource", nrs->fieldOffset);
+
   nrs->gradientVolumeKernel(mesh->Nelements,
                             mesh->o_vgeo,
                             mesh->o_D,
                             nrs->fieldOffset,
                             cds->o_S,
-                            platform->o_mempool.slice0);
+                            o_gradS);
 
   double flopsGrad = 6 * mesh->Np * mesh->Nq + 18 * mesh->Np;
   flopsGrad *= static_cast<double>(mesh->Nelements);
 
-  oogs::startFinish(platform->o_mempool.slice0, nrs->NVfields, nrs->fieldOffset, ogsDfloat, ogsAdd, nrs->gsh);
+  oogs::startFinish(o_gradS, nrs->NVfields, nrs->fieldOffset, ogsDfloat, ogsAdd, nrs->gsh);
 
   platform->linAlg
-      ->axmyVector(mesh->Nlocal, nrs->fieldOffset, 0, 1.0, nrs->meshV->o_invLMM, platform->o_mempool.slice0);
+      ->axmyVector(mesh->Nlocal, nrs->fieldOffset, 0, 1.0, nrs->meshV->o_invLMM, o_gradS);
 
-  platform->linAlg->fill(mesh->Nelements * mesh->Np, 0.0, platform->o_mempool.slice3);
+  platform->linAlg->fill(mesh->Nelements * mesh->Np, 0.0, o_src);
   if (udf.sEqnSource) {
     platform->timer.tic(scope + "udfSEqnSource", 1);
-    udf.sEqnSource(nrs, time, cds->o_S, platform->o_mempool.slice3);
+    udf.sEqnSource(nrs, time, cds->o_S, o_src);
     platform->timer.toc(scope + "udfSEqnSource");
   }
 
@@ -114,11 +118,11 @@ void lowMach::qThermalSingleComponent(dfloat time, occa::memory& o_div)
             mesh->o_vgeo,
             mesh->o_D,
             nrs->fieldOffset,
-            platform->o_mempool.slice0,
+            o_gradS,
             o_beta,
             cds->o_diff,
             cds->o_rho,
-            platform->o_mempool.slice3,
+            o_src,
             o_div);
 
   double flopsQTL = 18 * mesh->Np * mesh->Nq + 23 * mesh->Np;
@@ -137,8 +141,12 @@ void lowMach::qThermalSingleComponent(dfloat time, occa::memory& o_div)
 
     const dlong Nlocal = mesh->Nlocal;
 
-    linAlg->axmyz(Nlocal, 1.0, mesh->o_LMM, o_div, platform->o_mempool.slice0);
-    const dfloat termQ = linAlg->sum(Nlocal, platform->o_mempool.slice0, platform->comm.mpiComm);
+    // o_gradS is not needed anymore
+    occa::memory o_wrk0 = o_gradS;
+    occa::memory o_wrk1 = o_gradS + nrs->fieldOffset * sizeof(dfloat);
+
+    linAlg->axmyz(Nlocal, 1.0, mesh->o_LMM, o_div, o_wrk0);
+    const dfloat termQ = linAlg->sum(Nlocal, o_wrk0, platform->comm.mpiComm);
 
     surfaceFluxKernel(mesh->Nelements,
                       mesh->o_sgeo,
@@ -146,12 +154,12 @@ void lowMach::qThermalSingleComponent(dfloat time, occa::memory& o_div)
                       nrs->o_EToB,
                       nrs->fieldOffset,
                       rhsCVODE ? nrs->o_U : nrs->o_Ue,
-                      platform->o_mempool.slice0);
+                      o_wrk0);
 
     double surfaceFluxFlops = 13 * mesh->Nq * mesh->Nq;
     surfaceFluxFlops *= static_cast<double>(mesh->Nelements);
 
-    platform->o_mempool.slice0.copyTo(h_scratch.ptr(), mesh->Nelements * sizeof(dfloat));
+    o_wrk0.copyTo(h_scratch.ptr(), mesh->Nelements * sizeof(dfloat));
     auto scratch = (dfloat *) h_scratch.ptr();
 
     dfloat termV = 0.0;
@@ -167,14 +175,14 @@ void lowMach::qThermalSingleComponent(dfloat time, occa::memory& o_div)
                      o_kappa,
                      cds->o_rho,
                      nrs->meshV->o_LMM,
-                     platform->o_mempool.slice0,
-                     platform->o_mempool.slice1);
+                     o_wrk0,
+                     o_wrk1);
 
     double p0thHelperFlops = 4 * mesh->Nlocal;
 
     const dfloat prhs =
-        (termQ - termV) / linAlg->sum(Nlocal, platform->o_mempool.slice0, platform->comm.mpiComm);
-    linAlg->axpby(Nlocal, -prhs, platform->o_mempool.slice1, 1.0, o_div);
+        (termQ - termV) / linAlg->sum(Nlocal, o_wrk0, platform->comm.mpiComm);
+    linAlg->axpby(Nlocal, -prhs, o_wrk1, 1.0, o_div);
 
     const auto *coeff = rhsCVODE ? nrs->cvode->coeffBDF() : nrs->coeffBDF;
     dfloat Saqpq = 0.0;
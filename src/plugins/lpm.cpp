@@ -48,6 +48,7 @@ lpm_t::lpm_t(nrs_t *nrs_, dfloat bb_tol_, dfloat newton_tol_)
   dtEXT.resize(nEXT + 1);
   coeffEXT.resize(nEXT);
   o_coeffEXT = platform->device.malloc(nEXT * sizeof(dfloat));
+  interpFieldHistory = lagHistory_t(nEXT, false);
 
   coeffRK.resize(std::max(solverOrder, bootstrapRKOrder));
   o_coeffRK = platform->device.malloc(coeffRK.size() * sizeof(dfloat));
@@ -467,8 +468,10 @@ void lpm_t::integrate(dfloat tf)
   if (time >= tf) {
     for (auto [fieldName, o_field] : laggedInterpFields) {
       const auto Nfields = numFieldsInterp(fieldName);
+      const auto Nbyte = (Nfields * sizeof(dfloat)) * nrs->fieldOffset;
       auto o_currentField = interpFieldInputs.at(fieldName);
-      o_field.copyFrom(o_currentField, Nfields * nrs->fieldOffset * sizeof(dfloat));
+      auto o_newest = interpFieldHistory.level(o_field, Nbyte, 0);
+      o_newest.copyFrom(o_currentField, Nbyte);
     }
 
     if (timerLevel != TimerLevel::None) {
@@ -492,7 +495,7 @@ void lpm_t::integrate(dfloat tf)
     const auto Nfields = numFieldsInterp(fieldName);
     const auto Nbyte = (Nfields * sizeof(dfloat)) * nrs->fieldOffset;
     auto o_extField = extrapolatedInterpFields.at(fieldName);
-    o_extField.copyFrom(o_field, Nfields * nrs->fieldOffset * sizeof(dfloat));
+    o_extField.copyFrom(interpFieldHistory.level(o_field, Nbyte, 0), Nbyte);
   }
 
   // set EXT dt's
@@ -523,18 +526,17 @@ void lpm_t::integrate(dfloat tf)
   dtEXT[1] = tf - time;
   time = tf;
 
-  // lag previous time states in laggedInterpFields
+  // lag previous time states in laggedInterpFields, the oldest slot receives the most recent one
+  interpFieldHistory.rotate();
   for (auto [fieldName, o_field] : laggedInterpFields) {
     const auto Nfields = numFieldsInterp(fieldName);
     const auto Nbyte = (Nfields * sizeof(dfloat)) * nrs->fieldOffset;
-    for (int s = nEXT; s > 1; s--) {
-      o_field.copyFrom(o_field, Nbyte, (s - 1) * Nbyte, (s - 2) * Nbyte);
-    }
 
     auto o_currentField = interpFieldInputs.at(fieldName);
 
     // update most recent time state
-    o_field.copyFrom(o_currentField, Nfields * nrs->fieldOffset * sizeof(dfloat));
+    auto o_newest = interpFieldHistory.level(o_field, Nbyte, 0);
+    o_newest.copyFrom(o_currentField, Nbyte);
   }
 
   // always provide (t^n,y^n) for next step
@@ -581,7 +583,14 @@ void lpm_t::extrapolateFluidState(dfloat tEXT)
   for (auto [fieldName, o_field] : laggedInterpFields) {
     const auto Nfields = numFieldsInterp(fieldName);
     auto o_extField = extrapolatedInterpFields.at(fieldName);
-    nrs->extrapolateKernel(mesh->Nlocal, Nfields, nEXT, nrs->fieldOffset, o_coeffEXT, o_field, o_extField);
+    nrs->extrapolateKernel(mesh->Nlocal,
+                           Nfields,
+                           nEXT,
+                           nrs->fieldOffset,
+                           o_coeffEXT,
+                           interpFieldHistory.o_slot(),
+                           o_field,
+                           o_extField);
   }
 }
 
@@ -8,6 +8,7 @@
 #include <string>
 #include <map>
 #include "pointInterpolation.hpp"
+#include "lagHistory.hpp"
 
 class nrs_t;
 
@@ -385,6 +386,7 @@ private:
 
   // History of interpolated fields
   std::map<std::string, occa::memory> laggedInterpFields;
+  lagHistory_t interpFieldHistory;
 
   // Hold extrapolated state during a particle integration
   std::map<std::string, occa::memory> extrapolatedInterpFields;
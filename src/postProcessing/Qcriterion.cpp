@@ -5,7 +5,8 @@
 
 void postProcessing::Qcriterion(nrs_t *nrs, occa::memory& o_Q)
 {
-  occa::memory o_SijOij = platform->o_mempool.slice2;
+  auto scope = platform->memoryArena.scope("Qcriterion");
+  occa::memory o_SijOij = scope.allocate<dfloat>("SijOij", 3 * nrs->NVfields * nrs->fieldOffset);
   strainRotationRate(nrs, true, true, o_SijOij); 
 
   auto kernel = platform->kernels.get("Qcriterion");
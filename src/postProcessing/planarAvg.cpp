@@ -125,18 +125,9 @@ void fusedPlanarAvg(nrs_t *nrs, const std::string & direction, int NELGX, int NE
   }
 
   const auto Nwords = nflds * mesh->Nq * elemDir;
-  const auto Nbytes = Nwords * sizeof(dfloat);
 
-  if (platform->o_mempool.bytesAllocated < Nbytes) {
-    // compute minimum number of fields holding nrs->fieldOffset dfloat elements
-    auto Nfields = Nwords / nrs->fieldOffset;
-    if (Nwords % nrs->fieldOffset)
-      Nfields++;
-
-    platform->create_mempool(nrs->fieldOffset, Nfields);
-  }
-
-  auto &o_scratch = platform->o_mempool.o_ptr;
+  auto scope = platform->memoryArena.scope("planarAvg");
+  auto o_scratch = scope.allocate<dfloat>("planar values", Nwords);
 
   if(o_locToGlobE.size() == 0){
     std::vector<dlong> globalElement(mesh->Nelements, 0);
@@ -25,6 +25,7 @@ static occa::memory o_s;
 static occa::memory o_t;
 static std::vector<occa::memory> o_diff0;
 static std::vector<occa::memory> o_filterMT;
+static occa::memory o_aliasedUrst;
 
 static double cachedDt = -1.0;
 static bool recomputeUrst = false;
@@ -99,11 +100,14 @@ occa::memory computeEps(nrs_t *nrs, const dfloat time, const dlong scalarIndex,
 
   mesh_t *mesh = cds->mesh[scalarIndex];
 
-  occa::memory &o_logRelativeMassHighestMode = platform->o_mempool.slice0;
-  occa::memory &o_filteredField = platform->o_mempool.slice1;
-  occa::memory &o_hpfResidual = platform->o_mempool.slice2;
-  occa::memory &o_epsilon = platform->o_mempool.slice5;
-  occa::memory &o_aliasedUrst = platform->o_mempool.slice6;
+  // artificial viscosity is handed back in the caller's scope
+  const auto N = cds->fieldOffset[scalarIndex];
+  occa::memory o_epsilon = platform->memoryArena.allocate<dfloat>("epsilon", N);
+
+  auto scope = platform->memoryArena.scope("avm");
+  occa::memory o_logRelativeMassHighestMode = scope.allocate<dfloat>("logRelativeMassHighestMode", N);
+  occa::memory o_filteredField = scope.allocate<dfloat>("filteredField", N);
+  occa::memory o_hpfResidual = scope.allocate<dfloat>("hpfResidual", N);
 
   // artificial viscosity magnitude
   platform->linAlg->fill(cds->fieldOffset[scalarIndex], 0.0, o_epsilon);
@@ -127,6 +131,10 @@ occa::memory computeEps(nrs_t *nrs, const dfloat time, const dlong scalarIndex,
 
     occa::memory o_rhoField = cds->o_rho + cds->fieldOffsetScan[scalarIndex] * sizeof(dfloat);
 
+    // kept across calls, all scalars share it within a time step
+    if (!o_aliasedUrst.isInitialized())
+      o_aliasedUrst = platform->device.malloc((nrs->NVfields * sizeof(dfloat)) * nrs->fieldOffset);
+
     if (recomputeUrst) {
       nrs->UrstKernel(cds->meshV->Nelements,
                       cds->meshV->o_vgeo,
@@ -224,6 +232,7 @@ void apply(nrs_t *nrs, const dfloat time, const dlong scalarIndex, occa::memory
                          cds->fieldOffsetScan[scalarIndex] * sizeof(dfloat));
   }
 
+  auto scope = platform->memoryArena.scope("avm");
   occa::memory o_eps = computeEps(nrs, time, scalarIndex, o_S);
 
   if (verbose) {
@@ -4,6 +4,7 @@ cds_t *cdsSetup(nrs_t *nrs, setupAide options)
   cds_t *cds = new cds_t();
   platform_t *platform = platform_t::getInstance();
   device_t &device = platform->device;
+  auto memoryOwner = device.memoryOwner("cds");
 
   cds->mesh[0] = nrs->_mesh;
   mesh_t *mesh = cds->mesh[0];
@@ -44,7 +45,8 @@ cds_t *cdsSetup(nrs_t *nrs, setupAide options)
   cds->gshT = (nrs->cht) ? oogs::setup(mesh->ogs, 1, nrs->fieldOffset, ogsDfloat, NULL, OOGS_AUTO) : cds->gsh;
 
   cds->U = nrs->U;
-  cds->S = (dfloat *)calloc(std::max(cds->nBDF, cds->nEXT) * cds->fieldOffsetSum, sizeof(dfloat));
+  const int nStatesHost = options.compareArgs("LOW MEMORY", "TRUE") ? 1 : std::max(cds->nBDF, cds->nEXT);
+  cds->S = (dfloat *)calloc(nStatesHost * cds->fieldOffsetSum, sizeof(dfloat));
 
   cds->Nsubsteps = nrs->Nsubsteps;
   if (cds->Nsubsteps) {
@@ -125,10 +127,12 @@ cds_t *cdsSetup(nrs_t *nrs, setupAide options)
   cds->o_U = nrs->o_U;
   cds->o_Ue = nrs->o_Ue;
   int nFieldsAlloc = cds->anyEllipticSolver ? std::max(cds->nBDF, cds->nEXT) : 1;
-  cds->o_S = platform->device.malloc(nFieldsAlloc * cds->fieldOffsetSum * sizeof(dfloat), cds->S);
+  cds->o_S = platform->device.malloc(nFieldsAlloc * cds->fieldOffsetSum * sizeof(dfloat));
+  cds->SHistory = lagHistory_t(nFieldsAlloc, true);
 
   nFieldsAlloc = cds->anyEllipticSolver ? cds->nEXT : 1;
   cds->o_FS = platform->device.malloc(nFieldsAlloc * cds->fieldOffsetSum * sizeof(dfloat));
+  cds->FSHistory = lagHistory_t(nFieldsAlloc, true);
 
   if (cds->anyEllipticSolver) {
     cds->o_Se = platform->device.malloc(cds->fieldOffsetSum, sizeof(dfloat));
@@ -131,6 +131,7 @@ static std::vector<std::string> generalKeys = {
     {"writeInterval"},
     {"constFlowRate"},
     {"verbose"},
+    {"lowMemory"},
     {"variableDT"},
     {"nScalars"}, // sans temperature
 
@@ -179,6 +180,7 @@ static std::vector<std::string> meshKeys = {
     {"file"},
     {"connectivitytol"},
     {"writetofieldfile"},
+    {"geometricOrder"},
 };
 
 static std::vector<std::string> velocityKeys = {
@@ -223,10 +225,18 @@ static std::vector<std::string> boomeramgKeys = {
     {"chebyshevRelaxOrder"},
 };
 
+static std::vector<std::string> saamgKeys = {
+    {"smootherType"},
+    {"smootherSweeps"},
+    {"iterations"},
+    {"strongThreshold"},
+    {"maxCoarseSize"},
+};
+
 static std::vector<std::string> amgxKeys = {
     {"configFile"},
 };
-static std::vector<std::string> occaKeys = {{"backend"}, {"deviceNumber"}, {"platformNumber"}};
+static std::vector<std::string> occaKeys = {{"backend"}, {"deviceNumber"}, {"platformNumber"}, {"interleaveGeometricFactors"}};
 
 static std::vector<std::string> pressureKeys = {};
 
@@ -249,6 +259,7 @@ static std::vector<std::string> validSections = {
     {"problemtype"},
     {"amgx"},
     {"boomeramg"},
+    {"saamg"},
     {"occa"},
     {"mesh"},
     {"scalar"},
@@ -268,6 +279,7 @@ void makeStringsLowerCase()
   lowerCase(deprecatedKeys);
   lowerCase(amgxKeys);
   lowerCase(boomeramgKeys);
+  lowerCase(saamgKeys);
   lowerCase(pressureKeys);
   lowerCase(occaKeys);
   lowerCase(cvodeKeys);
@@ -299,6 +311,8 @@ const std::vector<std::string> &getValidKeys(const std::string &section)
     return amgxKeys;
   if (section == "boomeramg")
     return boomeramgKeys;
+  if (section == "saamg")
+    return saamgKeys;
   if (section == "occa")
     return occaKeys;
   if (section == "velocity")
@@ -633,6 +647,9 @@ void parseSolverTolerance(const int rank, setupAide &options, inipp::Ini *par, s
 
   const std::vector<std::string> validValues = {
       {"relative"},
+      {"adaptive"},
+      {"safetyfactor"},
+      {"maxtol"},
   };
 
   std::string residualTol;
@@ -642,6 +659,10 @@ void parseSolverTolerance(const int rank, setupAide &options, inipp::Ini *par, s
       options.setArgs(parSectionName + "LINEAR SOLVER STOPPING CRITERION", "RELATIVE");
     }
 
+    if (residualTol.find("adaptive") != std::string::npos) {
+      options.setArgs(parSectionName + "LINEAR SOLVER ADAPTIVE TOLERANCE", "TRUE");
+    }
+
     std::vector<std::string> entries = serializeString(residualTol, '+');
     for (std::string entry : entries) {
       double tolerance = std::strtod(entry.c_str(), nullptr);
@@ -651,6 +672,21 @@ void parseSolverTolerance(const int rank, setupAide &options, inipp::Ini *par, s
       else {
         checkValidity(rank, validValues, entry);
       }
+
+      const auto safetyFactorStr = parseValueForKey(entry, "safetyfactor");
+      if (!safetyFactorStr.empty()) {
+        options.setArgs(parSectionName + "LINEAR SOLVER ADAPTIVE TOLERANCE SAFETY FACTOR", safetyFactorStr);
+      }
+
+      const auto maxTolStr = parseValueForKey(entry, "maxtol");
+      if (!maxTolStr.empty()) {
+        options.setArgs(parSectionName + "LINEAR SOLVER ADAPTIVE TOLERANCE MAX", maxTolStr);
+      }
+    }
+
+    if (residualTol.find("adaptive") == std::string::npos &&
+        (residualTol.find("safetyfactor") != std::string::npos || residualTol.find("maxtol") != std::string::npos)) {
+      append_error("safetyFactor and maxTol require residualTol+adaptive");
     }
   }
 }
@@ -693,6 +729,12 @@ void parseCoarseGridDiscretization(const int rank, setupAide &options, inipp::In
   }
 }
 
+bool is_number(const std::string &s)
+{
+  return !s.empty() &&
+         std::find_if(s.begin(), s.end(), [](unsigned char c) { return !std::isdigit(c); }) == s.end();
+}
+
 void parseCoarseSolver(const int rank, setupAide &options, inipp::Ini *par, std::string parScope)
 {
   std::string parSectionName = parPrefixFromParSection(parScope);
@@ -712,9 +754,13 @@ void parseCoarseSolver(const int rank, setupAide &options, inipp::Ini *par, std:
       {"smoother"},
       {"boomeramg"},
       {"amgx"},
+      {"saamg"},
       {"cpu"},
       {"device"},
       {"overlap"},
+      {"agglomerate"},
+      {"cache"},
+      {"refresh"},
   };
 
   std::vector<std::string> entries = serializeString(p_coarseSolver, '+');
@@ -725,7 +771,8 @@ void parseCoarseSolver(const int rank, setupAide &options, inipp::Ini *par, std:
   const int smoother = p_coarseSolver.find("smoother") != std::string::npos;
   const int amgx = p_coarseSolver.find("amgx") != std::string::npos;
   const int boomer = p_coarseSolver.find("boomeramg") != std::string::npos;
-  if (amgx + boomer > 1)
+  const int saamg = p_coarseSolver.find("saamg") != std::string::npos;
+  if (amgx + boomer + saamg > 1)
     append_error("Conflicting solver types in coarseSolver!\n");
 
   if (boomer) {
@@ -736,7 +783,15 @@ void parseCoarseSolver(const int rank, setupAide &options, inipp::Ini *par, std:
     }
   }
 
-  if (boomer || amgx) {
+  if (saamg) {
+    std::string smoother;
+    options.getArgs(parSectionName + "MULTIGRID SMOOTHER", smoother);
+    if (smoother.find("DAMPEDJACOBI") != std::string::npos) {
+      options.setArgs("SAAMG ITERATIONS", "2");
+    }
+  }
+
+  if (boomer || amgx || saamg) {
     options.setArgs(parSectionName + "MULTIGRID COARSE SOLVE", "TRUE");
     options.setArgs(parSectionName + "COARSE SOLVER", "BOOMERAMG");
     if (amgx) {
@@ -744,6 +799,8 @@ void parseCoarseSolver(const int rank, setupAide &options, inipp::Ini *par, std:
       if (!AMGXenabled())
         append_error("AMGX was requested but is not enabled!\n");
     }
+    if (saamg)
+      options.setArgs(parSectionName + "COARSE SOLVER", "SAAMG");
 
     options.setArgs(parSectionName + "COARSE SOLVER PRECISION", "FP32");
     if (options.compareArgs(parSectionName + "PRECONDITIONER", "SEMFEM")) {
@@ -771,6 +828,42 @@ void parseCoarseSolver(const int rank, setupAide &options, inipp::Ini *par, std:
 
         if (!options.compareArgs(parSectionName + "MGSOLVER CYCLE", "ADDITIVE"))
           append_error("Overlapping coarse solve requires additive multigrid!\n");
+
+        if (entry.find("=") != std::string::npos) {
+          const auto nThreads = parseValueForKey(entry, "overlap");
+          if (is_number(nThreads) && std::stoi(nThreads) > 0)
+            options.setArgs(parSectionName + "COARSE SOLVER OVERLAP THREADS", nThreads);
+          else
+            append_error("Invalid number of overlap threads in coarseSolver!\n");
+        }
+      }
+      else if (entry.find("agglomerate") != std::string::npos) {
+        std::string ratio = "AUTO";
+        if (entry.find("=") != std::string::npos) {
+          ratio = parseValueForKey(entry, "agglomerate");
+          if (ratio == "node") {
+            ratio = "NODE";
+          }
+          else if (!is_number(ratio) || std::stoi(ratio) < 1) {
+            append_error("Invalid agglomeration ratio in coarseSolver!\n");
+            ratio = "AUTO";
+          }
+        }
+        options.setArgs(parSectionName + "COARSE SOLVER AGGLOMERATION", ratio);
+      }
+      else if (entry.find("cache") != std::string::npos) {
+        options.setArgs(parSectionName + "COARSE SOLVER CACHE", "TRUE");
+      }
+      else if (entry.find("refresh") != std::string::npos) {
+        std::string frequency = "1";
+        if (entry.find("=") != std::string::npos) {
+          frequency = parseValueForKey(entry, "refresh");
+          if (!is_number(frequency) || std::stoi(frequency) < 1) {
+            append_error("Invalid refresh frequency in coarseSolver!\n");
+            frequency = "1";
+          }
+        }
+        options.setArgs(parSectionName + "COARSE SOLVER REFRESH", frequency);
       }
     }
   }
@@ -795,6 +888,21 @@ void parseCoarseSolver(const int rank, setupAide &options, inipp::Ini *par, std:
     append_error("AMGX on CPU is not supported!\n");
   }
 
+  if (saamg) {
+    if (options.compareArgs(parSectionName + "COARSE SOLVER LOCATION", "DEVICE") &&
+        p_coarseSolver.find("device") != std::string::npos)
+      append_error("SAAMG on DEVICE is not supported!\n");
+    options.setArgs(parSectionName + "COARSE SOLVER LOCATION", "CPU");
+  }
+
+  if (options.getArgs(parSectionName + "COARSE SOLVER AGGLOMERATION").size()) {
+    if (!options.compareArgs(parSectionName + "COARSE SOLVER LOCATION", "CPU") || amgx)
+      append_error("Coarse grid agglomeration requires coarse solver on the CPU!\n");
+    if (options.compareArgs(parSectionName + "MULTIGRID SEMFEM", "TRUE") ||
+        options.compareArgs(parSectionName + "PRECONDITIONER", "SEMFEM"))
+      append_error("Coarse grid agglomeration is not supported for SEMFEM!\n");
+  }
+
   if (boomer && options.compareArgs(parSectionName + "COARSE SOLVER LOCATION", "GPU")) {
     if (hypreWrapperDevice::enabled()) {
       append_error("HYPRE is not configured to run on the GPU!\n");
@@ -808,12 +916,6 @@ void parseCoarseSolver(const int rank, setupAide &options, inipp::Ini *par, std:
   }
 }
 
-bool is_number(const std::string &s)
-{
-  return !s.empty() &&
-         std::find_if(s.begin(), s.end(), [](unsigned char c) { return !std::isdigit(c); }) == s.end();
-}
-
 std::vector<int> checkForIntInInputs(const std::vector<std::string> &inputs)
 {
   std::vector<int> values;
@@ -851,12 +953,15 @@ void parseSmoother(const int rank, setupAide &options, inipp::Ini *par, std::str
   const std::vector<std::string> validValues = {
       {"asm"},
       {"ras"},
+      {"msm"},
       {"cheby"},
       {"fourthcheby"},
       {"fourthoptcheby"},
       {"jac"},
       {"mineigenvalueboundfactor"},
       {"maxeigenvalueboundfactor"},
+      {"cache"},
+      {"refresh"},
   };
 
   {
@@ -899,6 +1004,24 @@ void parseSmoother(const int rank, setupAide &options, inipp::Ini *par, std::str
         if (!maxEigBoundStr.empty())
           options.setArgs(parSection + "MULTIGRID CHEBYSHEV MAX EIGENVALUE BOUND FACTOR", maxEigBoundStr);
 
+        if (s.find("cache") == 0) {
+          options.setArgs(parSection + "MULTIGRID CHEBYSHEV EIGENVALUE CACHE", "TRUE");
+          continue;
+        }
+
+        if (s.find("refresh") == 0) {
+          std::string frequency = "1";
+          if (s.find("=") != std::string::npos) {
+            frequency = parseValueForKey(s, "refresh");
+            if (!is_number(frequency) || std::stoi(frequency) < 1) {
+              append_error("Invalid eigenvalue refresh frequency in smootherType!\n");
+              frequency = "1";
+            }
+          }
+          options.setArgs(parSection + "MULTIGRID CHEBYSHEV EIGENVALUE REFRESH", frequency);
+          continue;
+        }
+
         if (s.find("jac") != std::string::npos) {
           surrogateSmootherSet = true;
           options.setArgs(parSection + "MULTIGRID SMOOTHER", "DAMPEDJACOBI," + chebyshevType);
@@ -926,6 +1049,9 @@ void parseSmoother(const int rank, setupAide &options, inipp::Ini *par, std::str
     }
 
     // Non-Chebyshev smoothers
+    if (p_smoother.find("+cache") != std::string::npos || p_smoother.find("+refresh") != std::string::npos)
+      append_error("smootherType cache/refresh requires Chebyshev");
+
     options.removeArgs(parSection + "MULTIGRID CHEBYSHEV DEGREE");
     options.removeArgs(parSection + "MULTIGRID CHEBYSHEV MAX EIGENVALUE BOUND FACTOR");
     if (p_smoother.find("asm") == 0) {
@@ -948,6 +1074,9 @@ void parseSmoother(const int rank, setupAide &options, inipp::Ini *par, std::str
         options.setArgs(parSection + "MGSOLVER CYCLE", "VCYCLE+ADDITIVE+OVERLAPCRS");
       }
     }
+    else if (p_smoother.find("msm") == 0) {
+      options.setArgs(parSection + "MULTIGRID SMOOTHER", "MSM");
+    }
     else if (p_smoother.find("jac") == 0) {
       append_error("Jacobi smoother requires Chebyshev");
       options.setArgs(parSection + "MULTIGRID SMOOTHER", "DAMPEDJACOBI");
@@ -971,6 +1100,7 @@ void parsePreconditioner(const int rank, setupAide &options, inipp::Ini *par, st
       {"multigrid"},
       {"additive"},
       {"multiplicative"},
+      {"autotune"},
   };
 
   std::string parSection = parPrefixFromParSection(parScope);
@@ -1009,6 +1139,18 @@ void parsePreconditioner(const int rank, setupAide &options, inipp::Ini *par, st
       key = "VCYCLE+MULTIPLICATIVE";
     }
     options.setArgs(parSection + "MGSOLVER CYCLE", key);
+
+    for (std::string s : list) {
+      if (s.find("autotune") != 0)
+        continue;
+      const auto mode = parseValueForKey(s, "=");
+      if (mode.empty())
+        options.setArgs(parSection + "MULTIGRID AUTOTUNE", "TRUE");
+      else if (mode == "file")
+        options.setArgs(parSection + "MULTIGRID AUTOTUNE", "FILE");
+      else
+        append_error("invalid value for autotune!\n");
+    }
   }
   else if (p_preconditioner.find("semfem") != std::string::npos ||
            p_preconditioner.find("femsem") != std::string::npos) {
@@ -1016,6 +1158,9 @@ void parsePreconditioner(const int rank, setupAide &options, inipp::Ini *par, st
     options.setArgs(parSection + "ELLIPTIC PRECO COEFF FIELD", "FALSE");
   }
 
+  if (!mg && p_preconditioner.find("autotune") != std::string::npos)
+    append_error("autotune requires multigrid preconditioner!\n");
+
   parseSmoother(rank, options, par, parScope);
 
   parseCoarseGridDiscretization(rank, options, par, parScope);
@@ -1119,6 +1264,8 @@ void parseLinearSolver(const int rank, setupAide &options, inipp::Ini *par, std:
       {"pgmres"},
       {"pcg"},
       {"block"},
+      {"multirhs"},
+      {"mixedprecision"},
   };
   std::vector<std::string> list = serializeString(p_solver, '+');
   for (const std::string s : list) {
@@ -1126,6 +1273,12 @@ void parseLinearSolver(const int rank, setupAide &options, inipp::Ini *par, std:
   }
 
   if (p_solver.find("gmres") != std::string::npos) {
+    if (p_solver.find("multirhs") != std::string::npos) {
+      append_error("multiRHS requires solver = pcg");
+    }
+    if (p_solver.find("mixedprecision") != std::string::npos) {
+      append_error("mixedPrecision requires solver = pcg");
+    }
     std::vector<std::string> list;
     list = serializeString(p_solver, '+');
     std::string n = "15";
@@ -1151,12 +1304,33 @@ void parseLinearSolver(const int rank, setupAide &options, inipp::Ini *par, std:
       options.setArgs(parSectionName + "BLOCK SOLVER", "FALSE");
     }
 
+    const bool multiRhs = p_solver.find("multirhs") != std::string::npos;
+    const bool mixedPrecision = p_solver.find("mixedprecision") != std::string::npos;
+    if (multiRhs) {
+      if (parScope == "velocity") {
+        options.setArgs(parSectionName + "BLOCK SOLVER", "TRUE");
+      }
+      else if (parScope.find("scalar") == std::string::npos && parScope != "temperature") {
+        append_error("multiRHS is only supported for velocity and scalars");
+      }
+    }
+
     if (p_solver.find("fcg") != std::string::npos || p_solver.find("flexible") != std::string::npos) {
       p_solver = "PCG+FLEXIBLE";
     }
     else {
       p_solver = "PCG";
     }
+    if (multiRhs) {
+      p_solver += "+MULTIRHS";
+    }
+
+    if (mixedPrecision) {
+      if (multiRhs) {
+        append_error("mixedPrecision does not support multiRHS solver");
+      }
+      p_solver += "+MIXEDPRECISION";
+    }
   }
   else if (p_solver.find("user") != std::string::npos) {
     p_solver = "USER";
@@ -1190,6 +1364,7 @@ void parseInitialGuess(const int rank, setupAide &options, inipp::Ini *par, std:
       // settings
       {"nvector"},
       {"start"},
+      {"adaptive"},
   };
 
   options.setArgs(parSectionName + "INITIAL GUESS", "EXTRAPOLATION");
@@ -1242,6 +1417,9 @@ void parseInitialGuess(const int rank, setupAide &options, inipp::Ini *par, std:
       const auto startStr = parseValueForKey(s, "start");
       if (!startStr.empty() && proj)
         options.setArgs(parSectionName + "RESIDUAL PROJECTION START", startStr);
+
+      if (s == "adaptive" && proj)
+        options.setArgs(parSectionName + "RESIDUAL PROJECTION ADAPTIVE", "TRUE");
     }
     return;
   }
@@ -1484,6 +1662,7 @@ void setDefaultSettings(setupAide &options, std::string casename, int rank)
   options.setArgs("PLATFORM NUMBER", "0");
 
   options.setArgs("VERBOSE", "FALSE");
+  options.setArgs("LOW MEMORY", "FALSE");
 
   options.setArgs("STDOUT PAR", "TRUE");
   options.setArgs("STDOUT UDF", "TRUE");
@@ -1547,6 +1726,34 @@ void parseBoomerAmgSection(const int rank, setupAide &options, inipp::Ini *par)
   }
 }
 
+void parseSAAMGSection(const int rank, setupAide &options, inipp::Ini *par)
+{
+  if (par->sections.count("saamg")) {
+    std::string smootherType;
+    if (par->extract("saamg", "smoothertype", smootherType)) {
+      const std::vector<std::string> validValues = {
+          {"jacobi"},
+          {"chebyshev"},
+      };
+      checkValidity(rank, validValues, smootherType);
+      upperCase(smootherType);
+      options.setArgs("SAAMG SMOOTHER TYPE", smootherType);
+    }
+    int sweeps;
+    if (par->extract("saamg", "smoothersweeps", sweeps))
+      options.setArgs("SAAMG SMOOTHER SWEEPS", std::to_string(sweeps));
+    int numCycles;
+    if (par->extract("saamg", "iterations", numCycles))
+      options.setArgs("SAAMG ITERATIONS", std::to_string(numCycles));
+    double strongThres;
+    if (par->extract("saamg", "strongthreshold", strongThres))
+      options.setArgs("SAAMG STRONG THRESHOLD", to_string_f(strongThres));
+    int maxCoarseSize;
+    if (par->extract("saamg", "maxcoarsesize", maxCoarseSize))
+      options.setArgs("SAAMG MAX COARSE SIZE", std::to_string(maxCoarseSize));
+  }
+}
+
 void parseOccaSection(const int rank, setupAide &options, inipp::Ini *par)
 {
   std::string backendSpecification;
@@ -1554,6 +1761,7 @@ void parseOccaSection(const int rank, setupAide &options, inipp::Ini *par)
     const std::vector<std::string> validBackends = {
         {"serial"},
         {"cpu"},
+        {"openmp"},
         {"cuda"},
         {"hip"},
         {"dpcpp"},
@@ -1627,6 +1835,11 @@ void parseOccaSection(const int rank, setupAide &options, inipp::Ini *par)
     upperCase(platformNumber);
     options.setArgs("PLATFORM NUMBER", platformNumber);
   }
+
+  bool interleaveGeometricFactors = false;
+  if (par->extract("occa", "interleavegeometricfactors", interleaveGeometricFactors))
+    if (interleaveGeometricFactors)
+      options.setArgs("INTERLEAVE GEOMETRIC FACTORS", "TRUE");
 }
 
 void parseGeneralSection(const int rank, setupAide &options, inipp::Ini *par)
@@ -1637,6 +1850,11 @@ void parseGeneralSection(const int rank, setupAide &options, inipp::Ini *par)
     if (verbose)
       options.setArgs("VERBOSE", "TRUE");
 
+  bool lowMemory = false;
+  if (par->extract("general", "lowmemory", lowMemory))
+    if (lowMemory)
+      options.setArgs("LOW MEMORY", "TRUE");
+
   std::string startFrom;
   if (par->extract("general", "startfrom", startFrom)) {
     options.setArgs("RESTART FILE NAME", startFrom);
@@ -1943,6 +2161,20 @@ void parseMeshSection(const int rank, setupAide &options, inipp::Ini *par)
       options.setArgs("MESH CONNECTIVITY TOL", meshConTol);
     }
 
+    int geometricOrder;
+    if (par->extract("mesh", "geometricorder", geometricOrder)) {
+      int N;
+      options.getArgs("POLYNOMIAL DEGREE", N);
+      if (geometricOrder < 1)
+        append_error("mesh::geometricOrder has to be >= 1");
+
+      // a lower order geometry is recomputed on the fly in the elliptic operator
+      if (geometricOrder < N) {
+        options.setArgs("ELEMENT MAP", "SUBPARAMETRIC");
+        options.setArgs("GEOMETRIC ORDER", std::to_string(geometricOrder));
+      }
+    }
+
     {
       const std::vector<std::string> validValues = {
           {"yes"},
@@ -1981,6 +2213,8 @@ void parsePressureSection(const int rank, setupAide &options, inipp::Ini *par)
 
   parseBoomerAmgSection(rank, options, par);
 
+  parseSAAMGSection(rank, options, par);
+
   if (par->sections.count("amgx")) {
     if (!AMGXenabled()) {
       append_error("AMGX was requested but is not compiled!\n");
@@ -132,6 +132,7 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
 {
   platform_t *platform = platform_t::getInstance();
   device_t &device = platform->device;
+  auto memoryOwner = device.memoryOwner("nrs");
   nrs->kernelInfo = new occa::properties();
   *(nrs->kernelInfo) = platform->kernelInfo;
   occa::properties &kernelInfo = *nrs->kernelInfo;
@@ -150,7 +151,7 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
 
   {
 #if 1
-    if (platform->device.mode() == "Serial") {
+    if (platform->serial) {
       platform->options.setArgs("ENABLE GS COMM OVERLAP", "FALSE");
     }
 #endif
@@ -233,7 +234,10 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
              "Invalid solid element partitioning");
   }
 
-  nrs->_mesh = createMesh(comm, N, cubN, nrs->cht, kernelInfo);
+  {
+    auto memoryOwner = device.memoryOwner("mesh");
+    nrs->_mesh = createMesh(comm, N, cubN, nrs->cht, kernelInfo);
+  }
   nrs->meshV = (mesh_t *)nrs->_mesh->fluid;
   mesh_t *mesh = nrs->meshV;
 
@@ -329,7 +333,7 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
     nrs->o_weightsRK = device.malloc(nrs->nRK * sizeof(dfloat), nrs->weightsRK);
   }
 
-  // setup mempool
+  // initial size of the scratch arena, it grows to the high-water mark if needed
   int ellipticMaxFields = 1;
   if (platform->options.compareArgs("VELOCITY BLOCK SOLVER", "TRUE") ||
       !platform->options.compareArgs("MESH SOLVER", "NONE")) {
@@ -344,24 +348,34 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
     wrkFields += nrs->NVfields;
   }
 
-  const int mempoolNflds = std::max(wrkFields, 2 * nrs->NVfields + elliptic_t::NWorkspaceFields * ellipticMaxFields);
-  platform->create_mempool(nrs->fieldOffset, mempoolNflds);
+  const int arenaNflds = std::max(wrkFields, 2 * nrs->NVfields + elliptic_t::NWorkspaceFields * ellipticMaxFields);
+  platform->o_mempool.offset = nrs->fieldOffset;
+  platform->memoryArena.reserve((arenaNflds * sizeof(dfloat)) * nrs->fieldOffset);
+  platform->o_mempool.bind(platform->memoryArena.buffer());
 
   if (options.compareArgs("MOVING MESH", "TRUE")) {
     const int nBDF = std::max(nrs->nBDF, nrs->nEXT);
-    platform->o_mempool.slice0.copyFrom(mesh->o_LMM, mesh->Nlocal * sizeof(dfloat));
-    mesh->o_LMM.free();
-    mesh->o_LMM = platform->device.malloc(nrs->fieldOffset * nBDF, sizeof(dfloat));
-    mesh->o_LMM.copyFrom(platform->o_mempool.slice0, mesh->Nlocal * sizeof(dfloat));
-
-    platform->o_mempool.slice0.copyFrom(mesh->o_invLMM, mesh->Nlocal * sizeof(dfloat));
-    mesh->o_invLMM.free();
-    mesh->o_invLMM = platform->device.malloc(nrs->fieldOffset * nBDF, sizeof(dfloat));
-    mesh->o_invLMM.copyFrom(platform->o_mempool.slice0, mesh->Nlocal * sizeof(dfloat));
+    {
+      auto scope = platform->memoryArena.scope("setup");
+      auto o_tmp = scope.allocate<dfloat>("LMM", mesh->Nlocal);
+
+      o_tmp.copyFrom(mesh->o_LMM, mesh->Nlocal * sizeof(dfloat));
+      mesh->o_LMM.free();
+      mesh->o_LMM = platform->device.malloc(nrs->fieldOffset * nBDF, sizeof(dfloat));
+      mesh->o_LMM.copyFrom(o_tmp, mesh->Nlocal * sizeof(dfloat));
+
+      o_tmp.copyFrom(mesh->o_invLMM, mesh->Nlocal * sizeof(dfloat));
+      mesh->o_invLMM.free();
+      mesh->o_invLMM = platform->device.malloc(nrs->fieldOffset * nBDF, sizeof(dfloat));
+      mesh->o_invLMM.copyFrom(o_tmp, mesh->Nlocal * sizeof(dfloat));
+    }
 
     const int nAB = std::max(nrs->nEXT, mesh->nAB);
-    mesh->U = (dfloat *)calloc(nrs->NVfields * nrs->fieldOffset * nAB, sizeof(dfloat));
-    mesh->o_U = platform->device.malloc((nrs->NVfields * nAB * sizeof(dfloat)) * nrs->fieldOffset, mesh->U);
+    // host shadows are exchanged with nek and only need the current level in low-memory mode
+    const int nABHost = options.compareArgs("LOW MEMORY", "TRUE") ? 1 : nAB;
+    mesh->U = (dfloat *)calloc(nrs->NVfields * nrs->fieldOffset * nABHost, sizeof(dfloat));
+    mesh->o_U = platform->device.malloc((nrs->NVfields * nAB * sizeof(dfloat)) * nrs->fieldOffset);
+    mesh->UHistory = lagHistory_t(nAB, true);
     mesh->o_Ue = platform->device.malloc((nrs->NVfields * nAB * sizeof(dfloat)) * nrs->fieldOffset);
     if (nrs->Nsubsteps) {
       mesh->o_divU = platform->device.malloc(nrs->fieldOffset * nAB, sizeof(dfloat));
@@ -380,9 +394,10 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
     }
   }
 
-  nrs->U = (dfloat *)calloc(nrs->NVfields * std::max(nrs->nBDF, nrs->nEXT) * nrs->fieldOffset, sizeof(dfloat));
-  nrs->o_U = platform->device.malloc(nrs->NVfields * std::max(nrs->nBDF, nrs->nEXT) * nrs->fieldOffset * sizeof(dfloat),
-                                     nrs->U);
+  const int nStatesHost = options.compareArgs("LOW MEMORY", "TRUE") ? 1 : std::max(nrs->nBDF, nrs->nEXT);
+  nrs->U = (dfloat *)calloc(nrs->NVfields * nStatesHost * nrs->fieldOffset, sizeof(dfloat));
+  nrs->o_U = platform->device.malloc(nrs->NVfields * std::max(nrs->nBDF, nrs->nEXT) * nrs->fieldOffset * sizeof(dfloat));
+  nrs->UHistory = lagHistory_t(std::max(nrs->nBDF, nrs->nEXT), true);
 
   nrs->o_Ue = platform->device.malloc((nrs->NVfields * sizeof(dfloat)) * nrs->fieldOffset);
 
@@ -391,6 +406,7 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
 
   nrs->o_BF = platform->device.malloc((nrs->NVfields * sizeof(dfloat)) * nrs->fieldOffset);
   nrs->o_FU = platform->device.malloc((nrs->NVfields * nrs->nEXT * sizeof(dfloat)) * nrs->fieldOffset);
+  nrs->FUHistory = lagHistory_t(nrs->nEXT, true);
 
   nrs->o_ellipticCoeff = device.malloc((2 * sizeof(dfloat)) * nrs->fieldOffset);
 
@@ -640,13 +656,13 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
   nrs->_mesh->update();
 
   // in case the user sets IC in udf.setup
-  nrs->o_U.copyFrom(nrs->U);
+  nrs->o_U.copyFrom(nrs->U, (nrs->NVfields * sizeof(dfloat)) * nrs->fieldOffset);
   nrs->o_P.copyFrom(nrs->P);
   if (nrs->Nscalar) {
-    nrs->cds->o_S.copyFrom(nrs->cds->S);
+    nrs->cds->o_S.copyFrom(nrs->cds->S, nrs->cds->fieldOffsetSum * sizeof(dfloat));
   }
   if (options.compareArgs("MOVING MESH", "TRUE")) {
-    mesh->o_U.copyFrom(mesh->U);
+    mesh->o_U.copyFrom(mesh->U, (nrs->NVfields * sizeof(dfloat)) * nrs->fieldOffset);
   }
 
   // ensure both codes see the same mesh + IC
@@ -676,6 +692,17 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
   if (nrs->Nscalar) {
     cds_t *cds = nrs->cds;
 
+    // mask ids of a multiRHS solver are ordered by field
+    auto NmaskedField = [&](elliptic_t *solver, int fld) {
+      if (solver->Nfields == 1 || solver->Nmasked == 0)
+        return solver->Nmasked;
+      std::vector<dlong> maskIds(solver->Nmasked);
+      solver->o_maskIds.copyTo(maskIds.data());
+      return static_cast<dlong>(std::count_if(maskIds.begin(), maskIds.end(), [&](dlong id) {
+        return id / solver->fieldOffset == fld;
+      }));
+    };
+
     for (int is = 0; is < cds->NSfields; is++) {
       std::string sid = scalarDigitStr(is);
 
@@ -703,36 +730,96 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
         continue;
       }
 
+      const int leader = cdsMultiRhsGroupLeader(is);
+      if (leader != is) {
+        const int fld = is - leader;
+        cds->solver[is] = cds->solver[leader];
+        cds->maskIdsStart[is] = cds->maskIdsStart[is - 1] + cds->Nmasked[is - 1];
+        cds->Nmasked[is] = NmaskedField(cds->solver[is], fld);
+        if (platform->comm.mpiRank == 0) {
+          std::cout << "solved together with scalar" << scalarDigitStr(leader) << " (multiRHS)\n";
+        }
+        continue;
+      }
+
+      const int Nfields = cdsMultiRhsGroupSize(is);
+
+      nrsCheck(Nfields > 1 && nrs->cht && is == 0,
+               platform->comm.mpiComm,
+               EXIT_FAILURE,
+               "%s\n",
+               "multiRHS solver not supported for CHT temperature!");
+
+      for (int fld = 1; fld < Nfields; fld++) {
+        const std::string sidMember = scalarDigitStr(is + fld);
+        for (auto &&key : {"SOLVER",
+                           "SOLVER TOLERANCE",
+                           "LINEAR SOLVER STOPPING CRITERION",
+                           "LINEAR SOLVER ADAPTIVE TOLERANCE",
+                           "MAXIMUM ITERATIONS",
+                           "PRECONDITIONER",
+                           "INITIAL GUESS",
+                           "RESIDUAL PROJECTION VECTORS",
+                           "RESIDUAL PROJECTION START",
+                           "RESIDUAL PROJECTION ADAPTIVE"}) {
+          nrsCheck(options.getArgs("SCALAR" + sid + " " + key) !=
+                       options.getArgs("SCALAR" + sidMember + " " + key),
+                   platform->comm.mpiComm,
+                   EXIT_FAILURE,
+                   "multiRHS scalar%s and scalar%s require the same setting for %s!\n",
+                   sid.c_str(),
+                   sidMember.c_str(),
+                   key);
+        }
+      }
+
       cds->solver[is] = new elliptic_t();
       cds->solver[is]->name = "scalar" + sid;
-      cds->solver[is]->Nfields = 1;
+      cds->solver[is]->Nfields = Nfields;
       cds->solver[is]->fieldOffset = nrs->fieldOffset;
       cds->solver[is]->mesh = mesh;
 
       cds->solver[is]->poisson = 0;
 
-      cds->setEllipticCoeffKernel(mesh->Nlocal,
-                                  cds->g0 * cds->idt,
-                                  cds->fieldOffsetScan[is],
-                                  nrs->fieldOffset,
-                                  0,
-                                  cds->o_diff,
-                                  cds->o_rho,
-                                  o_NULL,
-                                  cds->o_ellipticCoeff);
+      // group solvers own their coefficients (lambda0 and lambda1 of each field)
+      if (Nfields > 1) {
+        auto o_coeff = platform->device.malloc((2 * Nfields * sizeof(dfloat)) * nrs->fieldOffset);
+        cds->solver[is]->o_lambda0 = o_coeff.slice(0 * nrs->fieldOffset * sizeof(dfloat));
+        cds->solver[is]->o_lambda1 = o_coeff.slice(Nfields * nrs->fieldOffset * sizeof(dfloat));
+        cds->solver[is]->loffset = nrs->fieldOffset;
+      } else {
+        cds->solver[is]->o_lambda0 = cds->o_ellipticCoeff.slice(0 * nrs->fieldOffset * sizeof(dfloat));
+        cds->solver[is]->o_lambda1 = cds->o_ellipticCoeff.slice(1 * nrs->fieldOffset * sizeof(dfloat));
+      }
 
-      cds->solver[is]->o_lambda0 = cds->o_ellipticCoeff.slice(0 * nrs->fieldOffset * sizeof(dfloat));
-      cds->solver[is]->o_lambda1 = cds->o_ellipticCoeff.slice(1 * nrs->fieldOffset * sizeof(dfloat));
+      for (int fld = 0; fld < Nfields; fld++) {
+        cds->setEllipticCoeffKernel(mesh->Nlocal,
+                                    cds->g0 * cds->idt,
+                                    cds->fieldOffsetScan[is + fld],
+                                    Nfields * nrs->fieldOffset,
+                                    0,
+                                    cds->o_diff,
+                                    cds->o_rho,
+                                    o_NULL,
+                                    cds->solver[is]->o_lambda0 + fld * nrs->fieldOffset * sizeof(dfloat));
+      }
 
-      cds->solver[is]->EToB = (int *)calloc(mesh->Nelements * mesh->Nfaces, sizeof(int));
-      for (dlong e = 0; e < mesh->Nelements; e++) {
-        for (int f = 0; f < mesh->Nfaces; f++) {
-          const int bID = mesh->EToB[f + e * mesh->Nfaces];
-          cds->solver[is]->EToB[f + e * mesh->Nfaces] = bcMap::ellipticType(bID, "scalar" + sid);
+      cds->solver[is]->EToB = (int *)calloc(mesh->Nelements * mesh->Nfaces * Nfields, sizeof(int));
+      for (int fld = 0; fld < Nfields; fld++) {
+        const std::string field = "scalar" + scalarDigitStr(is + fld);
+        for (dlong e = 0; e < mesh->Nelements; e++) {
+          for (int f = 0; f < mesh->Nfaces; f++) {
+            const int bID = mesh->EToB[f + e * mesh->Nfaces];
+            const int offset = fld * mesh->Nelements * mesh->Nfaces;
+            cds->solver[is]->EToB[f + e * mesh->Nfaces + offset] = bcMap::ellipticType(bID, field);
+          }
         }
       }
 
       ellipticSolveSetup(cds->solver[is]);
+
+      cds->maskIdsStart[is] = 0;
+      cds->Nmasked[is] = NmaskedField(cds->solver[is], 0);
     }
   }
 
@@ -751,6 +838,13 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
              "%s\n",
              "SHL or unaligned SYM boundaries require solver = pcg+block");
 
+    // components are coupled by the zero normal mask
+    nrsCheck(unalignedBoundary && options.compareArgs("VELOCITY SOLVER", "MULTIRHS"),
+             platform->comm.mpiComm,
+             EXIT_FAILURE,
+             "%s\n",
+             "SHL or unaligned SYM boundaries are not supported by solver = pcg+multiRHS");
+
     if (platform->options.compareArgs("VELOCITY BLOCK SOLVER", "TRUE")) {
       nrs->uvwSolver = new elliptic_t();
     }
@@ -856,6 +950,8 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
       nrs->vSolver->o_lambda1 = nrs->o_ellipticCoeff.slice(1 * nrs->fieldOffset * sizeof(dfloat));
       nrs->vSolver->poisson = 0;
       nrs->vSolver->EToB = (int *)calloc(mesh->Nelements * mesh->Nfaces, sizeof(int));
+      if (options.compareArgs("LOW MEMORY", "TRUE"))
+        nrs->vSolver->preconSource = nrs->uSolver;
       for (dlong e = 0; e < mesh->Nelements; e++) {
         for (int f = 0; f < mesh->Nfaces; f++) {
           const int bID = mesh->EToB[f + e * mesh->Nfaces];
@@ -874,6 +970,8 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
       nrs->wSolver->o_lambda1 = nrs->o_ellipticCoeff.slice(1 * nrs->fieldOffset * sizeof(dfloat));
       nrs->wSolver->poisson = 0;
       nrs->wSolver->EToB = (int *)calloc(mesh->Nelements * mesh->Nfaces, sizeof(int));
+      if (options.compareArgs("LOW MEMORY", "TRUE"))
+        nrs->wSolver->preconSource = nrs->uSolver;
       for (dlong e = 0; e < mesh->Nelements; e++) {
         for (int f = 0; f < mesh->Nfaces; f++) {
           const int bID = mesh->EToB[f + e * mesh->Nfaces];
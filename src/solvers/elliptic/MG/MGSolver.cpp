@@ -24,6 +24,15 @@ SOFTWARE.
 
 */
 
+#include <thread>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "MGSolver.hpp"
 #include "platform.hpp"
 #include "linAlg.hpp"
@@ -57,6 +66,27 @@ void prolongateV(MGSolver_t* M)
     levelC->prolongate(o_xC, o_x);
   }
 }
+// restrict calling thread to the given cores (no-op if empty)
+void pinThread(const std::vector<int> &cores)
+{
+#ifdef __linux__
+  if (cores.empty()) return;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (auto core : cores)
+    CPU_SET(core, &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+}
+
+// accumulate time measured outside of tic/toc (e.g. by another thread)
+void addTime(const std::string &tag, double time)
+{
+  const auto elapsed = platform->timer.hostElapsed(tag);
+  const auto count = platform->timer.count(tag);
+  platform->timer.set(tag, std::max(elapsed, 0.0) + time, std::max(count, 0LL) + 1);
+}
+
 void schwarzSolve(MGSolver_t* M)
 {    
   for(int k = 0 ; k < M->numLevels-1; ++k){
@@ -107,20 +137,75 @@ MGSolver_t::MGSolver_t(occa::device device_, MPI_Comm comm_,
       additive = true;
       overlapCrsGridSolve = false;
       if(options.compareArgs("MGSOLVER CYCLE", "OVERLAPCRS")){
-        if(platform->device.mode() == "Serial" || platform->device.mode() == "OpenMP"){
+        // coarse solve runs on a helper thread communicating concurrently with the smoother,
+        // a funneled variant (only the main thread communicates) is not implemented
+        overlapCrsGridSolve = true;
+        int provided;
+        MPI_Query_thread(&provided);
+        // a single rank does not communicate but the helper thread still calls into MPI
+        const int required = (size > 1) ? MPI_THREAD_MULTIPLE : MPI_THREAD_SERIALIZED;
+        if(provided < required) {
+          overlapCrsGridSolve = false;
+          if(rank == 0)
+            printf("disable overlapping coarse solve as %s is not supported!\n",
+                   (size > 1) ? "MPI_THREAD_MULTIPLE" : "MPI_THREAD_SERIALIZED");
+        }
+
+        // +overlap=<int> requests the helper threads explicitly
+        const bool explicitThreads = options.getArgs("COARSE SOLVER OVERLAP THREADS", overlapCrsThreads);
+        overlapCrsThreads = std::max(overlapCrsThreads, 1);
+
+        int smootherThreads = 1;
+#ifdef _OPENMP
+        smootherThreads = omp_get_max_threads();
+#endif
+
+        int localSize;
+        {
+          MPI_Comm localComm;
+          MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &localComm);
+          MPI_Comm_size(localComm, &localSize);
+          MPI_Comm_free(&localComm);
+        }
+        const int NcoresNode = std::thread::hardware_concurrency();
+
+#ifdef __linux__
+        // reserve the last cores of the process mask, the smoother keeps the others
+        cpu_set_t mask;
+        int Ncores = 0;
+        if(sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+          std::vector<int> cores;
+          for(int core = 0; core < CPU_SETSIZE; core++)
+            if(CPU_ISSET(core, &mask)) cores.push_back(core);
+          Ncores = cores.size();
+
+          // unbound ranks see all cores of the node and are not pinned
+          const bool unbound = (Ncores == NcoresNode) && localSize > 1;
+          if(unbound)
+            Ncores /= localSize;
+          else if(overlapCrsGridSolve && cores.size() > overlapCrsThreads)
+            overlapCrsCores.assign(cores.end() - overlapCrsThreads, cores.end());
+        }
+#else
+        const int Ncores = NcoresNode / localSize;
+#endif
+
+        // without a spare core the helper thread only competes with the smoother
+        int spareCore = Ncores > smootherThreads;
+        MPI_Allreduce(MPI_IN_PLACE, &spareCore, 1, MPI_INT, MPI_MIN, comm);
+        if(overlapCrsGridSolve && !spareCore && !explicitThreads) {
           overlapCrsGridSolve = false;
-        } else {
-          overlapCrsGridSolve = true;
-          int provided;
-          MPI_Query_thread(&provided);
-          if(provided != MPI_THREAD_MULTIPLE) {
-            overlapCrsGridSolve = false;
-            if(rank ==0 && size > 1) 
-              printf("disable overlapping coarse solve as MPI_THREAD_MULTIPLE is not supported!\n");
-          }
-          if(size == 1) overlapCrsGridSolve = true;
+          overlapCrsCores.clear();
+          if(rank == 0)
+            printf("disable overlapping coarse solve as there is no spare core (use +overlap=<int> to enforce)\n");
+        }
+
+        if(rank ==0 && overlapCrsGridSolve) {
+          printf("overlapping coarse grid solve enabled (%d thread%s", overlapCrsThreads, overlapCrsThreads > 1 ? "s" : "");
+          if(overlapCrsCores.size())
+            printf(" on core %d-%d", overlapCrsCores.front(), overlapCrsCores.back());
+          printf(")\n");
         }
-        if(rank ==0 && overlapCrsGridSolve) printf("overlapping coarse grid solve enabled\n");
       }
     } else {
       if (options.compareArgs("MGSOLVER SMOOTHER", "RAS") || 
@@ -198,7 +283,6 @@ void MGSolver_t::runAdditiveVcycle()
     coarsenV(this);
   }
 
-  const int nThreads = this->overlapCrsGridSolve ? 2 : 1;
   occa::memory o_rhs = levels[baseLevel]->o_rhs;
   occa::memory o_x   = levels[baseLevel]->o_x;
 
@@ -217,30 +301,61 @@ void MGSolver_t::runAdditiveVcycle()
   o_rhs.copyTo(Sx, Nlocal*sizeof(pfloat));
 
   o_x.getDevice().finish();
-  #pragma omp parallel proc_bind(close) num_threads(nThreads)
-  {
-    #pragma omp single
-    {
-      #pragma omp task
-      {
-        schwarzSolve(this);
-      }
-      #pragma omp task
-      {
-        for(int i = 0; i < Nlocal; i++)
-          Sx[i] *= this->coarseLevel->weight[i]; 
-        ogsGather(Gx, Sx, ogsPfloat, ogsAdd, ogs);
-    
-        for(int i = 0; i < NlocalT; i++) {
-          xBuffer[i] = 0; 
-        }
- 
-        auto boomerAMG = (hypreWrapper::boomerAMG_t*) coarseLevel->boomerAMG;
-        boomerAMG->solve(Gx, xBuffer);
 
-        ogsScatter(Sx, xBuffer, ogsPfloat, ogsAdd, ogs);
-      }
+  auto coarseSolve = [&]() {
+    for(int i = 0; i < Nlocal; i++)
+      Sx[i] *= this->coarseLevel->weight[i]; 
+    ogsGather(Gx, Sx, ogsPfloat, ogsAdd, ogs);
+
+    for(int i = 0; i < NlocalT; i++) {
+      xBuffer[i] = 0; 
     }
+
+    coarseLevel->solveHost(Gx, xBuffer);
+
+    ogsScatter(Sx, xBuffer, ogsPfloat, ogsAdd, ogs);
+  };
+
+  if(overlapCrsGridSolve) {
+    // the helper thread must not touch the (non thread-safe) timer, its time is added after the join
+    double tCoarse = 0;
+    const double tStart = MPI_Wtime();
+    std::thread coarseThread([&]() {
+      pinThread(overlapCrsCores);
+#ifdef _OPENMP
+      omp_set_num_threads(overlapCrsThreads);
+#endif
+      const double t0 = MPI_Wtime();
+      coarseSolve();
+      tCoarse = MPI_Wtime() - t0;
+    });
+
+#ifdef _OPENMP
+    // leave the reserved cores to the coarse solve
+    const int nThreads = omp_get_max_threads();
+    if(overlapCrsCores.size())
+      omp_set_num_threads(std::max(nThreads - overlapCrsThreads, 1));
+#endif
+
+    schwarzSolve(this);
+    o_x.getDevice().finish();
+    const double tSmoother = MPI_Wtime() - tStart;
+
+    coarseThread.join();
+    const double tWall = MPI_Wtime() - tStart;
+
+#ifdef _OPENMP
+    omp_set_num_threads(nThreads);
+#endif
+
+    addTime("coarseSolve", tCoarse);
+    addTime("coarseSolve overlapped", std::max(tSmoother + tCoarse - tWall, 0.0));
+  } else {
+    schwarzSolve(this);
+
+    platform->timer.tic("coarseSolve", 1);
+    coarseSolve();
+    platform->timer.toc("coarseSolve");
   }
 
   o_x.copyFrom(Sx, Nlocal*sizeof(pfloat));
@@ -28,6 +28,7 @@ SOFTWARE.
 #define MGSOLVER_HPP
 
 #include <functional>
+#include <vector>
 
 #include "nrssys.hpp"
 #include "defines.hpp"
@@ -38,6 +39,7 @@ SOFTWARE.
 #include "hypreWrapper.hpp"
 #include "hypreWrapperDevice.hpp"
 #include "AMGX.hpp"
+#include "SAAMG.hpp"
 
 class MGSolver_t {
 
@@ -96,11 +98,36 @@ public:
 
     void setupSolver(hlong* globalRowStarts, dlong nnz, hlong* Ai, hlong* Aj, dfloat* Avals, bool nullSpace);
     void solve(occa::memory& o_rhs, occa::memory& o_x);
+    void solveHost(pfloat *rhs, pfloat *x);
     std::function<void(coarseLevel_t *, occa::memory&, occa::memory&)> solvePtr = nullptr;
  
     void *boomerAMG = nullptr;
     AMGX_t *AMGX = nullptr;
-  
+    SAAMG_t *SAAMG = nullptr;
+
+    // persisted SAAMG hierarchy is reused if set (see amgCache)
+    std::string cacheKey;
+
+    // coarse system agglomerated onto the first rank of each group
+    bool agglomerate = false;
+    MPI_Comm groupComm = MPI_COMM_NULL;
+    MPI_Comm solverComm = MPI_COMM_NULL;
+    std::vector<int> groupCounts, groupDispls;
+    std::vector<int> groupNnzCounts, groupNnzDispls;
+    std::vector<pfloat> groupRhs, groupX;
+
+    // numeric-only refresh, values are reassembled (collective, row sorted COO) and
+    // mapped onto the sparsity pattern of the setup
+    std::function<void(std::vector<hlong> &, std::vector<hlong> &, std::vector<dfloat> &)> assemble;
+    std::vector<hlong> setupAi, setupAj;
+    std::vector<double> solverAvals;
+    void update();
+
+  private:
+    void setupAgglomeration(hlong *globalRowStarts,
+                            std::vector<hlong> &Ai,
+                            std::vector<hlong> &Aj,
+                            std::vector<dfloat> &Avals);
   };
 
 
@@ -122,6 +149,10 @@ public:
   bool additive;
   bool overlapCrsGridSolve;
 
+  // host threads and cores (end of the process mask) of the overlapped coarse solve
+  int overlapCrsThreads = 1;
+  std::vector<int> overlapCrsCores;
+
   MGSolver_t(occa::device otherdevice, MPI_Comm othercomm,
            setupAide otheroptions);
 
@@ -27,9 +27,11 @@ SOFTWARE.
 
 #include "limits.h"
 #include "stdio.h"
+#include <algorithm>
 #include "timer.hpp"
 
 #include "AMGX.hpp"
+#include "amgSolver/amgCache.hpp"
 
 #include "platform.hpp"
 #include "linAlg.hpp"
@@ -37,6 +39,13 @@ SOFTWARE.
 
 static occa::kernel vectorDotStarKernel;
 
+namespace {
+
+// automatic agglomeration aims for (at least) this many rows per solver rank
+constexpr hlong agglomerationTargetRows = 4096;
+
+}
+
 MGSolver_t::coarseLevel_t::coarseLevel_t(setupAide options, MPI_Comm comm)
 {
   this->options = options;
@@ -74,8 +83,41 @@ void MGSolver_t::coarseLevel_t::setupSolver(
   h_xBuffer = platform->device.mallocHost(N * sizeof(pfloat));
   xBuffer = (pfloat*) h_xBuffer.ptr(); 
 
+  const bool refresh = options.getArgs("COARSE SOLVER REFRESH").size();
+  if (refresh) {
+    setupAi.assign(Ai, Ai + nnz);
+    setupAj.assign(Aj, Aj + nnz);
+  }
+
+  dlong Nsolver = N;
+  std::vector<hlong> aggAi, aggAj;
+  std::vector<dfloat> aggAvals;
+  agglomerate = !useDevice && options.getArgs("COARSE SOLVER AGGLOMERATION").size();
+  if (agglomerate) {
+    aggAi.assign(Ai, Ai + nnz);
+    aggAj.assign(Aj, Aj + nnz);
+    aggAvals.assign(Avals, Avals + nnz);
+    setupAgglomeration(globalRowStarts, aggAi, aggAj, aggAvals);
+
+    Nsolver = groupRhs.size();
+    nnz = aggAi.size();
+    Ai = aggAi.data();
+    Aj = aggAj.data();
+    Avals = aggAvals.data();
+  } else {
+    solverComm = comm;
+  }
+
+  if (solverComm != MPI_COMM_NULL && refresh)
+    solverAvals.assign(Avals, Avals + nnz);
+
+  // rows are solved by the solver rank of the group
+  if (solverComm == MPI_COMM_NULL) {
+    MPI_Barrier(comm);
+    return;
+  }
+
   if (options.compareArgs("COARSE SOLVER", "BOOMERAMG")){
- 
     double settings[hypreWrapperDevice::NPARAM+1];
     settings[0]  = 1;    /* custom settings              */
     settings[1]  = 10;   /* coarsening                   */
@@ -105,13 +147,13 @@ void MGSolver_t::coarseLevel_t::setupSolver(
 
     if(useDevice) {
       boomerAMG = new hypreWrapperDevice::boomerAMG_t(
-        N,
+        Nsolver,
         nnz,
         Ai,
         Aj,
         Avals,
         (int) nullSpace,
-        comm,
+        solverComm,
         platform->device.occaDevice(),
         useFP32,
         settings,
@@ -119,13 +161,13 @@ void MGSolver_t::coarseLevel_t::setupSolver(
     } else {
       const int Nthreads = 1;
       boomerAMG = new hypreWrapper::boomerAMG_t(
-        N,
+        Nsolver,
         nnz,
         Ai,
         Aj,
         Avals,
         (int) nullSpace,
-        comm,
+        solverComm,
         Nthreads,
         useFP32,
         settings,
@@ -138,17 +180,42 @@ void MGSolver_t::coarseLevel_t::setupSolver(
     char *cfg = NULL;
     if(configFile.size()) cfg = (char*) configFile.c_str();
     AMGX = new AMGX_t(
-      N,
+      Nsolver,
       nnz,
       Ai,
       Aj,
       Avals,
       (int) nullSpace,
-      comm,
+      solverComm,
       platform->device.id(),
       useFP32,
       std::stoi(getenv("NEKRS_GPU_MPI")),
       cfg);
+  }
+  else if (options.compareArgs("COARSE SOLVER", "SAAMG")){
+    double settings[SAAMG_t::NPARAM];
+    SAAMG_t::settings(platform->options, settings);
+
+    auto readHierarchy = [&](std::istream &in) {
+      SAAMG = new SAAMG_t(in, solverComm, useFP32, settings, verbose);
+    };
+    if (cacheKey.empty() || !amgCache::load("crs-saamg", cacheKey, solverComm, readHierarchy)) {
+      delete SAAMG;
+      SAAMG = new SAAMG_t(
+        Nsolver,
+        nnz,
+        Ai,
+        Aj,
+        Avals,
+        (int) nullSpace,
+        solverComm,
+        useFP32,
+        settings,
+        verbose);
+
+      if (cacheKey.size())
+        amgCache::save("crs-saamg", cacheKey, solverComm, [&](std::ostream &out) { SAAMG->write(out); });
+    }
   } else {
     std::string amgSolver;
     options.getArgs("COARSE SOLVER", amgSolver);
@@ -160,6 +227,180 @@ void MGSolver_t::coarseLevel_t::setupSolver(
   if(rank==0) printf("done (%gs)\n", MPI_Wtime()-startTime);
 }
 
+// Ranks are grouped (consecutive ranks or one group per node) and the coarse
+// system of a group is gathered on its first rank. Rows get renumbered such
+// that each solver rank owns a contiguous range of the new global numbering.
+void MGSolver_t::coarseLevel_t::setupAgglomeration(hlong *globalRowStarts,
+                                                   std::vector<hlong> &Ai,
+                                                   std::vector<hlong> &Aj,
+                                                   std::vector<dfloat> &Avals)
+{
+  int rank, size;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+
+  std::string mode;
+  options.getArgs("COARSE SOLVER AGGLOMERATION", mode);
+  if (mode == "NODE") {
+    MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &groupComm);
+  } else {
+    int ratio = 1;
+    if (mode == "AUTO") {
+      const hlong nSolverRanks = std::max(globalRowStarts[size] / agglomerationTargetRows, (hlong) 1);
+      ratio = (nSolverRanks >= size) ? 1 : (size + nSolverRanks - 1) / nSolverRanks;
+    } else {
+      ratio = std::stoi(mode);
+    }
+    ratio = std::clamp(ratio, 1, size);
+    MPI_Comm_split(comm, rank / ratio, rank, &groupComm);
+  }
+
+  int groupRank, groupSize;
+  MPI_Comm_rank(groupComm, &groupRank);
+  MPI_Comm_size(groupComm, &groupSize);
+  const bool solverRank = (groupRank == 0);
+  MPI_Comm_split(comm, solverRank ? 0 : MPI_UNDEFINED, rank, &solverComm);
+
+  const hlong Nlocal = N;
+  hlong groupOffset = 0;
+  MPI_Exscan(&Nlocal, &groupOffset, 1, MPI_HLONG, MPI_SUM, groupComm);
+  if (groupRank == 0) groupOffset = 0;
+
+  hlong groupRows = 0;
+  MPI_Allreduce(&Nlocal, &groupRows, 1, MPI_HLONG, MPI_SUM, groupComm);
+
+  hlong groupStart = 0;
+  if (solverRank) {
+    int solverCommRank;
+    MPI_Comm_rank(solverComm, &solverCommRank);
+    MPI_Exscan(&groupRows, &groupStart, 1, MPI_HLONG, MPI_SUM, solverComm);
+    if (solverCommRank == 0) groupStart = 0;
+  }
+  MPI_Bcast(&groupStart, 1, MPI_HLONG, 0, groupComm);
+
+  std::vector<hlong> newRowStarts(size);
+  const hlong rowStart = groupStart + groupOffset;
+  MPI_Allgather(&rowStart, 1, MPI_HLONG, newRowStarts.data(), 1, MPI_HLONG, comm);
+
+  auto renumber = [&](hlong id) {
+    const int owner = std::upper_bound(globalRowStarts, globalRowStarts + size + 1, id) - globalRowStarts - 1;
+    return newRowStarts[owner] + (id - globalRowStarts[owner]);
+  };
+  for (auto &id : Ai) id = renumber(id);
+  for (auto &id : Aj) id = renumber(id);
+
+  // gather rows and matrix entries on the solver rank
+  const int nnz = Ai.size();
+  auto &nnzCounts = groupNnzCounts;
+  auto &nnzDispls = groupNnzDispls;
+  nnzCounts.resize(groupSize);
+  nnzDispls.assign(groupSize + 1, 0);
+  MPI_Gather(&nnz, 1, MPI_INT, nnzCounts.data(), 1, MPI_INT, 0, groupComm);
+  groupCounts.resize(groupSize);
+  groupDispls.assign(groupSize + 1, 0);
+  MPI_Gather(&N, 1, MPI_INT, groupCounts.data(), 1, MPI_INT, 0, groupComm);
+  for (int r = 0; r < groupSize; r++) {
+    nnzDispls[r + 1] = nnzDispls[r] + nnzCounts[r];
+    groupDispls[r + 1] = groupDispls[r] + groupCounts[r];
+  }
+
+  std::vector<hlong> groupAi(nnzDispls[groupSize]), groupAj(nnzDispls[groupSize]);
+  std::vector<dfloat> groupAvals(nnzDispls[groupSize]);
+  MPI_Gatherv(Ai.data(), nnz, MPI_HLONG, groupAi.data(), nnzCounts.data(), nnzDispls.data(), MPI_HLONG, 0, groupComm);
+  MPI_Gatherv(Aj.data(), nnz, MPI_HLONG, groupAj.data(), nnzCounts.data(), nnzDispls.data(), MPI_HLONG, 0, groupComm);
+  MPI_Gatherv(Avals.data(), nnz, MPI_DFLOAT, groupAvals.data(), nnzCounts.data(), nnzDispls.data(), MPI_DFLOAT, 0, groupComm);
+
+  Ai = std::move(groupAi);
+  Aj = std::move(groupAj);
+  Avals = std::move(groupAvals);
+
+  groupRhs.resize(solverRank ? groupRows : 0);
+  groupX.resize(solverRank ? groupRows : 0);
+
+  int nSolverRanks = solverRank;
+  MPI_Allreduce(MPI_IN_PLACE, &nSolverRanks, 1, MPI_INT, MPI_SUM, comm);
+  if (rank == 0)
+    printf("agglomerating coarse system onto %d ranks ... ", nSolverRanks);
+}
+
+// solve on host buffers, gathers/scatters the group rows if agglomerated
+void MGSolver_t::coarseLevel_t::solveHost(pfloat *rhs, pfloat *x)
+{
+  pfloat *solverRhs = rhs;
+  pfloat *solverX = x;
+
+  if (agglomerate) {
+    MPI_Gatherv(rhs, N, MPI_PFLOAT, groupRhs.data(), groupCounts.data(), groupDispls.data(), MPI_PFLOAT, 0, groupComm);
+    std::fill(groupX.begin(), groupX.end(), 0);
+    solverRhs = groupRhs.data();
+    solverX = groupX.data();
+  }
+
+  if (solverComm != MPI_COMM_NULL) {
+    if (SAAMG) {
+      SAAMG->solve(solverRhs, solverX);
+    } else {
+      auto boomerAMG = (hypreWrapper::boomerAMG_t*) this->boomerAMG;
+      boomerAMG->solve(solverRhs, solverX);
+    }
+  }
+
+  if (agglomerate) {
+    MPI_Scatterv(groupX.data(), groupCounts.data(), groupDispls.data(), MPI_PFLOAT, x, N, MPI_PFLOAT, 0, groupComm);
+  }
+}
+
+// Reassembles the coarse operator (geometry and lambda0 of the coarse level, the fine
+// operator for Galerkin) and refreshes the solver values on the pattern of the setup.
+// Entries missing from the new assembly are zero, new entries are dropped.
+void MGSolver_t::coarseLevel_t::update()
+{
+  std::vector<hlong> Ai, Aj;
+  std::vector<dfloat> Av;
+  assemble(Ai, Aj, Av);
+
+  std::vector<dfloat> Avals(setupAi.size(), 0.0);
+  {
+    size_t n = 0;
+    for (size_t k = 0; k < setupAi.size(); ++k) {
+      while (n < Ai.size() && (Ai[n] < setupAi[k] || (Ai[n] == setupAi[k] && Aj[n] < setupAj[k])))
+        n++;
+      if (n < Ai.size() && Ai[n] == setupAi[k] && Aj[n] == setupAj[k])
+        Avals[k] = Av[n];
+    }
+  }
+
+  if (agglomerate) {
+    std::vector<dfloat> groupAvals(groupNnzDispls.size() ? groupNnzDispls.back() : 0);
+    MPI_Gatherv(Avals.data(),
+                Avals.size(),
+                MPI_DFLOAT,
+                groupAvals.data(),
+                groupNnzCounts.data(),
+                groupNnzDispls.data(),
+                MPI_DFLOAT,
+                0,
+                groupComm);
+    Avals = std::move(groupAvals);
+  }
+
+  if (solverComm == MPI_COMM_NULL)
+    return;
+
+  solverAvals.assign(Avals.begin(), Avals.end());
+
+  const bool useDevice = options.compareArgs("COARSE SOLVER LOCATION", "DEVICE");
+  if (AMGX) {
+    AMGX->update(solverAvals.data());
+  } else if (SAAMG) {
+    SAAMG->update(solverAvals.data());
+  } else if (useDevice) {
+    ((hypreWrapperDevice::boomerAMG_t*) this->boomerAMG)->update(solverAvals.data());
+  } else {
+    ((hypreWrapper::boomerAMG_t*) this->boomerAMG)->update(solverAvals.data());
+  }
+}
+
 MGSolver_t::coarseLevel_t::~coarseLevel_t()
 {
   const auto useDevice = options.compareArgs("COARSE SOLVER LOCATION", "DEVICE");
@@ -170,6 +411,14 @@ MGSolver_t::coarseLevel_t::~coarseLevel_t()
       delete (hypreWrapper::boomerAMG_t*) this->boomerAMG;
   }
   if(AMGX) delete AMGX;
+  if(SAAMG) delete SAAMG;
+
+  if(agglomerate) {
+    MPI_Comm_free(&groupComm);
+    if(solverComm != MPI_COMM_NULL) MPI_Comm_free(&solverComm);
+  }
+
+  if(weight) free(weight);
 
   h_xBuffer.free();
   o_xBuffer.free();
@@ -196,16 +445,13 @@ void MGSolver_t::coarseLevel_t::solve(occa::memory& o_rhs, occa::memory& o_x)
     ogsGather(o_Gx, o_Sx, ogsPfloat, ogsAdd, ogs);
     if(!useDevice) o_Gx.copyTo(Gx, N*sizeof(pfloat));
 
-    if (options.compareArgs("COARSE SOLVER", "BOOMERAMG")){
-      if(useDevice) {
+    if (options.compareArgs("COARSE SOLVER", "AMGX")){
+        AMGX->solve(o_Gx.ptr(), o_xBuffer.ptr());
+    } else if(useDevice) {
         auto boomerAMG = (hypreWrapperDevice::boomerAMG_t*) this->boomerAMG;
         boomerAMG->solve(o_Gx, o_xBuffer);
-      } else {
-        auto boomerAMG = (hypreWrapper::boomerAMG_t*) this->boomerAMG;
-        boomerAMG->solve(Gx, xBuffer); 
-      }
-    } else if (options.compareArgs("COARSE SOLVER", "AMGX")){
-        AMGX->solve(o_Gx.ptr(), o_xBuffer.ptr());
+    } else {
+        solveHost(Gx, xBuffer);
     }
 
     // T->E
@@ -54,7 +54,8 @@ std::vector<int> determineMGLevels(std::string section)
   }
 
   if (platform->options.compareArgs(optionsPrefix + "MULTIGRID SMOOTHER", "ASM") ||
-           platform->options.compareArgs(optionsPrefix + "MULTIGRID SMOOTHER", "RAS")) {
+           platform->options.compareArgs(optionsPrefix + "MULTIGRID SMOOTHER", "RAS") ||
+           platform->options.compareArgs(optionsPrefix + "MULTIGRID SMOOTHER", "MSM")) {
     std::map<int, std::vector<int>> mg_level_lookup = {
         {1, {1}},
         {2, {2, 1}},
@@ -24,12 +24,22 @@
 
  */
 
+#include <array>
+
 #include "elliptic.h"
 #include "ellipticPrecon.h"
 #include "platform.hpp"
 
 namespace{
 
+// kernels (re)assigned by a multigrid level
+std::array<occa::kernel*, 3> kernelsMG(elliptic_t* elliptic)
+{
+  return {&elliptic->AxPfloatKernel,
+          &elliptic->ellipticBlockBuildDiagonalKernel,
+          &elliptic->ellipticBlockBuildDiagonalPfloatKernel};
+}
+
 std::string gen_suffix(const elliptic_t * elliptic, const char * floatString)
 {
   const std::string precision = std::string(floatString);
@@ -50,6 +60,10 @@ elliptic_t* ellipticBuildMultigridLevel(elliptic_t* baseElliptic, int Nc, int Nf
   elliptic_t* elliptic = new elliptic_t();
   memcpy(elliptic,baseElliptic,sizeof(elliptic_t));
 
+  // copied handles are not registered with their kernels, start from empty ones
+  for(auto&& kernel : kernelsMG(elliptic))
+    new (kernel) occa::kernel();
+
   elliptic->mgLevel = true;
 
   mesh_t* mesh = createMeshMG(baseElliptic->mesh, Nc);
@@ -110,6 +124,16 @@ elliptic_t* ellipticBuildMultigridLevel(elliptic_t* baseElliptic, int Nc, int Nf
         elliptic->AxPfloatKernel =
           platform->kernels.get(poissonPrefix + kernelName + kernelSuffix);
       }
+  } else {
+    elliptic->AxPfloatKernel = baseElliptic->AxPfloatKernel;
+  }
+
+  // coarse meshes do not move, only Jacobi smoothing still reads the SoA copy
+  if (elliptic->AxPfloatKernel.properties().has("defines/p_aosoaBytes")) {
+    mesh->interleaveGeometricFactors(true);
+    if (!strstr(pfloatString, dfloatString) &&
+        !elliptic->options.compareArgs("MULTIGRID SMOOTHER", "DAMPEDJACOBI"))
+      mesh->o_ggeoPfloat.free();
   }
 
   elliptic->precon = new precon_t();
@@ -154,3 +178,29 @@ elliptic_t* ellipticBuildMultigridLevel(elliptic_t* baseElliptic, int Nc, int Nf
 
   return elliptic;
 }
+
+// releases what ellipticBuildMultigridLevel allocated, the gs handles built on top are up to the caller
+void ellipticFreeMultigridLevel(elliptic_t* elliptic)
+{
+  ogsFree(elliptic->ogs);
+
+  // empty masks keep the handles of the base solver
+  if(elliptic->Nmasked) elliptic->o_maskIds.free();
+  if(elliptic->NmaskedLocal) elliptic->o_maskIdsLocal.free();
+  if(elliptic->NmaskedGlobal) elliptic->o_maskIdsGlobal.free();
+
+  elliptic->o_invDegree.free();
+  elliptic->o_lambda0.free();
+  if(!elliptic->poisson)
+    elliptic->o_lambda1.free();
+  elliptic->o_interp.free();
+
+  delete elliptic->precon;
+  freeMeshMG(elliptic->mesh);
+
+  for(auto&& kernel : kernelsMG(elliptic))
+    *kernel = occa::kernel();
+
+  // shallow copy, members must not be destructed
+  ::operator delete(elliptic);
+}
@@ -24,10 +24,21 @@
 
  */
 
+#include <array>
+
 #include "elliptic.h"
 #include "platform.hpp"
 
 namespace{
+
+// kernels (re)assigned by a multigrid level
+std::array<occa::kernel*, 3> kernelsMG(elliptic_t* elliptic)
+{
+  return {&elliptic->AxPfloatKernel,
+          &elliptic->ellipticBlockBuildDiagonalKernel,
+          &elliptic->ellipticBlockBuildDiagonalPfloatKernel};
+}
+
 std::string gen_suffix(const elliptic_t * elliptic, const char * floatString)
 {
   const std::string precision = std::string(floatString);
@@ -47,6 +58,10 @@ elliptic_t* ellipticBuildMultigridLevelFine(elliptic_t* baseElliptic)
   elliptic_t* elliptic = new elliptic_t();
   memcpy(elliptic, baseElliptic, sizeof(*baseElliptic));
 
+  // copied handles are not registered with their kernels, start from empty ones
+  for(auto&& kernel : kernelsMG(elliptic))
+    new (kernel) occa::kernel();
+
   elliptic->mgLevel = true;
 
   mesh_t* mesh = elliptic->mesh;
@@ -97,5 +112,24 @@ elliptic_t* ellipticBuildMultigridLevelFine(elliptic_t* baseElliptic)
   elliptic->AxPfloatKernel =
     platform->kernels.get(poissonPrefix + kernelName + kernelSuffix);
 
+  if (elliptic->AxPfloatKernel.properties().has("defines/p_aosoaBytes") &&
+      !mesh->o_ggeoPfloatAoSoA.isInitialized())
+    mesh->interleaveGeometricFactors(true);
+
   return elliptic;
 }
+
+// releases what ellipticBuildMultigridLevelFine allocated, the pfloat geometry stays with the mesh
+void ellipticFreeMultigridLevelFine(elliptic_t* elliptic)
+{
+  elliptic->o_invDegree.free();
+  elliptic->o_lambda0.free();
+  if(!elliptic->poisson)
+    elliptic->o_lambda1.free();
+
+  for(auto&& kernel : kernelsMG(elliptic))
+    *kernel = occa::kernel();
+
+  // shallow copy, members must not be destructed
+  ::operator delete(elliptic);
+}
@@ -38,6 +38,7 @@ enum class SmootherType
   OPT_FOURTH_CHEBYSHEV,
   ASM,
   RAS,
+  MSM,
   JACOBI,
 };
 enum class ChebyshevSmootherType
@@ -73,6 +74,9 @@ public:
   dfloat lambda1, lambda0;
   dfloat maxEig;
 
+  // Ritz vector of maxEig, warm start for refreshed estimates
+  occa::memory o_ritzVector;
+
   int DownLegChebyshevDegree;
   int UpLegChebyshevDegree;
 
@@ -101,10 +105,41 @@ public:
   //local patch data
   occa::memory o_invAP, o_patchesIndex, o_invDegreeAP;
   void* ogs;
-  void* ogsOverlap;
-
-  void* ogsExt;
-  void* ogsExtOverlap;
+  void* ogsOverlap = nullptr;
+
+  void* ogsExt = nullptr;
+  void* ogsExtOverlap = nullptr;
+
+  // extended domain exchange split into halo and rank-local nodes,
+  // interior elements (no halo nodes) are smoothed while the halo exchange is in flight
+  void* ogsExtHalo = nullptr;
+  void* ogsExtLocal = nullptr;
+  dlong NextInteriorElements = 0;
+  dlong NextHaloElements = 0;
+  occa::memory o_extInteriorElementList;
+  occa::memory o_extHaloElementList;
+  void setupExtSplit(int Np_e,
+                     const hlong *maskedGlobalIdsExt,
+                     std::vector<hlong> &maskedGlobalIdsExtHalo,
+                     std::vector<hlong> &maskedGlobalIdsExtLocal);
+
+  // multicolor multiplicative Schwarz, elements of a color share no vertex.
+  // Per color the element lists are stored back to back (offsets into the list):
+  // the color, the elements feeding its extended domains (ext), the elements its
+  // update touches (update) and the elements whose residual changes (residual)
+  std::vector<dlong> colorOffsets;
+  occa::memory o_colorElementList;
+  std::vector<dlong> colorExtOffsets;
+  occa::memory o_colorExtElementList;
+  std::vector<dlong> colorUpdateOffsets;
+  occa::memory o_colorUpdateElementList;
+  std::vector<dlong> colorResidualOffsets;
+  occa::memory o_colorResidualElementList;
+  // gs handles restricted to the (extended) nodes of a color
+  std::vector<void *> ogsColorExt;
+  std::vector<void *> ogsColor;
+  occa::kernel multiplicativeSchwarzUpdateKernel;
+  void setupColors(int Np_e, const hlong *maskedGlobalIdsExt);
 
   void build(
     elliptic_t* pSolver);
@@ -132,6 +167,7 @@ public:
           MPI_Comm comm_,
           bool _isCoarse = false
           );
+  ~pMGLevel();
 
   void Ax(dfloat* /*x*/, dfloat* /*Ax*/) {}
   void Ax(occa::memory o_x, occa::memory o_Ax) final;
@@ -154,6 +190,7 @@ public:
   void smoothChebyshev (occa::memory &o_r, occa::memory &o_x, bool xIsZero);
   void smoothFourthKindChebyshev (occa::memory &o_r, occa::memory &o_x, bool xIsZero);
   void smoothSchwarz (occa::memory &o_r, occa::memory &o_x, bool xIsZero);
+  void smoothMultiplicativeSchwarz (occa::memory &o_r, occa::memory &o_x, bool xIsZero);
   void smoothJacobi (occa::memory &o_r, occa::memory &o_x, bool xIsZero);
 
   void smootherJacobi    (occa::memory &o_r, occa::memory &o_Sr);
@@ -161,7 +198,12 @@ public:
   void Report() final;
 
   void setupSmoother(elliptic_t* base);
+  void setupChebyshev();
   dfloat maxEigSmoothAx();
+  dfloat maxEigSmoothAxArnoldi();
+  dfloat maxEigSmoothAxLanczos(int steps, bool warmStart);
+  std::string eigenvalueCacheKey();
+  void updateMaxEig();
 
   void buildCoarsenerQuadHex(mesh_t **meshLevels, int Nf, int Nc);
 };
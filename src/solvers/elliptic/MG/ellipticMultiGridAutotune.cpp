@@ -0,0 +1,524 @@
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+#include "platform.hpp"
+#include "linAlg.hpp"
+#include "elliptic.h"
+#include "ellipticPrecon.h"
+#include "ellipticMultiGrid.h"
+#include "ellipticMultiGridAutotune.hpp"
+#include "compileKernels.hpp"
+#include "randomVector.hpp"
+
+namespace
+{
+
+// settings picked by the autotuner, also the content of a tuning file
+const std::vector<std::string> tunedKeys = {"MULTIGRID SMOOTHER",
+                                            "MULTIGRID CHEBYSHEV DEGREE",
+                                            "MULTIGRID SCHEDULE",
+                                            "COARSE SOLVER"};
+
+std::string tuningFile(const std::string &section)
+{
+  std::string casename;
+  platform->options.getArgs("CASENAME", casename);
+  return casename + "." + section + ".mgtune";
+}
+
+struct config_t {
+  std::string kind;  // Chebyshev acceleration, empty if none
+  std::string inner; // ASM, RAS or DAMPEDJACOBI
+  int degree = 0;    // 0 if not set (schedule or default)
+  std::string schedule;
+  std::string coarseSolver;
+
+  std::string smoother() const { return kind.empty() ? inner : kind + "+" + inner; }
+
+  // anything else can be changed without rebuilding the hierarchy
+  bool sameHierarchy(const config_t &other) const
+  {
+    return inner == other.inner && schedule == other.schedule && coarseSolver == other.coarseSolver;
+  }
+
+  std::string str() const
+  {
+    std::string s = smoother();
+    if (degree > 0)
+      s += "(" + std::to_string(degree) + ")";
+    if (schedule.size())
+      s += " " + schedule;
+    if (coarseSolver.size())
+      s += " " + coarseSolver;
+    return s;
+  }
+};
+
+config_t currentConfig(setupAide &options, const std::string &prefix = "")
+{
+  config_t cfg;
+
+  const std::string smoother = options.getArgs(prefix + "MULTIGRID SMOOTHER");
+  for (auto &&kind : {"FOURTHOPTCHEBYSHEV", "FOURTHCHEBYSHEV", "CHEBYSHEV"}) {
+    if (smoother.find(kind) != std::string::npos) {
+      cfg.kind = kind;
+      break;
+    }
+  }
+
+  cfg.inner = "DAMPEDJACOBI";
+  if (smoother.find("ASM") != std::string::npos)
+    cfg.inner = "ASM";
+  else if (smoother.find("RAS") != std::string::npos)
+    cfg.inner = "RAS";
+  else if (smoother.find("MSM") != std::string::npos)
+    cfg.inner = "MSM";
+
+  options.getArgs(prefix + "MULTIGRID CHEBYSHEV DEGREE", cfg.degree);
+  cfg.schedule = options.getArgs(prefix + "MULTIGRID SCHEDULE");
+  if (options.compareArgs(prefix + "MULTIGRID COARSE SOLVE", "TRUE"))
+    cfg.coarseSolver = options.getArgs(prefix + "COARSE SOLVER");
+
+  return cfg;
+}
+
+void setConfig(setupAide &options, const std::string &prefix, const config_t &cfg)
+{
+  options.setArgs(prefix + "MULTIGRID SMOOTHER", cfg.smoother());
+
+  if (cfg.degree > 0)
+    options.setArgs(prefix + "MULTIGRID CHEBYSHEV DEGREE", std::to_string(cfg.degree));
+  else
+    options.removeArgs(prefix + "MULTIGRID CHEBYSHEV DEGREE");
+
+  if (cfg.schedule.size())
+    options.setArgs(prefix + "MULTIGRID SCHEDULE", cfg.schedule);
+  else
+    options.removeArgs(prefix + "MULTIGRID SCHEDULE");
+
+  if (cfg.coarseSolver.size())
+    options.setArgs(prefix + "COARSE SOLVER", cfg.coarseSolver);
+}
+
+// V-cycle schedule string, the up leg mirrors the down leg
+std::string scheduleString(const std::vector<int> &levels)
+{
+  std::string s;
+  for (auto &&p : levels)
+    s += "p=" + std::to_string(p) + ",";
+  for (int i = static_cast<int>(levels.size()) - 2; i >= 0; i--)
+    s += "p=" + std::to_string(levels[i]) + ",";
+  s.pop_back();
+  return s;
+}
+
+void writeTuningFile(const std::string &section, const config_t &cfg)
+{
+  if (platform->comm.mpiRank != 0)
+    return;
+
+  const std::string file = tuningFile(section);
+  std::ofstream out(file);
+  out << "MULTIGRID SMOOTHER = " << cfg.smoother() << "\n";
+  out << "MULTIGRID CHEBYSHEV DEGREE = " << (cfg.degree > 0 ? std::to_string(cfg.degree) : "") << "\n";
+  out << "MULTIGRID SCHEDULE = " << cfg.schedule << "\n";
+  if (cfg.coarseSolver.size())
+    out << "COARSE SOLVER = " << cfg.coarseSolver << "\n";
+
+  if (!out.good())
+    printf("could not write multigrid tuning file %s!\n", file.c_str());
+  else
+    printf("multigrid settings written to %s\n", file.c_str());
+}
+
+// Helmholtz levels are built with the coefficients at hand, bring them up to date with the solve
+// that triggered the tuning (see ellipticSolve)
+void updateCoefficients(elliptic_t *elliptic)
+{
+  if (elliptic->poisson)
+    return;
+
+  setupAide &options = elliptic->options;
+  if (options.compareArgs("ELLIPTIC PRECO COEFF FIELD", "TRUE")) {
+    ellipticMultiGridUpdateLambda(elliptic);
+    if (options.compareArgs("MULTIGRID SMOOTHER", "DAMPEDJACOBI"))
+      ellipticUpdateJacobi(elliptic);
+  }
+
+  precon_t *precon = elliptic->precon;
+  if (precon->SEMFEMSolver)
+    precon->SEMFEMSolver->update();
+  else if (precon->MGSolver->coarseLevel && options.compareArgs("MULTIGRID COARSE SOLVE", "TRUE"))
+    precon->MGSolver->coarseLevel->update();
+
+  auto MGSolver = precon->MGSolver;
+  const bool coarseSmoother = options.compareArgs("MULTIGRID COARSE SOLVE", "FALSE") ||
+                              options.compareArgs("MULTIGRID COARSE SOLVE AND SMOOTH", "TRUE");
+  for (int lev = 0; lev < MGSolver->numLevels; lev++) {
+    auto level = (pMGLevel *)MGSolver->levels[lev];
+    if (level->isCoarse && MGSolver->numLevels > 1 && !coarseSmoother)
+      continue;
+    level->updateMaxEig();
+  }
+}
+
+} // namespace
+
+std::vector<std::vector<int>> multigridAutotuneLevels(int N)
+{
+  std::vector<std::vector<int>> candidates;
+  if (N < 2)
+    return candidates;
+
+  auto add = [&](std::vector<int> levels) {
+    levels.push_back(1);
+    if (std::find(candidates.begin(), candidates.end(), levels) == candidates.end())
+      candidates.push_back(levels);
+  };
+
+  {
+    // every other degree
+    std::vector<int> levels;
+    for (int p = N; p > 1; p -= 2)
+      levels.push_back(p);
+    add(levels);
+  }
+
+  {
+    // halve the degree
+    std::vector<int> levels;
+    for (int p = N; p > 1; p = (p + 1) / 2)
+      levels.push_back(p);
+    add(levels);
+  }
+
+  // two-level
+  add({N});
+
+  return candidates;
+}
+
+bool multigridAutotuneLoad(const std::string &section)
+{
+  const std::string prefix = createOptionsPrefix(section);
+  if (!platform->options.compareArgs(prefix + "MULTIGRID AUTOTUNE", "FILE"))
+    return false;
+
+  const std::string file = tuningFile(section);
+
+  std::string content;
+  int found = 0;
+  if (platform->comm.mpiRank == 0) {
+    std::ifstream in(file);
+    if (in) {
+      std::stringstream ss;
+      ss << in.rdbuf();
+      content = ss.str();
+      found = 1;
+    }
+  }
+  MPI_Bcast(&found, 1, MPI_INT, 0, platform->comm.mpiComm);
+  if (!found)
+    return false;
+
+  int size = content.size();
+  MPI_Bcast(&size, 1, MPI_INT, 0, platform->comm.mpiComm);
+  content.resize(size);
+  MPI_Bcast(content.data(), size, MPI_CHAR, 0, platform->comm.mpiComm);
+
+  std::istringstream in(content);
+  std::string line;
+  while (std::getline(in, line)) {
+    const auto pos = line.find(" = ");
+    if (pos == std::string::npos)
+      continue;
+
+    const std::string key = line.substr(0, pos);
+    const std::string value = line.substr(pos + 3);
+    if (std::find(tunedKeys.begin(), tunedKeys.end(), key) == tunedKeys.end())
+      continue;
+
+    if (value.empty())
+      platform->options.removeArgs(prefix + key);
+    else
+      platform->options.setArgs(prefix + key, value);
+  }
+
+  // nothing left to tune
+  platform->options.removeArgs(prefix + "MULTIGRID AUTOTUNE");
+
+  if (platform->comm.mpiRank == 0)
+    printf("loaded %s multigrid settings from %s\n", section.c_str(), file.c_str());
+
+  return true;
+}
+
+// Times a few solves with candidate pMG settings and keeps the fastest. Settings are tuned one at a
+// time (coordinate search): Chebyshev degree and kind are reset in place, smoother, schedule and
+// coarse solver require a rebuild of the hierarchy.
+// Poisson solvers are tuned at setup, Helmholtz solvers at their first solve (see ellipticSolve)
+// once the coefficients are known.
+void ellipticMultiGridAutotune(elliptic_t *elliptic)
+{
+  setupAide &options = elliptic->options;
+  mesh_t *mesh = elliptic->mesh;
+  const std::string prefix = createOptionsPrefix(elliptic->name);
+  const int rank = platform->comm.mpiRank;
+
+  const config_t initial = currentConfig(options);
+  config_t built = initial;
+
+  auto build = [&](const config_t &cfg) {
+    setConfig(options, "", cfg);
+    setConfig(platform->options, prefix, cfg);
+
+    if (!cfg.sameHierarchy(built)) {
+      free(elliptic->levels);
+      ellipticMultiGridFree(elliptic, elliptic->precon);
+      delete elliptic->precon;
+      ellipticPreconditionerSetup(elliptic, elliptic->ogs);
+      built = cfg;
+      updateCoefficients(elliptic);
+      return;
+    }
+
+    auto MGSolver = elliptic->precon->MGSolver;
+    const bool coarseSmoother = options.compareArgs("MULTIGRID COARSE SOLVE", "FALSE") ||
+                                options.compareArgs("MULTIGRID COARSE SOLVE AND SMOOTH", "TRUE");
+    for (int lev = 0; lev < MGSolver->numLevels; lev++) {
+      auto level = (pMGLevel *)MGSolver->levels[lev];
+      if (level->isCoarse && MGSolver->numLevels > 1 && !coarseSmoother)
+        continue;
+
+      setConfig(level->options, "", cfg);
+      level->setupChebyshev();
+    }
+  };
+
+  options.removeArgs("MULTIGRID AUTOTUNE");
+
+  // another solver of this section (e.g. a segregated velocity component) was tuned already
+  if (!platform->options.getArgs(prefix + "MULTIGRID AUTOTUNE").size()) {
+    const config_t tuned = currentConfig(platform->options, prefix);
+    if (rank == 0)
+      printf("using %s multigrid settings %s\n", elliptic->name.c_str(), tuned.str().c_str());
+    platform->timer.disable();
+    if (tuned.sameHierarchy(built))
+      updateCoefficients(elliptic);
+    build(tuned);
+    platform->timer.enable();
+    return;
+  }
+
+  if (rank == 0)
+    printf("autotuning %s multigrid preconditioner ...\n", elliptic->name.c_str());
+  fflush(stdout);
+
+  MPI_Barrier(platform->comm.mpiComm);
+  const double tStart = MPI_Wtime();
+
+  // keep trial solves out of the solver statistics
+  platform->timer.disable();
+
+  // the hierarchy was built before the coefficients of this solve were set
+  updateCoefficients(elliptic);
+
+  auto scope = platform->memoryArena.scope("multigrid autotune");
+  ellipticAllocateWorkspace(elliptic, scope);
+  elliptic->resNormFactor = 1 / mesh->volume;
+
+  // random right-hand sides, assembled, masked and scaled to unit norm
+  // hence absolute and relative stopping criterion coincide
+  const dlong Nentries = elliptic->Nfields * elliptic->fieldOffset;
+  const size_t Nbytes = Nentries * sizeof(dfloat);
+  std::vector<occa::memory> o_rhs(2);
+  for (auto &&o_b : o_rhs) {
+    std::vector<dfloat> b(Nentries, 0.0);
+    for (int fld = 0; fld < elliptic->Nfields; fld++) {
+      const auto r = randomVector<dfloat>(mesh->Nlocal);
+      std::copy(r.begin(), r.end(), b.begin() + fld * elliptic->fieldOffset);
+    }
+
+    o_b = platform->device.malloc(Nbytes, b.data());
+    oogs::startFinish(o_b, elliptic->Nfields, elliptic->fieldOffset, ogsDfloat, ogsAdd, elliptic->oogs);
+    if (elliptic->allNeumann)
+      ellipticZeroMean(elliptic, o_b);
+    ellipticApplyMask(elliptic, o_b, dfloatString);
+
+    const dfloat norm = platform->linAlg->weightedNorm2Many(mesh->Nlocal,
+                                                            elliptic->Nfields,
+                                                            elliptic->fieldOffset,
+                                                            elliptic->o_invDegree,
+                                                            o_b,
+                                                            platform->comm.mpiComm) *
+                        sqrt(elliptic->resNormFactor);
+    platform->linAlg->scale(Nentries, 1 / norm, o_b);
+  }
+
+  occa::memory o_r = platform->device.malloc(Nbytes);
+  occa::memory o_x = platform->device.malloc(Nbytes);
+
+  dfloat tol = 1e-6;
+  options.getArgs("SOLVER TOLERANCE", tol);
+  int maxIter = 999;
+  options.getArgs("MAXIMUM ITERATIONS", maxIter);
+
+  auto solve = [&](occa::memory &o_b) {
+    o_r.copyFrom(o_b, Nbytes);
+    platform->linAlg->fill(Nentries, 0.0, o_x);
+
+    dfloat resNorm = 1;
+    if (options.compareArgs("SOLVER", "MIXEDPRECISION"))
+      return ir(elliptic, o_r, o_x, tol, maxIter, resNorm);
+    else if (options.compareArgs("SOLVER", "PCG"))
+      return pcg(elliptic, o_r, o_x, tol, maxIter, resNorm);
+    else
+      return pgmres(elliptic, o_r, o_x, tol, maxIter, resNorm);
+  };
+
+  auto measure = [&](int &iterations) {
+    // the first solve pays for any lazy initialization
+    solve(o_rhs[0]);
+
+    platform->device.finish();
+    MPI_Barrier(platform->comm.mpiComm);
+    const double start = MPI_Wtime();
+
+    iterations = 0;
+    for (auto &&o_b : o_rhs)
+      iterations += solve(o_b);
+
+    platform->device.finish();
+    double elapsed = MPI_Wtime() - start;
+    MPI_Allreduce(MPI_IN_PLACE, &elapsed, 1, MPI_DOUBLE, MPI_MAX, platform->comm.mpiComm);
+
+    return elapsed;
+  };
+
+  config_t best = initial;
+  double bestTime = std::numeric_limits<double>::max();
+
+  auto trial = [&](const config_t &cfg) {
+    build(cfg);
+
+    int iterations;
+    const double elapsed = measure(iterations);
+    if (rank == 0)
+      printf("  %-60s iter: %4d  time: %.3es\n", cfg.str().c_str(), iterations, elapsed);
+    fflush(stdout);
+
+    if (elapsed < bestTime) {
+      bestTime = elapsed;
+      best = cfg;
+    }
+    return elapsed;
+  };
+
+  // degree first, then the kind of Chebyshev acceleration at the best degree
+  auto trialChebyshev = [&](const config_t &cfg) {
+    if (cfg.kind.empty() || cfg.schedule.find("degree") != std::string::npos) {
+      trial(cfg);
+      return;
+    }
+
+    config_t localBest = cfg;
+    double localBestTime = std::numeric_limits<double>::max();
+    for (int degree = 1; degree <= 4; degree++) {
+      config_t c = cfg;
+      c.degree = degree;
+      const double elapsed = trial(c);
+      if (elapsed < localBestTime) {
+        localBestTime = elapsed;
+        localBest = c;
+      }
+    }
+
+    for (auto &&kind : {"FOURTHOPTCHEBYSHEV", "FOURTHCHEBYSHEV", "CHEBYSHEV"}) {
+      if (localBest.kind == kind)
+        continue;
+      config_t c = localBest;
+      c.kind = kind;
+      trial(c);
+    }
+  };
+
+  trialChebyshev(initial);
+
+  // Schwarz or Jacobi smoothing, a multiplicative cycle requires Chebyshev acceleration for these
+  // (Helmholtz levels only support Jacobi, see checkConfig)
+  if (elliptic->poisson) {
+    const bool multiplicative = options.compareArgs("MGSOLVER CYCLE", "MULTIPLICATIVE");
+    std::vector<std::string> inners = {"ASM", "RAS"};
+    if (multiplicative)
+      inners.push_back("DAMPEDJACOBI");
+
+    const config_t base = best;
+    for (auto &&inner : inners) {
+      if (inner == base.inner)
+        continue;
+      config_t c = base;
+      c.inner = inner;
+      if (c.kind.empty() && multiplicative)
+        c.kind = "FOURTHOPTCHEBYSHEV";
+      trialChebyshev(c);
+    }
+
+    // multicolor multiplicative Schwarz runs without Chebyshev acceleration
+    if (base.inner != "MSM") {
+      config_t c = base;
+      c.kind.clear();
+      c.inner = "MSM";
+      c.degree = 0;
+      trial(c);
+    }
+  }
+
+  // pMG schedule, skipping candidates identical to the levels of the current best
+  {
+    const config_t base = best;
+    setConfig(platform->options, prefix, base);
+    const std::vector<int> baseLevels = determineMGLevels(elliptic->name);
+
+    for (auto &&levels : multigridAutotuneLevels(mesh->N)) {
+      if (levels == baseLevels)
+        continue;
+      if (options.compareArgs("MULTIGRID SEMFEM", "TRUE") && levels.back() != baseLevels.back())
+        continue;
+      config_t c = base;
+      c.schedule = scheduleString(levels);
+      trialChebyshev(c);
+    }
+  }
+
+  // AMG solver for the assembled coarse grid system
+  if (options.compareArgs("MULTIGRID COARSE SOLVE", "TRUE") &&
+      options.compareArgs("MULTIGRID SEMFEM", "FALSE") &&
+      options.compareArgs("COARSE SOLVER LOCATION", "CPU")) {
+    const config_t base = best;
+    for (auto &&solver : {"BOOMERAMG", "SAAMG"}) {
+      if (base.coarseSolver == solver)
+        continue;
+      config_t c = base;
+      c.coarseSolver = solver;
+      trial(c);
+    }
+  }
+
+  build(best);
+
+  platform->timer.enable();
+
+  // solvers sharing this section (e.g. segregated velocity components) use the choice as is
+  const bool writeFile = platform->options.compareArgs(prefix + "MULTIGRID AUTOTUNE", "FILE");
+  platform->options.removeArgs(prefix + "MULTIGRID AUTOTUNE");
+
+  if (writeFile)
+    writeTuningFile(elliptic->name, best);
+
+  MPI_Barrier(platform->comm.mpiComm);
+  if (rank == 0)
+    printf("selected %s (%.3es) done (%gs)\n", best.str().c_str(), bestTime, MPI_Wtime() - tStart);
+  fflush(stdout);
+}
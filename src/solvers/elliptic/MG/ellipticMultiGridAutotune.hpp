@@ -0,0 +1,14 @@
+#ifndef ELLIPTIC_MG_AUTOTUNE_HPP
+#define ELLIPTIC_MG_AUTOTUNE_HPP
+
+#include <string>
+#include <vector>
+
+// pMG levels probed by the autotuner, kernels are registered for all of them
+std::vector<std::vector<int>> multigridAutotuneLevels(int N);
+
+// applies a tuning file written by an earlier run to the platform options (collective),
+// returns false if there is none
+bool multigridAutotuneLoad(const std::string &section);
+
+#endif
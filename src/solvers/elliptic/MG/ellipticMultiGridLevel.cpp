@@ -28,6 +28,7 @@
 #include "ellipticPrecon.h"
 #include "ellipticMultiGrid.h"
 #include "linAlg.hpp"
+#include "ellipticFusedOps.hpp"
 #include <iostream>
 void pMGLevel::Ax(occa::memory o_x, occa::memory o_Ax)
 {
@@ -97,6 +98,8 @@ void pMGLevel::smooth(occa::memory o_rhs, occa::memory o_x, bool x_is_zero)
     this->smoothSchwarz(o_rhs, o_x, x_is_zero);
   else if (smootherType == SmootherType::RAS)
     this->smoothSchwarz(o_rhs, o_x, x_is_zero);
+  else if (smootherType == SmootherType::MSM)
+    this->smoothMultiplicativeSchwarz(o_rhs, o_x, x_is_zero);
   else if (smootherType == SmootherType::JACOBI)
     this->smoothJacobi(o_rhs, o_x, x_is_zero);
 
@@ -161,31 +164,43 @@ void pMGLevel::smoothChebyshev (occa::memory &o_r, occa::memory &o_x, bool xIsZe
   occa::memory o_Ad  = o_smootherResidual2;
   occa::memory o_d   = o_smootherUpdate;
 
-  double flopCount = 0.0;
+  // the Jacobi smoother is applied inside the fused updates
+  const bool jacobi = chebySmootherType == ChebyshevSmootherType::JACOBI;
+  auto linAlg = platform->linAlg;
 
-  if (xIsZero) {
-    platform->linAlg->pfill(Nrows, zero, o_x);
-  }
+  double flopCount = 0.0;
 
   // res = S(r-Ax)
-  if (!xIsZero) {
-    this->Ax(o_x,o_res);
-    platform->linAlg->paxpby(Nrows, one, o_r, mone, o_res);
-    flopCount += 2 * Nrows;
+  // d = invTheta*res
+  if (jacobi) {
+    if (xIsZero) {
+      linAlg->fused(ellipticFusedOps::chebyshevJacobiStartZero, Nrows, 1, 0, {invTheta}, {o_r, o_invDiagA, o_res, o_d, o_x});
+      flopCount += 2 * Nrows;
+    } else {
+      this->Ax(o_x,o_res);
+      linAlg->fused(ellipticFusedOps::chebyshevJacobiStart, Nrows, 1, 0, {invTheta}, {o_r, o_invDiagA, o_res, o_d});
+      flopCount += 3 * Nrows;
+    }
   } else {
-    o_res.copyFrom(o_r, Nrows*sizeof(pfloat));
+    if (xIsZero) {
+      linAlg->fused(ellipticFusedOps::smootherStartZero, Nrows, 1, 0, {}, {o_r, o_res, o_x});
+    } else {
+      this->Ax(o_x,o_res);
+      platform->linAlg->paxpby(Nrows, one, o_r, mone, o_res);
+      flopCount += 2 * Nrows;
+    }
+    this->smoother(o_res, o_res, xIsZero);
+
+    platform->linAlg->paxpby(Nrows, invTheta, o_res, zero, o_d);
+    flopCount += Nrows;
   }
-  this->smoother(o_res, o_res, xIsZero);
-
-  // d = invTheta*res
-  platform->linAlg->paxpby(Nrows, invTheta, o_res, zero, o_d);
-  flopCount += Nrows;
 
   for (int k = 1; k < ChebyshevDegree; k++) {
 
     // SAd_k
     this->Ax(o_d,o_Ad);
-    this->smoother(o_Ad, o_Ad, xIsZero);
+    if (!jacobi)
+      this->smoother(o_Ad, o_Ad, xIsZero);
 
     // x_k+1 = x_k + d_k
     // r_k+1 = r_k - SAd_k
@@ -197,9 +212,13 @@ void pMGLevel::smoothChebyshev (occa::memory &o_r, occa::memory &o_x, bool xIsZe
     const pfloat rCoeff = 2.0 * rho_n / delta;
     const pfloat dCoeff = rho_n * rhoSave;
 
-    elliptic->updateChebyshevKernel(Nrows, dCoeff, rCoeff, o_Ad, o_d, o_res, o_x);
-
-    flopCount += 5 * Nrows;
+    if (jacobi) {
+      linAlg->fused(ellipticFusedOps::chebyshevJacobiUpdate, Nrows, 1, 0, {dCoeff, rCoeff}, {o_Ad, o_invDiagA, o_d, o_res, o_x});
+      flopCount += 6 * Nrows;
+    } else {
+      linAlg->fused(ellipticFusedOps::chebyshevUpdate, Nrows, 1, 0, {dCoeff, rCoeff}, {o_Ad, o_d, o_res, o_x});
+      flopCount += 5 * Nrows;
+    }
   }
   //x_k+1 = x_k + d_k
   platform->linAlg->paxpby(Nrows, one, o_d, one, o_x);
@@ -226,12 +245,15 @@ void pMGLevel::smoothFourthKindChebyshev (occa::memory &o_r, occa::memory &o_x,
 
   const auto rho = this->lambda1;
 
+  // the Jacobi smoother is applied inside the fused updates
+  const bool jacobi = chebySmootherType == ChebyshevSmootherType::JACOBI;
+  auto linAlg = platform->linAlg;
+
   double flopCount = 0.0;
 
   // r = b - Ax
   if (xIsZero) {
-    platform->linAlg->pfill(Nrows, zero, o_x);
-    o_res.copyFrom(o_r, Nrows * sizeof(pfloat));
+    linAlg->fused(ellipticFusedOps::smootherStartZero, Nrows, 1, 0, {}, {o_r, o_res, o_x});
   }
   else {
     this->Ax(o_x,o_res);
@@ -240,9 +262,13 @@ void pMGLevel::smoothFourthKindChebyshev (occa::memory &o_r, occa::memory &o_x,
   }
 
   // d = \dfrac{4}{3} \dfrac{1}{\rho(SA)} Sr
-  this->smoother(o_res, o_Ad, xIsZero);
   const pfloat coeff = 4.0 / (3.0 * rho);
-  platform->linAlg->paxpby(Nrows, coeff, o_Ad, zero, o_d);
+  if (jacobi) {
+    platform->linAlg->paxmyz(Nrows, coeff, o_invDiagA, o_res, o_d);
+  } else {
+    this->smoother(o_res, o_Ad, xIsZero);
+    platform->linAlg->paxpby(Nrows, coeff, o_Ad, zero, o_d);
+  }
 
   for (int k = 1; k < ChebyshevDegree; k++) {
 
@@ -251,14 +277,18 @@ void pMGLevel::smoothFourthKindChebyshev (occa::memory &o_r, occa::memory &o_x,
 
     // x_k+1 = x_k + \beta_k d_k
     // r_k+1 = r_k - Ad_k
-    elliptic->updateFourthKindChebyshevKernel(Nrows, betas[k - 1], o_Ad, o_d, o_res, o_x);
-
-    this->smoother(o_res, o_Ad, xIsZero);
-
     // d_k+1 = \dfrac{2k-1}{2k+3} d_k + \dfrac{8k+4}{2k+3} \dfrac{1}{\rho(SA)} S r_k+1
     const pfloat dCoeff = (2.0 * k - 1.0) / (2.0 * k + 3.0);
     const pfloat rCoeff = (8.0 * k + 4.0) / ((2.0 * k + 3.0) * rho);
-    platform->linAlg->paxpby(Nrows, rCoeff, o_Ad, dCoeff, o_d);
+
+    if (jacobi) {
+      linAlg->fused(ellipticFusedOps::fourthKindJacobiUpdate, Nrows, 1, 0, {betas[k - 1], dCoeff, rCoeff}, {o_Ad, o_invDiagA, o_d, o_res, o_x});
+    } else {
+      linAlg->fused(ellipticFusedOps::fourthKindUpdate, Nrows, 1, 0, {betas[k - 1]}, {o_Ad, o_d, o_res, o_x});
+
+      this->smoother(o_res, o_Ad, xIsZero);
+      platform->linAlg->paxpby(Nrows, rCoeff, o_Ad, dCoeff, o_d);
+    }
   }
 
   //x_k+1 = x_k + \beta_k d_k
@@ -30,6 +30,7 @@
 #include "linAlg.hpp"
 #include "parseMultigridSchedule.hpp"
 #include "randomVector.hpp"
+#include "amgSolver/amgCache.hpp"
 
 namespace{
 
@@ -108,18 +109,16 @@ pMGLevel::pMGLevel(elliptic_t* ellipticBase,   //finest level
 
 void pMGLevel::setupSmoother(elliptic_t* ellipticBase)
 {
-  dfloat minMultiplier = 0.1;
-  options.getArgs("MULTIGRID CHEBYSHEV MIN EIGENVALUE BOUND FACTOR", minMultiplier);
-
-  dfloat maxMultiplier = 1.1;
-  options.getArgs("MULTIGRID CHEBYSHEV MAX EIGENVALUE BOUND FACTOR", maxMultiplier);
-
   const bool useASM = options.compareArgs("MULTIGRID SMOOTHER","ASM");
   const bool useRAS = options.compareArgs("MULTIGRID SMOOTHER","RAS");
+  const bool useMSM = options.compareArgs("MULTIGRID SMOOTHER","MSM");
   const bool useJacobi = options.compareArgs("MULTIGRID SMOOTHER","DAMPEDJACOBI");
   if (useASM || useRAS){
     smootherType = useASM ? SmootherType::ASM : SmootherType::RAS;
     build(ellipticBase);
+  } else if (useMSM) {
+    smootherType = SmootherType::MSM;
+    build(ellipticBase);
   } else {
     nrsCheck(!useJacobi, platform->comm.mpiComm, EXIT_FAILURE,
              "%s\n", "Invalid pMGLevel smoother!");
@@ -133,28 +132,43 @@ void pMGLevel::setupSmoother(elliptic_t* ellipticBase)
     smootherType = SmootherType::CHEBYSHEV;
 
     //estimate the max eigenvalue of S*A
-    dfloat rho = this->maxEigSmoothAx();
+    this->maxEig = this->maxEigSmoothAx();
+  }
 
-    lambda1 = maxMultiplier * rho;
-    lambda0 = minMultiplier * rho;
-    this->maxEig = rho;
+  setupChebyshev();
+}
 
-    UpLegChebyshevDegree = 3;
-    DownLegChebyshevDegree = 3;
+// Chebyshev kind, degree and bounds, can be reset without rebuilding the level (see autotuner)
+void pMGLevel::setupChebyshev()
+{
+  if (!options.compareArgs("MULTIGRID SMOOTHER","CHEBYSHEV"))
+    return;
 
-    if(isCoarse) {
-      if(options.compareArgs("MULTIGRID COARSE SOLVE AND SMOOTH", "TRUE")) {
-        UpLegChebyshevDegree = 3;
-        DownLegChebyshevDegree = 3;
-      } else {
-        UpLegChebyshevDegree = 3;
-        DownLegChebyshevDegree = 3;
-      }
+  dfloat minMultiplier = 0.1;
+  options.getArgs("MULTIGRID CHEBYSHEV MIN EIGENVALUE BOUND FACTOR", minMultiplier);
+
+  dfloat maxMultiplier = 1.1;
+  options.getArgs("MULTIGRID CHEBYSHEV MAX EIGENVALUE BOUND FACTOR", maxMultiplier);
+
+  smootherType = SmootherType::CHEBYSHEV;
+
+  lambda1 = maxMultiplier * maxEig;
+  lambda0 = minMultiplier * maxEig;
+
+  UpLegChebyshevDegree = 3;
+  DownLegChebyshevDegree = 3;
+
+  if(isCoarse) {
+    if(options.compareArgs("MULTIGRID COARSE SOLVE AND SMOOTH", "TRUE")) {
+      UpLegChebyshevDegree = 3;
+      DownLegChebyshevDegree = 3;
     } else {
-      options.getArgs("MULTIGRID CHEBYSHEV DEGREE", UpLegChebyshevDegree);
-      options.getArgs("MULTIGRID CHEBYSHEV DEGREE", DownLegChebyshevDegree);
+      UpLegChebyshevDegree = 3;
+      DownLegChebyshevDegree = 3;
     }
-
+  } else {
+    options.getArgs("MULTIGRID CHEBYSHEV DEGREE", UpLegChebyshevDegree);
+    options.getArgs("MULTIGRID CHEBYSHEV DEGREE", DownLegChebyshevDegree);
   }
 
   std::string schedule = options.getArgs("MULTIGRID SCHEDULE");
@@ -199,6 +213,9 @@ void pMGLevel::Report()
     if (smootherType == SmootherType::RAS || chebySmootherType == ChebyshevSmootherType::RAS){
       smootherString += "RAS";
     }
+    if (smootherType == SmootherType::MSM){
+      smootherString += "MSM(" + std::to_string(colorOffsets.size() - 1) + " colors)";
+    }
     if (smootherType == SmootherType::JACOBI || chebySmootherType == ChebyshevSmootherType::JACOBI){
       smootherString += "Jacobi";
     }
@@ -289,55 +306,31 @@ static void eigenValue(const int Nrows, double* A, double* WR, double* WI)
   delete [] WORK;
 }
 
-dfloat pMGLevel::maxEigSmoothAx()
+// Arnoldi process, the smoothed operators of ASM and RAS are not self-adjoint
+dfloat pMGLevel::maxEigSmoothAxArnoldi()
 {
-  MPI_Barrier(platform->comm.mpiComm);
-  const double tStart = MPI_Wtime();
-  if(platform->comm.mpiRank == 0)  printf("estimating maxEigenvalue ... "); fflush(stdout);
-     
   const dlong M = Ncols;
 
   hlong Nlocal = (hlong) Nrows;
   hlong Nglobal = 0;
   MPI_Allreduce(&Nlocal, &Nglobal, 1, MPI_HLONG, MPI_SUM, platform->comm.mpiComm);
 
-  occa::memory o_invDegree = platform->device.malloc(Nlocal*sizeof(dfloat), elliptic->ogs->invDegree);
   const auto k = (unsigned int) std::min(pMGLevel::Narnoldi, Nglobal);
 
   std::vector<double> H(k*k, 0.0);
   std::vector<occa::memory> o_V(k+1);
   auto Vx = randomVector<dfloat>(M);
 
-  size_t offset = 0;
-  const size_t vectorSize = ((M * sizeof(dfloat))/ALIGN_SIZE + 1) * ALIGN_SIZE ;
-
-  for(int i = 0; i <= k; i++) {
-    if(offset + vectorSize < platform->o_mempool.o_ptr.size()) {
-      o_V[i] = platform->o_mempool.o_ptr.slice(offset, vectorSize);
-      offset += vectorSize;
-    } else {
-      o_V[i]  = platform->device.malloc(vectorSize);
-    }
-  }
-
-  occa::memory o_Vx;
-  if(offset + vectorSize < platform->o_mempool.o_ptr.size()) {
-    o_Vx = platform->o_mempool.o_ptr.slice(offset, vectorSize);
-    offset += vectorSize;
-  } else {
-    o_Vx  = platform->device.malloc(vectorSize);
-  }
-
-  occa::memory o_AVx;
-  if(offset + vectorSize < platform->o_mempool.o_ptr.size()) {
-    o_AVx = platform->o_mempool.o_ptr.slice(offset, vectorSize);
-    offset += vectorSize;
-  } else {
-    o_AVx  = platform->device.malloc(vectorSize);
-  }
+  auto scope = platform->memoryArena.scope("multigrid setup");
+  occa::memory o_invDegree = scope.allocate<dfloat>("invDegree", Nlocal);
+  o_invDegree.copyFrom(elliptic->ogs->invDegree, Nlocal*sizeof(dfloat));
+  for(int i = 0; i <= k; i++)
+    o_V[i] = scope.allocate<dfloat>("V", M);
+  occa::memory o_Vx = scope.allocate<dfloat>("Vx", M);
+  occa::memory o_AVx = scope.allocate<dfloat>("AVx", M);
 
-  occa::memory o_AVxPfloat = platform->device.malloc(M, sizeof(pfloat));
-  occa::memory o_VxPfloat = platform->device.malloc(M, sizeof(pfloat));
+  occa::memory o_AVxPfloat = scope.allocate<pfloat>("AVxPfloat", M);
+  occa::memory o_VxPfloat = scope.allocate<pfloat>("VxPfloat", M);
 
   if (options.compareArgs("DISCRETIZATION","CONTINUOUS")) {
     ogsGatherScatter(Vx.data(), ogsDfloat, ogsAdd, mesh->ogs);
@@ -446,8 +439,256 @@ dfloat pMGLevel::maxEigSmoothAx()
       rho = rho_i;
   }
 
+  return rho;
+}
+
+// Lanczos process for S*A, self-adjoint in the A-inner product for Jacobi. The
+// Schwarz smoothers weight their output only, which breaks the symmetry of S.
+// The basis is kept A-orthonormal by carrying u = A v along, both coefficients
+// of a step then come from a single fused reduction.
+dfloat pMGLevel::maxEigSmoothAxLanczos(int steps, bool warmStart)
+{
+  const dlong M = Ncols;
+  const dlong Nlocal = Nrows;
+  const dlong Nfields = elliptic->Nfields;
+  const dlong fieldOffset = elliptic->fieldOffset;
+  const dlong Nvector = Nfields * fieldOffset; // >= M, there are no halo elements
+  auto linAlg = platform->linAlg;
+  MPI_Comm comm = platform->comm.mpiComm;
+
+  hlong Nglobal = 0;
+  {
+    hlong N = Nlocal;
+    MPI_Allreduce(&N, &Nglobal, 1, MPI_HLONG, MPI_SUM, comm);
+  }
+  const int k = (int) std::min((hlong) steps, Nglobal);
+
+  // scratch comes from the arena, refreshes run in every few solves
+  auto scope = platform->memoryArena.scope("multigrid setup");
+  occa::memory o_invDegree = scope.allocate<dfloat>("invDegree", Nlocal);
+  o_invDegree.copyFrom(elliptic->ogs->invDegree, Nlocal * sizeof(dfloat));
+
+  std::vector<occa::memory> o_V(k);
+  for (auto &&o_v : o_V)
+    o_v = scope.allocate<dfloat>("V", Nvector);
+
+  // u[j] and z = A*S*u[j] are adjacent to get both inner products in one reduction
+  occa::memory o_UZ = scope.allocate<dfloat>("UZ", 2 * Nvector);
+  occa::memory o_U = o_UZ.slice(0, Nvector * sizeof(dfloat));
+  occa::memory o_Z = o_UZ.slice(Nvector * sizeof(dfloat));
+  occa::memory o_Uprev = scope.allocate<dfloat>("Uprev", Nvector);
+  occa::memory o_W = scope.allocate<dfloat>("W", Nvector);
+
+  occa::memory o_xPfloat = scope.allocate<pfloat>("xPfloat", Nvector);
+  occa::memory o_yPfloat = scope.allocate<pfloat>("yPfloat", Nvector);
+
+  auto applyA = [&](occa::memory &o_x, occa::memory &o_Ax) {
+    platform->copyDfloatToPfloatKernel(M, o_x, o_xPfloat);
+    ellipticOperator(elliptic, o_xPfloat, o_yPfloat, pfloatString);
+    platform->copyPfloatToDfloatKernel(M, o_yPfloat, o_Ax);
+  };
+
+  auto applyS = [&](occa::memory &o_x, occa::memory &o_Sx) {
+    platform->copyDfloatToPfloatKernel(M, o_x, o_xPfloat);
+    this->smoother(o_xPfloat, o_yPfloat, true);
+    platform->copyPfloatToDfloatKernel(M, o_yPfloat, o_Sx);
+  };
+
+  if (warmStart && o_ritzVector.isInitialized()) {
+    o_V[0].copyFrom(o_ritzVector, Nvector * sizeof(dfloat));
+  } else {
+    auto Vx = randomVector<dfloat>(Nvector);
+
+    if (options.compareArgs("DISCRETIZATION", "CONTINUOUS")) {
+      ogsGatherScatter(Vx.data(), ogsDfloat, ogsAdd, mesh->ogs);
+
+      if (elliptic->Nmasked > 0) {
+        std::vector<dlong> maskIds(elliptic->Nmasked);
+        elliptic->o_maskIds.copyTo(maskIds.data(), elliptic->Nmasked * sizeof(dlong));
+        for (auto &&id : maskIds)
+          Vx[id] = 0.;
+      }
+    }
+    o_V[0].copyFrom(Vx.data(), Nvector * sizeof(dfloat));
+  }
+
+  // v[0] = v[0]/||v[0]||_A
+  applyA(o_V[0], o_U);
+  {
+    const dfloat norm =
+        sqrt(linAlg->weightedInnerProdMany(Nlocal, Nfields, fieldOffset, o_invDegree, o_V[0], o_U, comm));
+    linAlg->scaleMany(Nlocal, Nfields, fieldOffset, 1 / norm, o_V[0]);
+    linAlg->scaleMany(Nlocal, Nfields, fieldOffset, 1 / norm, o_U);
+  }
+
+  std::vector<double> alpha;
+  std::vector<double> beta;
+  double betaPrev = 0;
+  double betaLast = 0;
+
+  for (int j = 0; j < k; j++) {
+    // w = S*A*v[j], z = A*w
+    applyS(o_U, o_W);
+    applyA(o_W, o_Z);
+
+    // alpha = (w, v[j])_A, (w, w)_A
+    dfloat dots[2];
+    linAlg->weightedInnerProdMulti(Nlocal, 2, Nfields, fieldOffset, o_invDegree, o_UZ, o_W, comm, dots);
+
+    const double a = dots[0];
+    const double beta2 = dots[1] - a * a - betaPrev * betaPrev;
+    alpha.push_back(a);
+
+    // invariant subspace found (or loss of orthogonality)
+    if (j + 1 == k || beta2 <= 1e-12 * dots[1]) {
+      betaLast = sqrt(std::max(beta2, 0.0));
+      break;
+    }
+
+    const double b = sqrt(beta2);
+
+    // v[j+1] = (w - alpha v[j] - beta v[j-1])/b
+    o_V[j + 1].copyFrom(o_W, Nvector * sizeof(dfloat));
+    linAlg->axpbyMany(Nlocal, Nfields, fieldOffset, -a, o_V[j], 1.0, o_V[j + 1]);
+    if (j > 0)
+      linAlg->axpbyMany(Nlocal, Nfields, fieldOffset, -betaPrev, o_V[j - 1], 1.0, o_V[j + 1]);
+    linAlg->scaleMany(Nlocal, Nfields, fieldOffset, 1 / b, o_V[j + 1]);
+
+    // u[j+1] = A*v[j+1] by the same recurrence
+    linAlg->axpbyMany(Nlocal, Nfields, fieldOffset, -a, o_U, 1.0, o_Z);
+    if (j > 0)
+      linAlg->axpbyMany(Nlocal, Nfields, fieldOffset, -betaPrev, o_Uprev, 1.0, o_Z);
+    linAlg->scaleMany(Nlocal, Nfields, fieldOffset, 1 / b, o_Z);
+    o_Uprev.copyFrom(o_U, Nvector * sizeof(dfloat));
+    o_U.copyFrom(o_Z, Nvector * sizeof(dfloat));
+
+    beta.push_back(b);
+    betaPrev = b;
+  }
+
+  // eigenpairs of the tridiagonal Lanczos matrix (ascending order)
+  int m = alpha.size();
+  std::vector<double> Y(m * m);
+  {
+    std::vector<double> E(std::max(m - 1, 1), 0.0);
+    std::copy(beta.begin(), beta.begin() + (m - 1), E.begin());
+    std::vector<double> WORK(std::max(2 * m - 2, 1));
+    char JOBZ = 'V';
+    int INFO = -999;
+    dstev_(&JOBZ, &m, alpha.data(), E.data(), Y.data(), &m, WORK.data(), &INFO);
+    nrsCheck(INFO != 0, comm, EXIT_FAILURE, "%s\n", "dstev failed");
+  }
+  // Ritz values approach the spectrum from below, add the residual norm of the
+  // largest Ritz pair to get an upper estimate (Zhou & Li, 2006)
+  const double rho = alpha[m - 1] + betaLast * std::abs(Y[(m - 1) + (m - 1) * m]);
+
+  // Ritz vector of the largest eigenvalue
+  if (!o_ritzVector.isInitialized())
+    o_ritzVector = platform->device.malloc(Nvector, sizeof(dfloat));
+  linAlg->fill(Nvector, 0.0, o_ritzVector);
+  for (int i = 0; i < m; i++)
+    linAlg->axpbyMany(Nlocal, Nfields, fieldOffset, Y[i + (m - 1) * m], o_V[i], 1.0, o_ritzVector);
+
+  return rho;
+}
+
+// identifies the smoothed operator of this level, collective
+std::string pMGLevel::eigenvalueCacheKey()
+{
+  amgCache::key_t key;
+
+  key.add(elliptic->name);
+  key.add(mesh->N);
+  key.add(mesh->Nelements);
+  key.add(mesh->x, mesh->Nlocal);
+  key.add(mesh->y, mesh->Nlocal);
+  key.add(mesh->z, mesh->Nlocal);
+  key.add(mesh->globalIds, mesh->Nlocal);
+
+  std::vector<dlong> maskIds(elliptic->Nmasked);
+  if (elliptic->Nmasked)
+    elliptic->o_maskIds.copyTo(maskIds.data(), elliptic->Nmasked * sizeof(dlong));
+  key.add(maskIds);
+
+  // level coefficients are stored in pfloat
+  std::vector<pfloat> lambda(mesh->Nlocal);
+  elliptic->o_lambda0.copyTo(lambda.data(), mesh->Nlocal * sizeof(pfloat));
+  key.add(lambda);
+  if (!elliptic->poisson) {
+    elliptic->o_lambda1.copyTo(lambda.data(), mesh->Nlocal * sizeof(pfloat));
+    key.add(lambda);
+  }
+  key.add(elliptic->allNeumann);
+
+  key.add(options.getArgs("MULTIGRID SMOOTHER"));
+  key.add(Narnoldi);
+  key.add(std::string(pfloatString));
+
+  return key.str(platform->comm.mpiComm);
+}
+
+dfloat pMGLevel::maxEigSmoothAx()
+{
+  MPI_Barrier(platform->comm.mpiComm);
+  const double tStart = MPI_Wtime();
+  if(platform->comm.mpiRank == 0)  printf("estimating maxEigenvalue ... "); fflush(stdout);
+
+  const bool selfAdjoint = chebySmootherType == ChebyshevSmootherType::JACOBI;
+  const bool useCache = options.compareArgs("MULTIGRID CHEBYSHEV EIGENVALUE CACHE", "TRUE");
+  const size_t Nvector = elliptic->Nfields * elliptic->fieldOffset;
+
+  std::string key;
+  if (useCache) {
+    key = eigenvalueCacheKey();
+
+    double rho = 0;
+    std::vector<dfloat> ritzVector;
+    const bool found = amgCache::load("eig", key, platform->comm.mpiComm, [&](std::istream &in) {
+      amgCache::read(in, rho);
+      amgCache::read(in, ritzVector);
+    });
+
+    if (found) {
+      if (ritzVector.size() == Nvector)
+        o_ritzVector = platform->device.malloc(Nvector * sizeof(dfloat), ritzVector.data());
+
+      MPI_Barrier(platform->comm.mpiComm);
+      if(platform->comm.mpiRank == 0)  printf("%g loaded from cache (%gs)\n", rho, MPI_Wtime() - tStart); fflush(stdout);
+      return rho;
+    }
+  }
+
+  const double rho = selfAdjoint ? maxEigSmoothAxLanczos(Narnoldi, false) : maxEigSmoothAxArnoldi();
+
+  if (useCache) {
+    std::vector<dfloat> ritzVector;
+    if (o_ritzVector.isInitialized()) {
+      ritzVector.resize(Nvector);
+      o_ritzVector.copyTo(ritzVector.data(), Nvector * sizeof(dfloat));
+    }
+    amgCache::save("eig", key, platform->comm.mpiComm, [&](std::ostream &out) {
+      amgCache::write(out, rho);
+      amgCache::write(out, ritzVector);
+    });
+  }
+
   MPI_Barrier(platform->comm.mpiComm);
   if(platform->comm.mpiRank == 0)  printf("%g done (%gs)\n", rho, MPI_Wtime() - tStart); fflush(stdout);
 
   return rho;
 }
+
+// a few Lanczos steps started from the previous Ritz vector track slowly
+// varying operators (moving mesh, variable properties) at a fraction of the setup cost,
+// Schwarz smoothers are not self-adjoint in the A inner product and rerun the full Arnoldi
+void pMGLevel::updateMaxEig()
+{
+  if (!options.compareArgs("MULTIGRID SMOOTHER", "CHEBYSHEV"))
+    return;
+
+  constexpr int refreshSteps = 4;
+  const bool selfAdjoint = chebySmootherType == ChebyshevSmootherType::JACOBI;
+  maxEig = selfAdjoint ? maxEigSmoothAxLanczos(refreshSteps, true) : maxEigSmoothAxArnoldi();
+
+  setupChebyshev();
+}
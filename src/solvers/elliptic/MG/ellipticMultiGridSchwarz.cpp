@@ -55,6 +55,18 @@ struct FDMOperators {
   dfloat *Sz;
   dfloat *D;
 };
+
+// Schwarz gs handles are set up from ids, hence own their ogs
+static void freeSchwarzHandle(void *handle)
+{
+  if (!handle)
+    return;
+  auto gs = (oogs_t *)handle;
+  ogs_t *ogs = gs->ogs;
+  oogs::destroy(gs);
+  ogsFree(ogs);
+}
+
 void harmonic_mean_element_length(ElementLengths *lengths, elliptic_t *elliptic)
 {
   mesh_t *mesh = elliptic->mesh;
@@ -795,6 +807,23 @@ void extrude(pfloat *arr1,
 #undef arr2
 }
 
+// multiplicative Schwarz applies the restricted (RAS) local solves color by color
+bool restrictedSchwarz(setupAide &options)
+{
+  return options.compareArgs("MULTIGRID SMOOTHER", "RAS") || options.compareArgs("MULTIGRID SMOOTHER", "MSM");
+}
+
+// bijection on [0, 2^63), scrambles element ids into coloring priorities without ties
+long long elementPriority(unsigned long long id)
+{
+  constexpr unsigned long long mask = (1ULL << 63) - 1;
+  id = (id * 0x9e3779b97f4a7c15ULL) & mask;
+  id ^= id >> 31;
+  id = (id * 0xbf58476d1ce4e5b9ULL) & mask;
+  id ^= id >> 29;
+  return static_cast<long long>(id);
+}
+
 void pMGLevel::generate_weights()
 {
   // platform_t* platform = platform_t::getInstance();
@@ -834,6 +863,16 @@ void pMGLevel::generate_weights()
   free(wts);
 }
 
+pMGLevel::~pMGLevel()
+{
+  for (void *handle : {ogsOverlap, ogsExt, ogsExtOverlap, ogsExtHalo, ogsExtLocal})
+    freeSchwarzHandle(handle);
+  for (void *handle : ogsColorExt)
+    freeSchwarzHandle(handle);
+  for (void *handle : ogsColor)
+    freeSchwarzHandle(handle);
+}
+
 void pMGLevel::build(elliptic_t *pSolver)
 {
   nrsCheck(elliptic->elementType != HEXAHEDRA,
@@ -842,6 +881,8 @@ void pMGLevel::build(elliptic_t *pSolver)
            "%s\n",
            "Unsupported element type!");
 
+  auto memoryOwner = platform->device.memoryOwner("Schwarz " + pSolver->name);
+
   const dlong Nelements = elliptic->mesh->Nelements;
   const int Nq = elliptic->mesh->Nq;
   const int Np = elliptic->mesh->Np;
@@ -895,7 +936,7 @@ void pMGLevel::build(elliptic_t *pSolver)
   o_Sz = platform->device.malloc(Nq_e * Nq_e * Nelements * sizeof(pfloat));
   o_invL = platform->device.malloc(Nlocal_e * sizeof(pfloat));
   o_work1 = platform->device.malloc(Nlocal_e * sizeof(pfloat));
-  if (!options.compareArgs("MULTIGRID SMOOTHER", "RAS"))
+  if (!restrictedSchwarz(options))
     o_work2 = platform->device.malloc(Nlocal_e * sizeof(pfloat));
   o_Sx.copyFrom(casted_Sx, Nq_e * Nq_e * Nelements * sizeof(pfloat));
   o_Sy.copyFrom(casted_Sy, Nq_e * Nq_e * Nelements * sizeof(pfloat));
@@ -903,7 +944,8 @@ void pMGLevel::build(elliptic_t *pSolver)
   o_invL.copyFrom(casted_D, Nlocal_e * sizeof(pfloat));
 
   {
-    const std::string suffix = std::string("_") + std::to_string(Nq_e - 1) + std::string("pfloat");
+    const std::string suffix = std::string("_") + std::to_string(Nq_e - 1) + std::string("pfloat") +
+                               (restrictedSchwarz(options) ? "RAS" : "");
     preFDMKernel = platform->kernels.get("preFDM" + suffix);
     fusedFDMKernel = platform->kernels.get("fusedFDM" + suffix);
     postFDMKernel = platform->kernels.get("postFDM" + suffix);
@@ -916,6 +958,8 @@ void pMGLevel::build(elliptic_t *pSolver)
   auto autoOverlap = [&]() {
     ogsOverlap = nullptr;
     ogsExtOverlap = nullptr;
+    ogsExtHalo = nullptr;
+    ogsExtLocal = nullptr;
 
     auto timeOperator = [&](occa::memory &o_u, occa::memory &o_Su) {
       const int Nsamples = 10;
@@ -943,7 +987,7 @@ void pMGLevel::build(elliptic_t *pSolver)
       auto nonOverlappedTime = timeOperator(o_u, o_Su);
 
       auto callback = [&]() {
-        if (options.compareArgs("MULTIGRID SMOOTHER", "RAS")) {
+        if (restrictedSchwarz(options)) {
           if (mesh->NlocalGatherElements)
             fusedFDMKernel(mesh->NlocalGatherElements,
                            mesh->o_localGatherElementList,
@@ -970,7 +1014,7 @@ void pMGLevel::build(elliptic_t *pSolver)
 
       double overlappedTime;
       auto overlapEnabled = true;
-      if (options.compareArgs("MULTIGRID SMOOTHER", "RAS")) {
+      if (restrictedSchwarz(options)) {
         auto maskedGlobalIds = (hlong *)calloc(mesh->Nlocal, sizeof(hlong));
         memcpy(maskedGlobalIds, mesh->globalIds, mesh->Nlocal * sizeof(hlong));
         auto maskIds = (dlong *)std::malloc(elliptic->o_maskIds.size());
@@ -993,6 +1037,7 @@ void pMGLevel::build(elliptic_t *pSolver)
 
         overlappedTime = timeOperator(o_u, o_Su);
         if (overlappedTime > nonOverlappedTime) {
+          freeSchwarzHandle(ogsOverlap);
           ogsOverlap = nullptr;
           overlapEnabled = false;
         }
@@ -1011,14 +1056,12 @@ void pMGLevel::build(elliptic_t *pSolver)
 
         overlappedTime = timeOperator(o_u, o_Su);
         if (overlappedTime > nonOverlappedTime) {
+          freeSchwarzHandle(ogsExtOverlap);
           ogsExtOverlap = nullptr;
           overlapEnabled = false;
         }
       }
 
-      o_u.free();
-      o_Su.free();
-
       if (platform->comm.mpiRank == 0) {
         printf("autotuning overlap in smoothSchwarz: %.2es %.2es ", nonOverlappedTime, overlappedTime);
         if (overlapEnabled) {
@@ -1026,6 +1069,91 @@ void pMGLevel::build(elliptic_t *pSolver)
         }
         printf("\n");
       }
+
+      // alternatively hide the extended domain exchange behind the FDM solves of interior elements
+      std::vector<hlong> maskedGlobalIdsExtHalo, maskedGlobalIdsExtLocal;
+      setupExtSplit(Np_e, maskedGlobalIdsExt, maskedGlobalIdsExtHalo, maskedGlobalIdsExtLocal);
+
+      hlong NextInteriorElementsGlobal = NextInteriorElements;
+      MPI_Allreduce(MPI_IN_PLACE, &NextInteriorElementsGlobal, 1, MPI_HLONG, MPI_SUM, platform->comm.mpiComm);
+
+      if (NextInteriorElementsGlobal > 0) {
+        void *ogsOverlapSaved = ogsOverlap;
+        void *ogsExtOverlapSaved = ogsExtOverlap;
+        ogsOverlap = nullptr;
+        ogsExtOverlap = nullptr;
+
+        auto callbackExt = [&]() {
+          if (!NextInteriorElements)
+            return;
+          if (restrictedSchwarz(options))
+            fusedFDMKernel(NextInteriorElements,
+                           o_extInteriorElementList,
+                           o_Su,
+                           o_Sx,
+                           o_Sy,
+                           o_Sz,
+                           o_invL,
+                           elliptic->o_invDegree,
+                           o_work1);
+          else
+            fusedFDMKernel(NextInteriorElements,
+                           o_extInteriorElementList,
+                           o_work2,
+                           o_Sx,
+                           o_Sy,
+                           o_Sz,
+                           o_invL,
+                           o_work1);
+        };
+
+        ogsExtHalo = (void *)oogs::setup(Nelements * Np_e,
+                                         maskedGlobalIdsExtHalo.data(),
+                                         1,
+                                         0,
+                                         ogsPfloat,
+                                         platform->comm.mpiComm,
+                                         1,
+                                         platform->device.occaDevice(),
+                                         callbackExt,
+                                         oogsMode);
+        ogsExtLocal = (void *)oogs::setup(Nelements * Np_e,
+                                          maskedGlobalIdsExtLocal.data(),
+                                          1,
+                                          0,
+                                          ogsPfloat,
+                                          platform->comm.mpiComm,
+                                          1,
+                                          platform->device.occaDevice(),
+                                          nullptr,
+                                          OOGS_LOCAL);
+
+        const double splitTime = timeOperator(o_u, o_Su);
+        const double bestTime = overlapEnabled ? overlappedTime : nonOverlappedTime;
+        const bool splitEnabled = splitTime < bestTime;
+        if (!splitEnabled) {
+          freeSchwarzHandle(ogsExtHalo);
+          freeSchwarzHandle(ogsExtLocal);
+          ogsExtHalo = nullptr;
+          ogsExtLocal = nullptr;
+          ogsOverlap = ogsOverlapSaved;
+          ogsExtOverlap = ogsExtOverlapSaved;
+        } else {
+          freeSchwarzHandle(ogsOverlapSaved);
+          freeSchwarzHandle(ogsExtOverlapSaved);
+        }
+
+        if (platform->comm.mpiRank == 0) {
+          printf("autotuning split extended exchange in smoothSchwarz: %.2es ", splitTime);
+          if (splitEnabled) {
+            printf("(split enabled)");
+          }
+          printf("\n");
+        }
+      }
+
+      o_u.free();
+      o_Su.free();
     }
   };
 
@@ -1040,10 +1168,14 @@ void pMGLevel::build(elliptic_t *pSolver)
                                nullptr,
                                oogsMode);
 
-  autoOverlap();
+  if (smootherType != SmootherType::MSM)
+    autoOverlap();
+  else
+    setupColors(Np_e, maskedGlobalIdsExt);
 
   free(maskedGlobalIdsExt);
   meshFree(extendedMesh);
+  delete extendedMesh;
 
   generate_weights();
 
@@ -1053,47 +1185,71 @@ void pMGLevel::build(elliptic_t *pSolver)
   free(casted_D);
 }
 
-void pMGLevel::smoothSchwarz(occa::memory &o_u, occa::memory &o_Su, bool xIsZero)
+void pMGLevel::setupExtSplit(int Np_e,
+                             const hlong *maskedGlobalIdsExt,
+                             std::vector<hlong> &maskedGlobalIdsExtHalo,
+                             std::vector<hlong> &maskedGlobalIdsExtLocal)
 {
-  const char *ogsDataTypeString = ogsPfloat;
   const dlong Nelements = elliptic->mesh->Nelements;
-  preFDMKernel(Nelements, o_u, o_work1);
+  const dlong Nlocal_e = Nelements * Np_e;
+  const int rank = platform->comm.mpiRank;
 
-  oogs::startFinish(o_work1, 1, 0, ogsDataTypeString, ogsAdd, (oogs_t *)ogsExt);
+  // ranks taking part in the gather of each extended node
+  std::vector<int> minRank(Nlocal_e, rank);
+  std::vector<int> maxRank(Nlocal_e, rank);
+  ogs_t *ogsExtHandle = ((oogs_t *)ogsExt)->ogs;
+  ogsGatherScatter(minRank.data(), ogsInt, ogsMin, ogsExtHandle);
+  ogsGatherScatter(maxRank.data(), ogsInt, ogsMax, ogsExtHandle);
 
-  if (options.compareArgs("MULTIGRID SMOOTHER", "RAS")) {
-    const int overlap = (ogsOverlap != nullptr) ? 1 : 0;
-    oogs_t *ogsFdm = (overlap) ? (oogs_t *)ogsOverlap : (oogs_t *)ogs;
+  // every node is assembled by exactly one of the two handles
+  maskedGlobalIdsExtHalo.assign(Nlocal_e, 0);
+  maskedGlobalIdsExtLocal.assign(Nlocal_e, 0);
 
-    if (!overlap) {
-      fusedFDMKernel(Nelements,
-                     mesh->o_elementList,
-                     o_Su,
-                     o_Sx,
-                     o_Sy,
-                     o_Sz,
-                     o_invL,
-                     elliptic->o_invDegree,
-                     o_work1);
-    }
-    else {
-      if (mesh->NglobalGatherElements)
-        fusedFDMKernel(mesh->NglobalGatherElements,
-                       mesh->o_globalGatherElementList,
-                       o_Su,
-                       o_Sx,
-                       o_Sy,
-                       o_Sz,
-                       o_invL,
-                       elliptic->o_invDegree,
-                       o_work1);
+  std::vector<dlong> interiorElements, haloElements;
+  for (dlong e = 0; e < Nelements; ++e) {
+    bool isHalo = false;
+    for (int n = 0; n < Np_e; ++n) {
+      const dlong id = e * Np_e + n;
+      if (minRank[id] != rank || maxRank[id] != rank) {
+        maskedGlobalIdsExtHalo[id] = maskedGlobalIdsExt[id];
+        isHalo = true;
+      }
+      else {
+        maskedGlobalIdsExtLocal[id] = maskedGlobalIdsExt[id];
+      }
     }
+    if (isHalo)
+      haloElements.push_back(e);
+    else
+      interiorElements.push_back(e);
+  }
 
-    oogs::start(o_Su, 1, 0, ogsDataTypeString, ogsAdd, ogsFdm);
+  NextInteriorElements = interiorElements.size();
+  NextHaloElements = haloElements.size();
+  if (NextInteriorElements)
+    o_extInteriorElementList =
+        platform->device.malloc(NextInteriorElements * sizeof(dlong), interiorElements.data());
+  if (NextHaloElements)
+    o_extHaloElementList = platform->device.malloc(NextHaloElements * sizeof(dlong), haloElements.data());
+}
 
-    if (overlap && mesh->NlocalGatherElements)
-      fusedFDMKernel(mesh->NlocalGatherElements,
-                     mesh->o_localGatherElementList,
+void pMGLevel::smoothSchwarz(occa::memory &o_u, occa::memory &o_Su, bool xIsZero)
+{
+  const char *ogsDataTypeString = ogsPfloat;
+  const dlong Nelements = elliptic->mesh->Nelements;
+  const bool ras = restrictedSchwarz(options);
+
+  // RAS restricts in place, ASM accumulates the extended solutions before restriction
+  occa::memory &o_Sext = ras ? o_Su : o_work2;
+  oogs_t *ogsFdm = ras ? (oogs_t *)ogs : (oogs_t *)ogsExt;
+  oogs_t *ogsFdmOverlap = ras ? (oogs_t *)ogsOverlap : (oogs_t *)ogsExtOverlap;
+
+  auto fusedFDM = [&](dlong NelementsList, occa::memory &o_elementList) {
+    if (!NelementsList)
+      return;
+    if (ras)
+      fusedFDMKernel(NelementsList,
+                     o_elementList,
                      o_Su,
                      o_Sx,
                      o_Sy,
@@ -1101,44 +1257,41 @@ void pMGLevel::smoothSchwarz(occa::memory &o_u, occa::memory &o_Su, bool xIsZero
                      o_invL,
                      elliptic->o_invDegree,
                      o_work1);
+    else
+      fusedFDMKernel(NelementsList, o_elementList, o_work2, o_Sx, o_Sy, o_Sz, o_invL, o_work1);
+  };
+
+  preFDMKernel(Nelements, mesh->o_elementList, o_u, o_work1);
+
+  if (ogsExtHalo) {
+    // interior elements only need rank-local contributions
+    oogs::start(o_work1, 1, 0, ogsDataTypeString, ogsAdd, (oogs_t *)ogsExtHalo);
+    oogs::startFinish(o_work1, 1, 0, ogsDataTypeString, ogsAdd, (oogs_t *)ogsExtLocal);
+
+    fusedFDM(NextInteriorElements, o_extInteriorElementList);
 
-    oogs::finish(o_Su, 1, 0, ogsDataTypeString, ogsAdd, ogsFdm);
+    oogs::finish(o_work1, 1, 0, ogsDataTypeString, ogsAdd, (oogs_t *)ogsExtHalo);
+
+    fusedFDM(NextHaloElements, o_extHaloElementList);
+
+    oogs::startFinish(o_Sext, 1, 0, ogsDataTypeString, ogsAdd, ogsFdm);
   }
   else {
-    const int overlap = (ogsExtOverlap != nullptr) ? 1 : 0;
-    oogs_t *ogsFdm = (overlap) ? (oogs_t *)ogsExtOverlap : (oogs_t *)ogsExt;
+    oogs::startFinish(o_work1, 1, 0, ogsDataTypeString, ogsAdd, (oogs_t *)ogsExt);
 
-    if (!overlap) {
-      fusedFDMKernel(Nelements, mesh->o_elementList, o_work2, o_Sx, o_Sy, o_Sz, o_invL, o_work1);
+    if (ogsFdmOverlap) {
+      fusedFDM(mesh->NglobalGatherElements, mesh->o_globalGatherElementList);
+      oogs::start(o_Sext, 1, 0, ogsDataTypeString, ogsAdd, ogsFdmOverlap);
+      fusedFDM(mesh->NlocalGatherElements, mesh->o_localGatherElementList);
+      oogs::finish(o_Sext, 1, 0, ogsDataTypeString, ogsAdd, ogsFdmOverlap);
     }
     else {
-      if (mesh->NglobalGatherElements)
-        fusedFDMKernel(mesh->NglobalGatherElements,
-                       mesh->o_globalGatherElementList,
-                       o_work2,
-                       o_Sx,
-                       o_Sy,
-                       o_Sz,
-                       o_invL,
-                       o_work1);
+      fusedFDM(Nelements, mesh->o_elementList);
+      oogs::startFinish(o_Sext, 1, 0, ogsDataTypeString, ogsAdd, ogsFdm);
     }
+  }
 
-    oogs::start(o_work2, 1, 0, ogsDataTypeString, ogsAdd, ogsFdm);
-
-    if (overlap) {
-      if (mesh->NlocalGatherElements)
-        fusedFDMKernel(mesh->NlocalGatherElements,
-                       mesh->o_localGatherElementList,
-                       o_work2,
-                       o_Sx,
-                       o_Sy,
-                       o_Sz,
-                       o_invL,
-                       o_work1);
-    }
-
-    oogs::finish(o_work2, 1, 0, ogsDataTypeString, ogsAdd, ogsFdm);
-
+  if (!ras) {
     postFDMKernel(Nelements, o_work1, o_work2, o_Su, o_wts);
 
     oogs::startFinish(o_Su, 1, 0, ogsDataTypeString, ogsAdd, (oogs_t *)ogs);
@@ -1154,3 +1307,272 @@ void pMGLevel::smoothSchwarz(occa::memory &o_u, occa::memory &o_Su, bool xIsZero
   const double factor = std::is_same<pfloat, float>::value ? 0.5 : 1.0;
   platform->flopCounter->add(elliptic->name + " Schwarz, N=" + std::to_string(mesh->N), factor * flops);
 }
+
+void pMGLevel::setupColors(int Np_e, const hlong *maskedGlobalIdsExt)
+{
+  const dlong Nelements = mesh->Nelements;
+  const int Nq = mesh->Nq;
+  const int Np = mesh->Np;
+  constexpr int Nverts = 8;
+  MPI_Comm comm = platform->comm.mpiComm;
+
+  // extended domains of elements sharing a vertex overlap,
+  // vertices are identified by the global ids of the corner nodes
+  std::vector<hlong> vertexIds(Nverts * Nelements);
+  for (dlong e = 0; e < Nelements; ++e) {
+    int v = 0;
+    for (int k : {0, Nq - 1})
+      for (int j : {0, Nq - 1})
+        for (int i : {0, Nq - 1})
+          vertexIds[e * Nverts + v++] = mesh->globalIds[e * Np + i + j * Nq + k * Nq * Nq];
+  }
+  ogs_t *ogsVertex = ogsSetup(Nverts * Nelements, vertexIds.data(), comm, 0, platform->device.occaDevice());
+
+  hlong elementOffset = 0;
+  {
+    hlong NelementsLocal = Nelements;
+    MPI_Exscan(&NelementsLocal, &elementOffset, 1, MPI_HLONG, MPI_SUM, comm);
+    if (platform->comm.mpiRank == 0)
+      elementOffset = 0;
+  }
+  std::vector<long long> priority(Nelements);
+  for (dlong e = 0; e < Nelements; ++e)
+    priority[e] = elementPriority(elementOffset + e);
+
+  auto anyGlobal = [&](const std::vector<int> &flags) {
+    int any = std::find(flags.begin(), flags.end(), 1) != flags.end();
+    MPI_Allreduce(MPI_IN_PLACE, &any, 1, MPI_INT, MPI_MAX, comm);
+    return any;
+  };
+
+  // each color is a maximal independent set, picked in rounds by local priority maxima
+  std::vector<int> color(Nelements, -1);
+  std::vector<int> uncolored(Nelements, 1);
+  std::vector<int> candidate(Nelements);
+  std::vector<int> winner(Nelements);
+  std::vector<long long> vertexWork(Nverts * Nelements);
+
+  int Ncolors = 0;
+  while (anyGlobal(uncolored)) {
+    candidate = uncolored;
+
+    while (anyGlobal(candidate)) {
+      for (dlong e = 0; e < Nelements; ++e)
+        for (int v = 0; v < Nverts; ++v)
+          vertexWork[e * Nverts + v] = candidate[e] ? priority[e] : -1;
+      ogsGatherScatter(vertexWork.data(), ogsLong, ogsMax, ogsVertex);
+
+      for (dlong e = 0; e < Nelements; ++e) {
+        winner[e] = candidate[e];
+        for (int v = 0; v < Nverts && winner[e]; ++v)
+          winner[e] = vertexWork[e * Nverts + v] == priority[e];
+
+        if (winner[e]) {
+          color[e] = Ncolors;
+          uncolored[e] = 0;
+          candidate[e] = 0;
+        }
+      }
+
+      // neighbors of this round's winners have to wait for the next color
+      for (dlong e = 0; e < Nelements; ++e)
+        for (int v = 0; v < Nverts; ++v)
+          vertexWork[e * Nverts + v] = winner[e];
+      ogsGatherScatter(vertexWork.data(), ogsLong, ogsMax, ogsVertex);
+
+      for (dlong e = 0; e < Nelements; ++e)
+        for (int v = 0; v < Nverts && candidate[e]; ++v)
+          if (vertexWork[e * Nverts + v])
+            candidate[e] = 0;
+    }
+
+    Ncolors++;
+  }
+
+  ogsFree(ogsVertex);
+
+  colorOffsets.assign(Ncolors + 1, 0);
+  for (dlong e = 0; e < Nelements; ++e)
+    colorOffsets[color[e] + 1]++;
+  for (int c = 0; c < Ncolors; ++c)
+    colorOffsets[c + 1] += colorOffsets[c];
+
+  std::vector<dlong> colorElementList(Nelements);
+  std::vector<dlong> position(colorOffsets.begin(), colorOffsets.end() - 1);
+  for (dlong e = 0; e < Nelements; ++e)
+    colorElementList[position[color[e]]++] = e;
+
+  if (Nelements)
+    o_colorElementList = platform->device.malloc(Nelements * sizeof(dlong), colorElementList.data());
+
+  // a color only reaches the elements around it, restrict its work and exchanges to them
+  std::vector<hlong> maskedGlobalIds(mesh->globalIds, mesh->globalIds + mesh->Nlocal);
+  if (elliptic->Nmasked) {
+    std::vector<dlong> maskIds(elliptic->Nmasked);
+    elliptic->o_maskIds.copyTo(maskIds.data(), elliptic->Nmasked * sizeof(dlong));
+    for (auto &&id : maskIds)
+      maskedGlobalIds[id] = 0;
+  }
+
+  // flags the nodes of the given elements and all their copies,
+  // returns the elements holding a flagged node
+  std::vector<int> flags;
+  auto reach = [&](ogs_t *gsh, int Npe, const std::vector<dlong> &elements) {
+    flags.assign(Nelements * Npe, 0);
+    for (auto &&e : elements)
+      std::fill(flags.begin() + e * Npe, flags.begin() + (e + 1) * Npe, 1);
+    ogsGatherScatter(flags.data(), ogsInt, ogsMax, gsh);
+
+    std::vector<dlong> reached;
+    for (dlong e = 0; e < Nelements; ++e)
+      if (std::find(flags.begin() + e * Npe, flags.begin() + (e + 1) * Npe, 1) != flags.begin() + (e + 1) * Npe)
+        reached.push_back(e);
+    return reached;
+  };
+
+  auto restrictedHandle = [&](int Npe, const hlong *ids) {
+    std::vector<hlong> restrictedIds(Nelements * Npe, 0);
+    for (dlong n = 0; n < Nelements * Npe; ++n)
+      if (flags[n])
+        restrictedIds[n] = ids[n];
+    return (void *)oogs::setup(Nelements * Npe,
+                               restrictedIds.data(),
+                               1,
+                               0,
+                               ogsPfloat,
+                               comm,
+                               0,
+                               platform->device.occaDevice(),
+                               nullptr,
+                               OOGS_DEFAULT);
+  };
+
+  std::vector<dlong> extList, updateList, residualList;
+  colorExtOffsets.assign(1, 0);
+  colorUpdateOffsets.assign(1, 0);
+  colorResidualOffsets.assign(1, 0);
+  for (int c = 0; c < Ncolors; ++c) {
+    const std::vector<dlong> colorElements(colorElementList.begin() + colorOffsets[c],
+                                           colorElementList.begin() + colorOffsets[c + 1]);
+
+    // elements sharing extended nodes with the color
+    const auto ext = reach(((oogs_t *)ogsExt)->ogs, Np_e, colorElements);
+    ogsColorExt.push_back(restrictedHandle(Np_e, maskedGlobalIdsExt));
+
+    // elements sharing nodes with the color
+    const auto update = reach(((oogs_t *)ogs)->ogs, Np, colorElements);
+    ogsColor.push_back(restrictedHandle(Np, maskedGlobalIds.data()));
+
+    // elements sharing nodes with the update elements
+    const auto residual = reach(((oogs_t *)ogs)->ogs, Np, update);
+
+    extList.insert(extList.end(), ext.begin(), ext.end());
+    updateList.insert(updateList.end(), update.begin(), update.end());
+    residualList.insert(residualList.end(), residual.begin(), residual.end());
+    colorExtOffsets.push_back(extList.size());
+    colorUpdateOffsets.push_back(updateList.size());
+    colorResidualOffsets.push_back(residualList.size());
+  }
+
+  if (extList.size())
+    o_colorExtElementList = platform->device.malloc(extList.size() * sizeof(dlong), extList.data());
+  if (updateList.size())
+    o_colorUpdateElementList = platform->device.malloc(updateList.size() * sizeof(dlong), updateList.data());
+  if (residualList.size())
+    o_colorResidualElementList =
+        platform->device.malloc(residualList.size() * sizeof(dlong), residualList.data());
+
+  multiplicativeSchwarzUpdateKernel =
+      platform->kernels.get("multiplicativeSchwarzUpdate_" + std::to_string(mesh->N) + "pfloat");
+}
+
+void pMGLevel::smoothMultiplicativeSchwarz(occa::memory &o_r, occa::memory &o_x, bool xIsZero)
+{
+  occa::memory o_res = o_smootherResidual;
+  occa::memory o_Ad = o_smootherResidual2;
+  occa::memory o_d = o_smootherUpdate;
+
+  const pfloat one = 1.0;
+  const pfloat mone = -1.0;
+  const pfloat zero = 0.0;
+
+  const char *ogsDataTypeString = ogsPfloat;
+  const int Ncolors = colorOffsets.size() - 1;
+
+  if (xIsZero) {
+    platform->linAlg->pfill(Nrows, zero, o_x);
+    o_res.copyFrom(o_r, Nrows * sizeof(pfloat));
+  }
+  else {
+    this->residual(o_r, o_x, o_res);
+  }
+
+  // d and Ad are zero outside the elements of the current color,
+  // the update kernel consumes them
+  platform->linAlg->pfill(Nrows, zero, o_d);
+  platform->linAlg->pfill(Nrows, zero, o_Ad);
+
+  auto elementList = [](occa::memory &o_list, const std::vector<dlong> &offsets, int c) {
+    return (offsets[c + 1] > offsets[c]) ? o_list + offsets[c] * sizeof(dlong) : occa::memory();
+  };
+
+  double NupdateElements = 0;
+  double NresidualElements = 0;
+
+  // colors are visited in reverse order on the up leg (x != 0)
+  for (int i = 0; i < Ncolors; ++i) {
+    const int c = xIsZero ? i : Ncolors - 1 - i;
+    const dlong NcolorElements = colorOffsets[c + 1] - colorOffsets[c];
+    const dlong NextElements = colorExtOffsets[c + 1] - colorExtOffsets[c];
+    const dlong NupdateList = colorUpdateOffsets[c + 1] - colorUpdateOffsets[c];
+    const dlong NresidualList = colorResidualOffsets[c + 1] - colorResidualOffsets[c];
+    auto o_colorList = elementList(o_colorElementList, colorOffsets, c);
+    auto o_extList = elementList(o_colorExtElementList, colorExtOffsets, c);
+    auto o_updateList = elementList(o_colorUpdateElementList, colorUpdateOffsets, c);
+    auto o_residualList = elementList(o_colorResidualElementList, colorResidualOffsets, c);
+
+    // extended residual of the color
+    if (NextElements)
+      preFDMKernel(NextElements, o_extList, o_res, o_work1);
+    oogs::startFinish(o_work1, 1, 0, ogsDataTypeString, ogsAdd, (oogs_t *)ogsColorExt[c]);
+
+    if (NcolorElements)
+      fusedFDMKernel(NcolorElements,
+                     o_colorList,
+                     o_d,
+                     o_Sx,
+                     o_Sy,
+                     o_Sz,
+                     o_invL,
+                     elliptic->o_invDegree,
+                     o_work1);
+
+    oogs::startFinish(o_d, 1, 0, ogsDataTypeString, ogsAdd, (oogs_t *)ogsColor[c]);
+    ellipticApplyMask(elliptic, o_d, pfloatString);
+
+    // residual update for the next color, res -= A d
+    if (i < Ncolors - 1) {
+      ellipticAx(elliptic, NupdateList, o_updateList, o_d, o_Ad, pfloatString);
+      oogs::startFinish(o_Ad, 1, 0, ogsDataTypeString, ogsAdd, (oogs_t *)ogs);
+      ellipticApplyMask(elliptic, o_Ad, pfloatString);
+      if (NresidualList)
+        multiplicativeSchwarzUpdateKernel(NresidualList, o_residualList, mone, o_Ad, o_res);
+      NresidualElements += NresidualList;
+    }
+
+    // x += d
+    if (NupdateList)
+      multiplicativeSchwarzUpdateKernel(NupdateList, o_updateList, one, o_d, o_x);
+    NupdateElements += NupdateList;
+  }
+
+  const auto Nqe = mesh->Nq + 2;
+  const auto Npe = Nqe * Nqe * Nqe;
+  const double flopsPerElem = 12 * Nqe * Npe + Npe;
+  const double flops = static_cast<double>(mesh->Nelements) * flopsPerElem +
+                       2.0 * (NupdateElements + NresidualElements) * mesh->Np;
+
+  const double factor = std::is_same<pfloat, float>::value ? 0.5 : 1.0;
+  platform->flopCounter->add(elliptic->name + " multiplicative Schwarz, N=" + std::to_string(mesh->N),
+                             factor * flops);
+}
@@ -29,6 +29,7 @@
 #include "ellipticPrecon.h"
 #include "ellipticMultiGrid.h"
 #include "ellipticBuildFEM.hpp"
+#include "amgSolver/amgCache.hpp"
 
 void pMGLevelAllocateStorage(pMGLevel *level, int k)
 {
@@ -64,6 +65,7 @@ void ellipticMultiGridSetup(elliptic_t *elliptic_, precon_t *precon_)
   fflush(stdout);
 
   precon_t *precon = precon_;
+  auto memoryOwner = platform->device.memoryOwner("MG " + elliptic_->name);
   // setup new object from fine grid but with constant coeff
   elliptic_t *elliptic = ellipticBuildMultigridLevelFine(elliptic_);
   setupAide options = elliptic_->options;
@@ -134,8 +136,10 @@ void ellipticMultiGridSetup(elliptic_t *elliptic_, precon_t *precon_)
       elliptic->oogsAx = oogs::setup(elliptic->ogs, 1, 0, ogsPfloat, callback, oogsMode);
 
       auto overlappedTime = timeOperator();
-      if (overlappedTime > nonOverlappedTime)
+      if (overlappedTime > nonOverlappedTime) {
+        oogs::destroy(elliptic->oogsAx);
         elliptic->oogsAx = elliptic->oogs;
+      }
 
       if (platform->comm.mpiRank == 0) {
         printf("autotuning overlap in ellipticOperator: %.2es %.2es ", nonOverlappedTime, overlappedTime);
@@ -252,34 +256,76 @@ void ellipticMultiGridSetup(elliptic_t *elliptic_, precon_t *precon_)
     }
     else {
 
-      hlong *coarseGlobalStarts = (hlong *)calloc(platform->comm.mpiCommSize + 1, sizeof(hlong));
+      const bool galerkin = options.compareArgs("GALERKIN COARSE OPERATOR", "TRUE");
 
-      nonZero_t *coarseA;
-      dlong nnzCoarseA;
+      std::string cacheKey;
+      if (options.compareArgs("COARSE SOLVER CACHE", "TRUE"))
+        cacheKey = ellipticCoarseSystemKey(ellipticCoarse, galerkin ? elliptic : nullptr);
 
-      if (options.compareArgs("GALERKIN COARSE OPERATOR", "TRUE"))
-        ellipticBuildFEMGalerkinHex3D(ellipticCoarse, elliptic, &coarseA, &nnzCoarseA, coarseGlobalStarts);
-      else
-        ellipticBuildFEM(ellipticCoarse, &coarseA, &nnzCoarseA, coarseGlobalStarts);
+      std::vector<hlong> coarseGlobalStarts(platform->comm.mpiCommSize + 1, 0);
+      std::vector<hlong> Rows, Cols;
+      std::vector<dfloat> Vals;
 
-      hlong *Rows = (hlong *)calloc(nnzCoarseA, sizeof(hlong));
-      hlong *Cols = (hlong *)calloc(nnzCoarseA, sizeof(hlong));
-      dfloat *Vals = (dfloat *)calloc(nnzCoarseA, sizeof(dfloat));
+      auto readMatrix = [&](std::istream &in) {
+        amgCache::read(in, coarseGlobalStarts);
+        amgCache::read(in, Rows);
+        amgCache::read(in, Cols);
+        amgCache::read(in, Vals);
+      };
 
-      for (dlong i = 0; i < nnzCoarseA; i++) {
-        Rows[i] = coarseA[i].row;
-        Cols[i] = coarseA[i].col;
-        Vals[i] = coarseA[i].val;
-      }
-      free(coarseA);
+      auto assemble = [ellipticCoarse, elliptic, galerkin](std::vector<hlong> &globalStarts,
+                                                           std::vector<hlong> &Rows,
+                                                           std::vector<hlong> &Cols,
+                                                           std::vector<dfloat> &Vals) {
+        nonZero_t *coarseA;
+        dlong nnzCoarseA;
+
+        if (galerkin)
+          ellipticBuildFEMGalerkinHex3D(ellipticCoarse, elliptic, &coarseA, &nnzCoarseA, globalStarts.data());
+        else
+          ellipticBuildFEM(ellipticCoarse, &coarseA, &nnzCoarseA, globalStarts.data());
+
+        Rows.resize(nnzCoarseA);
+        Cols.resize(nnzCoarseA);
+        Vals.resize(nnzCoarseA);
+        for (dlong i = 0; i < nnzCoarseA; i++) {
+          Rows[i] = coarseA[i].row;
+          Cols[i] = coarseA[i].col;
+          Vals[i] = coarseA[i].val;
+        }
+        free(coarseA);
+      };
 
-      precon->MGSolver->coarseLevel
-          ->setupSolver(coarseGlobalStarts, nnzCoarseA, Rows, Cols, Vals, elliptic->allNeumann);
+      const bool cached = cacheKey.size() && amgCache::load("crs", cacheKey, platform->comm.mpiComm, readMatrix);
+      if (cached) {
+        if (platform->comm.mpiRank == 0)
+          printf("loaded FEM matrix from cache\n");
+      }
+      else {
+        assemble(coarseGlobalStarts, Rows, Cols, Vals);
+
+        if (cacheKey.size()) {
+          amgCache::save("crs", cacheKey, platform->comm.mpiComm, [&](std::ostream &out) {
+            amgCache::write(out, coarseGlobalStarts);
+            amgCache::write(out, Rows);
+            amgCache::write(out, Cols);
+            amgCache::write(out, Vals);
+          });
+        }
+      }
 
-      free(coarseGlobalStarts);
-      free(Rows);
-      free(Cols);
-      free(Vals);
+      precon->MGSolver->coarseLevel->cacheKey = cacheKey;
+      precon->MGSolver->coarseLevel->assemble =
+          [assemble](std::vector<hlong> &Rows, std::vector<hlong> &Cols, std::vector<dfloat> &Vals) {
+            std::vector<hlong> globalStarts(platform->comm.mpiCommSize + 1, 0);
+            assemble(globalStarts, Rows, Cols, Vals);
+          };
+      precon->MGSolver->coarseLevel->setupSolver(coarseGlobalStarts.data(),
+                                                 Rows.size(),
+                                                 Rows.data(),
+                                                 Cols.data(),
+                                                 Vals.data(),
+                                                 elliptic->allNeumann);
 
       MGSolver_t::coarseLevel_t *coarseLevel = precon->MGSolver->coarseLevel;
       coarseLevel->ogs = ellipticCoarse->ogs;
@@ -341,3 +387,34 @@ void ellipticMultiGridSetup(elliptic_t *elliptic_, precon_t *precon_)
   if (platform->comm.mpiRank == 0)
     printf("-----------------------------------------------------------------------\n");
 }
+
+// counterpart of ellipticMultiGridSetup, call before deleting precon
+void ellipticMultiGridFree(elliptic_t *elliptic_, precon_t *precon)
+{
+  MGSolver_t *MGSolver = precon->MGSolver;
+
+  // Run points the fine level vectors to the caller's buffers, they must not be freed with the level
+  if (MGSolver->numLevels) {
+    MGSolver->levels[0]->o_x = occa::memory();
+    MGSolver->levels[0]->o_rhs = occa::memory();
+  }
+
+  for (int lev = 0; lev < MGSolver->numLevels; lev++) {
+    auto level = (pMGLevel *)MGSolver->levels[lev];
+    elliptic_t *elliptic = level->elliptic;
+
+    // a single level hierarchy runs on the gs handles of the base solver
+    if (elliptic->oogsAx != elliptic->oogs && elliptic->oogsAx != elliptic_->oogsAx)
+      oogs::destroy(elliptic->oogsAx);
+    if (elliptic->oogs != elliptic_->oogs)
+      oogs::destroy(elliptic->oogs);
+
+    if (lev == 0)
+      ellipticFreeMultigridLevelFine(elliptic);
+    else
+      ellipticFreeMultigridLevel(elliptic);
+
+    level->elliptic = nullptr;
+    level->mesh = nullptr;
+  }
+}
@@ -33,3 +33,32 @@ ellipticMultiGridUpdateLambda(elliptic_t* elliptic)
  
   }
 }
+
+// Chebyshev bounds of levels with varying operators (moving mesh, variable coefficients)
+void
+ellipticMultiGridUpdateEigenvalues(elliptic_t* elliptic)
+{
+  int frequency = 0;
+  elliptic->options.getArgs("MULTIGRID CHEBYSHEV EIGENVALUE REFRESH", frequency);
+  if (frequency <= 0 || !elliptic->precon || !elliptic->precon->MGSolver)
+    return;
+
+  precon_t *precon = elliptic->precon;
+  if (++precon->eigenvalueSolves % frequency)
+    return;
+
+  const auto tag = elliptic->name + " eigenvalue refresh";
+  platform->timer.tic(tag, 1);
+
+  auto MGSolver = precon->MGSolver;
+  const bool coarseSmoother = elliptic->options.compareArgs("MULTIGRID COARSE SOLVE", "FALSE") ||
+                              elliptic->options.compareArgs("MULTIGRID COARSE SOLVE AND SMOOTH", "TRUE");
+  for (int levelIndex = 0; levelIndex < MGSolver->numLevels; levelIndex++) {
+    auto level = dynamic_cast<pMGLevel*>(MGSolver->levels[levelIndex]);
+    if (level->isCoarse && MGSolver->numLevels > 1 && !coarseSmoother)
+      continue;
+    level->updateMaxEig();
+  }
+
+  platform->timer.toc(tag);
+}
@@ -2,6 +2,7 @@
 #include "platform.hpp"
 #include "elliptic.h"
 #include "SEMFEMSolver.hpp"
+#include "amgSolver/amgCache.hpp"
 
 static occa::kernel gatherKernel;
 static occa::kernel scatterKernel;
@@ -37,19 +38,71 @@ SEMFEMSolver_t::SEMFEMSolver_t(elliptic_t* elliptic_)
   pfloat lambda0;
   elliptic->o_lambda0.copyTo(&lambda0, sizeof(pfloat));
 
-  auto hypreIJ = new hypreWrapper::IJ_t();
-  matrix_t* matrix = build(
-    mesh->Nq,
-    mesh->Nelements,
-    mesh->o_x,
-    mesh->o_y,
-    mesh->o_z,
-    mask,
-    lambda0,
-    *hypreIJ,
-    platform->comm.mpiComm,
-    mesh->globalIds
-  );
+  std::string cacheKey;
+  if(elliptic->options.compareArgs("COARSE SOLVER CACHE", "TRUE"))
+    cacheKey = ellipticCoarseSystemKey(elliptic);
+
+  // a refresh reassembles on the graph of build()
+  int refreshFrequency = 0;
+  elliptic->options.getArgs("COARSE SOLVER REFRESH", refreshFrequency);
+  keepAssembly = refreshFrequency > 0;
+
+  matrix_t* matrix = new matrix_t();
+  auto readMatrix = [&](std::istream &in) {
+    std::vector<long long> Ai, Aj, dofMap;
+    std::vector<double> Av;
+    amgCache::read(in, matrix->rowStart);
+    amgCache::read(in, matrix->rowEnd);
+    amgCache::read(in, Ai);
+    amgCache::read(in, Aj);
+    amgCache::read(in, Av);
+    amgCache::read(in, dofMap);
+
+    matrix->nnz = Ai.size();
+    matrix->Ai = (long long*) calloc(Ai.size(), sizeof(long long));
+    matrix->Aj = (long long*) calloc(Aj.size(), sizeof(long long));
+    matrix->Av = (double*) calloc(Av.size(), sizeof(double));
+    matrix->dofMap = (long long*) calloc(dofMap.size(), sizeof(long long));
+    std::copy(Ai.begin(), Ai.end(), matrix->Ai);
+    std::copy(Aj.begin(), Aj.end(), matrix->Aj);
+    std::copy(Av.begin(), Av.end(), matrix->Av);
+    std::copy(dofMap.begin(), dofMap.end(), matrix->dofMap);
+  };
+
+  // a refresh needs the assembly graph of build(), which is not cached
+  if(cacheKey.size() && keepAssembly && platform->comm.mpiRank == 0)
+    printf("SEMFEM matrix cache not used with a coarse solver refresh\n");
+
+  if(cacheKey.size() && !keepAssembly && amgCache::load("semfem", cacheKey, platform->comm.mpiComm, readMatrix)) {
+    if(platform->comm.mpiRank == 0) printf("loaded SEMFEM matrix from cache\n");
+  } else {
+    delete matrix;
+    hypreWrapper::IJ_t hypreIJ;
+    matrix = build(
+      mesh->Nq,
+      mesh->Nelements,
+      mesh->o_x,
+      mesh->o_y,
+      mesh->o_z,
+      mask,
+      lambda0,
+      hypreIJ,
+      platform->comm.mpiComm,
+      mesh->globalIds
+    );
+
+    if(cacheKey.size()) {
+      amgCache::save("semfem", cacheKey, platform->comm.mpiComm, [&](std::ostream &out) {
+        const dlong numRows = matrix->rowEnd - matrix->rowStart + 1;
+        amgCache::write(out, matrix->rowStart);
+        amgCache::write(out, matrix->rowEnd);
+        amgCache::write(out, std::vector<long long>(matrix->Ai, matrix->Ai + matrix->nnz));
+        amgCache::write(out, std::vector<long long>(matrix->Aj, matrix->Aj + matrix->nnz));
+        amgCache::write(out, std::vector<double>(matrix->Av, matrix->Av + matrix->nnz));
+        amgCache::write(out, std::vector<long long>(matrix->dofMap, matrix->dofMap + numRows));
+      });
+    }
+  }
   free(mask);
 
 
@@ -96,7 +149,7 @@ SEMFEMSolver_t::SEMFEMSolver_t(elliptic_t* elliptic_)
       platform->options.getArgs("BOOMERAMG AGGRESSIVE COARSENING LEVELS" , settings[10]);
       platform->options.getArgs("BOOMERAMG CHEBYSHEV RELAX ORDER" , settings[11]);
 
-      if(platform->device.mode() != "Serial" && useDevice) {
+      if(!platform->serial && useDevice) {
         boomerAMG = new hypreWrapperDevice::boomerAMG_t(
                         numRows,
                         matrix->nnz,
@@ -146,6 +199,31 @@ SEMFEMSolver_t::SEMFEMSolver_t(elliptic_t* elliptic_)
       std::stoi(getenv("NEKRS_GPU_MPI")),
       cfg);
   }
+  else if(elliptic->options.compareArgs("COARSE SOLVER", "SAAMG")){
+    double settings[SAAMG_t::NPARAM];
+    SAAMG_t::settings(platform->options, settings);
+
+    auto readHierarchy = [&](std::istream &in) {
+      SAAMG = new SAAMG_t(in, platform->comm.mpiComm, useFP32, settings, verbose);
+    };
+    if(cacheKey.empty() || !amgCache::load("semfem-saamg", cacheKey, platform->comm.mpiComm, readHierarchy)) {
+      delete SAAMG;
+      SAAMG = new SAAMG_t(
+        numRows,
+        matrix->nnz,
+        matrix->Ai,
+        matrix->Aj,
+        matrix->Av,
+        (int) elliptic->allNeumann,
+        platform->comm.mpiComm,
+        useFP32,
+        settings,
+        verbose);
+
+      if(cacheKey.size())
+        amgCache::save("semfem-saamg", cacheKey, platform->comm.mpiComm, [&](std::ostream &out) { SAAMG->write(out); });
+    }
+  }
   else {
     std::string amgSolver;
     elliptic->options.getArgs("COARSE SOLVER", amgSolver);
@@ -153,7 +231,10 @@ SEMFEMSolver_t::SEMFEMSolver_t(elliptic_t* elliptic_)
              "COARSE SOLVER %s is not supported!\n", amgSolver.c_str());
   }
 
-  free(matrix);
+  if(keepAssembly)
+    this->matrix = matrix;
+  else
+    free(matrix);
   if(platform->comm.mpiRank == 0)  printf("done (%gs)\n", MPI_Wtime() - tStart); fflush(stdout);
 }
 
@@ -167,12 +248,45 @@ SEMFEMSolver_t::~SEMFEMSolver_t()
       delete (hypreWrapper::boomerAMG_t*) this->boomerAMG;
   }
   if(AMGX) delete AMGX;
+  if(SAAMG) delete SAAMG;
+
+  if(matrix) {
+    free(matrix->Ai);
+    free(matrix->Aj);
+    free(matrix->Av);
+    free(matrix->dofMap);
+    delete matrix;
+  }
+  freeAssembly();
 
   o_dofMap.free();
   o_SEMFEMBuffer1.free();
   o_SEMFEMBuffer2.free();
 }
 
+void SEMFEMSolver_t::update()
+{
+  nrsCheck(!assembly, platform->comm.mpiComm, EXIT_FAILURE,
+           "%s\n", "SEMFEM solver was not set up for a refresh!");
+
+  const bool useDevice = elliptic->options.compareArgs("COARSE SOLVER LOCATION", "DEVICE");
+
+  pfloat lambda0;
+  elliptic->o_lambda0.copyTo(&lambda0, sizeof(pfloat));
+  reassemble(lambda0, matrix);
+
+  if(elliptic->options.compareArgs("COARSE SOLVER", "BOOMERAMG")){
+    if(useDevice)
+      ((hypreWrapperDevice::boomerAMG_t*) this->boomerAMG)->update(matrix->Av);
+    else
+      ((hypreWrapper::boomerAMG_t*) this->boomerAMG)->update(matrix->Av);
+  } else if(elliptic->options.compareArgs("COARSE SOLVER", "AMGX")){
+    AMGX->update(matrix->Av);
+  } else if(elliptic->options.compareArgs("COARSE SOLVER", "SAAMG")){
+    SAAMG->update(matrix->Av);
+  }
+}
+
 void SEMFEMSolver_t::run(occa::memory& o_r, occa::memory& o_z)
 {
   mesh_t* mesh = elliptic->mesh;
@@ -210,6 +324,12 @@ void SEMFEMSolver_t::run(occa::memory& o_r, occa::memory& o_z)
 
     AMGX->solve(o_bufr.ptr(), o_bufz.ptr());
 
+  } else if(elliptic->options.compareArgs("COARSE SOLVER", "SAAMG")){
+
+    o_bufr.copyTo(SEMFEMBuffer1_h_d, numRowsSEMFEM * sizeof(pfloat));
+    SAAMG->solve(SEMFEMBuffer1_h_d, SEMFEMBuffer2_h_d);
+    o_bufz.copyFrom(SEMFEMBuffer2_h_d, numRowsSEMFEM * sizeof(pfloat));
+
   } else {
 
     nrsAbort(platform->comm.mpiComm, EXIT_FAILURE,
@@ -33,6 +33,7 @@ SOFTWARE.
 #include "hypreWrapper.hpp"
 #include "hypreWrapperDevice.hpp"
 #include "AMGX.hpp"
+#include "SAAMG.hpp"
 
 class SEMFEMSolver_t {
 
@@ -42,6 +43,9 @@ public:
 
   void run(occa::memory&, occa::memory&);
 
+  // reassembles the matrix for the current mesh and lambda0 and refreshes the AMG setup
+  void update();
+
 private:
   dlong numRowsSEMFEM;
   occa::memory o_dofMap;
@@ -51,6 +55,7 @@ private:
   void *SEMFEMBuffer2_h_d;
   void *boomerAMG = nullptr;
   AMGX_t *AMGX = nullptr;
+  SAAMG_t *SAAMG = nullptr;
 
   elliptic_t *elliptic;
 
@@ -75,6 +80,13 @@ private:
                   MPI_Comm comm,
                   long long int *gatherGlobalNodes);
 
+  struct assembly_t;
+  bool keepAssembly = false;
+  assembly_t *assembly = nullptr;
+  matrix_t *matrix = nullptr;
+
+  void reassemble(double lambda, matrix_t *matrix);
+  void freeAssembly();
 };
 
 #endif
@@ -1,8 +1,9 @@
 #include <math.h>
 #include <limits>
-#include <unordered_map>
 #include <unordered_set>
 #include <algorithm>
+#include <numeric>
+#include <vector>
 
 #include "SEMFEMSolver.hpp"
 #include "platform.hpp"
@@ -52,22 +53,7 @@ long long bisection_search_index(const long long *sortedArr, long long value, lo
   return fail;
 }
 
-long long linear_search_index(const long long *unsortedArr, long long value, long long start, long long end)
-{
-  long long fail = -1;
-  for (long long idx = start; idx < end; ++idx) {
-    if (unsortedArr[idx] == value) {
-      return idx;
-    }
-  }
-  return fail;
-}
-
-/* Basis functions and derivatives in 3D */
-double phi_3D_1(double q_r[4][3], int q) { return q_r[q][0]; }
-double phi_3D_2(double q_r[4][3], int q) { return q_r[q][1]; }
-double phi_3D_3(double q_r[4][3], int q) { return q_r[q][2]; }
-double phi_3D_4(double q_r[4][3], int q) { return 1.0 - q_r[q][0] - q_r[q][1] - q_r[q][2]; }
+/* Basis function derivatives in 3D */
 void dphi(double deriv[3], int q)
 {
   if (q == 0) {
@@ -128,18 +114,6 @@ void inverse(double invA[3][3], double A[3][3])
   invA[2][2] = inv_det_A * (A[0][0] * A[1][1] - A[1][0] * A[0][1]);
 }
 
-void x_map(double x[3], double q_r[4][3], double x_t[3][4], int q)
-{
-  const int n_dim = 3;
-
-  for (int d = 0; d < n_dim; d++) {
-    x[d] = x_t[d][0] * phi_3D_1(q_r, q);
-    x[d] += x_t[d][1] * phi_3D_2(q_r, q);
-    x[d] += x_t[d][2] * phi_3D_3(q_r, q);
-    x[d] += x_t[d][3] * phi_3D_4(q_r, q);
-  }
-}
-
 void J_xr_map(double J_xr[3][3], double q_r[4][3], double x_t[3][4])
 {
   const int n_dim = 3;
@@ -159,13 +133,6 @@ void J_xr_map(double J_xr[3][3], double q_r[4][3], double x_t[3][4])
   }
 }
 
-occa::memory scratchOrAllocateMemory(int nWords,
-                                     int sizeT,
-                                     void *src,
-                                     size_t &bytesRemaining,
-                                     size_t &byteOffset,
-                                     size_t &bytesAllocated,
-                                     bool &allocated);
 static occa::kernel computeStiffnessMatrixKernel;
 static occa::memory o_x;
 static occa::memory o_y;
@@ -180,6 +147,11 @@ void fem_assembly_host(hypreWrapper::IJ_t &hypreIJ);
 
 void matrix_distribution();
 void fem_assembly(hypreWrapper::IJ_t &hypreIJ);
+void assemble_values(hypreWrapper::IJ_t &hypreIJ);
+void owned_entries(hypreWrapper::IJ_t &hypreIJ,
+                   std::vector<long long> &Ai,
+                   std::vector<long long> &Aj,
+                   std::vector<double> &Av);
 void mesh_connectivity(int[8][3], int[8][4]);
 long long maximum(long long, long long);
 
@@ -206,8 +178,25 @@ struct COOGraph {
 
 static COOGraph coo_graph;
 
+void free_coo_graph(COOGraph &graph);
+
 } // namespace
 
+/* State of build() required for a numeric-only reassembly */
+struct SEMFEMSolver_t::assembly_t {
+  int N;
+  int nElements;
+  occa::memory o_x;
+  occa::memory o_y;
+  occa::memory o_z;
+  std::vector<double> mask;
+  long long *gloNum;
+  COOGraph graph;
+  long long rowStart;
+  long long rowEnd;
+  bool onHost;
+};
+
 static struct comm comm;
 struct gs_data {
   struct comm comm;
@@ -275,41 +264,10 @@ SEMFEMSolver_t::matrix_t *SEMFEMSolver_t::build(const int N_,
                "%s\n", "Number of global rows requires BigInt support!");
     }
 
-    hypreWrapper::BigInt *ownedRows = (hypreWrapper::BigInt *)calloc(numRows, sizeof(hypreWrapper::BigInt));
-    int ctr = 0;
-    for (long long row = row_start; row <= row_end; ++row)
-      ownedRows[ctr++] = row;
-
-    hypreWrapper::Int *ncols = (hypreWrapper::Int *)calloc(numRows, sizeof(hypreWrapper::Int));
-    hypreIJ.MatrixGetRowCounts(numRows, ownedRows, ncols);
-
-    int nnz = 0;
-    for (int i = 0; i < numRows; ++i)
-      nnz += ncols[i];
-
-    // construct COO matrix from Hypre matrix
-    hypreWrapper::BigInt *hAj = (hypreWrapper::BigInt *)calloc(nnz, sizeof(hypreWrapper::BigInt));
-    hypreWrapper::Real *hAv = (hypreWrapper::Real *)calloc(nnz, sizeof(hypreWrapper::Real));
-    hypreIJ.MatrixGetValues(-numRows, ncols, ownedRows, &hAj[0], &hAv[0]);
-
-    long long *Ai = (long long *)calloc(nnz, sizeof(long long));
-    long long *Aj = (long long *)calloc(nnz, sizeof(long long));
-    double *Av = (double *)calloc(nnz, sizeof(double));
-    for (int n = 0; n < nnz; ++n) {
-      Aj[n] = hAj[n];
-      Av[n] = hAv[n];
-    }
-    ctr = 0;
-    for (int i = 0; i < numRows; ++i) {
-      long long row = ownedRows[i];
-      for (int col = 0; col < ncols[i]; ++col)
-        Ai[ctr++] = row;
-    }
-
-    free(hAj);
-    free(hAv);
-    free(ownedRows);
-    free(ncols);
+    std::vector<long long> Ai, Aj;
+    std::vector<double> Av;
+    owned_entries(hypreIJ, Ai, Aj, Av);
+    const int nnz = Ai.size();
 
     double dropTol = 0.0;
     platform->options.getArgs("AMG DROP TOLERANCE", dropTol);
@@ -335,10 +293,6 @@ SEMFEMSolver_t::matrix_t *SEMFEMSolver_t::build(const int N_,
       }
     }
 
-    free(Ai);
-    free(Aj);
-    free(Av);
-
     matrix->Ai = AiTol;
     matrix->Aj = AjTol;
     matrix->Av = AvTol;
@@ -348,9 +302,85 @@ SEMFEMSolver_t::matrix_t *SEMFEMSolver_t::build(const int N_,
     matrix->dofMap = dof_map;
   }
 
+  if (keepAssembly) {
+    assembly = new assembly_t();
+    assembly->N = N_;
+    assembly->nElements = n_elem_;
+    assembly->o_x = o_x;
+    assembly->o_y = o_y;
+    assembly->o_z = o_z;
+    assembly->mask.assign(pmask, pmask + n_xyze);
+    assembly->gloNum = glo_num;
+    assembly->graph = coo_graph;
+    assembly->rowStart = row_start;
+    assembly->rowEnd = row_end;
+    assembly->onHost = constructOnHost;
+  }
+  else {
+    free(glo_num);
+    free_coo_graph(coo_graph);
+  }
+
   return matrix;
 }
 
+/* Recomputes the values of matrix for the current mesh coordinates and lambda0,
+ * its sparsity pattern and row distribution are kept */
+void SEMFEMSolver_t::reassemble(double lambda0_, matrix_t *matrix)
+{
+  n_x = assembly->N;
+  n_y = assembly->N;
+  n_z = assembly->N;
+  n_elem = assembly->nElements;
+  n_xyz = n_x * n_y * n_z;
+  n_xyze = n_xyz * n_elem;
+  o_x = assembly->o_x;
+  o_y = assembly->o_y;
+  o_z = assembly->o_z;
+  pmask = assembly->mask.data();
+  glo_num = assembly->gloNum;
+  coo_graph = assembly->graph;
+  row_start = assembly->rowStart;
+  row_end = assembly->rowEnd;
+  constructOnHost = assembly->onHost;
+  lambda0 = lambda0_;
+
+  if (!constructOnHost)
+    load();
+
+  // the IJ matrix only lives until the values are extracted
+  hypreWrapper::IJ_t hypreIJ;
+  assemble_values(hypreIJ);
+
+  std::vector<long long> Ai, Aj;
+  std::vector<double> Av;
+  owned_entries(hypreIJ, Ai, Aj, Av);
+
+  // both are sorted by row, entries dropped during build stay dropped
+  std::fill(matrix->Av, matrix->Av + matrix->nnz, 0.0);
+  int start = 0;
+  for (size_t n = 0; n < Ai.size(); ++n) {
+    while (start < matrix->nnz && matrix->Ai[start] < Ai[n])
+      start++;
+    for (int k = start; k < matrix->nnz && matrix->Ai[k] == Ai[n]; ++k) {
+      if (matrix->Aj[k] == Aj[n]) {
+        matrix->Av[k] = Av[n];
+        break;
+      }
+    }
+  }
+}
+
+void SEMFEMSolver_t::freeAssembly()
+{
+  if (!assembly)
+    return;
+  free(assembly->gloNum);
+  free_coo_graph(assembly->graph);
+  delete assembly;
+  assembly = nullptr;
+}
+
 namespace {
 
 /* FEM Assembly definition */
@@ -460,6 +490,11 @@ void matrix_distribution()
 }
 void construct_coo_graph()
 {
+  /*
+   * Two passes over the element vertices: the first one bounds the number of
+   * entries of each row, the second one fills them. Rows are sorted and
+   * deduplicated afterwards which allows to look up columns by bisection.
+   */
 
   /* Mesh connectivity (Can be changed to fill-out or one-per-vertex) */
   constexpr int num_fem = 8;
@@ -472,76 +507,122 @@ void construct_coo_graph()
   int E_y = n_y - 1;
   int E_z = n_z - 1;
 
-  std::unordered_map<long long, std::unordered_set<long long>> graph;
-  std::unordered_map<int, std::unordered_set<int>> rowIdxToColIdxMap;
-  const int nvert = 8;
-  for (int s_z = 0; s_z < E_z; s_z++) {
-    for (int s_y = 0; s_y < E_y; s_y++) {
-      for (int s_x = 0; s_x < E_x; s_x++) {
-        /* Get indices */
-        int s[n_dim];
+  /* Couplings of the vertices of the reference element */
+  std::vector<std::vector<int>> stencil(n_xyz);
+  {
+    std::vector<std::unordered_set<int>> couplings(n_xyz);
+    const int nvert = 8;
+    for (int s_z = 0; s_z < E_z; s_z++) {
+      for (int s_y = 0; s_y < E_y; s_y++) {
+        for (int s_x = 0; s_x < E_x; s_x++) {
+          /* Get indices */
+          int s[n_dim];
 
-        s[0] = s_x;
-        s[1] = s_y;
-        s[2] = s_z;
+          s[0] = s_x;
+          s[1] = s_y;
+          s[2] = s_z;
 
-        int idx[nvert];
+          int idx[nvert];
 
-        for (int i = 0; i < nvert; i++) {
-          idx[i] = 0;
+          for (int i = 0; i < nvert; i++) {
+            idx[i] = 0;
 
-          idx[i] += (s[0] + v_coord[i][0]) * 1;
-          idx[i] += (s[1] + v_coord[i][1]) * n_x;
-          idx[i] += (s[2] + v_coord[i][2]) * n_x * n_x;
-        }
-        for (int t = 0; t < num_fem; t++) {
-          for (int i = 0; i < n_dim + 1; i++) {
-            for (int j = 0; j < n_dim + 1; j++) {
-              rowIdxToColIdxMap[idx[t_map[t][i]]].insert(idx[t_map[t][j]]);
+            idx[i] += (s[0] + v_coord[i][0]) * 1;
+            idx[i] += (s[1] + v_coord[i][1]) * n_x;
+            idx[i] += (s[2] + v_coord[i][2]) * n_x * n_x;
+          }
+          for (int t = 0; t < num_fem; t++) {
+            for (int i = 0; i < n_dim + 1; i++) {
+              for (int j = 0; j < n_dim + 1; j++) {
+                couplings[idx[t_map[t][i]]].insert(idx[t_map[t][j]]);
+              }
             }
           }
         }
       }
     }
+    for (int v = 0; v < n_xyz; v++)
+      stencil[v].assign(couplings[v].begin(), couplings[v].end());
+  }
+
+  /* Rows are the global ids of all unmasked element vertices */
+  std::vector<long long> rowIds;
+  for (int idx = 0; idx < n_xyze; idx++) {
+    if (pmask[idx] > 0.0)
+      rowIds.push_back(glo_num[idx]);
+  }
+  std::sort(rowIds.begin(), rowIds.end());
+  rowIds.erase(std::unique(rowIds.begin(), rowIds.end()), rowIds.end());
+  const int nrows = rowIds.size();
+
+  std::vector<int> localRow(n_xyze, -1);
+  #pragma omp parallel for
+  for (int idx = 0; idx < n_xyze; idx++) {
+    if (pmask[idx] > 0.0)
+      localRow[idx] = std::lower_bound(rowIds.begin(), rowIds.end(), glo_num[idx]) - rowIds.begin();
+  }
+
+  /* Pass 1: upper bound of the entries of each row */
+  std::vector<long long> bound(nrows + 1, 0);
+  #pragma omp parallel for
+  for (int e = 0; e < n_elem; ++e) {
+    for (int v = 0; v < n_xyz; ++v) {
+      const int row = localRow[e * n_xyz + v];
+      if (row < 0)
+        continue;
+      long long count = 0;
+      for (auto &&c : stencil[v]) {
+        if (pmask[e * n_xyz + c] > 0.0)
+          count++;
+      }
+      #pragma omp atomic
+      bound[row + 1] += count;
+    }
   }
+  std::partial_sum(bound.begin(), bound.end(), bound.begin());
+
+  /* Pass 2: fill, duplicates from neighboring elements are removed below */
+  std::vector<long long> buffer(bound[nrows]);
+  std::vector<long long> next(bound.begin(), bound.end() - 1);
+  #pragma omp parallel for
   for (int e = 0; e < n_elem; ++e) {
-    for (auto &&idx_row_lookup_and_col_lookups : rowIdxToColIdxMap) {
-      auto row_lookup = idx_row_lookup_and_col_lookups.first;
-      for (auto &&col_lookup : idx_row_lookup_and_col_lookups.second) {
-        if (pmask[e * n_xyz + row_lookup] > 0.0 && pmask[e * n_xyz + col_lookup] > 0.0) {
-          long long row = glo_num[e * n_xyz + row_lookup];
-          long long col = glo_num[e * n_xyz + col_lookup];
-          graph[row].emplace(col);
+    for (int v = 0; v < n_xyz; ++v) {
+      const int row = localRow[e * n_xyz + v];
+      if (row < 0)
+        continue;
+      for (auto &&c : stencil[v]) {
+        if (pmask[e * n_xyz + c] > 0.0) {
+          long long pos;
+          #pragma omp atomic capture
+          pos = next[row]++;
+          buffer[pos] = glo_num[e * n_xyz + c];
         }
       }
     }
   }
-  const int nrows = graph.size();
+
+  int *ncols = (int *)malloc(nrows * sizeof(int));
+  #pragma omp parallel for
+  for (int row = 0; row < nrows; ++row) {
+    auto first = buffer.begin() + bound[row];
+    auto last = buffer.begin() + bound[row + 1];
+    std::sort(first, last);
+    ncols[row] = std::unique(first, last) - first;
+  }
+
   long long *rows = (long long *)malloc(nrows * sizeof(long long));
   long long *rowOffsets = (long long *)malloc((nrows + 1) * sizeof(long long));
-  int *ncols = (int *)malloc(nrows * sizeof(int));
-  long long nnz = 0;
-  long long ctr = 0;
+  std::copy(rowIds.begin(), rowIds.end(), rows);
+  rowOffsets[0] = 0;
+  for (int row = 0; row < nrows; ++row)
+    rowOffsets[row + 1] = rowOffsets[row] + ncols[row];
+  const long long nnz = rowOffsets[nrows];
 
-  for (auto &&row_and_colset : graph) {
-    rows[ctr++] = row_and_colset.first;
-    nnz += row_and_colset.second.size();
-  }
   long long *cols = (long long *)malloc(nnz * sizeof(long long));
   float *vals = (float *)calloc(nnz, sizeof(float));
-  std::sort(rows, rows + nrows);
-  long long entryCtr = 0;
-  rowOffsets[0] = 0;
-  for (auto localrow = 0; localrow < nrows; ++localrow) {
-    const long long row = rows[localrow];
-    const auto &colset = graph[row];
-    const auto size = colset.size();
-    ncols[localrow] = size;
-    rowOffsets[localrow + 1] = rowOffsets[localrow] + size;
-    for (auto &&col : colset) {
-      cols[entryCtr++] = col;
-    }
-  }
+  #pragma omp parallel for
+  for (int row = 0; row < nrows; ++row)
+    std::copy(buffer.begin() + bound[row], buffer.begin() + bound[row] + ncols[row], cols + rowOffsets[row]);
 
   coo_graph.nrows = nrows;
   coo_graph.nnz = nnz;
@@ -559,6 +640,7 @@ void fem_assembly_host(hypreWrapper::IJ_t &hypreIJ)
   long long *rows = coo_graph.rows;
   long long *rowOffsets = coo_graph.rowOffsets;
   int *ncols = coo_graph.ncols;
+  long long nnz = coo_graph.nnz;
   long long *cols = coo_graph.cols;
   float *vals = coo_graph.vals;
 
@@ -579,6 +661,23 @@ void fem_assembly_host(hypreWrapper::IJ_t &hypreIJ)
   const int n_quad = 4;
   const int num_fem = 8;
 
+  double weight = 0.0;
+  for (int q = 0; q < n_quad; q++)
+    weight += q_w[q];
+
+  /* Local row of each element vertex */
+  std::vector<long long> localRow(n_xyze, -1);
+  #pragma omp parallel for
+  for (int idx = 0; idx < n_xyze; idx++) {
+    if (pmask[idx] > 0.0)
+      localRow[idx] = bisection_search_index(rows, glo_num[idx], 0, nrows);
+  }
+
+  /* Elements are processed in parallel, contributions to shared vertices are
+   * summed up atomically in double precision */
+  std::vector<double> sums(nnz, 0.0);
+
+  #pragma omp parallel for
   for (int e = 0; e < n_elem; e++) {
 
     /* Cycle through collocated quads/hexes */
@@ -589,7 +688,6 @@ void fem_assembly_host(hypreWrapper::IJ_t &hypreIJ)
           double J_xr[3][3];
           double J_rx[3][3];
           double x_t[3][4];
-          double q_x[3];
           /* Get indices */
           int s[n_dim];
 
@@ -616,59 +714,49 @@ void fem_assembly_host(hypreWrapper::IJ_t &hypreIJ)
             }
 
             /* Local FEM matrices */
-            /* Reset local stiffness and mass matrices */
-            for (int i = 0; i < n_dim + 1; i++) {
-              for (int j = 0; j < n_dim + 1; j++) {
-                A_loc[i][j] = 0.0;
-              }
-            }
-
-            /* Build local stiffness matrices by applying quadrature rules */
+            /* Gradients of the linear basis functions are constant on a tet,
+             * the quadrature therefore reduces to the sum of its weights.
+             * Only the upper triangle of the symmetric matrix is computed. */
             J_xr_map(J_xr, q_r, x_t);
             inverse(J_rx, J_xr);
             const double det_J_xr = determinant(J_xr);
-            for (int q = 0; q < n_quad; q++) {
-              /* From r to x */
-              x_map(q_x, q_r, x_t, q);
-
-              /* Integrand */
-              for (int i = 0; i < n_dim + 1; i++) {
-                double deriv_i[3];
-                dphi(deriv_i, i);
-                for (int j = 0; j < n_dim + 1; j++) {
-                  double deriv_j[3];
-                  dphi(deriv_j, j);
-                  int alpha, beta;
-                  double func = 0.0;
-
-                  for (alpha = 0; alpha < n_dim; alpha++) {
-                    double a = 0.0, b = 0.0;
-
-                    for (beta = 0; beta < n_dim; beta++) {
-                      a += deriv_i[beta] * J_rx[beta][alpha];
 
-                      b += deriv_j[beta] * J_rx[beta][alpha];
-                    }
-
-                    func += a * b;
-                  }
+            double grad[n_dim + 1][n_dim];
+            for (int i = 0; i < n_dim + 1; i++) {
+              double deriv_i[3];
+              dphi(deriv_i, i);
+              for (int alpha = 0; alpha < n_dim; alpha++) {
+                grad[i][alpha] = 0.0;
+                for (int beta = 0; beta < n_dim; beta++)
+                  grad[i][alpha] += deriv_i[beta] * J_rx[beta][alpha];
+              }
+            }
 
-                  A_loc[i][j] += func * det_J_xr * q_w[q];
-                }
+            for (int i = 0; i < n_dim + 1; i++) {
+              for (int j = i; j < n_dim + 1; j++) {
+                double func = 0.0;
+                for (int alpha = 0; alpha < n_dim; alpha++)
+                  func += grad[i][alpha] * grad[j][alpha];
+                A_loc[i][j] = func * det_J_xr * weight;
+              }
+            }
+            for (int i = 0; i < n_dim + 1; i++) {
+              for (int j = 0; j < i; j++) {
+                A_loc[i][j] = A_loc[j][i];
               }
             }
             for (int i = 0; i < n_dim + 1; i++) {
               for (int j = 0; j < n_dim + 1; j++) {
                 if ((pmask[idx[t_map[t][i]] + e * n_x * n_x * n_x] > 0.0) &&
                     (pmask[idx[t_map[t][j]] + e * n_x * n_x * n_x] > 0.0)) {
-                  long long row = glo_num[idx[t_map[t][i]] + e * n_x * n_x * n_x];
+                  long long local_row_id = localRow[idx[t_map[t][i]] + e * n_x * n_x * n_x];
                   long long col = glo_num[idx[t_map[t][j]] + e * n_x * n_x * n_x];
-                  long long local_row_id = bisection_search_index(rows, row, 0, nrows);
                   long long start = rowOffsets[local_row_id];
                   long long end = rowOffsets[local_row_id + 1];
 
-                  long long id = linear_search_index(cols, col, start, end);
-                  vals[id] += lambda0 * A_loc[i][j];
+                  long long id = bisection_search_index(cols, col, start, end);
+                  #pragma omp atomic
+                  sums[id] += lambda0 * A_loc[i][j];
                 }
               }
             }
@@ -678,15 +766,13 @@ void fem_assembly_host(hypreWrapper::IJ_t &hypreIJ)
     }
   }
 
+  for (long long n = 0; n < nnz; n++)
+    vals[n] = sums[n];
+
   int err = hypreIJ.MatrixAddToValues(nrows, ncols, rows, cols, vals);
   nrsCheck(err != 0, comm.c, EXIT_FAILURE, 
            "%s\n", "hypreWrapper::IJMatrixAddToValues failed!");
 
-  free(rows);
-  free(rowOffsets);
-  free(ncols);
-  free(cols);
-  free(vals);
   free(x);
   free(y);
   free(z);
@@ -702,60 +788,13 @@ void fem_assembly_device(hypreWrapper::IJ_t &hypreIJ)
   long long *cols = coo_graph.cols;
   float *vals = coo_graph.vals;
 
-  struct AllocationTracker {
-    bool o_maskAlloc;
-    bool o_glo_numAlloc;
-    bool o_rowOffsetsAlloc;
-    bool o_rowsAlloc;
-    bool o_colsAlloc;
-    bool o_valsAlloc;
-  };
-  AllocationTracker allocations;
-  size_t bytesRemaining = platform->o_mempool.bytesAllocated;
-  size_t byteOffset = 0;
-  size_t bytesAllocated = 0;
-  occa::memory o_mask = scratchOrAllocateMemory(n_xyze,
-                                                sizeof(double),
-                                                pmask,
-                                                bytesRemaining,
-                                                byteOffset,
-                                                bytesAllocated,
-                                                allocations.o_maskAlloc);
-  occa::memory o_glo_num = scratchOrAllocateMemory(n_xyze,
-                                                   sizeof(long long),
-                                                   glo_num,
-                                                   bytesRemaining,
-                                                   byteOffset,
-                                                   bytesAllocated,
-                                                   allocations.o_glo_numAlloc);
-  occa::memory o_rows = scratchOrAllocateMemory(nrows,
-                                                sizeof(long long),
-                                                rows,
-                                                bytesRemaining,
-                                                byteOffset,
-                                                bytesAllocated,
-                                                allocations.o_rowsAlloc);
-  occa::memory o_rowOffsets = scratchOrAllocateMemory(nrows + 1,
-                                                      sizeof(long long),
-                                                      rowOffsets,
-                                                      bytesRemaining,
-                                                      byteOffset,
-                                                      bytesAllocated,
-                                                      allocations.o_rowOffsetsAlloc);
-  occa::memory o_cols = scratchOrAllocateMemory(nnz,
-                                                sizeof(long long),
-                                                cols,
-                                                bytesRemaining,
-                                                byteOffset,
-                                                bytesAllocated,
-                                                allocations.o_colsAlloc);
-  occa::memory o_vals = scratchOrAllocateMemory(nnz,
-                                                sizeof(float),
-                                                vals,
-                                                bytesRemaining,
-                                                byteOffset,
-                                                bytesAllocated,
-                                                allocations.o_valsAlloc);
+  // one-off and sized by the number of nonzeros, hence not taken from the scratch arena
+  occa::memory o_mask = platform->device.malloc(n_xyze * sizeof(double), pmask);
+  occa::memory o_glo_num = platform->device.malloc(n_xyze * sizeof(long long), glo_num);
+  occa::memory o_rows = platform->device.malloc(nrows * sizeof(long long), rows);
+  occa::memory o_rowOffsets = platform->device.malloc((nrows + 1) * sizeof(long long), rowOffsets);
+  occa::memory o_cols = platform->device.malloc(nnz * sizeof(long long), cols);
+  occa::memory o_vals = platform->device.malloc(nnz * sizeof(float), vals);
 
   computeStiffnessMatrixKernel(n_elem,
                                (int)nrows,
@@ -770,28 +809,16 @@ void fem_assembly_device(hypreWrapper::IJ_t &hypreIJ)
                                o_vals);
   o_vals.copyTo(vals, nnz * sizeof(float));
 
-  if (allocations.o_maskAlloc)
-    o_mask.free();
-  if (allocations.o_glo_numAlloc)
-    o_glo_num.free();
-  if (allocations.o_rowOffsetsAlloc)
-    o_rowOffsets.free();
-  if (allocations.o_rowsAlloc)
-    o_rows.free();
-  if (allocations.o_colsAlloc)
-    o_cols.free();
-  if (allocations.o_valsAlloc)
-    o_vals.free();
+  o_mask.free();
+  o_glo_num.free();
+  o_rowOffsets.free();
+  o_rows.free();
+  o_cols.free();
+  o_vals.free();
 
   int err = hypreIJ.MatrixAddToValues(nrows, ncols, rows, cols, vals);
   nrsCheck(err != 0, comm.c, EXIT_FAILURE,
            "%s\n", "hypreWrapper::IJMatrixAddToValues failed!");
-
-  free(rows);
-  free(rowOffsets);
-  free(ncols);
-  free(cols);
-  free(vals);
 }
 
 void fem_assembly(hypreWrapper::IJ_t &hypreIJ)
@@ -830,12 +857,23 @@ void fem_assembly(hypreWrapper::IJ_t &hypreIJ)
     }
   }
 
+  construct_coo_graph();
+
+  assemble_values(hypreIJ);
+
+  MPI_Barrier(comm.c);
+  if (comm.id == 0)
+    printf("done (%gs)\n", MPI_Wtime() - tStart);
+}
+
+void assemble_values(hypreWrapper::IJ_t &hypreIJ)
+{
   /* Assemble FE matrices with boundary conditions applied */
   hypreIJ.MatrixCreate(comm.c, row_start, row_end, row_start, row_end);
   hypreIJ.MatrixSetObjectType();
   hypreIJ.MatrixInitialize();
 
-  construct_coo_graph();
+  std::fill(coo_graph.vals, coo_graph.vals + coo_graph.nnz, 0.0f);
 
   if (constructOnHost) {
     fem_assembly_host(hypreIJ);
@@ -844,15 +882,49 @@ void fem_assembly(hypreWrapper::IJ_t &hypreIJ)
     fem_assembly_device(hypreIJ);
   }
 
-  {
-    hypreIJ.MatrixAssemble();
-  }
+  hypreIJ.MatrixAssemble();
+}
 
-  free(glo_num);
+void free_coo_graph(COOGraph &graph)
+{
+  free(graph.rows);
+  free(graph.rowOffsets);
+  free(graph.ncols);
+  free(graph.cols);
+  free(graph.vals);
+}
 
-  MPI_Barrier(comm.c);
-  if (comm.id == 0)
-    printf("done (%gs)\n", MPI_Wtime() - tStart);
+/* COO entries of the owned rows, sorted by row */
+void owned_entries(hypreWrapper::IJ_t &hypreIJ,
+                   std::vector<long long> &Ai,
+                   std::vector<long long> &Aj,
+                   std::vector<double> &Av)
+{
+  const int numRows = row_end - row_start + 1;
+
+  std::vector<hypreWrapper::BigInt> ownedRows(numRows);
+  for (int i = 0; i < numRows; ++i)
+    ownedRows[i] = row_start + i;
+
+  std::vector<hypreWrapper::Int> ncols(numRows);
+  hypreIJ.MatrixGetRowCounts(numRows, ownedRows.data(), ncols.data());
+
+  int nnz = 0;
+  for (int i = 0; i < numRows; ++i)
+    nnz += ncols[i];
+
+  std::vector<hypreWrapper::BigInt> hAj(nnz);
+  std::vector<hypreWrapper::Real> hAv(nnz);
+  hypreIJ.MatrixGetValues(-numRows, ncols.data(), ownedRows.data(), hAj.data(), hAv.data());
+
+  Ai.resize(nnz);
+  Aj.assign(hAj.begin(), hAj.end());
+  Av.assign(hAv.begin(), hAv.end());
+  int ctr = 0;
+  for (int i = 0; i < numRows; ++i) {
+    for (int col = 0; col < ncols[i]; ++col)
+      Ai[ctr++] = ownedRows[i];
+  }
 }
 
 void load() { computeStiffnessMatrixKernel = platform->kernels.get("computeStiffnessMatrix"); }
@@ -918,28 +990,4 @@ void mesh_connectivity(int v_coord[8][3], int t_map[8][4])
   (t_map)[7][3] = 5;
 }
 
-occa::memory scratchOrAllocateMemory(int nWords,
-                                     int sizeT,
-                                     void *src,
-                                     size_t &bytesRemaining,
-                                     size_t &byteOffset,
-                                     size_t &bytesAllocated,
-                                     bool &allocated)
-{
-  occa::memory o_mem;
-  if (nWords * sizeT < bytesRemaining) {
-    o_mem = platform->o_mempool.o_ptr.slice(byteOffset);
-    o_mem.copyFrom(src, nWords * sizeT);
-    bytesRemaining -= nWords * sizeT;
-    byteOffset += nWords * sizeT;
-    allocated = false;
-  }
-  else {
-    o_mem = platform->device.malloc(nWords * sizeT, src);
-    allocated = true;
-    bytesAllocated += nWords * sizeT;
-  }
-  return o_mem;
-}
-
 } // namespace
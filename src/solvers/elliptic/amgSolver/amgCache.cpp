@@ -0,0 +1,118 @@
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "amgCache.hpp"
+
+namespace fs = std::filesystem;
+
+namespace
+{
+
+constexpr uint64_t fnvPrime = 1099511628211ULL;
+
+// bump if the layout of any cached entry changes
+constexpr int formatVersion = 2;
+
+fs::path entryPath(const std::string &name, const std::string &key)
+{
+  const char *cacheDir = getenv("NEKRS_CACHE_DIR");
+  const fs::path base = cacheDir ? fs::path(cacheDir) : fs::path(".cache");
+  return base / "amg" / (name + "-" + key);
+}
+
+fs::path rankFile(const fs::path &dir, MPI_Comm comm)
+{
+  int rank;
+  MPI_Comm_rank(comm, &rank);
+  return dir / ("rank" + std::to_string(rank) + ".bin");
+}
+
+} // namespace
+
+namespace amgCache
+{
+
+void key_t::add(const void *data, size_t bytes)
+{
+  const auto c = (const unsigned char *)data;
+  for (size_t i = 0; i < bytes; i++) {
+    hash ^= c[i];
+    hash *= fnvPrime;
+  }
+}
+
+std::string key_t::str(MPI_Comm comm) const
+{
+  int size;
+  MPI_Comm_size(comm, &size);
+
+  std::vector<unsigned long long> hashes(size);
+  unsigned long long localHash = hash;
+  MPI_Allgather(&localHash, 1, MPI_UNSIGNED_LONG_LONG, hashes.data(), 1, MPI_UNSIGNED_LONG_LONG, comm);
+
+  key_t global;
+  global.add(formatVersion);
+  global.add(hashes);
+
+  std::stringstream ss;
+  ss << std::hex << global.hash;
+  return ss.str();
+}
+
+bool load(const std::string &name,
+          const std::string &key,
+          MPI_Comm comm,
+          const std::function<void(std::istream &)> &read)
+{
+  const auto file = rankFile(entryPath(name, key), comm);
+
+  int found = fs::exists(file);
+  MPI_Allreduce(MPI_IN_PLACE, &found, 1, MPI_INT, MPI_MIN, comm);
+  if (!found)
+    return false;
+
+  std::ifstream in(file, std::ios::binary);
+  read(in);
+  int ok = in.good();
+  MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, comm);
+
+  return ok;
+}
+
+void save(const std::string &name,
+          const std::string &key,
+          MPI_Comm comm,
+          const std::function<void(std::ostream &)> &write)
+{
+  const auto dir = entryPath(name, key);
+  std::error_code ec;
+  fs::create_directories(dir, ec);
+
+  // rename makes a partially written file invisible to load
+  const auto file = rankFile(dir, comm);
+  const auto tmpFile = fs::path(file.string() + ".tmp");
+  int ok = 0;
+  {
+    std::ofstream out(tmpFile, std::ios::binary | std::ios::trunc);
+    if (out) {
+      write(out);
+      ok = out.good();
+    }
+  }
+  if (ok) {
+    fs::rename(tmpFile, file, ec);
+    ok = !ec;
+  }
+  fs::remove(tmpFile, ec);
+
+  MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, comm);
+  int rank;
+  MPI_Comm_rank(comm, &rank);
+  if (!ok && rank == 0)
+    printf("could not write AMG cache entry %s!\n", dir.string().c_str());
+}
+
+} // namespace amgCache
@@ -0,0 +1,87 @@
+#ifndef AMG_CACHE_HPP
+#define AMG_CACHE_HPP
+
+#include <mpi.h>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/*
+   Persistent storage of assembled coarse/SEMFEM matrices, AMG hierarchies
+   and Chebyshev eigenvalue estimates of the pMG levels.
+
+   Entries live in $NEKRS_CACHE_DIR/amg/<name>-<key>/ with one file per rank.
+   The key hashes all inputs of the setup (mesh, boundary conditions, solver
+   settings) on every rank, a stale or foreign entry therefore never matches.
+*/
+namespace amgCache
+{
+
+class key_t
+{
+public:
+  void add(const void *data, size_t bytes);
+
+  template <typename T> void add(const T &value) { add((const void *)&value, sizeof(T)); }
+
+  template <typename T> void add(const T *data, size_t n) { add((const void *)data, n * sizeof(T)); }
+
+  template <typename T> void add(const std::vector<T> &v)
+  {
+    add(v.size());
+    add(v.data(), v.size());
+  }
+
+  void add(const std::string &s)
+  {
+    add(s.size());
+    add(s.data(), s.size());
+  }
+
+  // combines the rank-local hashes, collective
+  std::string str(MPI_Comm comm) const;
+
+private:
+  uint64_t hash = 14695981039346656037ULL;
+};
+
+// collective, returns true on all ranks if every rank could read its entry
+bool load(const std::string &name,
+          const std::string &key,
+          MPI_Comm comm,
+          const std::function<void(std::istream &)> &read);
+
+// collective
+void save(const std::string &name,
+          const std::string &key,
+          MPI_Comm comm,
+          const std::function<void(std::ostream &)> &write);
+
+template <typename T> void write(std::ostream &out, const T &value)
+{
+  out.write((const char *)&value, sizeof(T));
+}
+
+template <typename T> void write(std::ostream &out, const std::vector<T> &v)
+{
+  write(out, (uint64_t)v.size());
+  out.write((const char *)v.data(), v.size() * sizeof(T));
+}
+
+template <typename T> void read(std::istream &in, T &value) { in.read((char *)&value, sizeof(T)); }
+
+template <typename T> void read(std::istream &in, std::vector<T> &v)
+{
+  uint64_t n = 0;
+  read(in, n);
+  if (!in)
+    return;
+  v.resize(n);
+  in.read((char *)v.data(), n * sizeof(T));
+}
+
+} // namespace amgCache
+
+#endif
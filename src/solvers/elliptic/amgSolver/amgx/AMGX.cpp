@@ -15,13 +15,15 @@ void printHandler(const char *msg, int length)
   if(myid == 0) printf("%s", msg);
 }
 
-AMGX_t::AMGX_t(const int nLocalRows_, const int nnz,
+AMGX_t::AMGX_t(const int nLocalRows_, const int nnz_,
                const long long *rows, const long long *cols, const double *values, /* COO */ 
                const int nullspace, const MPI_Comm comm_, int deviceID,
-               int useFP32, int MPI_DIRECT, const char* cfgFile)
+               int useFP32_, int MPI_DIRECT, const char* cfgFile)
 {
   MPI_Comm_dup(comm_,&comm);
   nLocalRows = nLocalRows_;
+  nnz = nnz_;
+  useFP32 = useFP32_;
  
   int myid, commSize;
   MPI_Comm_rank(comm, &myid);
@@ -130,6 +132,21 @@ AMGX_t::AMGX_t(const int nLocalRows_, const int nnz,
   AMGXinit = 1;
 }
 
+// rows are sorted, COO and CSR values share the same order
+void AMGX_t::update(const double *values)
+{
+  if(useFP32) {
+    float *csrValues = (float*) malloc(nnz * sizeof(float));
+    for (int i = 0; i < nnz; i++) csrValues[i] = values[i];
+    AMGX_matrix_replace_coefficients(AmgXA, nLocalRows, nnz, csrValues, NULL);
+    free(csrValues);
+  } else {
+    AMGX_matrix_replace_coefficients(AmgXA, nLocalRows, nnz, values, NULL);
+  }
+
+  AMGX_solver_resetup(solver, AmgXA);
+}
+
 int AMGX_t::solve(void *rhs, void *x)
 {
   AMGX_vector_upload(AmgXP, nLocalRows, 1, x);
@@ -181,6 +198,13 @@ AMGX_t::AMGX_t(const int nLocalRows, const int nnz,
   if(rank == 0) printf("ERROR: Recompile with AMGX support!\n");
 }
 
+void AMGX_t::update(const double *values)
+{
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD,&rank);  
+  if(rank == 0) printf("ERROR: Recompile with AMGX support!\n");
+}
+
 int AMGX_t::solve(void *x, void *rhs)
 {
   int rank;
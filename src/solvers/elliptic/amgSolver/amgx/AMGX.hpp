@@ -28,9 +28,14 @@ public:
          int useFP32, int MPIDIRECT, const char* cfgFile);
   int solve(void *rhs, void *x);
 
+  // new values for the COO entries passed to the constructor
+  void update(const double *values);
+
 private:
   MPI_Comm comm;
   int nLocalRows;
+  int nnz;
+  int useFP32;
   AMGX_vector_handle AmgXP;
   AMGX_vector_handle AmgXRHS;
   AMGX_matrix_handle AmgXA;
@@ -80,23 +80,23 @@ boomerAMG_t::boomerAMG_t(int _nRows,
   HYPRE_IJMatrixSetObjectType(*A, HYPRE_PARCSR);
   HYPRE_IJMatrixInitialize(*A);
 
-  std::map<HYPRE_BigInt, std::vector<std::pair<HYPRE_BigInt, HYPRE_Real>>> rowToColAndVal;
+  std::map<HYPRE_BigInt, std::vector<std::pair<HYPRE_BigInt, int>>> rowToColAndIdx;
   for (int i = 0; i < nz; i++) {
     HYPRE_BigInt mati = (HYPRE_BigInt)(Ai[i]);
     HYPRE_BigInt matj = (HYPRE_BigInt)(Aj[i]);
-    HYPRE_Real matv = (HYPRE_Real)Av[i];
-    rowToColAndVal[mati].emplace_back(std::make_pair(matj, matv));
+    rowToColAndIdx[mati].emplace_back(std::make_pair(matj, i));
   }
 
-  const HYPRE_Int rowsToSet = rowToColAndVal.size();
+  const HYPRE_Int rowsToSet = rowToColAndIdx.size();
   std::vector<HYPRE_Int> ncols(rowsToSet);
   std::vector<HYPRE_BigInt> rows(rowsToSet);
   std::vector<HYPRE_BigInt> cols(nz);
   std::vector<HYPRE_Real> vals(nz);
+  ijToCoo.resize(nz);
 
   unsigned rowCtr = 0;
   unsigned colCtr = 0;
-  for (auto &&rowAndColValPair : rowToColAndVal) {
+  for (auto &&rowAndColValPair : rowToColAndIdx) {
     const auto &row = rowAndColValPair.first;
     const auto &colAndValues = rowAndColValPair.second;
 
@@ -105,9 +105,10 @@ boomerAMG_t::boomerAMG_t(int _nRows,
 
     for (auto &&colAndValue : colAndValues) {
       const auto &col = colAndValue.first;
-      const auto &val = colAndValue.second;
+      const auto &idx = colAndValue.second;
       cols[colCtr] = col;
-      vals[colCtr] = val;
+      vals[colCtr] = (HYPRE_Real)Av[idx];
+      ijToCoo[colCtr] = idx;
       ++colCtr;
     }
     ++rowCtr;
@@ -117,6 +118,11 @@ boomerAMG_t::boomerAMG_t(int _nRows,
 
   HYPRE_IJMatrixAssemble(*A);
 
+  // pattern is kept for update
+  ijNcols = std::move(ncols);
+  ijRows = std::move(rows);
+  ijCols = std::move(cols);
+
   if(DEBUG)
     HYPRE_IJMatrixPrint(*A, "matrix.dat");
 
@@ -178,7 +184,13 @@ boomerAMG_t::boomerAMG_t(int _nRows,
   HYPRE_IJVectorInitialize(*x);
   HYPRE_IJVectorAssemble(*x);
 
-  // Perform AMG setup
+  setup();
+
+  HYPREinit = 1;
+}
+
+void boomerAMG_t::setup()
+{
   HYPRE_ParVector par_b;
   HYPRE_ParVector par_x;
   HYPRE_IJVectorGetObject(*b, (void **)&par_b);
@@ -202,7 +214,20 @@ boomerAMG_t::boomerAMG_t(int _nRows,
 #ifdef _OPENMP
   omp_set_num_threads(NthreadsSave);
 #endif
-  HYPREinit = 1;
+}
+
+void __attribute__((visibility("default"))) boomerAMG_t::update(const double *Av)
+{
+  std::vector<HYPRE_Real> vals(ijCols.size());
+  for (size_t i = 0; i < vals.size(); i++)
+    vals[i] = (HYPRE_Real)Av[ijToCoo[i]];
+
+  HYPRE_IJMatrixInitialize(*A);
+  HYPRE_IJMatrixSetValues(*A, ijRows.size(), ijNcols.data(), ijRows.data(), ijCols.data(), vals.data());
+  HYPRE_IJMatrixAssemble(*A);
+
+  // there is no numeric-only setup in BoomerAMG, the hierarchy is rebuilt in place
+  setup();
 }
 
 void __attribute__((visibility("default"))) boomerAMG_t::solve(void *bin, void *xin)
@@ -260,7 +285,10 @@ __attribute__((visibility("default"))) IJ_t::IJ_t() {}
 
 __attribute__((visibility("default"))) IJ_t::~IJ_t()
 {
-  if(A) HYPRE_IJMatrixDestroy(*A);
+  if(A) {
+    HYPRE_IJMatrixDestroy(*A);
+    delete A;
+  }
 }
 
 int __attribute__((visibility("default")))
@@ -296,7 +324,11 @@ IJ_t::MatrixCreate(MPI_Comm comm,
                             HYPRE_BigInt jlower,
                             HYPRE_BigInt jupper)
 {
-  A = new HYPRE_IJMatrix(); 
+  // a previous matrix is replaced
+  if(A)
+    HYPRE_IJMatrixDestroy(*A);
+  else
+    A = new HYPRE_IJMatrix();
   return HYPRE_IJMatrixCreate(comm, ilower, iupper, jlower, jupper, A);
 }
 
@@ -2,6 +2,7 @@
 #define HYPRE_WRAPPER_H
 
 #include <mpi.h>
+#include <vector>
 
 namespace hypreWrapper {
 
@@ -46,7 +47,12 @@ public:
 
   void solve(void *b, void *x);
 
+  // new values for the COO entries passed to the constructor
+  void update(const double *Av);
+
 private:
+  void setup();
+
   MPI_Comm comm;
   int nRows;
   int Nthreads;
@@ -56,6 +62,11 @@ private:
   HYPRE_IJMatrix *A;
   HYPRE_IJVector *b;
   HYPRE_IJVector *x;
+
+  std::vector<HYPRE_Int> ijNcols;
+  std::vector<HYPRE_BigInt> ijRows;
+  std::vector<HYPRE_BigInt> ijCols;
+  std::vector<int> ijToCoo;
 };
 
 class IJ_t {
@@ -92,7 +103,7 @@ public:
   int MatrixAssemble();
 
 private:
-  HYPRE_IJMatrix *A;
+  HYPRE_IJMatrix *A = nullptr;
 };
 
 
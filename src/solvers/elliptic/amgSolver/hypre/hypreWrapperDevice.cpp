@@ -106,23 +106,23 @@ boomerAMG_t::boomerAMG_t(int _nRows,
     HYPRE_IJMatrixSetObjectType(*A, HYPRE_PARCSR);
     HYPRE_IJMatrixInitialize(*A);
 
-    std::map<HYPRE_BigInt, std::vector<std::pair<HYPRE_BigInt, HYPRE_Real>>> rowToColAndVal;
+    std::map<HYPRE_BigInt, std::vector<std::pair<HYPRE_BigInt, int>>> rowToColAndIdx;
     for (int i = 0; i < nz; i++) {
       HYPRE_BigInt mati = (HYPRE_BigInt)(Ai[i]);
       HYPRE_BigInt matj = (HYPRE_BigInt)(Aj[i]);
-      HYPRE_Real matv = (HYPRE_Real)Av[i];
-      rowToColAndVal[mati].emplace_back(std::make_pair(matj, matv));
+      rowToColAndIdx[mati].emplace_back(std::make_pair(matj, i));
     }
 
-    const HYPRE_Int rowsToSet = rowToColAndVal.size();
+    const HYPRE_Int rowsToSet = rowToColAndIdx.size();
     std::vector<HYPRE_Int> ncols(rowsToSet);
     std::vector<HYPRE_BigInt> rows(rowsToSet);
     std::vector<HYPRE_BigInt> cols(nz);
     std::vector<HYPRE_Real> vals(nz);
+    ijToCoo.resize(nz);
 
     unsigned rowCtr = 0;
     unsigned colCtr = 0;
-    for (auto &&rowAndColValPair : rowToColAndVal) {
+    for (auto &&rowAndColValPair : rowToColAndIdx) {
       const auto &row = rowAndColValPair.first;
       const auto &colAndValues = rowAndColValPair.second;
 
@@ -131,9 +131,10 @@ boomerAMG_t::boomerAMG_t(int _nRows,
 
       for (auto &&colAndValue : colAndValues) {
         const auto &col = colAndValue.first;
-        const auto &val = colAndValue.second;
+        const auto &idx = colAndValue.second;
         cols[colCtr] = col;
-        vals[colCtr] = val;
+        vals[colCtr] = (HYPRE_Real)Av[idx];
+        ijToCoo[colCtr] = idx;
         ++colCtr;
       }
       ++rowCtr;
@@ -158,6 +159,11 @@ boomerAMG_t::boomerAMG_t(int _nRows,
 
     HYPRE_IJMatrixAssemble(*A);
 
+    // pattern is kept for update
+    ijNcols = std::move(ncols);
+    ijRows = std::move(rows);
+    ijCols = std::move(cols);
+
     if(DEBUG)
       HYPRE_IJMatrixPrint(*A, "matrix.dat");
   }
@@ -229,7 +235,13 @@ boomerAMG_t::boomerAMG_t(int _nRows,
   HYPRE_IJVectorInitialize(*x);
   HYPRE_IJVectorAssemble(*x);
 
-  // Perform AMG setup
+  setup();
+
+  HYPREinit = 1;
+}
+
+void boomerAMG_t::setup()
+{
   HYPRE_ParVector par_b;
   HYPRE_ParVector par_x;
   HYPRE_ParCSRMatrix par_A;
@@ -242,8 +254,35 @@ boomerAMG_t::boomerAMG_t(int _nRows,
       printf("HYPRE_BoomerAMGDeviceSetup failed with %d!\n", err);
     MPI_Abort(comm, err);
   }
+}
 
-  HYPREinit = 1;
+void __attribute__((visibility("default"))) boomerAMG_t::update(const double *Av)
+{
+  std::vector<HYPRE_Real> vals(ijCols.size());
+  for (int i = 0; i < vals.size(); i++)
+    vals[i] = (HYPRE_Real)Av[ijToCoo[i]];
+
+  auto o_ncols = device.malloc(ijNcols.size() * sizeof(HYPRE_Int), ijNcols.data());
+  auto o_rows = device.malloc(ijRows.size() * sizeof(HYPRE_BigInt), ijRows.data());
+  auto o_cols = device.malloc(ijCols.size() * sizeof(HYPRE_BigInt), ijCols.data());
+  auto o_vals = device.malloc(vals.size() * sizeof(HYPRE_Real), vals.data());
+
+  HYPRE_IJMatrixInitialize(*A);
+  HYPRE_IJMatrixSetValues(*A,
+                          ijRows.size(),
+                          (HYPRE_Int *)o_ncols.ptr(),
+                          (HYPRE_BigInt *)o_rows.ptr(),
+                          (HYPRE_BigInt *)o_cols.ptr(),
+                          (HYPRE_Real *)o_vals.ptr());
+  HYPRE_IJMatrixAssemble(*A);
+
+  o_ncols.free();
+  o_rows.free();
+  o_cols.free();
+  o_vals.free();
+
+  // there is no numeric-only setup in BoomerAMG, the hierarchy is rebuilt in place
+  setup();
 }
 
 void __attribute__((visibility("default")))
@@ -330,6 +369,15 @@ boomerAMG_t::solve(const occa::memory &o_b, const occa::memory &o_x)
   MPI_Abort(MPI_COMM_WORLD, 1);
 }
 
+void __attribute__((visibility("default"))) boomerAMG_t::update(const double *Av)
+{
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  if (rank == 0)
+    printf("ERROR: Recompile with HYPRE GPU support!\n");
+  MPI_Abort(MPI_COMM_WORLD, 1);
+}
+
 __attribute__((visibility("default"))) boomerAMG_t::~boomerAMG_t()
 {
 }
@@ -2,6 +2,7 @@
 #define HYPRE_WRAPPER_DEVICE_H
 
 #include <mpi.h>
+#include <vector>
 #include "occa.hpp"
 
 namespace hypreWrapperDevice {
@@ -40,7 +41,12 @@ public:
 
   void solve(const occa::memory &o_b, const occa::memory &o_x);
 
+  // new values for the COO entries passed to the constructor
+  void update(const double *Av);
+
 private:
+  void setup();
+
   MPI_Comm comm;
   int rank;
   occa::device device;
@@ -50,6 +56,11 @@ private:
   HYPRE_IJMatrix *A;
   HYPRE_IJVector *b;
   HYPRE_IJVector *x;
+
+  std::vector<HYPRE_Int> ijNcols;
+  std::vector<HYPRE_BigInt> ijRows;
+  std::vector<HYPRE_BigInt> ijCols;
+  std::vector<int> ijToCoo;
 };
 
 } // namespace hypreWrapperDevice
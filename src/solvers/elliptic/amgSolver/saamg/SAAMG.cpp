@@ -0,0 +1,1130 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+#include <utility>
+
+#include "SAAMG.hpp"
+#include "amgSolver/amgCache.hpp"
+
+namespace {
+
+constexpr int haloTag = 1123;
+
+// levels with fewer rows are processed by a single thread
+constexpr int ompMinRows = 4096;
+
+// coarsest levels beyond this size are smoothed instead of factorized
+constexpr long long maxDenseRows = 4096;
+
+// number of iterations to estimate the spectral radius of D^{-1}A
+constexpr int powerIterations = 15;
+
+// Chebyshev interval is [chebyFraction*lambdaMax, lambdaMax]
+constexpr double chebyFraction = 0.3;
+
+using sparseRow_t = std::vector<std::pair<long long, double>>;
+
+struct csr_t {
+  int nRows = 0;
+  int nCols = 0; // local rows followed by halo columns
+  std::vector<int> rowStart;
+  std::vector<int> col;
+  std::vector<double> val;
+};
+
+struct halo_t {
+  std::vector<int> recvRanks, recvOffsets;
+  std::vector<int> sendRanks, sendOffsets;
+  std::vector<int> sendIds;
+  std::vector<double> sendBuffer;
+  std::vector<MPI_Request> requests;
+};
+
+template <typename T>
+void neighborExchange(halo_t &halo,
+                      const T *sendBuffer,
+                      const std::vector<int> &sendOffsets,
+                      T *recvBuffer,
+                      const std::vector<int> &recvOffsets,
+                      MPI_Datatype type,
+                      MPI_Comm comm)
+{
+  halo.requests.resize(halo.recvRanks.size() + halo.sendRanks.size());
+  int nReq = 0;
+  for (size_t n = 0; n < halo.recvRanks.size(); n++) {
+    MPI_Irecv(recvBuffer + recvOffsets[n],
+              recvOffsets[n + 1] - recvOffsets[n],
+              type,
+              halo.recvRanks[n],
+              haloTag,
+              comm,
+              &halo.requests[nReq++]);
+  }
+  for (size_t n = 0; n < halo.sendRanks.size(); n++) {
+    MPI_Isend(sendBuffer + sendOffsets[n],
+              sendOffsets[n + 1] - sendOffsets[n],
+              type,
+              halo.sendRanks[n],
+              haloTag,
+              comm,
+              &halo.requests[nReq++]);
+  }
+  MPI_Waitall(nReq, halo.requests.data(), MPI_STATUSES_IGNORE);
+}
+
+// fill halo entries x[nRows:nCols] from their owners
+void haloExchange(halo_t &halo, double *x, int nRows, MPI_Comm comm)
+{
+  for (size_t i = 0; i < halo.sendIds.size(); i++)
+    halo.sendBuffer[i] = x[halo.sendIds[i]];
+  neighborExchange(halo, halo.sendBuffer.data(), halo.sendOffsets, x + nRows, halo.recvOffsets, MPI_DOUBLE, comm);
+}
+
+// ship sparse rows (global column ids) to the ranks having them in their halo
+std::vector<sparseRow_t>
+exchangeRows(halo_t &halo, const std::vector<sparseRow_t> &rows, int nHalo, MPI_Comm comm)
+{
+  std::vector<int> sendLength(halo.sendIds.size());
+  for (size_t i = 0; i < halo.sendIds.size(); i++)
+    sendLength[i] = rows[halo.sendIds[i]].size();
+  std::vector<int> recvLength(nHalo);
+  neighborExchange(halo, sendLength.data(), halo.sendOffsets, recvLength.data(), halo.recvOffsets, MPI_INT, comm);
+
+  auto entryOffsets = [](const std::vector<int> &offsets, const std::vector<int> &length) {
+    std::vector<int> entries(offsets.size(), 0);
+    for (size_t n = 0; n + 1 < offsets.size(); n++)
+      entries[n + 1] = entries[n] + std::accumulate(length.begin() + offsets[n], length.begin() + offsets[n + 1], 0);
+    return entries;
+  };
+  const auto sendEntryOffsets = entryOffsets(halo.sendOffsets, sendLength);
+  const auto recvEntryOffsets = entryOffsets(halo.recvOffsets, recvLength);
+
+  std::vector<long long> sendCols;
+  std::vector<double> sendVals;
+  sendCols.reserve(sendEntryOffsets.back());
+  sendVals.reserve(sendEntryOffsets.back());
+  for (size_t i = 0; i < halo.sendIds.size(); i++) {
+    for (const auto &entry : rows[halo.sendIds[i]]) {
+      sendCols.push_back(entry.first);
+      sendVals.push_back(entry.second);
+    }
+  }
+
+  std::vector<long long> recvCols(recvEntryOffsets.back());
+  std::vector<double> recvVals(recvEntryOffsets.back());
+  neighborExchange(halo, sendCols.data(), sendEntryOffsets, recvCols.data(), recvEntryOffsets, MPI_LONG_LONG, comm);
+  neighborExchange(halo, sendVals.data(), sendEntryOffsets, recvVals.data(), recvEntryOffsets, MPI_DOUBLE, comm);
+
+  std::vector<sparseRow_t> haloRows(nHalo);
+  int entry = 0;
+  for (int i = 0; i < nHalo; i++) {
+    for (int k = 0; k < recvLength[i]; k++, entry++)
+      haloRows[i].push_back({recvCols[entry], recvVals[entry]});
+  }
+  return haloRows;
+}
+
+// sort by column and sum up duplicates
+void compress(sparseRow_t &row)
+{
+  std::sort(row.begin(), row.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+  int n = 0;
+  for (size_t k = 0; k < row.size(); k++) {
+    if (n > 0 && row[n - 1].first == row[k].first)
+      row[n - 1].second += row[k].second;
+    else
+      row[n++] = row[k];
+  }
+  row.resize(n);
+}
+
+int owner(const std::vector<long long> &rowStarts, long long gid)
+{
+  return std::upper_bound(rowStarts.begin(), rowStarts.end(), gid) - rowStarts.begin() - 1;
+}
+
+// y = A*x, x has to include the halo
+void spmv(const csr_t &A, const double *x, double *y)
+{
+  #pragma omp parallel for if(A.nRows > ompMinRows)
+  for (int i = 0; i < A.nRows; i++) {
+    double sum = 0;
+    for (int jj = A.rowStart[i]; jj < A.rowStart[i + 1]; jj++)
+      sum += A.val[jj] * x[A.col[jj]];
+    y[i] = sum;
+  }
+}
+
+void write(std::ostream &out, const csr_t &A)
+{
+  amgCache::write(out, A.nRows);
+  amgCache::write(out, A.nCols);
+  amgCache::write(out, A.rowStart);
+  amgCache::write(out, A.col);
+  amgCache::write(out, A.val);
+}
+
+void read(std::istream &in, csr_t &A)
+{
+  amgCache::read(in, A.nRows);
+  amgCache::read(in, A.nCols);
+  amgCache::read(in, A.rowStart);
+  amgCache::read(in, A.col);
+  amgCache::read(in, A.val);
+}
+
+void write(std::ostream &out, const halo_t &halo)
+{
+  amgCache::write(out, halo.recvRanks);
+  amgCache::write(out, halo.recvOffsets);
+  amgCache::write(out, halo.sendRanks);
+  amgCache::write(out, halo.sendOffsets);
+  amgCache::write(out, halo.sendIds);
+}
+
+void read(std::istream &in, halo_t &halo)
+{
+  amgCache::read(in, halo.recvRanks);
+  amgCache::read(in, halo.recvOffsets);
+  amgCache::read(in, halo.sendRanks);
+  amgCache::read(in, halo.sendOffsets);
+  amgCache::read(in, halo.sendIds);
+  halo.sendBuffer.resize(halo.sendIds.size());
+}
+
+} // namespace
+
+struct SAAMG_t::level_t {
+  std::vector<long long> rowStarts; // global row partition
+  std::vector<long long> haloIds;   // global ids of halo columns
+  halo_t halo;
+
+  csr_t A;
+  std::vector<double> invDiag;
+  double lambdaMax = 0;
+
+  // prolongation to this level from the next coarser one and its transpose
+  csr_t P, R;
+  std::vector<int> agg; // aggregate of each row
+
+  std::vector<double> b, x, r, d;
+
+  long long start() const { return rowStarts[rank]; }
+  long long globalRows() const { return rowStarts.back(); }
+
+  int rank = 0;
+
+  level_t() = default;
+  level_t(const std::vector<long long> &_rowStarts,
+          int _rank,
+          const std::vector<sparseRow_t> &rows,
+          MPI_Comm comm);
+
+  void write(std::ostream &out) const
+  {
+    amgCache::write(out, rank);
+    amgCache::write(out, rowStarts);
+    amgCache::write(out, haloIds);
+    ::write(out, halo);
+    ::write(out, A);
+    amgCache::write(out, invDiag);
+    amgCache::write(out, lambdaMax);
+    ::write(out, P);
+    ::write(out, R);
+    amgCache::write(out, agg);
+  }
+
+  void read(std::istream &in)
+  {
+    amgCache::read(in, rank);
+    amgCache::read(in, rowStarts);
+    amgCache::read(in, haloIds);
+    ::read(in, halo);
+    ::read(in, A);
+    amgCache::read(in, invDiag);
+    amgCache::read(in, lambdaMax);
+    ::read(in, P);
+    ::read(in, R);
+    amgCache::read(in, agg);
+
+    b.resize(A.nRows);
+    r.resize(A.nRows);
+    x.resize(A.nCols);
+    d.resize(A.nCols);
+  }
+
+  void applyA(double *x, double *y, MPI_Comm comm)
+  {
+    haloExchange(halo, x, A.nRows, comm);
+    spmv(A, x, y);
+  }
+
+  // local column of a global id, -1 if it is not referenced
+  int localCol(long long gid) const
+  {
+    const long long rowStart = start();
+    if (gid >= rowStart && gid < rowStart + A.nRows)
+      return gid - rowStart;
+    const auto it = std::lower_bound(haloIds.begin(), haloIds.end(), gid);
+    return (it != haloIds.end() && *it == gid) ? A.nRows + (it - haloIds.begin()) : -1;
+  }
+
+  // position of (i,j) in A, -1 if it is not part of the sparsity pattern
+  int find(int i, int j) const
+  {
+    for (int jj = A.rowStart[i]; jj < A.rowStart[i + 1]; jj++) {
+      if (A.col[jj] == j)
+        return jj;
+    }
+    return -1;
+  }
+
+  void setInvDiag()
+  {
+    invDiag.assign(A.nRows, 0);
+    for (int i = 0; i < A.nRows; i++) {
+      const int jj = find(i, i);
+      if (jj >= 0 && A.val[jj] != 0)
+        invDiag[i] = 1 / A.val[jj];
+    }
+  }
+
+  // entries outside of the sparsity pattern are dropped
+  void setValues(const std::vector<sparseRow_t> &rows)
+  {
+    std::fill(A.val.begin(), A.val.end(), 0.0);
+    for (int i = 0; i < A.nRows; i++) {
+      for (const auto &entry : rows[i]) {
+        const int j = localCol(entry.first);
+        const int jj = (j < 0) ? -1 : find(i, j);
+        if (jj >= 0)
+          A.val[jj] += entry.second;
+      }
+    }
+    setInvDiag();
+  }
+
+  double estimateLambdaMax(bool local, MPI_Comm comm);
+  long long nnz(MPI_Comm comm) const;
+};
+
+// rows are local with global column ids
+SAAMG_t::level_t::level_t(const std::vector<long long> &_rowStarts,
+                          int _rank,
+                          const std::vector<sparseRow_t> &rows,
+                          MPI_Comm comm)
+    : rowStarts(_rowStarts), rank(_rank)
+{
+  const int nRanks = rowStarts.size() - 1;
+  const long long rowStart = start();
+  const int nRows = rowStarts[rank + 1] - rowStart;
+
+  for (const auto &row : rows) {
+    for (const auto &entry : row) {
+      if (entry.first < rowStart || entry.first >= rowStart + nRows)
+        haloIds.push_back(entry.first);
+    }
+  }
+  std::sort(haloIds.begin(), haloIds.end());
+  haloIds.erase(std::unique(haloIds.begin(), haloIds.end()), haloIds.end());
+
+  A.nRows = nRows;
+  A.nCols = nRows + haloIds.size();
+  A.rowStart.assign(nRows + 1, 0);
+  for (int i = 0; i < nRows; i++) {
+    A.rowStart[i + 1] = A.rowStart[i] + rows[i].size();
+  }
+  A.col.resize(A.rowStart[nRows]);
+  A.val.resize(A.rowStart[nRows]);
+
+  for (int i = 0; i < nRows; i++) {
+    int jj = A.rowStart[i];
+    for (const auto &entry : rows[i]) {
+      A.col[jj] = localCol(entry.first);
+      A.val[jj] = entry.second;
+      jj++;
+    }
+  }
+  setInvDiag();
+
+  // haloIds are sorted, hence grouped by owner
+  std::vector<int> recvCounts(nRanks, 0), sendCounts(nRanks);
+  for (const auto gid : haloIds)
+    recvCounts[owner(rowStarts, gid)]++;
+  MPI_Alltoall(recvCounts.data(), 1, MPI_INT, sendCounts.data(), 1, MPI_INT, comm);
+
+  std::vector<int> recvDispls(nRanks + 1, 0), sendDispls(nRanks + 1, 0);
+  for (int r = 0; r < nRanks; r++) {
+    recvDispls[r + 1] = recvDispls[r] + recvCounts[r];
+    sendDispls[r + 1] = sendDispls[r] + sendCounts[r];
+  }
+
+  std::vector<long long> requested(sendDispls[nRanks]);
+  MPI_Alltoallv(haloIds.data(),
+                recvCounts.data(),
+                recvDispls.data(),
+                MPI_LONG_LONG,
+                requested.data(),
+                sendCounts.data(),
+                sendDispls.data(),
+                MPI_LONG_LONG,
+                comm);
+
+  halo.recvOffsets.push_back(0);
+  halo.sendOffsets.push_back(0);
+  for (int r = 0; r < nRanks; r++) {
+    if (recvCounts[r]) {
+      halo.recvRanks.push_back(r);
+      halo.recvOffsets.push_back(recvDispls[r + 1]);
+    }
+    if (sendCounts[r]) {
+      halo.sendRanks.push_back(r);
+      halo.sendOffsets.push_back(sendDispls[r + 1]);
+    }
+  }
+  for (const auto gid : requested)
+    halo.sendIds.push_back(gid - rowStart);
+  halo.sendBuffer.resize(halo.sendIds.size());
+
+  b.resize(nRows);
+  r.resize(nRows);
+  x.resize(A.nCols);
+  d.resize(A.nCols);
+}
+
+// power iteration on D^{-1}A, local ignores couplings to other ranks
+double SAAMG_t::level_t::estimateLambdaMax(bool local, MPI_Comm comm)
+{
+  const int n = A.nRows;
+  std::vector<double> v(A.nCols, 0), w(n);
+
+  // deterministic start vector independent of the partitioning
+  for (int i = 0; i < n; i++) {
+    const unsigned long long gid = start() + i;
+    v[i] = 1.0 + ((gid * 2654435761ULL) % 1000) / 1000.0;
+  }
+
+  double lambda = 0;
+  for (int it = 0; it < powerIterations; it++) {
+    if (local)
+      spmv(A, v.data(), w.data());
+    else
+      applyA(v.data(), w.data(), comm);
+
+    double norms[2] = {0, 0};
+    for (int i = 0; i < n; i++) {
+      w[i] *= invDiag[i];
+      norms[0] += w[i] * w[i];
+      norms[1] += v[i] * v[i];
+    }
+    if (!local)
+      MPI_Allreduce(MPI_IN_PLACE, norms, 2, MPI_DOUBLE, MPI_SUM, comm);
+    if (norms[0] == 0 || norms[1] == 0)
+      break;
+
+    lambda = std::sqrt(norms[0] / norms[1]);
+    const double scale = 1 / std::sqrt(norms[0]);
+    for (int i = 0; i < n; i++)
+      v[i] = scale * w[i];
+  }
+
+  return lambda;
+}
+
+long long SAAMG_t::level_t::nnz(MPI_Comm comm) const
+{
+  long long nnz = A.col.size();
+  MPI_Allreduce(MPI_IN_PLACE, &nnz, 1, MPI_LONG_LONG, MPI_SUM, comm);
+  return nnz;
+}
+
+namespace {
+
+// three-phase aggregation on the rank-local part of the strength graph
+int aggregate(const csr_t &A, const std::vector<double> &invDiag, double theta, std::vector<int> &agg)
+{
+  const int n = A.nRows;
+
+  auto strong = [&](int i, int jj) {
+    const int j = A.col[jj];
+    if (j == i || j >= n)
+      return false;
+    return std::abs(A.val[jj]) >= theta / std::sqrt(std::abs(invDiag[i] * invDiag[j]));
+  };
+
+  agg.assign(n, -1);
+  int nAgg = 0;
+
+  // 1: nodes with a free strong neighborhood become roots
+  for (int i = 0; i < n; i++) {
+    if (agg[i] != -1)
+      continue;
+    bool isFree = true;
+    for (int jj = A.rowStart[i]; jj < A.rowStart[i + 1] && isFree; jj++) {
+      if (strong(i, jj) && agg[A.col[jj]] != -1)
+        isFree = false;
+    }
+    if (!isFree)
+      continue;
+    agg[i] = nAgg;
+    for (int jj = A.rowStart[i]; jj < A.rowStart[i + 1]; jj++) {
+      if (strong(i, jj))
+        agg[A.col[jj]] = nAgg;
+    }
+    nAgg++;
+  }
+
+  // 2: attach leftovers to the most strongly connected aggregate
+  const std::vector<int> rootAgg = agg;
+  for (int i = 0; i < n; i++) {
+    if (rootAgg[i] != -1)
+      continue;
+    double maxVal = 0;
+    for (int jj = A.rowStart[i]; jj < A.rowStart[i + 1]; jj++) {
+      const int j = A.col[jj];
+      if (strong(i, jj) && rootAgg[j] != -1 && std::abs(A.val[jj]) >= maxVal) {
+        agg[i] = rootAgg[j];
+        maxVal = std::abs(A.val[jj]);
+      }
+    }
+  }
+
+  // 3: whatever is left forms aggregates with its free strong neighbors
+  for (int i = 0; i < n; i++) {
+    if (agg[i] != -1)
+      continue;
+    agg[i] = nAgg;
+    for (int jj = A.rowStart[i]; jj < A.rowStart[i + 1]; jj++) {
+      if (strong(i, jj) && agg[A.col[jj]] == -1)
+        agg[A.col[jj]] = nAgg;
+    }
+    nAgg++;
+  }
+
+  return nAgg;
+}
+
+csr_t transpose(const csr_t &P, int nCols)
+{
+  csr_t R;
+  R.nRows = nCols;
+  R.nCols = P.nRows;
+  R.rowStart.assign(nCols + 1, 0);
+  for (const auto j : P.col)
+    R.rowStart[j + 1]++;
+  std::partial_sum(R.rowStart.begin(), R.rowStart.end(), R.rowStart.begin());
+
+  R.col.resize(P.col.size());
+  R.val.resize(P.val.size());
+  std::vector<int> fill(R.rowStart.begin(), R.rowStart.end() - 1);
+  for (int i = 0; i < P.nRows; i++) {
+    for (int jj = P.rowStart[i]; jj < P.rowStart[i + 1]; jj++) {
+      const int k = fill[P.col[jj]]++;
+      R.col[k] = i;
+      R.val[k] = P.val[jj];
+    }
+  }
+  return R;
+}
+
+// smoothed prolongator from the aggregates of fine
+void smoothProlongator(SAAMG_t::level_t &fine, int nAgg, MPI_Comm comm)
+{
+  const int n = fine.A.nRows;
+
+  // tentative prolongator, constants are preserved on every aggregate
+  std::vector<double> tentative(nAgg, 0);
+  for (int i = 0; i < n; i++)
+    tentative[fine.agg[i]] += 1;
+  for (auto &t : tentative)
+    t = 1 / std::sqrt(t);
+
+  // P = (I - omega D^{-1} A_loc) T
+  const double omega = 4.0 / 3.0 / (1.1 * fine.estimateLambdaMax(true, comm));
+  {
+    csr_t &P = fine.P;
+    P = csr_t();
+    P.nRows = n;
+    P.nCols = nAgg;
+    P.rowStart.assign(n + 1, 0);
+    std::vector<int> marker(nAgg, -1);
+    for (int i = 0; i < n; i++) {
+      auto add = [&](int c, double v) {
+        if (marker[c] < P.rowStart[i]) {
+          marker[c] = P.col.size();
+          P.col.push_back(c);
+          P.val.push_back(v);
+        }
+        else {
+          P.val[marker[c]] += v;
+        }
+      };
+      P.rowStart[i] = P.col.size();
+      add(fine.agg[i], tentative[fine.agg[i]]);
+      for (int jj = fine.A.rowStart[i]; jj < fine.A.rowStart[i + 1]; jj++) {
+        const int j = fine.A.col[jj];
+        if (j < n)
+          add(fine.agg[j], -omega * fine.invDiag[i] * fine.A.val[jj] * tentative[fine.agg[j]]);
+      }
+    }
+    P.rowStart[n] = P.col.size();
+    fine.R = transpose(P, nAgg);
+  }
+}
+
+// rows of Ac = P^T A P with global column ids, P rows of halo columns are fetched from their owners
+std::vector<sparseRow_t>
+galerkinProduct(SAAMG_t::level_t &fine, const std::vector<long long> &coarseStarts, MPI_Comm comm)
+{
+  const int n = fine.A.nRows;
+  const int nAgg = fine.P.nCols;
+  std::vector<sparseRow_t> coarseRows(nAgg);
+  {
+    const long long coarseStart = coarseStarts[fine.rank];
+    std::vector<sparseRow_t> Prows(n);
+    for (int i = 0; i < n; i++) {
+      for (int jj = fine.P.rowStart[i]; jj < fine.P.rowStart[i + 1]; jj++)
+        Prows[i].push_back({coarseStart + fine.P.col[jj], fine.P.val[jj]});
+    }
+    const auto haloProws = exchangeRows(fine.halo, Prows, fine.haloIds.size(), comm);
+
+    // compact column space: local aggregates followed by off-rank ones
+    std::vector<long long> haloCoarseIds;
+    for (const auto &row : haloProws) {
+      for (const auto &entry : row) {
+        if (entry.first < coarseStart || entry.first >= coarseStart + nAgg)
+          haloCoarseIds.push_back(entry.first);
+      }
+    }
+    std::sort(haloCoarseIds.begin(), haloCoarseIds.end());
+    haloCoarseIds.erase(std::unique(haloCoarseIds.begin(), haloCoarseIds.end()), haloCoarseIds.end());
+    const int nCoarseCols = nAgg + haloCoarseIds.size();
+
+    std::vector<std::vector<std::pair<int, double>>> haloPcompact(haloProws.size());
+    for (size_t i = 0; i < haloProws.size(); i++) {
+      for (const auto &entry : haloProws[i]) {
+        const long long gid = entry.first;
+        const int k = (gid >= coarseStart && gid < coarseStart + nAgg)
+                          ? gid - coarseStart
+                          : nAgg + (std::lower_bound(haloCoarseIds.begin(), haloCoarseIds.end(), gid) -
+                                    haloCoarseIds.begin());
+        haloPcompact[i].push_back({k, entry.second});
+      }
+    }
+    auto compactToGlobal = [&](int k) {
+      return (k < nAgg) ? coarseStart + k : haloCoarseIds[k - nAgg];
+    };
+
+    #pragma omp parallel if(n > ompMinRows)
+    {
+      std::vector<double> sum(nCoarseCols);
+      std::vector<int> marker(nCoarseCols, -1);
+      std::vector<int> touched;
+
+      #pragma omp for
+      for (int c = 0; c < nAgg; c++) {
+        touched.clear();
+        auto add = [&](int k, double v) {
+          if (marker[k] != c) {
+            marker[k] = c;
+            sum[k] = 0;
+            touched.push_back(k);
+          }
+          sum[k] += v;
+        };
+
+        for (int ii = fine.R.rowStart[c]; ii < fine.R.rowStart[c + 1]; ii++) {
+          const int i = fine.R.col[ii];
+          const double p = fine.R.val[ii];
+          for (int jj = fine.A.rowStart[i]; jj < fine.A.rowStart[i + 1]; jj++) {
+            const int j = fine.A.col[jj];
+            const double pa = p * fine.A.val[jj];
+            if (j < n) {
+              for (int kk = fine.P.rowStart[j]; kk < fine.P.rowStart[j + 1]; kk++)
+                add(fine.P.col[kk], pa * fine.P.val[kk]);
+            }
+            else {
+              for (const auto &entry : haloPcompact[j - n])
+                add(entry.first, pa * entry.second);
+            }
+          }
+        }
+
+        coarseRows[c].reserve(touched.size());
+        for (const auto k : touched)
+          coarseRows[c].push_back({compactToGlobal(k), sum[k]});
+      }
+    }
+  }
+  return coarseRows;
+}
+
+} // namespace
+
+SAAMG_t::SAAMG_t(const int _nLocalRows,
+                 const int nnz,
+                 const long long *Ai,
+                 const long long *Aj,
+                 const double *Av,
+                 const int null_space,
+                 const MPI_Comm _comm,
+                 int _useFP32,
+                 const double *param,
+                 int verbose)
+{
+  MPI_Comm_dup(_comm, &comm);
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+
+  nLocalRows = _nLocalRows;
+  useFP32 = _useFP32;
+  setParameters(param);
+
+  {
+    std::vector<long long> rowStarts(size + 1, 0);
+    long long n = nLocalRows;
+    MPI_Allgather(&n, 1, MPI_LONG_LONG, rowStarts.data() + 1, 1, MPI_LONG_LONG, comm);
+    std::partial_sum(rowStarts.begin(), rowStarts.end(), rowStarts.begin());
+
+    std::vector<sparseRow_t> rows(nLocalRows);
+    for (int n = 0; n < nnz; n++) {
+      if (Av[n] != 0)
+        rows[Ai[n] - rowStarts[rank]].push_back({Aj[n], Av[n]});
+    }
+    for (auto &row : rows)
+      compress(row);
+
+    levels.push_back(std::make_unique<level_t>(rowStarts, rank, rows, comm));
+
+    const auto &L = *levels[0];
+    cooToA.assign(nnz, -1);
+    for (int n = 0; n < nnz; n++) {
+      if (Av[n] != 0)
+        cooToA[n] = L.find(Ai[n] - rowStarts[rank], L.localCol(Aj[n]));
+    }
+  }
+
+  while (static_cast<int>(levels.size()) < maxLevels && levels.back()->globalRows() > maxCoarseRows) {
+    auto &fine = *levels.back();
+
+    const int nAgg = aggregate(fine.A, fine.invDiag, strongThreshold, fine.agg);
+
+    std::vector<long long> coarseStarts(size + 1, 0);
+    {
+      long long nc = nAgg;
+      MPI_Allgather(&nc, 1, MPI_LONG_LONG, coarseStarts.data() + 1, 1, MPI_LONG_LONG, comm);
+      std::partial_sum(coarseStarts.begin(), coarseStarts.end(), coarseStarts.begin());
+    }
+
+    // aggregation stalled
+    if (coarseStarts.back() > 0.9 * fine.globalRows() || coarseStarts.back() == 0) {
+      fine.agg.clear();
+      break;
+    }
+
+    smoothProlongator(fine, nAgg, comm);
+    const auto coarseRows = galerkinProduct(fine, coarseStarts, comm);
+
+    levels.push_back(std::make_unique<level_t>(coarseStarts, rank, coarseRows, comm));
+  }
+
+  for (size_t lev = 0; lev < levels.size(); lev++)
+    levels[lev]->lambdaMax = 1.1 * levels[lev]->estimateLambdaMax(false, comm);
+
+  // a null space shows up as vanishing pivot of the coarsest operator
+  setupCoarsest();
+
+  printSummary(verbose);
+}
+
+SAAMG_t::SAAMG_t(std::istream &in, const MPI_Comm _comm, int _useFP32, const double *param, int verbose)
+{
+  MPI_Comm_dup(_comm, &comm);
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+
+  useFP32 = _useFP32;
+  setParameters(param);
+
+  int nLevels = 0;
+  amgCache::read(in, nLevels);
+  for (int lev = 0; lev < nLevels && in; lev++) {
+    levels.push_back(std::make_unique<level_t>());
+    levels.back()->read(in);
+  }
+  amgCache::read(in, cooToA);
+  nLocalRows = levels.size() ? levels[0]->A.nRows : 0;
+
+  amgCache::read(in, nDense);
+  amgCache::read(in, pivot);
+  amgCache::read(in, zeroPivot);
+  amgCache::read(in, denseCounts);
+  amgCache::read(in, denseDispls);
+  denseRhs.resize(nDense);
+
+  // the replicated factors are stored once
+  long long nLU = 0;
+  if (rank == 0) {
+    amgCache::read(in, LU);
+    nLU = LU.size();
+  }
+  MPI_Bcast(&nLU, 1, MPI_LONG_LONG, 0, comm);
+  LU.resize(nLU);
+  MPI_Bcast(LU.data(), nLU, MPI_DOUBLE, 0, comm);
+  if (nLU != (long long)nDense * nDense)
+    in.setstate(std::ios::failbit);
+
+  int ok = in.good();
+  MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, comm);
+  if (ok)
+    printSummary(verbose);
+  else
+    in.setstate(std::ios::failbit);
+}
+
+void SAAMG_t::write(std::ostream &out) const
+{
+  amgCache::write(out, (int)levels.size());
+  for (const auto &level : levels)
+    level->write(out);
+  amgCache::write(out, cooToA);
+
+  amgCache::write(out, nDense);
+  amgCache::write(out, pivot);
+  amgCache::write(out, zeroPivot);
+  amgCache::write(out, denseCounts);
+  amgCache::write(out, denseDispls);
+  if (rank == 0)
+    amgCache::write(out, LU);
+}
+
+void SAAMG_t::update(const double *Av)
+{
+  auto &L = *levels[0];
+  std::fill(L.A.val.begin(), L.A.val.end(), 0.0);
+  for (size_t n = 0; n < cooToA.size(); n++) {
+    if (cooToA[n] >= 0)
+      L.A.val[cooToA[n]] += Av[n];
+  }
+  L.setInvDiag();
+
+  // aggregates and all sparsity patterns are kept
+  for (size_t lev = 0; lev + 1 < levels.size(); lev++) {
+    auto &fine = *levels[lev];
+    auto &coarse = *levels[lev + 1];
+    smoothProlongator(fine, coarse.A.nRows, comm);
+    coarse.setValues(galerkinProduct(fine, coarse.rowStarts, comm));
+  }
+
+  for (size_t lev = 0; lev < levels.size(); lev++)
+    levels[lev]->lambdaMax = 1.1 * levels[lev]->estimateLambdaMax(false, comm);
+
+  setupCoarsest();
+}
+
+// cycle settings may differ from the ones the hierarchy was built with
+void SAAMG_t::setParameters(const double *param)
+{
+  strongThreshold = param[0];
+  chebyshev = param[1];
+  sweeps = param[2];
+  cycles = param[3];
+  maxCoarseRows = param[4];
+  maxLevels = param[5];
+}
+
+void SAAMG_t::printSummary(int verbose)
+{
+  if (rank == 0 && verbose) {
+    printf("\nSAAMG: %d levels\n", (int)levels.size());
+  }
+
+  long long nnzFine = 0, nnzTotal = 0, rowsTotal = 0;
+  for (int lev = 0; lev < static_cast<int>(levels.size()); lev++) {
+    const long long levNnz = levels[lev]->nnz(comm);
+    if (lev == 0)
+      nnzFine = levNnz;
+    nnzTotal += levNnz;
+    rowsTotal += levels[lev]->globalRows();
+    if (rank == 0 && verbose)
+      printf("  level %d: rows %lld nnz %lld lambdaMax %g\n",
+             lev,
+             levels[lev]->globalRows(),
+             levNnz,
+             levels[lev]->lambdaMax);
+  }
+  if (rank == 0) {
+    printf("SAAMG levels: %d, grid complexity: %.2f, operator complexity: %.2f ... ",
+           (int)levels.size(),
+           (double)rowsTotal / levels[0]->globalRows(),
+           (double)nnzTotal / std::max(nnzFine, 1LL));
+    fflush(stdout);
+  }
+}
+
+SAAMG_t::~SAAMG_t()
+{
+  MPI_Comm_free(&comm);
+}
+
+// replicate the coarsest operator on all ranks and LU factorize it
+void SAAMG_t::setupCoarsest()
+{
+  auto &L = *levels.back();
+  if (L.globalRows() > maxDenseRows)
+    return;
+
+  nDense = L.globalRows();
+  const int n = L.A.nRows;
+
+  denseCounts.resize(size);
+  denseDispls.assign(size + 1, 0);
+  for (int r = 0; r < size; r++) {
+    denseCounts[r] = L.rowStarts[r + 1] - L.rowStarts[r];
+    denseDispls[r + 1] = L.rowStarts[r + 1];
+  }
+  denseRhs.resize(nDense);
+
+  std::vector<double> localRows((size_t)n * nDense, 0);
+  for (int i = 0; i < n; i++) {
+    for (int jj = L.A.rowStart[i]; jj < L.A.rowStart[i + 1]; jj++) {
+      const int j = L.A.col[jj];
+      const long long gid = (j < n) ? L.start() + j : L.haloIds[j - n];
+      localRows[(size_t)i * nDense + gid] = L.A.val[jj];
+    }
+  }
+
+  std::vector<int> counts(size), displs(size);
+  for (int r = 0; r < size; r++) {
+    counts[r] = denseCounts[r] * nDense;
+    displs[r] = denseDispls[r] * nDense;
+  }
+  LU.resize((size_t)nDense * nDense);
+  MPI_Allgatherv(localRows.data(), n * nDense, MPI_DOUBLE, LU.data(), counts.data(), displs.data(), MPI_DOUBLE, comm);
+
+  // partial pivoting, vanishing pivots (null space) pin the corresponding unknown to zero
+  double maxAbs = 0;
+  for (const auto v : LU)
+    maxAbs = std::max(maxAbs, std::abs(v));
+  const double pivotTol = 1e-12 * maxAbs;
+
+  pivot.resize(nDense);
+  zeroPivot.assign(nDense, 0);
+  for (int k = 0; k < nDense; k++) {
+    int p = k;
+    for (int i = k + 1; i < nDense; i++) {
+      if (std::abs(LU[(size_t)i * nDense + k]) > std::abs(LU[(size_t)p * nDense + k]))
+        p = i;
+    }
+    pivot[k] = p;
+    if (p != k) {
+      std::swap_ranges(LU.begin() + (size_t)k * nDense,
+                       LU.begin() + (size_t)(k + 1) * nDense,
+                       LU.begin() + (size_t)p * nDense);
+    }
+
+    const double akk = LU[(size_t)k * nDense + k];
+    if (std::abs(akk) <= pivotTol) {
+      zeroPivot[k] = 1;
+      for (int i = k + 1; i < nDense; i++)
+        LU[(size_t)i * nDense + k] = 0;
+      continue;
+    }
+
+    #pragma omp parallel for if(nDense - k > 256)
+    for (int i = k + 1; i < nDense; i++) {
+      double *rowi = LU.data() + (size_t)i * nDense;
+      const double *rowk = LU.data() + (size_t)k * nDense;
+      const double l = rowi[k] / akk;
+      rowi[k] = l;
+      if (l == 0)
+        continue;
+      for (int j = k + 1; j < nDense; j++)
+        rowi[j] -= l * rowk[j];
+    }
+  }
+}
+
+void SAAMG_t::solveCoarsest()
+{
+  auto &L = *levels.back();
+  const int n = L.A.nRows;
+
+  if (!nDense) {
+    smooth(levels.size() - 1, true);
+    for (int it = 1; it < 4; it++)
+      smooth(levels.size() - 1, false);
+    return;
+  }
+
+  MPI_Allgatherv(L.b.data(), n, MPI_DOUBLE, denseRhs.data(), denseCounts.data(), denseDispls.data(), MPI_DOUBLE, comm);
+
+  double *y = denseRhs.data();
+  for (int k = 0; k < nDense; k++) {
+    std::swap(y[k], y[pivot[k]]);
+    for (int i = k + 1; i < nDense; i++)
+      y[i] -= LU[(size_t)i * nDense + k] * y[k];
+  }
+  for (int k = nDense - 1; k >= 0; k--) {
+    if (zeroPivot[k]) {
+      y[k] = 0;
+      continue;
+    }
+    const double *rowk = LU.data() + (size_t)k * nDense;
+    double sum = y[k];
+    for (int j = k + 1; j < nDense; j++)
+      sum -= rowk[j] * y[j];
+    y[k] = sum / rowk[k];
+  }
+
+  const long long offset = L.start();
+  for (int i = 0; i < n; i++)
+    L.x[i] = y[offset + i];
+}
+
+// Jacobi or Chebyshev (1st kind) on D^{-1}A, acts on L.b and L.x
+void SAAMG_t::smooth(int lev, bool xIsZero)
+{
+  auto &L = *levels[lev];
+  const int n = L.A.nRows;
+  double *x = L.x.data();
+  double *r = L.r.data();
+  double *d = L.d.data();
+  const double *b = L.b.data();
+  const double *invDiag = L.invDiag.data();
+
+  // res = D^{-1}(b - Ax)
+  auto residual = [&]() {
+    if (xIsZero) {
+      #pragma omp parallel for if(n > ompMinRows)
+      for (int i = 0; i < n; i++) {
+        x[i] = 0;
+        r[i] = invDiag[i] * b[i];
+      }
+    }
+    else {
+      L.applyA(x, r, comm);
+      #pragma omp parallel for if(n > ompMinRows)
+      for (int i = 0; i < n; i++)
+        r[i] = invDiag[i] * (b[i] - r[i]);
+    }
+  };
+
+  if (!chebyshev) {
+    const double omega = 4.0 / (3.0 * L.lambdaMax);
+    for (int s = 0; s < sweeps; s++) {
+      residual();
+      #pragma omp parallel for if(n > ompMinRows)
+      for (int i = 0; i < n; i++)
+        x[i] += omega * r[i];
+      xIsZero = false;
+    }
+    return;
+  }
+
+  const double lambda1 = L.lambdaMax;
+  const double lambda0 = chebyFraction * lambda1;
+  const double theta = 0.5 * (lambda1 + lambda0);
+  const double delta = 0.5 * (lambda1 - lambda0);
+  const double sigma = theta / delta;
+  double rho_n = 1. / sigma;
+
+  residual();
+
+  // d = invTheta*res
+  #pragma omp parallel for if(n > ompMinRows)
+  for (int i = 0; i < n; i++)
+    d[i] = r[i] / theta;
+
+  for (int k = 1; k < sweeps; k++) {
+    // x_k+1 = x_k + d_k
+    // r_k+1 = r_k - D^{-1}Ad_k
+    // d_k+1 = (rho_k+1*rho_k)*d_k  + (2*rho_k+1/delta)*r_k+1
+    const double rhoSave = rho_n;
+    rho_n = 1.0 / (2.0 * sigma - rho_n);
+    const double rCoeff = 2.0 * rho_n / delta;
+    const double dCoeff = rho_n * rhoSave;
+
+    #pragma omp parallel for if(n > ompMinRows)
+    for (int i = 0; i < n; i++)
+      x[i] += d[i];
+
+    haloExchange(L.halo, d, n, comm);
+    #pragma omp parallel for if(n > ompMinRows)
+    for (int i = 0; i < n; i++) {
+      double Ad = 0;
+      for (int jj = L.A.rowStart[i]; jj < L.A.rowStart[i + 1]; jj++)
+        Ad += L.A.val[jj] * d[L.A.col[jj]];
+      r[i] -= invDiag[i] * Ad;
+    }
+
+    // d is read with its halo above, update after all rows are done
+    #pragma omp parallel for if(n > ompMinRows)
+    for (int i = 0; i < n; i++)
+      d[i] = dCoeff * d[i] + rCoeff * r[i];
+  }
+
+  // x_k+1 = x_k + d_k
+  #pragma omp parallel for if(n > ompMinRows)
+  for (int i = 0; i < n; i++)
+    x[i] += d[i];
+}
+
+void SAAMG_t::vcycle(int lev, bool xIsZero)
+{
+  if (lev == static_cast<int>(levels.size()) - 1) {
+    solveCoarsest();
+    return;
+  }
+
+  auto &L = *levels[lev];
+  auto &C = *levels[lev + 1];
+  const int n = L.A.nRows;
+
+  smooth(lev, xIsZero);
+
+  // r = b - Ax
+  L.applyA(L.x.data(), L.r.data(), comm);
+  #pragma omp parallel for if(n > ompMinRows)
+  for (int i = 0; i < n; i++)
+    L.r[i] = L.b[i] - L.r[i];
+
+  // bc = R r
+  spmv(L.R, L.r.data(), C.b.data());
+
+  vcycle(lev + 1, true);
+
+  // x += P xc
+  #pragma omp parallel for if(n > ompMinRows)
+  for (int i = 0; i < n; i++) {
+    double sum = 0;
+    for (int jj = L.P.rowStart[i]; jj < L.P.rowStart[i + 1]; jj++)
+      sum += L.P.val[jj] * C.x[L.P.col[jj]];
+    L.x[i] += sum;
+  }
+
+  smooth(lev, false);
+}
+
+void SAAMG_t::solve(void *rhs, void *x)
+{
+  auto &L = *levels[0];
+
+  if (useFP32) {
+    std::copy((float *)rhs, (float *)rhs + nLocalRows, L.b.begin());
+  }
+  else {
+    std::copy((double *)rhs, (double *)rhs + nLocalRows, L.b.begin());
+  }
+
+  for (int cycle = 0; cycle < cycles; cycle++)
+    vcycle(0, cycle == 0);
+
+  if (useFP32) {
+    std::copy(L.x.begin(), L.x.begin() + nLocalRows, (float *)x);
+  }
+  else {
+    std::copy(L.x.begin(), L.x.begin() + nLocalRows, (double *)x);
+  }
+}
@@ -0,0 +1,82 @@
+#ifndef SAAMG_H
+#define SAAMG_H
+
+#include <mpi.h>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+class setupAide;
+
+/*
+   Smoothed aggregation AMG for the assembled coarse grid / SEMFEM systems.
+
+   Aggregates are formed rank-locally, the tentative prolongator is smoothed
+   by one damped Jacobi step and coarse operators are computed by a Galerkin
+   product. The coarsest level is solved by a replicated dense LU. Setup and
+   solve run on the host and are threaded by OpenMP.
+*/
+class SAAMG_t
+{
+public:
+  // strong threshold, smoother (0: Jacobi, 1: Chebyshev), sweeps/degree,
+  // V-cycles per solve, max coarsest level rows, max levels
+  static constexpr int NPARAM = 6;
+
+  // defaults overridden by the [SAAMG] par section
+  static void settings(setupAide &options, double *param);
+
+  SAAMG_t(const int nLocalRows, const int nnz,
+          const long long *Ai, const long long *Aj, const double *Av, /* COO */
+          const int null_space, const MPI_Comm comm,
+          int useFP32, const double *param, int verbose);
+  // restores a hierarchy stored by write(), check the stream state afterwards
+  SAAMG_t(std::istream &in, const MPI_Comm comm, int useFP32, const double *param, int verbose);
+  ~SAAMG_t();
+
+  void solve(void *rhs, void *x);
+
+  // new values for the COO entries of the setup, aggregates and sparsity patterns are kept
+  void update(const double *Av);
+
+  // rank-local part of the hierarchy
+  void write(std::ostream &out) const;
+
+  struct level_t;
+
+private:
+  void setParameters(const double *param);
+  void printSummary(int verbose);
+  void setupCoarsest();
+  void smooth(int lev, bool xIsZero);
+  void solveCoarsest();
+  void vcycle(int lev, bool xIsZero);
+
+  MPI_Comm comm;
+  int rank;
+  int size;
+  int nLocalRows;
+  int useFP32;
+
+  double strongThreshold;
+  int chebyshev;
+  int sweeps;
+  int cycles;
+  long long maxCoarseRows;
+  int maxLevels;
+
+  std::vector<std::unique_ptr<level_t>> levels;
+
+  // position of each setup COO entry in the finest operator, -1 if dropped
+  std::vector<int> cooToA;
+
+  // replicated LU factors of the coarsest operator
+  int nDense = 0;
+  std::vector<double> LU;
+  std::vector<int> pivot;
+  std::vector<int> zeroPivot;
+  std::vector<double> denseRhs;
+  std::vector<int> denseCounts, denseDispls;
+};
+
+#endif
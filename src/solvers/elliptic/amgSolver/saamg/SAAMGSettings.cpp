@@ -0,0 +1,19 @@
+#include "SAAMG.hpp"
+#include "setupAide.hpp"
+
+void SAAMG_t::settings(setupAide &options, double *param)
+{
+  param[0] = 0.02; /* strong threshold             */
+  param[1] = 1;    /* smoother (1: Chebyshev)      */
+  param[2] = 2;    /* Chebyshev order / sweeps     */
+  param[3] = 1;    /* number of cycles             */
+  param[4] = 256;  /* max rows of coarsest level   */
+  param[5] = 20;   /* max number of levels         */
+
+  options.getArgs("SAAMG STRONG THRESHOLD", param[0]);
+  if (options.compareArgs("SAAMG SMOOTHER TYPE", "JACOBI"))
+    param[1] = 0;
+  options.getArgs("SAAMG SMOOTHER SWEEPS", param[2]);
+  options.getArgs("SAAMG ITERATIONS", param[3]);
+  options.getArgs("SAAMG MAX COARSE SIZE", param[4]);
+}
@@ -89,11 +89,20 @@ struct elliptic_t
   int Niter;
   dfloat res00Norm, res0Norm, resNorm;
 
+  // adaptive stopping tolerance (LINEAR SOLVER ADAPTIVE TOLERANCE)
+  dfloat tol = 0;              // stopping tolerance of the last solve
+  dfloat truncationError = 0;  // temporal truncation error estimate set by the time stepper
+  dfloat residualScale = 0;    // residual norm per unit correction norm observed in the last solve
+  dfloat convergenceRate = 0;  // average log residual reduction per iteration
+  int NiterSaved = 0;
+  long long int NiterSavedSum = 0;
+
   dlong fieldOffset; 
 
   mesh_t* mesh;
 
   precon_t *precon = nullptr;
+  elliptic_t *preconSource = nullptr; // reuse its preconditioner if the operators match (not owned)
 
   ogs_t* ogs;
   oogs_t* oogs;
@@ -109,8 +118,6 @@ struct elliptic_t
 
   int* EToB;
 
-  static occa::memory o_wrk;
-
   // C0-FEM mask data
   dlong Nmasked;
   dlong NmaskedLocal;
@@ -142,12 +149,6 @@ struct elliptic_t
 
   occa::kernel fusedCopyDfloatToPfloatKernel;
 
-  // update for 1st Kind Chebyshev iteration
-  occa::kernel updateChebyshevKernel;
-
-  // fourth kind Chebyshev iteration
-  occa::kernel updateFourthKindChebyshevKernel;
-
   occa::kernel updatePGMRESSolutionKernel;
   occa::kernel fusedResidualAndNormKernel;
 
@@ -155,10 +156,21 @@ struct elliptic_t
 
   dfloat resNormFactor;
 
-  // combined PCG update step
+  // block partials of the multi-RHS PCG reductions
   dfloat* tmpNormr;
   occa::memory o_tmpNormr;
-  occa::kernel updatePCGKernel;
+
+  // PCG for multiple right-hand sides
+  occa::memory o_multiRhsCoeff;
+  occa::kernel updateMultiRhsPCGKernel;
+  occa::kernel multiRhsWeightedInnerProdKernel;
+  occa::kernel multiRhsUpdatePKernel;
+
+  // pfloat operator data for the inner solves of mixed-precision iterative refinement
+  occa::memory o_lambda0Pfloat;
+  occa::memory o_lambda1Pfloat;
+  occa::memory o_invDegreePfloat;
+  occa::memory o_invDiagAPfloat;
 
   hlong NelementsGlobal;
 
@@ -183,8 +195,10 @@ struct elliptic_t
 #include "ellipticSolutionProjection.h"
 
 elliptic_t* ellipticBuildMultigridLevelFine(elliptic_t* elliptic);
+void ellipticFreeMultigridLevelFine(elliptic_t* elliptic);
 
 void ellipticPreconditioner(elliptic_t* elliptic, occa::memory &o_r, occa::memory &o_z);
+void ellipticPreconditionerPfloat(elliptic_t* elliptic, occa::memory &o_r, occa::memory &o_z);
 void ellipticPreconditionerSetup(elliptic_t* elliptic, ogs_t* ogs);
 void ellipticBuildPreconditionerKernels(elliptic_t* elliptic);
 
@@ -195,6 +209,12 @@ void ellipticSolveSetup(elliptic_t* elliptic);
 int pcg(elliptic_t* elliptic, occa::memory &o_r, occa::memory &o_x,
         const dfloat tol, const int MAXIT, dfloat &res);
 
+int pcgMultiRhs(elliptic_t* elliptic, occa::memory &o_r, occa::memory &o_x,
+        const dfloat tol, const int MAXIT, dfloat &res);
+
+int ir(elliptic_t* elliptic, occa::memory &o_r, occa::memory &o_x,
+       const dfloat tol, const int MAXIT, dfloat &res);
+
 void initializeGmresData(elliptic_t*);
 int pgmres(elliptic_t* elliptic, occa::memory &o_r, occa::memory &o_x,
         const dfloat tol, const int MAXIT, dfloat &res);
@@ -213,17 +233,24 @@ void ellipticAx(elliptic_t* elliptic,
                 const char* precision);
 
 void ellipticMultiGridUpdateLambda(elliptic_t* elliptic);
+void ellipticMultiGridUpdateEigenvalues(elliptic_t* elliptic);
+void ellipticUpdateCoarseSolver(elliptic_t *elliptic);
 void ellipticUpdateJacobi(elliptic_t *ellipticBase, occa::memory &o_invDiagA);
 void ellipticUpdateJacobi(elliptic_t* elliptic);
 
 void ellipticMultiGridSetup(elliptic_t *elliptic, precon_t *precon);
+void ellipticMultiGridFree(elliptic_t *elliptic, precon_t *precon);
+void ellipticMultiGridAutotune(elliptic_t *elliptic);
 elliptic_t* ellipticBuildMultigridLevel(elliptic_t* baseElliptic, int Nc, int Nf);
+void ellipticFreeMultigridLevel(elliptic_t* elliptic);
 
 dfloat ellipticUpdatePCG(elliptic_t* elliptic, occa::memory &o_p, occa::memory &o_Ap, dfloat alpha,
                           occa::memory &o_x, occa::memory &o_r);
 
 void ellipticZeroMean(elliptic_t* elliptic, occa::memory &o_q);
 
+std::string ellipticCoarseSystemKey(elliptic_t *elliptic, elliptic_t *ellipticFine = nullptr);
+
 void ellipticOgs(mesh_t *mesh,
                  dlong mNlocal,
                  int nFields,
@@ -237,28 +264,7 @@ void ellipticOgs(mesh_t *mesh,
                  occa::memory &o_maskIdsGlobal,
                  ogs_t **ogs);
 
-static void ellipticUpdateWorkspace(elliptic_t* elliptic)
-{
-  const auto Nfields = 6; // first 6 slices are reserved as input to ellipticSolve
-  const auto offsetBytesWrk = elliptic->fieldOffset * (Nfields * sizeof(dfloat));
-  const auto offsetBytes = elliptic->fieldOffset * (elliptic->Nfields * sizeof(dfloat));
-
-  const auto requiredBytes = offsetBytesWrk + elliptic_t::NWorkspaceFields * offsetBytes;
-  nrsCheck(platform->o_mempool.o_ptr.size() < requiredBytes,
-           MPI_COMM_SELF,
-           EXIT_FAILURE,
-           "platform mempool too small! (required %ld out of %ld bytes)\n", 
-           requiredBytes, platform->o_mempool.o_ptr.size());
-
-  elliptic_t::o_wrk = 
-    platform->o_mempool.o_ptr.slice(offsetBytesWrk);
-
-  elliptic->o_p = elliptic->o_wrk + 0 * offsetBytes;
-  elliptic->o_z = elliptic->o_wrk + 1 * offsetBytes;
-  elliptic->o_Ap = elliptic->o_wrk + 2 * offsetBytes;
-  elliptic->o_x0 = elliptic->o_wrk + 3 * offsetBytes;
-  elliptic->o_rPfloat = elliptic->o_wrk + 4 * offsetBytes;
-  elliptic->o_zPfloat = elliptic->o_wrk + 5 * offsetBytes;
-}
+// Krylov workspace, valid until scope is destroyed
+void ellipticAllocateWorkspace(elliptic_t* elliptic, memoryArena_t::scope_t &scope);
  
 #endif
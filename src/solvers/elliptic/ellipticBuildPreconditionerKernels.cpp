@@ -47,12 +47,6 @@ void ellipticBuildPreconditionerKernels(elliptic_t* elliptic)
     mesh->maskPfloatKernel =
       platform->kernels.get(kernelName + orderSuffix + "pfloat");
 
-    kernelName = "updateChebyshev";
-    elliptic->updateChebyshevKernel = platform->kernels.get(kernelName + orderSuffix);
-
-    kernelName = "updateFourthKindChebyshev";
-    elliptic->updateFourthKindChebyshevKernel = platform->kernels.get(kernelName + orderSuffix);
-
     kernelName = "ellipticBlockBuildDiagonalHex3D";
     const std::string poissonPrefix = elliptic->poisson ? "poisson-" : "";
     elliptic->ellipticBlockBuildDiagonalKernel =
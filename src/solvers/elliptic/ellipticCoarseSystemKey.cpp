@@ -0,0 +1,71 @@
+#include "elliptic.h"
+#include "platform.hpp"
+#include "amgSolver/amgCache.hpp"
+
+namespace {
+
+void addMesh(amgCache::key_t &key, elliptic_t *elliptic)
+{
+  mesh_t *mesh = elliptic->mesh;
+
+  key.add(mesh->N);
+  key.add(mesh->Nelements);
+  key.add(mesh->x, mesh->Nlocal);
+  key.add(mesh->y, mesh->Nlocal);
+  key.add(mesh->z, mesh->Nlocal);
+  key.add(mesh->globalIds, mesh->Nlocal);
+
+  std::vector<dlong> maskIds(elliptic->Nmasked);
+  if (elliptic->Nmasked)
+    elliptic->o_maskIds.copyTo(maskIds.data(), elliptic->Nmasked * sizeof(dlong));
+  key.add(maskIds);
+
+  // every point of the coefficients, MG levels hold a pfloat copy of the first field
+  const size_t wordSize = elliptic->mgLevel ? sizeof(pfloat) : sizeof(dfloat);
+  const int Nblocks = (elliptic->mgLevel || elliptic->loffset == 0) ? 1 : elliptic->Nfields;
+  key.add(Nblocks);
+  auto addLambda = [&](occa::memory &o_lambda) {
+    std::vector<char> lambda(Nblocks * mesh->Nlocal * wordSize);
+    for (int fld = 0; fld < Nblocks; fld++)
+      o_lambda.copyTo(lambda.data() + fld * mesh->Nlocal * wordSize,
+                      mesh->Nlocal * wordSize,
+                      fld * elliptic->loffset * wordSize);
+    key.add(lambda);
+  };
+  addLambda(elliptic->o_lambda0);
+  if (!elliptic->poisson)
+    addLambda(elliptic->o_lambda1);
+  key.add(elliptic->allNeumann);
+}
+
+} // namespace
+
+// identifies the assembled coarse/SEMFEM system and its AMG hierarchy, collective
+std::string ellipticCoarseSystemKey(elliptic_t *elliptic, elliptic_t *ellipticFine)
+{
+  amgCache::key_t key;
+
+  addMesh(key, elliptic);
+  if (ellipticFine)
+    addMesh(key, ellipticFine);
+
+  for (auto &&s : {"COARSE SOLVER",
+                   "COARSE SOLVER PRECISION",
+                   "COARSE SOLVER LOCATION",
+                   "COARSE SOLVER AGGLOMERATION",
+                   "GALERKIN COARSE OPERATOR",
+                   "MULTIGRID SEMFEM"})
+    key.add(elliptic->options.getArgs(s));
+
+  for (auto &&s : {"AMG DROP TOLERANCE",
+                   "SAAMG STRONG THRESHOLD",
+                   "SAAMG SMOOTHER TYPE",
+                   "SAAMG SMOOTHER SWEEPS",
+                   "SAAMG ITERATIONS",
+                   "SAAMG MAX COARSE SIZE"})
+    key.add(platform->options.getArgs(s));
+
+  key.add(std::string(pfloatString));
+
+  return key.str(platform->comm.mpiComm);
+}
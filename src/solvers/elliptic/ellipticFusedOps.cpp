@@ -0,0 +1,90 @@
+#include "ellipticFusedOps.hpp"
+
+namespace ellipticFusedOps
+{
+// xx *= scale, bb *= scale
+const linAlg_t::fusedOps_t projectionScale{{"xx", "bb"}, {"scale"}, {"xx *= scale", "bb *= scale"}};
+
+// x = x + xbar, xx[0] = x
+const linAlg_t::fusedOps_t projectionRestart{{"x", "xbar", "xx"}, {}, {"x += xbar", "xx = x"}};
+
+// xx[m-1] = x, x = x + xbar
+const linAlg_t::fusedOps_t projectionAppend{{"x", "xbar", "xx"}, {}, {"xx = x", "x += xbar"}};
+
+// x <= x + alpha*p, r <= r - alpha*A*p, dot(r,r)
+const linAlg_t::fusedOps_t pcgUpdate{{"p", "Ap", "x", "r"},
+                                     {"alpha"},
+                                     {"x += alpha * p", "r -= alpha * Ap"},
+                                     {"r * r"},
+                                     true};
+
+// dot(r,z), dot(z,Ap)
+const linAlg_t::fusedOps_t pcgFlexibleDots{{"r", "z", "Ap"}, {}, {}, {"r * z", "z * Ap"}, true};
+
+// r <= r - alpha*A*p, dot(r,r)
+const linAlg_t::fusedOps_t irUpdate{{"Ap", "r"}, {"alpha"}, {"r -= alpha * Ap"}, {"r * r"}, true, true};
+
+const linAlg_t::fusedOps_t smootherStartZero{{"r", "res", "x"}, {}, {"x = 0", "res = r"}, {}, false, true};
+
+const linAlg_t::fusedOps_t chebyshevJacobiStartZero{{"r", "invDiag", "res", "d", "x"},
+                                                    {"invTheta"},
+                                                    {"x = 0", "res = invDiag * r", "d = invTheta * res"},
+                                                    {},
+                                                    false,
+                                                    true};
+
+const linAlg_t::fusedOps_t chebyshevJacobiStart{{"r", "invDiag", "res", "d"},
+                                                {"invTheta"},
+                                                {"res = invDiag * (r - res)", "d = invTheta * res"},
+                                                {},
+                                                false,
+                                                true};
+
+const linAlg_t::fusedOps_t chebyshevJacobiUpdate{
+    {"Ad", "invDiag", "d", "res", "x"},
+    {"dCoeff", "rCoeff"},
+    {"x += d", "res -= invDiag * Ad", "d = dCoeff * d + rCoeff * res"},
+    {},
+    false,
+    true};
+
+const linAlg_t::fusedOps_t chebyshevUpdate{{"SAd", "d", "res", "x"},
+                                           {"dCoeff", "rCoeff"},
+                                           {"x += d", "res -= SAd", "d = dCoeff * d + rCoeff * res"},
+                                           {},
+                                           false,
+                                           true};
+
+const linAlg_t::fusedOps_t fourthKindJacobiUpdate{
+    {"Ad", "invDiag", "d", "res", "x"},
+    {"beta", "dCoeff", "rCoeff"},
+    {"x += beta * d", "res -= Ad", "d = dCoeff * d + rCoeff * invDiag * res"},
+    {},
+    false,
+    true};
+
+const linAlg_t::fusedOps_t fourthKindUpdate{{"Ad", "d", "res", "x"},
+                                            {"beta"},
+                                            {"x += beta * d", "res -= Ad"},
+                                            {},
+                                            false,
+                                            true};
+
+const std::vector<const linAlg_t::fusedOps_t *> &all()
+{
+  static const std::vector<const linAlg_t::fusedOps_t *> ops{&projectionScale,
+                                                             &projectionRestart,
+                                                             &projectionAppend,
+                                                             &pcgUpdate,
+                                                             &pcgFlexibleDots,
+                                                             &irUpdate,
+                                                             &smootherStartZero,
+                                                             &chebyshevJacobiStartZero,
+                                                             &chebyshevJacobiStart,
+                                                             &chebyshevJacobiUpdate,
+                                                             &chebyshevUpdate,
+                                                             &fourthKindJacobiUpdate,
+                                                             &fourthKindUpdate};
+  return ops;
+}
+} // namespace ellipticFusedOps
@@ -0,0 +1,32 @@
+#ifndef ellipticFusedOps_hpp
+#define ellipticFusedOps_hpp
+
+#include <vector>
+#include "linAlg.hpp"
+
+// fused pipelines of the elliptic solvers, requested in registerEllipticKernels
+namespace ellipticFusedOps
+{
+// solution projection
+extern const linAlg_t::fusedOps_t projectionScale;
+extern const linAlg_t::fusedOps_t projectionRestart;
+extern const linAlg_t::fusedOps_t projectionAppend;
+
+// Krylov solvers
+extern const linAlg_t::fusedOps_t pcgUpdate;
+extern const linAlg_t::fusedOps_t pcgFlexibleDots;
+extern const linAlg_t::fusedOps_t irUpdate;
+
+// Chebyshev smoothers of the MG levels (pfloat)
+extern const linAlg_t::fusedOps_t smootherStartZero;
+extern const linAlg_t::fusedOps_t chebyshevJacobiStartZero;
+extern const linAlg_t::fusedOps_t chebyshevJacobiStart;
+extern const linAlg_t::fusedOps_t chebyshevJacobiUpdate;
+extern const linAlg_t::fusedOps_t chebyshevUpdate;
+extern const linAlg_t::fusedOps_t fourthKindJacobiUpdate;
+extern const linAlg_t::fusedOps_t fourthKindUpdate;
+
+const std::vector<const linAlg_t::fusedOps_t *> &all();
+} // namespace ellipticFusedOps
+
+#endif
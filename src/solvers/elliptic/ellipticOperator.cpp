@@ -43,54 +43,65 @@ void ellipticAx(elliptic_t* elliptic,
 
   const bool coeffField = options.compareArgs("ELLIPTIC COEFF FIELD", "TRUE");
   const bool continuous = options.compareArgs("DISCRETIZATION", "CONTINUOUS");
-  const int mapType = (elliptic->elementType == HEXAHEDRA &&
-                       options.compareArgs("ELEMENT MAP", "TRILINEAR")) ? 1:0;
   const std::string precisionStr(precision);
   const std::string dFloatStr(dfloatString);
 
+  nrsCheck(!continuous, MPI_COMM_SELF, EXIT_FAILURE,
+           "%s\n", "Encountered invalid configuration inside ellipticAx!");
 
-  bool valid = true;
-  valid &= continuous;
-  if(precisionStr != dFloatStr) {
-    valid &= !elliptic->blockSolver;
-    valid &= mapType == 0;
-  }
-
-  auto errTxt = [&]()
-  {
-    std::stringstream txt;
-    txt << "Encountered invalid configuration inside ellipticAx!\n";
-    if(elliptic->blockSolver)
-      txt << "Precision level (" << precision << ") does not support block solver\n";
-    if(mapType != 0)
-      txt << "Precision level (" << precision << ") does not support mapType " << mapType << "\n";
+  occa::kernel &AxKernel =
+      (precisionStr != dFloatStr) ? elliptic->AxPfloatKernel : elliptic->AxKernel;
 
-    return txt.str();
-  };
-  nrsCheck(!valid, MPI_COMM_SELF, EXIT_FAILURE, errTxt().c_str(), "");
+  // kernels built for interleaved geometric factors read the AoSoA copies
+  const bool aosoa = AxKernel.properties().has("defines/p_aosoaBytes");
 
   occa::memory & o_geom_factors =
-    (precisionStr != dFloatStr) ? mesh->o_ggeoPfloat :
-      elliptic->stressForm ? mesh->o_vgeo : mesh->o_ggeo;
+    (precisionStr != dFloatStr) ?
+      (elliptic->stressForm ? mesh->o_vgeoPfloat : (aosoa ? mesh->o_ggeoPfloatAoSoA : mesh->o_ggeoPfloat)) :
+      (elliptic->stressForm ? mesh->o_vgeo : (aosoa ? mesh->o_ggeoAoSoA : mesh->o_ggeo));
   occa::memory & o_D = (precisionStr != dFloatStr) ? mesh->o_DPfloat : mesh->o_D;
   occa::memory & o_DT = (precisionStr != dFloatStr) ? mesh->o_DTPfloat : mesh->o_DT;
-  occa::memory & o_lambda0 = elliptic->o_lambda0;
-  occa::memory & o_lambda1 = elliptic->o_lambda1;
-
-  occa::kernel &AxKernel =
-      (precisionStr != dFloatStr) ? elliptic->AxPfloatKernel : elliptic->AxKernel;
-
-  AxKernel(NelementsList,
-           elliptic->fieldOffset,
-           elliptic->loffset,
-           o_elementsList,
-           o_geom_factors,
-           o_D,
-           o_DT,
-           o_lambda0,
-           o_lambda1,
-           o_q,
-           o_Aq);
+  // MG levels own pfloat coefficients, the fine level keeps separate copies
+  const bool pfloatCopies = (precisionStr != dFloatStr) && !elliptic->mgLevel;
+  occa::memory & o_lambda0 = pfloatCopies ? elliptic->o_lambda0Pfloat : elliptic->o_lambda0;
+  occa::memory & o_lambda1 = pfloatCopies ? elliptic->o_lambda1Pfloat : elliptic->o_lambda1;
+
+  // kernels built for a lower geometry order recompute the geometric factors
+  // (all mesh kernels define p_Nq_g, it only differs from p_Nq for those).
+  // Mass matrix, Jacobi diagonal and MG levels keep the stored order N factors, they
+  // only match this operator exactly for elements of the lower order.
+  const auto &AxProps = AxKernel.properties();
+  const bool lowOrderGeom = AxProps.has("defines/p_Nq_g") &&
+                            static_cast<int>(AxProps["defines/p_Nq_g"]) != static_cast<int>(AxProps["defines/p_Nq"]);
+  if (lowOrderGeom) {
+    occa::memory &o_geomXYZ = (precisionStr != dFloatStr) ? mesh->o_geomXYZPfloat : mesh->o_geomXYZ;
+    occa::memory &o_geomBasis = (precisionStr != dFloatStr) ? mesh->o_geomBasisPfloat : mesh->o_geomBasis;
+    AxKernel(NelementsList,
+             elliptic->fieldOffset,
+             elliptic->loffset,
+             o_elementsList,
+             o_geomXYZ,
+             o_geomBasis,
+             o_D,
+             o_DT,
+             o_lambda0,
+             o_lambda1,
+             o_q,
+             o_Aq);
+  }
+  else {
+    AxKernel(NelementsList,
+             elliptic->fieldOffset,
+             elliptic->loffset,
+             o_elementsList,
+             o_geom_factors,
+             o_D,
+             o_DT,
+             o_lambda0,
+             o_lambda1,
+             o_q,
+             o_Aq);
+  }
 
   double flopCount = mesh->Np * 12 * mesh->Nq + 15 * mesh->Np;
   if(coeffField)
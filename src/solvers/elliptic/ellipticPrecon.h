@@ -45,6 +45,12 @@ struct precon_t
 
   SEMFEMSolver_t* SEMFEMSolver = nullptr;
 
+  // solves since setup, drives COARSE SOLVER REFRESH
+  int coarseSolverSolves = 0;
+
+  // solves since setup, drives MULTIGRID CHEBYSHEV EIGENVALUE REFRESH
+  int eigenvalueSolves = 0;
+
   ~precon_t();
 };
 
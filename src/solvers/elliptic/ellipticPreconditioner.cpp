@@ -82,3 +82,42 @@ void ellipticPreconditioner(elliptic_t *elliptic, occa::memory &o_r, occa::memor
   if (elliptic->allNeumann)
     ellipticZeroMean(elliptic, o_z);
 }
+
+// input and output in pfloat, used by the inner solves of mixed-precision iterative refinement
+void ellipticPreconditionerPfloat(elliptic_t *elliptic, occa::memory &o_r, occa::memory &o_z)
+{
+  mesh_t *mesh = elliptic->mesh;
+  precon_t *precon = elliptic->precon;
+  setupAide &options = elliptic->options;
+
+  const dlong Nlocal = mesh->Np * mesh->Nelements;
+
+  platform->timer.tic(elliptic->name + " preconditioner", 1);
+  if (options.compareArgs("PRECONDITIONER", "JACOBI")) {
+    const pfloat one = 1.0;
+    platform->linAlg->paxmyzMany(Nlocal,
+                                 elliptic->Nfields,
+                                 elliptic->fieldOffset,
+                                 one,
+                                 o_r,
+                                 elliptic->o_invDiagAPfloat,
+                                 o_z);
+    platform->flopCounter->add("jacobiPrecon", 0.5 * static_cast<double>(Nlocal) * elliptic->Nfields);
+  }
+  else if (options.compareArgs("PRECONDITIONER", "MULTIGRID")) {
+    platform->linAlg->pfill(elliptic->fieldOffset * elliptic->Nfields, 0.0, o_z);
+    precon->MGSolver->Run(o_r, o_z);
+  }
+  else if (options.compareArgs("PRECONDITIONER", "SEMFEM")) {
+    platform->linAlg->pfill(elliptic->fieldOffset * elliptic->Nfields, 0.0, o_z);
+    precon->SEMFEMSolver->run(o_r, o_z);
+  }
+  else if (options.compareArgs("PRECONDITIONER", "NONE")) {
+    o_z.copyFrom(o_r, elliptic->fieldOffset * elliptic->Nfields * sizeof(pfloat));
+  }
+  else {
+    nrsAbort(platform->comm.mpiComm, EXIT_FAILURE,
+             "%s\n", "Preconditioner not supported by mixed-precision solver!");
+  }
+  platform->timer.toc(elliptic->name + " preconditioner");
+}
@@ -50,6 +50,7 @@ void ellipticPreconditionerSetup(elliptic_t* elliptic, ogs_t* ogs)
     ellipticMultiGridSetup(elliptic, precon);
   } else if(options.compareArgs("PRECONDITIONER", "SEMFEM")) {
     if(platform->comm.mpiRank == 0) printf("building SEMFEM preconditioner ...\n"); fflush(stdout);
+    auto memoryOwner = platform->device.memoryOwner("SEMFEM " + elliptic->name);
     precon->SEMFEMSolver = new SEMFEMSolver_t(elliptic);
   } else if(options.compareArgs("PRECONDITIONER", "JACOBI")) {
     if(platform->comm.mpiRank == 0) printf("building Jacobi preconditioner ... "); fflush(stdout);
@@ -24,13 +24,12 @@
 
  */
 
+#include <algorithm>
 #include "elliptic.h"
 #include "ellipticPrecon.h"
 #include "platform.hpp"
 #include "linAlg.hpp"
 
-occa::memory elliptic_t::o_wrk = occa::memory();
-
 void checkConfig(elliptic_t *elliptic)
 {
   mesh_t *mesh = elliptic->mesh;
@@ -50,9 +49,10 @@ void checkConfig(elliptic_t *elliptic)
     err++;
   }
 
+  // MG levels are scalar, the FP32 block operator is only used by mixed-precision PCG
   if (elliptic->blockSolver && options.compareArgs("PRECONDITIONER", "MULTIGRID")) {
     if (platform->comm.mpiRank == 0)
-      printf("Block solver does not support multigrid preconditioner\n");
+      printf("Block solver does not support multigrid preconditioner (use +mixedPrecision with Jacobi)\n");
     err++;
   }
 
@@ -78,6 +78,27 @@ void checkConfig(elliptic_t *elliptic)
     err++;
   }
 
+  if (options.compareArgs("SOLVER", "MULTIRHS") && elliptic->stressForm) {
+    if (platform->comm.mpiRank == 0)
+      printf("multiRHS solver does not support stress formulation\n");
+    err++;
+  }
+
+  if (options.compareArgs("SOLVER", "MULTIRHS") && elliptic->Nfields != 3 &&
+      options.compareArgs("ELEMENT MAP", "TRILINEAR")) {
+    if (platform->comm.mpiRank == 0)
+      printf("multiRHS solver does not support trilinear element map\n");
+    err++;
+  }
+
+  if (options.compareArgs("SOLVER", "MIXEDPRECISION")) {
+    if (options.compareArgs("PRECONDITIONER", "USER")) {
+      if (platform->comm.mpiRank == 0)
+        printf("mixed-precision solver does not support user preconditioner\n");
+      err++;
+    }
+  }
+
   if (elliptic->Nfields < 1 || elliptic->Nfields > 3) {
     if (platform->comm.mpiRank == 0)
       printf("Invalid Nfields = %d!", elliptic->Nfields);
@@ -113,6 +134,34 @@ void checkConfig(elliptic_t *elliptic)
   nrsCheck(err, platform->comm.mpiComm, EXIT_FAILURE, "%s", "\n");
 }
 
+// the caller guarantees preconSource has the same coefficients, the
+// preconditioner is reused if the boundary masks and settings match as well
+static bool reusePreconditioner(elliptic_t *elliptic)
+{
+  elliptic_t *source = elliptic->preconSource;
+  if (!source || !source->precon)
+    return false;
+
+  mesh_t *mesh = elliptic->mesh;
+  const dlong NEToB = mesh->Nelements * mesh->Nfaces * elliptic->Nfields;
+
+  int match = source->mesh == mesh && source->Nfields == elliptic->Nfields &&
+              source->options.getArgs("PRECONDITIONER") == elliptic->options.getArgs("PRECONDITIONER") &&
+              std::equal(elliptic->EToB, elliptic->EToB + NEToB, source->EToB);
+  MPI_Allreduce(MPI_IN_PLACE, &match, 1, MPI_INT, MPI_MIN, platform->comm.mpiComm);
+  if (!match)
+    return false;
+
+  elliptic->precon = source->precon;
+  elliptic->nLevels = source->nLevels;
+  elliptic->levels = source->levels;
+
+  if (platform->comm.mpiRank == 0)
+    printf("reusing %s preconditioner\n", source->name.c_str());
+
+  return true;
+}
+
 void ellipticSolveSetup(elliptic_t *elliptic)
 {
   MPI_Barrier(platform->comm.mpiComm);
@@ -124,6 +173,8 @@ void ellipticSolveSetup(elliptic_t *elliptic)
            "%s\n",
            "Empty elliptic solver name!");
 
+  auto memoryOwner = platform->device.memoryOwner("elliptic " + elliptic->name);
+
   elliptic->options.setArgs("DISCRETIZATION", "CONTINUOUS");
 
   platform->options.getArgs("ELEMENT TYPE", elliptic->elementType);
@@ -144,7 +195,7 @@ void ellipticSolveSetup(elliptic_t *elliptic)
   if (platform->comm.mpiRank == 0 && platform->verbose)
     std::cout << elliptic->options << std::endl;
 
-  if (platform->device.mode() == "Serial")
+  if (platform->serial)
     elliptic->options.setArgs("COARSE SOLVER LOCATION", "CPU");
 
   setupAide &options = elliptic->options;
@@ -178,11 +229,11 @@ void ellipticSolveSetup(elliptic_t *elliptic)
 
   mesh->maskKernel = platform->kernels.get("mask");
   mesh->maskPfloatKernel = platform->kernels.get("maskPfloat");
- 
-  ellipticUpdateWorkspace(elliptic);
 
-  elliptic->tmpNormr = (dfloat *)calloc(Nblocks, sizeof(dfloat));
-  elliptic->o_tmpNormr = platform->device.malloc(Nblocks * sizeof(dfloat), elliptic->tmpNormr);
+  // multiRHS needs per field partial sums for up to two reductions
+  const int NtmpNormr = options.compareArgs("SOLVER", "MULTIRHS") ? 2 * elliptic->Nfields : 1;
+  elliptic->tmpNormr = (dfloat *)calloc(NtmpNormr * Nblocks, sizeof(dfloat));
+  elliptic->o_tmpNormr = platform->device.malloc(NtmpNormr * Nblocks * sizeof(dfloat), elliptic->tmpNormr);
 
   elliptic->allNeumann = 0;
   if (elliptic->poisson) {
@@ -247,61 +298,130 @@ void ellipticSolveSetup(elliptic_t *elliptic)
       kernelName += "Trilinear";
     kernelName += suffix;
 
-    elliptic->AxKernel = platform->kernels.get(kernelNamePrefix + "Partial" + kernelName);
+    // block kernels are specialized for velocity, scalar groups use a generic Nfields kernel
+    if (elliptic->blockSolver && !elliptic->stressForm && elliptic->Nfields != 3)
+      elliptic->AxKernel = platform->kernels.get(sectionIdentifier + "ellipticMultiRhsPartial" + kernelName);
+    else
+      elliptic->AxKernel = platform->kernels.get(kernelNamePrefix + "Partial" + kernelName);
+
+    if (options.compareArgs("SOLVER", "MULTIRHS")) {
+      elliptic->updateMultiRhsPCGKernel = platform->kernels.get(sectionIdentifier + "ellipticMultiRhsUpdatePCG");
+      elliptic->multiRhsWeightedInnerProdKernel =
+          platform->kernels.get(sectionIdentifier + "ellipticMultiRhsWeightedInnerProd");
+      elliptic->multiRhsUpdatePKernel = platform->kernels.get(sectionIdentifier + "ellipticMultiRhsUpdateP");
+      elliptic->o_multiRhsCoeff = platform->device.malloc(2 * elliptic->Nfields * sizeof(dfloat));
+    }
 
-    elliptic->updatePCGKernel = platform->kernels.get(sectionIdentifier + "ellipticBlockUpdatePCG");
+    if (options.compareArgs("SOLVER", "MIXEDPRECISION")) {
+      if (elliptic->blockSolver && !elliptic->stressForm && elliptic->Nfields != 3)
+        elliptic->AxPfloatKernel =
+            platform->kernels.get(sectionIdentifier + "ellipticMultiRhsPartial" + kernelName + "Pfloat");
+      else
+        elliptic->AxPfloatKernel = platform->kernels.get(kernelNamePrefix + "Partial" + kernelName + "Pfloat");
+    }
   }
 
-  auto timeEllipticOperator = [&]() {
-    const int Nsamples = 10;
-    ellipticOperator(elliptic, elliptic->o_p, elliptic->o_Ap, dfloatString);
+  // interleaved geometric factors are only created for Ax kernels reading them
+  if (elliptic->AxKernel.properties().has("defines/p_aosoaBytes") && !mesh->o_ggeoAoSoA.isInitialized())
+    mesh->interleaveGeometricFactors(false);
 
-    platform->device.finish();
-    MPI_Barrier(platform->comm.mpiComm);
-    const double start = MPI_Wtime();
+  {
+    // Krylov workspace is needed by the operator timings and the preconditioner setup
+    auto scope = platform->memoryArena.scope("elliptic setup");
+    ellipticAllocateWorkspace(elliptic, scope);
 
-    for (int test = 0; test < Nsamples; ++test)
+    auto timeEllipticOperator = [&]() {
+      const int Nsamples = 10;
       ellipticOperator(elliptic, elliptic->o_p, elliptic->o_Ap, dfloatString);
 
-    platform->device.finish();
-    double elapsed = (MPI_Wtime() - start) / Nsamples;
-    MPI_Allreduce(MPI_IN_PLACE, &elapsed, 1, MPI_DOUBLE, MPI_MAX, platform->comm.mpiComm);
-
-    return elapsed;
-  };
-
-  oogs_mode oogsMode = OOGS_AUTO;
-  elliptic->oogs =
-      oogs::setup(elliptic->ogs, elliptic->Nfields, elliptic->fieldOffset, ogsDfloat, NULL, oogsMode);
-  elliptic->oogsAx = elliptic->oogs;
-
-  if (platform->options.compareArgs("ENABLE GS COMM OVERLAP", "TRUE")) {
-    auto nonOverlappedTime = timeEllipticOperator();
-    auto callback = [&]() {
-      ellipticAx(elliptic,
-                 mesh->NlocalGatherElements,
-                 mesh->o_localGatherElementList,
-                 elliptic->o_p,
-                 elliptic->o_Ap,
-                 dfloatString);
-    };
-    elliptic->oogsAx =
-        oogs::setup(elliptic->ogs, elliptic->Nfields, elliptic->fieldOffset, ogsDfloat, callback, oogsMode);
+      platform->device.finish();
+      MPI_Barrier(platform->comm.mpiComm);
+      const double start = MPI_Wtime();
+
+      for (int test = 0; test < Nsamples; ++test)
+        ellipticOperator(elliptic, elliptic->o_p, elliptic->o_Ap, dfloatString);
 
-    auto overlappedTime = timeEllipticOperator();
-    if (overlappedTime > nonOverlappedTime)
-      elliptic->oogsAx = elliptic->oogs;
+      platform->device.finish();
+      double elapsed = (MPI_Wtime() - start) / Nsamples;
+      MPI_Allreduce(MPI_IN_PLACE, &elapsed, 1, MPI_DOUBLE, MPI_MAX, platform->comm.mpiComm);
 
-    if (platform->comm.mpiRank == 0) {
-      printf("testing Ax overlap %.2es %.2es ", nonOverlappedTime, overlappedTime);
-      if (elliptic->oogsAx != elliptic->oogs)
-        printf("(overlap enabled)");
+      return elapsed;
+    };
+
+    oogs_mode oogsMode = OOGS_AUTO;
+    elliptic->oogs =
+        oogs::setup(elliptic->ogs, elliptic->Nfields, elliptic->fieldOffset, ogsDfloat, NULL, oogsMode);
+    elliptic->oogsAx = elliptic->oogs;
+
+    if (platform->options.compareArgs("ENABLE GS COMM OVERLAP", "TRUE")) {
+      auto nonOverlappedTime = timeEllipticOperator();
+      auto callback = [&]() {
+        ellipticAx(elliptic,
+                   mesh->NlocalGatherElements,
+                   mesh->o_localGatherElementList,
+                   elliptic->o_p,
+                   elliptic->o_Ap,
+                   dfloatString);
+      };
+      elliptic->oogsAx =
+          oogs::setup(elliptic->ogs, elliptic->Nfields, elliptic->fieldOffset, ogsDfloat, callback, oogsMode);
+
+      auto overlappedTime = timeEllipticOperator();
+      if (overlappedTime > nonOverlappedTime)
+        elliptic->oogsAx = elliptic->oogs;
+
+      if (platform->comm.mpiRank == 0) {
+        printf("testing Ax overlap %.2es %.2es ", nonOverlappedTime, overlappedTime);
+        if (elliptic->oogsAx != elliptic->oogs)
+          printf("(overlap enabled)");
+
+        printf("\n");
+      }
+    }
 
-      printf("\n");
+    if (!reusePreconditioner(elliptic)) {
+      elliptic->preconSource = nullptr;
+      ellipticPreconditionerSetup(elliptic, elliptic->ogs);
     }
   }
 
-  ellipticPreconditionerSetup(elliptic, elliptic->ogs);
+  // coefficients are refreshed at every solve, geometric factors may be shared with the MG fine level
+  if (options.compareArgs("SOLVER", "MIXEDPRECISION")) {
+    // block solvers may carry one coefficient per field (loffset > 0)
+    const dlong Nlambda = mesh->Nlocal + (elliptic->Nfields - 1) * elliptic->loffset;
+    elliptic->o_lambda0Pfloat = platform->device.malloc(Nlambda, sizeof(pfloat));
+    elliptic->o_lambda1Pfloat = (elliptic->poisson) ? elliptic->o_lambda0Pfloat
+                                                    : platform->device.malloc(Nlambda, sizeof(pfloat));
+
+    std::vector<pfloat> invDegree(mesh->Nlocal);
+    for (dlong i = 0; i < mesh->Nlocal; i++)
+      invDegree[i] = (pfloat)elliptic->ogs->invDegree[i];
+    elliptic->o_invDegreePfloat = platform->device.malloc(mesh->Nlocal * sizeof(pfloat), invDegree.data());
+
+    if (options.compareArgs("PRECONDITIONER", "JACOBI"))
+      elliptic->o_invDiagAPfloat =
+          platform->device.malloc(elliptic->Nfields * elliptic->fieldOffset, sizeof(pfloat));
+
+    if (!mesh->o_ggeoPfloat.isInitialized()) {
+      mesh->o_ggeoPfloat = platform->device.malloc(mesh->Nlocal * mesh->Nggeo, sizeof(pfloat));
+      platform->copyDfloatToPfloatKernel(mesh->Nlocal * mesh->Nggeo, mesh->o_ggeo, mesh->o_ggeoPfloat);
+
+      mesh->o_DPfloat = platform->device.malloc(mesh->Nq * mesh->Nq, sizeof(pfloat));
+      platform->copyDfloatToPfloatKernel(mesh->Nq * mesh->Nq, mesh->o_D, mesh->o_DPfloat);
+
+      mesh->o_DTPfloat = platform->device.malloc(mesh->Nq * mesh->Nq, sizeof(pfloat));
+      platform->copyDfloatToPfloatKernel(mesh->Nq * mesh->Nq, mesh->o_DT, mesh->o_DTPfloat);
+    }
+
+    if (elliptic->AxPfloatKernel.properties().has("defines/p_aosoaBytes") &&
+        !mesh->o_ggeoPfloatAoSoA.isInitialized())
+      mesh->interleaveGeometricFactors(true);
+
+    if (elliptic->stressForm && !mesh->o_vgeoPfloat.isInitialized()) {
+      mesh->o_vgeoPfloat = platform->device.malloc(mesh->Nlocal * mesh->Nvgeo, sizeof(pfloat));
+      platform->copyDfloatToPfloatKernel(mesh->Nlocal * mesh->Nvgeo, mesh->o_vgeo, mesh->o_vgeoPfloat);
+    }
+  }
 
   if (options.compareArgs("INITIAL GUESS", "PROJECTION") ||
       options.compareArgs("INITIAL GUESS", "PROJECTION-ACONJ")) {
@@ -317,19 +437,33 @@ void ellipticSolveSetup(elliptic_t *elliptic)
     else if (options.compareArgs("INITIAL GUESS", "PROJECTION"))
       type = SolutionProjection::ProjectionType::CLASSIC;
 
-    elliptic->solutionProjection = new SolutionProjection(*elliptic, type, nVecsProject, nStepsStart);
+    // A-conjugate bases do not store the operator applied to each basis vector
+    if (platform->options.compareArgs("LOW MEMORY", "TRUE"))
+      type = SolutionProjection::ProjectionType::ACONJ;
+
+    const bool adaptive = options.compareArgs("RESIDUAL PROJECTION ADAPTIVE", "TRUE");
+    auto projectionMemoryOwner = platform->device.memoryOwner("projection " + elliptic->name);
+    elliptic->solutionProjection = new SolutionProjection(*elliptic, type, nVecsProject, nStepsStart, adaptive);
   }
 
   MPI_Barrier(platform->comm.mpiComm);
   if (platform->comm.mpiRank == 0)
     printf("done (%gs)\n", MPI_Wtime() - tStart);
   fflush(stdout);
+
+  // Helmholtz solvers are tuned at their first solve
+  if (options.compareArgs("PRECONDITIONER", "MULTIGRID") && options.getArgs("MULTIGRID AUTOTUNE").size() &&
+      !elliptic->preconSource && elliptic->poisson)
+    ellipticMultiGridAutotune(elliptic);
 }
 
 elliptic_t::~elliptic_t()
 {
-  if (precon)
+  if (precon && !preconSource) {
+    if (precon->MGSolver)
+      ellipticMultiGridFree(this, precon);
     delete this->precon;
+  }
   free(this->tmpNormr);
   this->o_tmpNormr.free();
   this->o_EToB.free();
@@ -27,9 +27,12 @@
 #include "elliptic.h"
 #include "ellipticSolutionProjection.h"
 #include <iostream>
+#include <algorithm>
+#include <limits>
 #include "timer.hpp"
 #include "platform.hpp"
 #include "linAlg.hpp"
+#include "ellipticFusedOps.hpp"
 
 void SolutionProjection::matvec(occa::memory &o_Ax,
                                 const dlong Ax_offset,
@@ -78,6 +81,7 @@ void SolutionProjection::updateProjectionSpace()
 #endif
 
   const dfloat norm_orig = alpha[numVecsProjection - 1];
+  newVecEnergy = norm_orig;
   const dfloat one = 1.0;
   multiScaledAddwOffsetKernel(Nlocal,
                               numVecsProjection,
@@ -110,19 +114,18 @@ void SolutionProjection::updateProjectionSpace()
   const dfloat test = norm_new / norm_orig;
   if (test > tol) {
     const dfloat scale = 1.0 / norm_new;
-    platform->linAlg->scaleMany(Nlocal,
-                                Nfields,
-                                fieldOffset,
-                                scale,
-                                o_xx,
-                                fieldOffset * Nfields * (numVecsProjection - 1));
-    if (type == ProjectionType::CLASSIC)
+    const auto offset = (fieldOffset * Nfields * (numVecsProjection - 1)) * sizeof(dfloat);
+    if (type == ProjectionType::CLASSIC) {
+      platform->linAlg->fused(ellipticFusedOps::projectionScale, Nlocal, Nfields, fieldOffset, {scale}, {o_xx + offset, o_bb + offset});
+    }
+    else {
       platform->linAlg->scaleMany(Nlocal,
                                   Nfields,
                                   fieldOffset,
                                   scale,
-                                  o_bb,
+                                  o_xx,
                                   fieldOffset * Nfields * (numVecsProjection - 1));
+    }
     flopCount += static_cast<double>(Nlocal) * Nfields;
     flopCount *= (type == ProjectionType::CLASSIC) ? 2 : 1;
   }
@@ -137,7 +140,7 @@ void SolutionProjection::updateProjectionSpace()
   platform->flopCounter->add(solverName + " SolutionProjection::updateProjectionSpace", flopCount);
 }
 
-void SolutionProjection::computePreProjection(occa::memory &o_r)
+dfloat SolutionProjection::computePreProjection(occa::memory &o_r)
 {
 
   dfloat flopCount = 0.0;
@@ -145,33 +148,38 @@ void SolutionProjection::computePreProjection(occa::memory &o_r)
   dfloat one = 1.0;
   dfloat zero = 0.0;
   dfloat mone = -1.0;
-  if (numVecsProjection <= 0)
-    return;
 
-#if USE_WEIGHTED_INNER_PROD_MULTI_DEVICE
-  platform->linAlg->weightedInnerProdMulti(Nlocal,
-                                           numVecsProjection,
-                                           Nfields,
-                                           fieldOffset,
-                                           o_invDegree,
-                                           o_xx,
-                                           o_r,
-                                           platform->comm.mpiComm,
-                                           o_alpha,
-                                           Nfields * 0 * fieldOffset);
-#else
-  platform->linAlg->weightedInnerProdMulti(Nlocal,
-                                           numVecsProjection,
-                                           Nfields,
-                                           fieldOffset,
-                                           o_invDegree,
-                                           o_xx,
-                                           o_r,
-                                           platform->comm.mpiComm,
-                                           alpha,
-                                           Nfields * 0 * fieldOffset);
+  // projection coefficients and norm of o_r in one reduction,
+  // the adaptive policy piggybacks its timings of the previous solve
+  const int Ntimings = adaptive ? 2 : 0;
+  std::vector<dfloat> values(numVecsProjection + 1 + Ntimings);
+  platform->linAlg->weightedInnerProdMultiNorm(Nlocal,
+                                               numVecsProjection,
+                                               Nfields,
+                                               fieldOffset,
+                                               o_invDegree,
+                                               o_xx,
+                                               o_r,
+                                               MPI_COMM_SELF,
+                                               values.data());
+  if (adaptive) {
+    values[numVecsProjection + 1] = tProjLocal;
+    values[numVecsProjection + 2] = tSolveLocal;
+  }
+  MPI_Allreduce(MPI_IN_PLACE, values.data(), values.size(), MPI_DFLOAT, MPI_SUM, platform->comm.mpiComm);
+
+  for (int k = 0; k < numVecsProjection; ++k)
+    alpha[k] = values[k];
+  const dfloat rdotr = values[numVecsProjection];
   o_alpha.copyFrom(alpha, sizeof(dfloat) * numVecsProjection);
-#endif
+
+  if (adaptive) {
+    alphaPre.assign(alpha, alpha + numVecsProjection);
+    const double tProj = values[numVecsProjection + 1] / platform->comm.mpiCommSize;
+    const double tSolve = values[numVecsProjection + 2] / platform->comm.mpiCommSize;
+    tVec = (NvecsTimed > 0) ? tProj / NvecsTimed : 0;
+    tIter = (NiterTimed > 0) ? tSolve / NiterTimed : 0;
+  }
 
   // o_xbar = sum_i alpha_i * o_xx_i
   accumulateKernel(Nlocal, numVecsProjection, fieldOffset, o_alpha, o_xx, o_xbar);
@@ -189,32 +197,27 @@ void SolutionProjection::computePreProjection(occa::memory &o_r)
   }
 
   platform->flopCounter->add(solverName + " SolutionProjection::computePreProjection", flopCount);
+
+  return rdotr;
 }
 
 void SolutionProjection::computePostProjection(occa::memory &o_x)
 {
-  const dfloat one = 1.0;
-  const dfloat zero = 0.0;
-
   if (numVecsProjection == 0) {
     // reset bases
     numVecsProjection = 1;
     o_xx.copyFrom(o_x, Nfields * fieldOffset * sizeof(dfloat));
   }
-  else if (numVecsProjection == maxNumVecsProjection) {
+  else if (!adaptive && numVecsProjection == maxNumVecsProjection) {
     numVecsProjection = 1;
-    platform->linAlg->axpbyMany(Nlocal, Nfields, fieldOffset, one, o_xbar, one, o_x);
-    o_xx.copyFrom(o_x, Nfields * fieldOffset * sizeof(dfloat));
+    // x = x + xbar, xx[0] = x
+    platform->linAlg->fused(ellipticFusedOps::projectionRestart, Nlocal, Nfields, fieldOffset, {}, {o_x, o_xbar, o_xx});
   }
   else {
     numVecsProjection++;
-    // xx[m-1] = x
-    o_xx.copyFrom(o_x,
-                  fieldOffset *  Nfields * sizeof(dfloat),
-                  fieldOffset * (Nfields * sizeof(dfloat) * (numVecsProjection - 1)),
-                  0);
-    // x = x + xbar
-    platform->linAlg->axpbyMany(Nlocal, Nfields, fieldOffset, one, o_xbar, one, o_x);
+    // xx[m-1] = x, x = x + xbar
+    const auto offset = (fieldOffset * Nfields * (numVecsProjection - 1)) * sizeof(dfloat);
+    platform->linAlg->fused(ellipticFusedOps::projectionAppend, Nlocal, Nfields, fieldOffset, {}, {o_x, o_xbar, o_xx + offset});
   }
   const dlong previousNumVecsProjection = numVecsProjection;
   const dlong bOffset = (type == ProjectionType::CLASSIC) ? numVecsProjection - 1 : 0;
@@ -227,16 +230,105 @@ void SolutionProjection::computePostProjection(occa::memory &o_x)
                   Nfields * fieldOffset * sizeof(dfloat)); // writes first n words of o_xx, first approximation vector
     matvec(o_bb, 0, o_xx, 0);
     updateProjectionSpace();
+    return;
+  }
+
+  if (adaptive)
+    adaptProjectionSpace();
+}
+
+// drop basis vectors by compacting the remaining ones, an orthonormal subset stays orthonormal
+void SolutionProjection::removeVectors(const std::vector<int> &ids)
+{
+  if (ids.empty())
+    return;
+
+  const auto Nbyte = (Nfields * sizeof(dfloat)) * fieldOffset;
+  int dst = 0;
+  for (int src = 0; src < numVecsProjection; ++src) {
+    if (std::find(ids.begin(), ids.end(), src) != ids.end())
+      continue;
+    if (dst != src) {
+      o_xx.copyFrom(o_xx, Nbyte, dst * Nbyte, src * Nbyte);
+      if (type == ProjectionType::CLASSIC)
+        o_bb.copyFrom(o_bb, Nbyte, dst * Nbyte, src * Nbyte);
+    }
+    dst++;
+  }
+  numVecsProjection = dst;
+}
+
+// Vector k contributed alpha_k^2 to the A-norm of the initial error. Without it the solver
+// would have started from an error of energy newVecEnergy + alpha_k^2, costing
+// log(1 + alpha_k^2/newVecEnergy)/(2 rate) additional iterations. Vectors saving less than
+// their own cost (in units of an iteration) are dropped. If the space is full and every
+// vector pays, it grows up to maxNumVecsProjection.
+void SolutionProjection::adaptProjectionSpace()
+{
+  // the newest vector (last slot) has no coefficient yet
+  const int Nold = std::min<dlong>(alphaPre.size(), numVecsProjection - 1);
+
+  const dfloat res0 = elliptic.res0Norm;
+  const dfloat res = elliptic.resNorm;
+  const dfloat rate = (elliptic.Niter > 0 && res > 0 && res0 > res) ? log(res0 / res) / elliptic.Niter : 0;
+  const bool costKnown = rate > 0 && tIter > 0 && tVec > 0 && newVecEnergy > 0;
+
+  std::vector<dfloat> savedIter(Nold, std::numeric_limits<dfloat>::max());
+  if (costKnown) {
+    for (int k = 0; k < Nold; ++k)
+      savedIter[k] = 0.5 * log1p(alphaPre[k] * alphaPre[k] / newVecEnergy) / rate;
+  }
+
+  std::vector<int> dropIds;
+  if (costKnown) {
+    const dfloat vecCost = tVec / tIter;
+    for (int k = 0; k < Nold; ++k) {
+      if (savedIter[k] < vecCost)
+        dropIds.push_back(k);
+    }
+  }
+
+  if (numVecsProjection - static_cast<dlong>(dropIds.size()) > numVecsLimit) {
+    if (dropIds.empty() && costKnown && numVecsLimit < maxNumVecsProjection) {
+      numVecsLimit++;
+    }
+    else if (dropIds.empty()) {
+      // drop the least valuable (or without cost information the oldest) vector
+      int k = 0;
+      for (int i = 1; i < Nold; ++i) {
+        if (alphaPre[i] * alphaPre[i] < alphaPre[k] * alphaPre[k])
+          k = i;
+      }
+      dropIds.push_back(k);
+    }
   }
+
+  removeVectors(dropIds);
+
+  if (verbose && platform->comm.mpiRank == 0 && !dropIds.empty())
+    printf("solutionProjection %s: dropped %zu vector(s), %d/%d in use\n",
+           solverName.c_str(),
+           dropIds.size(),
+           numVecsProjection,
+           numVecsLimit);
+}
+
+// no room to grow in low-memory mode
+int SolutionProjection::adaptiveGrowthFactor()
+{
+  return platform->options.compareArgs("LOW MEMORY", "TRUE") ? 1 : 2;
 }
 
 SolutionProjection::SolutionProjection(elliptic_t &elliptic,
                                        const ProjectionType _type,
                                        const dlong _maxNumVecsProjection,
-                                       const dlong _numTimeSteps)
-    : maxNumVecsProjection(_maxNumVecsProjection), numTimeSteps(_numTimeSteps), type(_type),
-      alpha((dfloat *)calloc(maxNumVecsProjection, sizeof(dfloat))), numVecsProjection(0),
-      prevNumVecsProjection(0), Nlocal(elliptic.mesh->Np * elliptic.mesh->Nelements),
+                                       const dlong _numTimeSteps,
+                                       const bool _adaptive)
+    : maxNumVecsProjection(_adaptive ? adaptiveGrowthFactor() * _maxNumVecsProjection : _maxNumVecsProjection),
+      numTimeSteps(_numTimeSteps), type(_type), adaptive(_adaptive), elliptic(elliptic),
+      alpha((dfloat *)calloc(maxNumVecsProjection + 1, sizeof(dfloat))), numVecsProjection(0),
+      prevNumVecsProjection(0), numVecsLimit(_maxNumVecsProjection),
+      Nlocal(elliptic.mesh->Np * elliptic.mesh->Nelements),
       fieldOffset(elliptic.fieldOffset), Nfields(elliptic.Nfields), timestep(0),
       verbose(platform->options.compareArgs("VERBOSE", "TRUE")), o_invDegree(elliptic.mesh->ogs->o_invDegree),
       o_rtmp(elliptic.o_z), o_Ap(elliptic.o_Ap)
@@ -245,11 +337,14 @@ SolutionProjection::SolutionProjection(elliptic_t &elliptic,
 
   platform_t *platform = platform_t::getInstance();
 
-  o_alpha = platform->device.malloc(maxNumVecsProjection * sizeof(dfloat));
+  // adaptive sizing appends the new vector before deciding which ones to drop
+  const dlong Nslots = adaptive ? maxNumVecsProjection + 1 : maxNumVecsProjection;
+
+  o_alpha = platform->device.malloc(Nslots * sizeof(dfloat));
   o_xbar = platform->device.malloc((Nfields * sizeof(dfloat)) * fieldOffset);
-  o_xx = platform->device.malloc((Nfields * maxNumVecsProjection * sizeof(dfloat)) * fieldOffset);
+  o_xx = platform->device.malloc((Nfields * Nslots * sizeof(dfloat)) * fieldOffset);
   o_bb =
-      platform->device.malloc((type == ProjectionType::CLASSIC) ? Nfields * fieldOffset * maxNumVecsProjection
+      platform->device.malloc((type == ProjectionType::CLASSIC) ? Nfields * fieldOffset * Nslots
                                                                 : Nfields * fieldOffset,
                               sizeof(dfloat));
 
@@ -267,22 +362,56 @@ SolutionProjection::SolutionProjection(elliptic_t &elliptic,
   maskOperator = [&](occa::memory &o_x) { ellipticApplyMask(&elliptic, o_x, dfloatString); };
 }
 
-void SolutionProjection::pre(occa::memory &o_r)
+dfloat SolutionProjection::pre(occa::memory &o_r)
 {
+  if (adaptive) {
+    platform->device.finish();
+    tPreStart = MPI_Wtime();
+  }
+
   ++timestep;
-  if (timestep < numTimeSteps)
-    return;
+  prevNumVecsProjection = 0;
+
+  dfloat rdotr;
+  if (timestep < numTimeSteps || numVecsProjection <= 0) {
+    rdotr = platform->linAlg->weightedInnerProdMany(Nlocal,
+                                                    Nfields,
+                                                    fieldOffset,
+                                                    o_invDegree,
+                                                    o_r,
+                                                    o_r,
+                                                    platform->comm.mpiComm);
+  }
+  else {
+    prevNumVecsProjection = numVecsProjection;
+    rdotr = computePreProjection(o_r);
+  }
 
-  if (numVecsProjection <= 0)
-    return;
+  if (adaptive) {
+    platform->device.finish();
+    tPreEnd = MPI_Wtime();
+  }
 
-  prevNumVecsProjection = numVecsProjection;
-  computePreProjection(o_r);
+  return rdotr;
 }
 
 void SolutionProjection::post(occa::memory &o_x)
 {
   if (timestep < numTimeSteps)
     return;
+
+  if (adaptive) {
+    platform->device.finish();
+    tPostStart = MPI_Wtime();
+  }
+
   computePostProjection(o_x);
+
+  if (adaptive) {
+    platform->device.finish();
+    tProjLocal = (tPreEnd - tPreStart) + (MPI_Wtime() - tPostStart);
+    tSolveLocal = tPostStart - tPreEnd;
+    NvecsTimed = std::max(numVecsProjection, prevNumVecsProjection);
+    NiterTimed = elliptic.Niter;
+  }
 }
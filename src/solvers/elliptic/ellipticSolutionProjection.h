@@ -41,25 +41,35 @@ public:
   SolutionProjection(elliptic_t& _elliptic,
                      const ProjectionType _type,
                      const dlong _maxNumVecsProjection = 8,
-                     const dlong _numTimeSteps = 5);
-  void pre(occa::memory& o_r);
+                     const dlong _numTimeSteps = 5,
+                     const bool _adaptive = false);
+  // returns the invDegree weighted squared norm of o_r before projection
+  dfloat pre(occa::memory& o_r);
   void post(occa::memory& o_x);
   dlong getNumVecsProjection() const { return numVecsProjection; }
   dlong getPrevNumVecsProjection() const { return prevNumVecsProjection; }
-  dlong getMaxNumVecsProjection() const { return maxNumVecsProjection; }
+  dlong getMaxNumVecsProjection() const { return numVecsLimit; }
 private:
-  void computePreProjection(occa::memory& o_r);
+  // upper bound of the adaptive space relative to the requested number of vectors
+  static int adaptiveGrowthFactor();
+
+  dfloat computePreProjection(occa::memory& o_r);
   void computePostProjection(occa::memory& o_x);
   void updateProjectionSpace();
+  void adaptProjectionSpace();
+  void removeVectors(const std::vector<int>& ids);
   void matvec(occa::memory& o_Ax, const dlong Ax_offset, occa::memory& o_x, const dlong x_offset);
   const dlong maxNumVecsProjection;
   const dlong numTimeSteps;
   const ProjectionType type;
+  const bool adaptive;
   dlong timestep;
   bool verbose;
 
   std::string solverName;
 
+  elliptic_t& elliptic;
+
   occa::memory o_xbar;
   occa::memory o_xx;
   occa::memory o_bb;
@@ -77,10 +87,20 @@ private:
 
   dlong numVecsProjection;
   dlong prevNumVecsProjection;
+  dlong numVecsLimit;
   const dlong Nlocal; // vector size
   const dlong fieldOffset; // offset
   const dlong Nfields;
 
+  // adaptive sizing
+  std::vector<dfloat> alphaPre; // projection coefficients of the current solve
+  dfloat newVecEnergy = 0;      // A-norm squared of the last solver correction
+  double tPreStart = 0, tPreEnd = 0, tPostStart = 0;
+  double tProjLocal = 0, tSolveLocal = 0;
+  dlong NvecsTimed = 0;
+  int NiterTimed = 0;
+  double tVec = 0, tIter = 0;   // rank averaged cost of one basis vector and one solver iteration
+
   std::function<void(occa::memory&,occa::memory&)> matvecOperator;
   std::function<void(occa::memory&)> maskOperator;
 };
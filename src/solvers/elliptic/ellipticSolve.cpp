@@ -24,14 +24,96 @@
 
  */
 
+#include <algorithm>
+
 #include "elliptic.h"
 #include "ellipticPrecon.h"
 #include "platform.hpp"
 #include "linAlg.hpp"
 
+namespace {
+
+// Relax the stopping tolerance to a fraction of the temporal truncation error. The error estimate
+// (solution units) is mapped to residual units by the residual-to-correction ratio of the previous
+// solve. The user tolerance acts as floor.
+dfloat adaptiveTolerance(elliptic_t *elliptic, dfloat tol)
+{
+  setupAide &options = elliptic->options;
+
+  if (elliptic->truncationError <= 0 || elliptic->residualScale <= 0)
+    return tol;
+
+  dfloat safetyFactor = 0.1;
+  options.getArgs("LINEAR SOLVER ADAPTIVE TOLERANCE SAFETY FACTOR", safetyFactor);
+
+  dfloat maxTol = 100 * tol;
+  if (options.getArgs("LINEAR SOLVER ADAPTIVE TOLERANCE MAX", maxTol) &&
+      options.compareArgs("LINEAR SOLVER STOPPING CRITERION", "RELATIVE"))
+    maxTol *= elliptic->res0Norm;
+
+  const dfloat tolAdaptive = safetyFactor * elliptic->residualScale * elliptic->truncationError;
+  return std::max(tol, std::min(tolAdaptive, maxTol));
+}
+
+// update operator scale and convergence rate, estimate iterations a solve to tolNominal would have taken
+void adaptiveToleranceUpdate(elliptic_t *elliptic, occa::memory &o_x, dfloat tolNominal)
+{
+  mesh_t *mesh = elliptic->mesh;
+
+  // o_x holds the Krylov correction, it is paired with the residual the Krylov solver started
+  // from (after projection) to match the residual the tolerance is applied to
+  const dfloat correctionNorm =
+      platform->linAlg->weightedNorm2Many(mesh->Nlocal,
+                                          elliptic->Nfields,
+                                          elliptic->fieldOffset,
+                                          elliptic->o_invDegree,
+                                          o_x,
+                                          platform->comm.mpiComm) *
+      sqrt(elliptic->resNormFactor);
+  if (correctionNorm > 0)
+    elliptic->residualScale = elliptic->res0Norm / correctionNorm;
+
+  if (elliptic->Niter > 0 && elliptic->resNorm > 0 && elliptic->res0Norm > elliptic->resNorm)
+    elliptic->convergenceRate = log(elliptic->res0Norm / elliptic->resNorm) / elliptic->Niter;
+
+  elliptic->NiterSaved = 0;
+  if (elliptic->convergenceRate > 0 && elliptic->res0Norm > tolNominal) {
+    const int NiterNominal = ceil(log(elliptic->res0Norm / tolNominal) / elliptic->convergenceRate);
+    elliptic->NiterSaved = std::max(NiterNominal - elliptic->Niter, 0);
+  }
+  elliptic->NiterSavedSum += elliptic->NiterSaved;
+}
+
+} // namespace
+
+void ellipticAllocateWorkspace(elliptic_t* elliptic, memoryArena_t::scope_t &scope)
+{
+  const auto N = elliptic->Nfields * static_cast<size_t>(elliptic->fieldOffset);
+
+  elliptic->o_p = scope.allocate<dfloat>("p", N);
+  elliptic->o_z = scope.allocate<dfloat>("z", N);
+  elliptic->o_Ap = scope.allocate<dfloat>("Ap", N);
+  elliptic->o_x0 = scope.allocate<dfloat>("x0", N);
+  elliptic->o_rPfloat = scope.allocate<pfloat>("rPfloat", N);
+  elliptic->o_zPfloat = scope.allocate<pfloat>("zPfloat", N);
+}
+
 void ellipticSolve(elliptic_t* elliptic, occa::memory &o_r, occa::memory &o_x)
 {
-  ellipticUpdateWorkspace(elliptic); // in case o_wrk has changed
+  // coefficients are set by now, the tuning allocates its own workspace
+  if (elliptic->options.compareArgs("PRECONDITIONER", "MULTIGRID") &&
+      elliptic->options.getArgs("MULTIGRID AUTOTUNE").size() && !elliptic->preconSource)
+    ellipticMultiGridAutotune(elliptic);
+
+  // the source may have rebuilt its hierarchy
+  if (elliptic->preconSource) {
+    elliptic->precon = elliptic->preconSource->precon;
+    elliptic->nLevels = elliptic->preconSource->nLevels;
+    elliptic->levels = elliptic->preconSource->levels;
+  }
+
+  auto scope = platform->memoryArena.scope("elliptic");
+  ellipticAllocateWorkspace(elliptic, scope);
 
   setupAide& options = elliptic->options;
   precon_t *precon = elliptic->precon;
@@ -87,6 +169,11 @@ void ellipticSolve(elliptic_t* elliptic, occa::memory &o_r, occa::memory &o_x)
     }
   }
 
+  ellipticUpdateCoarseSolver(elliptic);
+
+  if(options.compareArgs("PRECONDITIONER", "MULTIGRID"))
+    ellipticMultiGridUpdateEigenvalues(elliptic);
+
   // compute initial residual r = rhs - Ax0
   ellipticAx(elliptic, mesh->Nelements, mesh->o_elementList, o_x, elliptic->o_Ap, dfloatString);
   platform->linAlg->axpbyMany(
@@ -108,22 +195,13 @@ void ellipticSolve(elliptic_t* elliptic, occa::memory &o_r, occa::memory &o_x)
      options.compareArgs("INITIAL GUESS","PROJECTION-ACONJ")) {
     
     platform->timer.tic(name + " proj pre",1);
-    elliptic->res00Norm = 
-      platform->linAlg->weightedNorm2Many(
-        mesh->Nlocal,
-        elliptic->Nfields,
-        elliptic->fieldOffset,
-        elliptic->o_invDegree,
-        o_r,
-        platform->comm.mpiComm
-      )
-      * sqrt(elliptic->resNormFactor); 
+    // norm of the unprojected residual comes with the projection coefficients
+    const dfloat rdotr = elliptic->solutionProjection->pre(o_r);
+    elliptic->res00Norm = sqrt(rdotr * elliptic->resNormFactor);
 
     nrsCheck(std::isnan(elliptic->res00Norm), MPI_COMM_SELF, EXIT_FAILURE,
              "%s unreasonable res00Norm!\n", name.c_str());
 
-    elliptic->solutionProjection->pre(o_r);
-
     platform->timer.toc(name + " proj pre");
   }
 
@@ -146,10 +224,20 @@ void ellipticSolve(elliptic_t* elliptic, occa::memory &o_r, occa::memory &o_x)
   if(options.compareArgs("LINEAR SOLVER STOPPING CRITERION", "RELATIVE")) 
     tol *= elliptic->res0Norm;
 
+  const bool adaptiveTol = options.compareArgs("LINEAR SOLVER ADAPTIVE TOLERANCE", "TRUE");
+  const dfloat tolNominal = tol;
+  if(adaptiveTol)
+    tol = adaptiveTolerance(elliptic, tol);
+  elliptic->tol = tol;
+
   if(!options.compareArgs("SOLVER", "NONBLOCKING")) {
     elliptic->resNorm = elliptic->res0Norm;
 
-    if(options.compareArgs("SOLVER", "PCG")) {
+    if(options.compareArgs("SOLVER", "MIXEDPRECISION")) {
+      elliptic->Niter = ir (elliptic, o_r, o_x, tol, maxIter, elliptic->resNorm);
+    } else if(options.compareArgs("SOLVER", "MULTIRHS")) {
+      elliptic->Niter = pcgMultiRhs (elliptic, o_r, o_x, tol, maxIter, elliptic->resNorm);
+    } else if(options.compareArgs("SOLVER", "PCG")) {
       elliptic->Niter = pcg (elliptic, o_r, o_x, tol, maxIter, elliptic->resNorm);
     } else if(options.compareArgs("SOLVER", "PGMRES")) {
       elliptic->Niter = pgmres (elliptic, o_r, o_x, tol, maxIter, elliptic->resNorm);
@@ -166,6 +254,9 @@ void ellipticSolve(elliptic_t* elliptic, occa::memory &o_r, occa::memory &o_x)
              "%s\n", "NONBLOCKING Krylov solvers currently not supported!");
   }
 
+  if(adaptiveTol)
+    adaptiveToleranceUpdate(elliptic, o_x, tolNominal);
+
   if(options.compareArgs("INITIAL GUESS","PROJECTION") ||
      options.compareArgs("INITIAL GUESS","PROJECTION-ACONJ")) { 
     platform->timer.tic(name + " proj post",1);
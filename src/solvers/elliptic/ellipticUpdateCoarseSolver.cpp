@@ -0,0 +1,30 @@
+#include "elliptic.h"
+#include "ellipticPrecon.h"
+#include "platform.hpp"
+
+// Numeric-only refresh of the coarse/SEMFEM AMG setup for moving meshes and
+// varying coefficients. Sparsity, distribution and aggregates are kept.
+void ellipticUpdateCoarseSolver(elliptic_t *elliptic)
+{
+  int frequency = 0;
+  elliptic->options.getArgs("COARSE SOLVER REFRESH", frequency);
+  if (frequency <= 0 || !elliptic->precon)
+    return;
+
+  precon_t *precon = elliptic->precon;
+  if (++precon->coarseSolverSolves % frequency)
+    return;
+
+  const auto tag = elliptic->name + " coarse solver refresh";
+  platform->timer.tic(tag, 1);
+
+  if (precon->SEMFEMSolver) {
+    precon->SEMFEMSolver->update();
+  }
+  else if (precon->MGSolver && precon->MGSolver->coarseLevel &&
+           elliptic->options.compareArgs("MULTIGRID COARSE SOLVE", "TRUE")) {
+    precon->MGSolver->coarseLevel->update();
+  }
+
+  platform->timer.toc(tag);
+}
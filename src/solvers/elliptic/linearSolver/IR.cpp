@@ -0,0 +1,227 @@
+/*
+   Mixed-precision iterative refinement.
+
+   The outer loop keeps solution and residual in dfloat and recomputes
+   r = r - A*e after every correction, while the correction equation A*e = r
+   is solved by PCG with operator, vectors and reductions in pfloat. The inner
+   tolerance is adapted to the remaining residual, so the inner solve does not
+   oversolve early on and the final dfloat residual meets SOLVER TOLERANCE.
+*/
+
+#include <algorithm>
+
+#include "elliptic.h"
+#include "ellipticPrecon.h"
+#include "linAlg.hpp"
+#include "ellipticFusedOps.hpp"
+
+namespace {
+
+// smallest relative residual reduction we ask from a single pfloat solve
+constexpr dfloat minInnerRelTol = 1e-4;
+
+// an outer step reducing the residual by less than this is considered stagnated
+constexpr dfloat maxOuterRate = 0.5;
+
+void updatePfloatOperator(elliptic_t *elliptic)
+{
+  mesh_t *mesh = elliptic->mesh;
+
+  const dlong Nlambda = mesh->Nlocal + (elliptic->Nfields - 1) * elliptic->loffset;
+  platform->copyDfloatToPfloatKernel(Nlambda, elliptic->o_lambda0, elliptic->o_lambda0Pfloat);
+  if (!elliptic->poisson)
+    platform->copyDfloatToPfloatKernel(Nlambda, elliptic->o_lambda1, elliptic->o_lambda1Pfloat);
+
+  if (elliptic->options.compareArgs("PRECONDITIONER", "JACOBI"))
+    platform->copyDfloatToPfloatKernel(elliptic->Nfields * elliptic->fieldOffset,
+                                       elliptic->precon->o_invDiagA,
+                                       elliptic->o_invDiagAPfloat);
+
+  if (platform->options.compareArgs("MOVING MESH", "TRUE")) {
+    platform->copyDfloatToPfloatKernel(mesh->Nlocal * mesh->Nggeo, mesh->o_ggeo, mesh->o_ggeoPfloat);
+    if (mesh->o_ggeoPfloatAoSoA.isInitialized())
+      mesh->interleaveGeometricFactors(true);
+    if (elliptic->stressForm)
+      platform->copyDfloatToPfloatKernel(mesh->Nlocal * mesh->Nvgeo, mesh->o_vgeo, mesh->o_vgeoPfloat);
+  }
+}
+
+// r <= r - alpha*A*p
+// dot(r,r), the global sum is completed by the caller
+linAlg_t::reduction_t updateStart(elliptic_t *elliptic, occa::memory &o_Ap, const pfloat alpha, occa::memory &o_r)
+{
+  mesh_t *mesh = elliptic->mesh;
+
+  platform->flopCounter->add(elliptic->name + " ellipticUpdatePC",
+                             0.5 * (elliptic->Nfields * static_cast<double>(mesh->Nlocal) * 4 + mesh->Nlocal));
+
+  return platform->linAlg->fusedStart(ellipticFusedOps::irUpdate,
+                                      mesh->Nlocal,
+                                      elliptic->Nfields,
+                                      elliptic->fieldOffset,
+                                      {alpha},
+                                      {o_Ap, o_r},
+                                      platform->comm.mpiComm,
+                                      elliptic->o_invDegreePfloat);
+}
+
+// PCG on pfloat vectors, o_x is zeroed on entry and o_r is overwritten
+int pcgPfloat(elliptic_t *elliptic,
+              occa::memory &o_r,
+              occa::memory &o_x,
+              occa::memory &o_p,
+              occa::memory &o_Ap,
+              const dfloat tol,
+              const int MAXIT,
+              dfloat &rdotr)
+{
+  mesh_t *mesh = elliptic->mesh;
+  setupAide &options = elliptic->options;
+
+  const int flexible = options.compareArgs("SOLVER", "FLEXIBLE");
+  const int verbose = platform->options.compareArgs("VERBOSE", "TRUE");
+  const bool preconditioned = !options.compareArgs("PRECONDITIONER", "NONE");
+  const dlong Nlocal = mesh->Nlocal;
+  const dlong Nfields = elliptic->Nfields;
+  const dlong fieldOffset = elliptic->fieldOffset;
+
+  occa::memory &o_z = preconditioned ? elliptic->o_zPfloat : o_r;
+  occa::memory &o_weight = elliptic->o_invDegreePfloat;
+
+  platform->linAlg->pfill(Nfields * fieldOffset, 0.0, o_p);
+  platform->linAlg->pfill(Nfields * fieldOffset, 0.0, o_x);
+
+  dfloat rdotr2 = rdotr * rdotr / elliptic->resNormFactor;
+  dfloat rdotz1 = 0;
+  dfloat alpha = 0;
+
+  int iter = 0;
+  while (rdotr > tol && iter < MAXIT) {
+    iter++;
+    const dfloat rdotz2 = rdotz1;
+
+    if (preconditioned) {
+      ellipticPreconditionerPfloat(elliptic, o_r, o_z);
+      rdotz1 = platform->linAlg
+                   ->pweightedInnerProdMany(Nlocal, Nfields, fieldOffset, o_weight, o_r, o_z, platform->comm.mpiComm);
+    }
+    else {
+      rdotz1 = rdotr2;
+    }
+
+    dfloat beta = 0;
+    if (iter > 1) {
+      beta = rdotz1 / rdotz2;
+      if (flexible) {
+        const dfloat zdotAp =
+            platform->linAlg
+                ->pweightedInnerProdMany(Nlocal, Nfields, fieldOffset, o_weight, o_z, o_Ap, platform->comm.mpiComm);
+        beta = -alpha * zdotAp / rdotz2;
+      }
+    }
+
+    platform->linAlg->paxpbyMany(Nlocal, Nfields, fieldOffset, 1.0, o_z, beta, o_p);
+
+    ellipticOperator(elliptic, o_p, o_Ap, pfloatString);
+    const dfloat pAp =
+        platform->linAlg
+            ->pweightedInnerProdMany(Nlocal, Nfields, fieldOffset, o_weight, o_p, o_Ap, platform->comm.mpiComm);
+    alpha = rdotz1 / (pAp + 1e-300);
+
+    //  r <= r - alpha*A*p
+    //  dot(r,r)
+    auto rdotrRequest = updateStart(elliptic, o_Ap, alpha, o_r);
+
+    //  x <= x + alpha*p while the reduction is in flight
+    platform->linAlg->paxpbyMany(Nlocal, Nfields, fieldOffset, alpha, o_p, 1.0, o_x);
+
+    rdotr2 = platform->linAlg->finish(rdotrRequest);
+    rdotr = sqrt(rdotr2 * elliptic->resNormFactor);
+
+    if (platform->comm.mpiRank == 0)
+      nrsCheck(std::isnan(rdotr), MPI_COMM_SELF, EXIT_FAILURE,
+               "%s\n", "Detected invalid resiual norm while running linear solver!");
+
+    if (verbose && (platform->comm.mpiRank == 0))
+      printf("it %d r norm %.15e (pfloat)\n", iter, rdotr);
+  }
+
+  return iter;
+}
+
+} // namespace
+
+int ir(elliptic_t *elliptic, occa::memory &o_r, occa::memory &o_x, const dfloat tol, const int MAXIT, dfloat &rdotr)
+{
+  mesh_t *mesh = elliptic->mesh;
+
+  const int verbose = platform->options.compareArgs("VERBOSE", "TRUE");
+  const dlong Nlocal = mesh->Nlocal;
+  const dlong Nfields = elliptic->Nfields;
+  const dlong fieldOffset = elliptic->fieldOffset;
+
+  // pfloat views of the dfloat workspace, o_zPfloat is used by the preconditioner
+  occa::memory &o_rPfloat = elliptic->o_rPfloat;
+  occa::memory &o_pPfloat = elliptic->o_p;
+  occa::memory &o_ApPfloat = elliptic->o_z;
+  occa::memory &o_ePfloat = elliptic->o_Ap;
+
+  // dfloat correction and its image once the inner solve is done
+  occa::memory &o_e = elliptic->o_z;
+  occa::memory &o_Ae = elliptic->o_p;
+
+  updatePfloatOperator(elliptic);
+
+  if (platform->comm.mpiRank == 0 && verbose) {
+    printf("IR+PCG %s: initial res norm %.15e WE NEED TO GET TO %e \n", elliptic->name.c_str(), rdotr, tol);
+  }
+
+  int iter = 0;
+  int outer = 0;
+  while (rdotr > tol && iter < MAXIT) {
+    outer++;
+    const dfloat rdotrPrev = rdotr;
+
+    platform->copyDfloatToPfloatKernel(Nfields * fieldOffset, o_r, o_rPfloat);
+
+    // don't ask for more than pfloat can deliver, but stop early once the outer tolerance is in reach
+    const dfloat innerTol = std::max(0.5 * tol, minInnerRelTol * rdotr);
+    dfloat innerRes = rdotr;
+    iter += pcgPfloat(elliptic, o_rPfloat, o_ePfloat, o_pPfloat, o_ApPfloat, innerTol, MAXIT - iter, innerRes);
+
+    platform->copyPfloatToDfloatKernel(Nfields * fieldOffset, o_ePfloat, o_e);
+    if (elliptic->allNeumann)
+      ellipticZeroMean(elliptic, o_e);
+
+    // x <= x + e
+    // r <= r - A*e
+    platform->linAlg->axpbyMany(Nlocal, Nfields, fieldOffset, 1.0, o_e, 1.0, o_x);
+    ellipticOperator(elliptic, o_e, o_Ae, dfloatString);
+    platform->linAlg->axpbyMany(Nlocal, Nfields, fieldOffset, -1.0, o_Ae, 1.0, o_r);
+
+    rdotr = platform->linAlg->weightedNorm2Many(Nlocal,
+                                                Nfields,
+                                                fieldOffset,
+                                                elliptic->o_invDegree,
+                                                o_r,
+                                                platform->comm.mpiComm) *
+            sqrt(elliptic->resNormFactor);
+
+    if (platform->comm.mpiRank == 0)
+      nrsCheck(std::isnan(rdotr), MPI_COMM_SELF, EXIT_FAILURE,
+               "%s\n", "Detected invalid resiual norm while running linear solver!");
+
+    if (verbose && (platform->comm.mpiRank == 0))
+      printf("IR it %d (%d) r norm %.15e\n", outer, iter, rdotr);
+
+    // pfloat accuracy exhausted, finish in dfloat
+    if (rdotr > tol && rdotr > maxOuterRate * rdotrPrev && iter < MAXIT) {
+      if (verbose && (platform->comm.mpiRank == 0))
+        printf("IR stagnated, continue with dfloat PCG\n");
+      iter += pcg(elliptic, o_r, o_x, tol, MAXIT - iter, rdotr);
+      break;
+    }
+  }
+
+  return iter;
+}
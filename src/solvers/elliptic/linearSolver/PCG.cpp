@@ -27,6 +27,7 @@
 #include "elliptic.h"
 #include "timer.hpp"
 #include "linAlg.hpp"
+#include "ellipticFusedOps.hpp"
 
 //#define DEBUG
 
@@ -36,45 +37,19 @@ static dfloat update(elliptic_t* elliptic,
 {
   mesh_t* mesh = elliptic->mesh;
 
-  const bool serial = platform->serial;
-
+  // x <= x + alpha*p
   // r <= r - alpha*A*p
   // dot(r,r)
-  elliptic->updatePCGKernel(mesh->Nlocal,
-                            elliptic->fieldOffset,
-                            elliptic->o_invDegree,
-                            o_Ap,
-                            alpha,
-                            o_r,
-                            elliptic->o_tmpNormr);
-
   dfloat rdotr1 = 0;
-#ifdef ELLIPTIC_ENABLE_TIMER
-    //platform->timer.tic("dotp",1);
-#endif
-  if(serial) {
-    rdotr1 = *((dfloat *) elliptic->o_tmpNormr.ptr());
-  } else {
-    const dlong Nblock = (mesh->Nlocal + BLOCKSIZE - 1) / BLOCKSIZE;
-    elliptic->o_tmpNormr.copyTo(elliptic->tmpNormr, Nblock*sizeof(dfloat));
-    for(int n = 0; n < Nblock; ++n)
-      rdotr1 += elliptic->tmpNormr[n];
-  }
-
-  // x <= x + alpha*p
-  platform->linAlg->axpbyMany(
-    mesh->Nlocal,
-    elliptic->Nfields,
-    elliptic->fieldOffset,
-    alpha,
-    o_p,
-    1.0,
-    o_x);
-
-  MPI_Allreduce(MPI_IN_PLACE, &rdotr1, 1, MPI_DFLOAT, MPI_SUM, platform->comm.mpiComm);
-#ifdef ELLIPTIC_ENABLE_TIMER
-    //platform->timer.toc("dotp");
-#endif
+  platform->linAlg->fused(ellipticFusedOps::pcgUpdate,
+                          mesh->Nlocal,
+                          elliptic->Nfields,
+                          elliptic->fieldOffset,
+                          {alpha},
+                          {o_p, o_Ap, o_x, o_r},
+                          platform->comm.mpiComm,
+                          &rdotr1,
+                          elliptic->o_invDegree);
 
   platform->flopCounter->add(elliptic->name + " ellipticUpdatePC",
                              elliptic->Nfields * static_cast<double>(mesh->Nlocal) * 6 + mesh->Nlocal);
@@ -95,6 +70,7 @@ int pcg(elliptic_t* elliptic, occa::memory &o_r, occa::memory &o_x,
 
   dfloat rdotz1;
   dfloat alpha;
+  dfloat zdotAp = 0;
 
   /*aux variables */
   occa::memory &o_p  = elliptic->o_p;
@@ -118,14 +94,30 @@ int pcg(elliptic_t* elliptic, occa::memory &o_r, occa::memory &o_x,
     if(!options.compareArgs("PRECONDITIONER", "NONE")) {
       ellipticPreconditioner(elliptic, o_r, o_z);
 
-      rdotz1 = platform->linAlg->weightedInnerProdMany(
-        mesh->Nlocal,
-        elliptic->Nfields,
-        elliptic->fieldOffset,
-        o_weight,
-        o_r,
-        o_z,
-        platform->comm.mpiComm);
+      if (flexible && iter > 1) {
+        // both inner products in a single pass
+        dfloat dots[2];
+        platform->linAlg->fused(ellipticFusedOps::pcgFlexibleDots,
+                                mesh->Nlocal,
+                                elliptic->Nfields,
+                                elliptic->fieldOffset,
+                                {},
+                                {o_r, o_z, o_Ap},
+                                platform->comm.mpiComm,
+                                dots,
+                                o_weight);
+        rdotz1 = dots[0];
+        zdotAp = dots[1];
+      } else {
+        rdotz1 = platform->linAlg->weightedInnerProdMany(
+          mesh->Nlocal,
+          elliptic->Nfields,
+          elliptic->fieldOffset,
+          o_weight,
+          o_r,
+          o_z,
+          platform->comm.mpiComm);
+      }
     } else {
       rdotz1 = rdotr; 
     }
@@ -138,14 +130,15 @@ int pcg(elliptic_t* elliptic, occa::memory &o_r, occa::memory &o_x,
     if(iter > 1) {
       beta = rdotz1/rdotz2;
       if(flexible) {
-        const dfloat zdotAp = platform->linAlg->weightedInnerProdMany(
-          mesh->Nlocal,
-          elliptic->Nfields,
-          elliptic->fieldOffset,
-          o_weight,
-          o_z,
-          o_Ap,
-          platform->comm.mpiComm);
+        if(options.compareArgs("PRECONDITIONER", "NONE"))
+          zdotAp = platform->linAlg->weightedInnerProdMany(
+            mesh->Nlocal,
+            elliptic->Nfields,
+            elliptic->fieldOffset,
+            o_weight,
+            o_z,
+            o_Ap,
+            platform->comm.mpiComm);
         beta = -alpha * zdotAp/rdotz2;
 #ifdef DEBUG
         printf("norm zdotAp: %.15e\n", zdotAp);
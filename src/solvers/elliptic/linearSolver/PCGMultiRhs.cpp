@@ -0,0 +1,203 @@
+/*
+   PCG for Nfields independent right-hand sides sharing one operator.
+
+   The fields are iterated in lockstep with their own alpha/beta, so the
+   recurrences are those of Nfields scalar PCG solves (no rank deficiency
+   issues as in block CG), while every operator application, preconditioner
+   call and reduction is done once for all fields.
+*/
+
+#include <algorithm>
+
+#include "elliptic.h"
+#include "timer.hpp"
+#include "linAlg.hpp"
+
+namespace {
+
+// sum block partials of nValues per-field reductions and do a single allreduce
+void reduce(elliptic_t *elliptic, int nValues, dfloat *values)
+{
+  mesh_t *mesh = elliptic->mesh;
+  const dlong Nblock = (mesh->Nlocal + BLOCKSIZE - 1) / BLOCKSIZE;
+  const int Nfields = elliptic->Nfields;
+
+  for (int v = 0; v < nValues; v++) {
+    values[v] = 0;
+  }
+
+  for (int set = 0; set < nValues / Nfields; set++) {
+    const auto o_partials = elliptic->o_tmpNormr + set * Nfields * Nblock * sizeof(dfloat);
+    if (platform->serial) {
+      const auto partials = (dfloat *)o_partials.ptr();
+      for (int fld = 0; fld < Nfields; fld++) {
+        values[fld + set * Nfields] = partials[fld];
+      }
+    } else {
+      o_partials.copyTo(elliptic->tmpNormr, Nfields * Nblock * sizeof(dfloat));
+      for (int fld = 0; fld < Nfields; fld++) {
+        for (int n = 0; n < Nblock; ++n) {
+          values[fld + set * Nfields] += elliptic->tmpNormr[n + fld * Nblock];
+        }
+      }
+    }
+  }
+
+  MPI_Allreduce(MPI_IN_PLACE, values, nValues, MPI_DFLOAT, MPI_SUM, platform->comm.mpiComm);
+}
+
+void innerProd(elliptic_t *elliptic, int set, occa::memory &o_a, occa::memory &o_b)
+{
+  mesh_t *mesh = elliptic->mesh;
+  const dlong Nblock = (mesh->Nlocal + BLOCKSIZE - 1) / BLOCKSIZE;
+
+  elliptic->multiRhsWeightedInnerProdKernel(mesh->Nlocal,
+                                            Nblock,
+                                            elliptic->fieldOffset,
+                                            elliptic->o_invDegree,
+                                            o_a,
+                                            o_b,
+                                            elliptic->o_tmpNormr +
+                                                set * elliptic->Nfields * Nblock * sizeof(dfloat));
+
+  platform->flopCounter->add(elliptic->name + " multiRhsInnerProd",
+                             elliptic->Nfields * static_cast<double>(mesh->Nlocal) * 3);
+}
+
+} // namespace
+
+int pcgMultiRhs(elliptic_t *elliptic,
+                occa::memory &o_r,
+                occa::memory &o_x,
+                const dfloat tol,
+                const int MAXIT,
+                dfloat &rdotr)
+{
+  mesh_t *mesh = elliptic->mesh;
+  setupAide &options = elliptic->options;
+
+  const int Nfields = elliptic->Nfields;
+  const dlong Nblock = (mesh->Nlocal + BLOCKSIZE - 1) / BLOCKSIZE;
+
+  const int flexible = options.compareArgs("SOLVER", "FLEXIBLE");
+  const int verbose = platform->options.compareArgs("VERBOSE", "TRUE");
+  const bool preconditioned = !options.compareArgs("PRECONDITIONER", "NONE");
+
+  occa::memory &o_p = elliptic->o_p;
+  occa::memory &o_z = preconditioned ? elliptic->o_z : o_r;
+  occa::memory &o_Ap = elliptic->o_Ap;
+  occa::memory o_alpha = elliptic->o_multiRhsCoeff;
+  occa::memory o_beta = elliptic->o_multiRhsCoeff + Nfields * sizeof(dfloat);
+
+  std::vector<dfloat> rdotz1(Nfields), rdotz2(Nfields), rdotrField(Nfields);
+  std::vector<dfloat> alpha(Nfields, 0), beta(Nfields, 0), tolField(Nfields, tol);
+  std::vector<dfloat> values(2 * Nfields);
+  std::vector<int> converged(Nfields, 0);
+
+  // per field residual norms to decide convergence on each right-hand side
+  innerProd(elliptic, 0, o_r, o_r);
+  reduce(elliptic, Nfields, values.data());
+  if (options.compareArgs("LINEAR SOLVER STOPPING CRITERION", "RELATIVE")) {
+    dfloat relTol = 1e-6;
+    options.getArgs("SOLVER TOLERANCE", relTol);
+    for (int fld = 0; fld < Nfields; fld++) {
+      tolField[fld] = relTol * sqrt(values[fld] * elliptic->resNormFactor);
+    }
+  }
+  for (int fld = 0; fld < Nfields; fld++) {
+    rdotrField[fld] = sqrt(values[fld] * elliptic->resNormFactor);
+    converged[fld] = rdotrField[fld] <= tolField[fld];
+  }
+
+  platform->linAlg->fill(Nfields * elliptic->fieldOffset, 0.0, o_p);
+
+  if (platform->comm.mpiRank == 0 && verbose) {
+    printf("%s ", flexible ? "PFCG+MULTIRHS" : "PCG+MULTIRHS");
+    printf("%s: initial res norm %.15e WE NEED TO GET TO %e \n", elliptic->name.c_str(), rdotr, tol);
+  }
+
+  auto allConverged = [&]() {
+    return std::all_of(converged.begin(), converged.end(), [](int c) { return c; });
+  };
+
+  int iter = 0;
+  while (!allConverged() && iter < MAXIT) {
+    iter++;
+    rdotz2 = rdotz1;
+
+    if (preconditioned) {
+      ellipticPreconditioner(elliptic, o_r, o_z);
+    }
+
+    // rdotz (and zdotAp for flexible) in a single reduction
+    innerProd(elliptic, 0, o_r, o_z);
+    if (flexible && iter > 1) {
+      innerProd(elliptic, 1, o_z, o_Ap);
+    }
+    reduce(elliptic, (flexible && iter > 1) ? 2 * Nfields : Nfields, values.data());
+
+    for (int fld = 0; fld < Nfields; fld++) {
+      rdotz1[fld] = values[fld];
+      beta[fld] = 0;
+      if (iter > 1 && !converged[fld]) {
+        beta[fld] = rdotz1[fld] / (rdotz2[fld] + 1e-300);
+        if (flexible) {
+          beta[fld] = -alpha[fld] * values[fld + Nfields] / (rdotz2[fld] + 1e-300);
+        }
+      }
+    }
+    o_beta.copyFrom(beta.data(), Nfields * sizeof(dfloat));
+
+    // p <= z + beta*p
+    elliptic->multiRhsUpdatePKernel(mesh->Nlocal, elliptic->fieldOffset, o_beta, o_z, o_p);
+
+    ellipticOperator(elliptic, o_p, o_Ap, dfloatString);
+
+    innerProd(elliptic, 0, o_p, o_Ap);
+    reduce(elliptic, Nfields, values.data());
+
+    for (int fld = 0; fld < Nfields; fld++) {
+      alpha[fld] = converged[fld] ? 0 : rdotz1[fld] / (values[fld] + 1e-300);
+    }
+    o_alpha.copyFrom(alpha.data(), Nfields * sizeof(dfloat));
+
+    //  x <= x + alpha*p
+    //  r <= r - alpha*A*p
+    //  dot(r,r)
+    elliptic->updateMultiRhsPCGKernel(mesh->Nlocal,
+                                      Nblock,
+                                      elliptic->fieldOffset,
+                                      elliptic->o_invDegree,
+                                      o_alpha,
+                                      o_p,
+                                      o_Ap,
+                                      o_x,
+                                      o_r,
+                                      elliptic->o_tmpNormr);
+    platform->flopCounter->add(elliptic->name + " ellipticUpdatePC",
+                               Nfields * static_cast<double>(mesh->Nlocal) * 7);
+
+    reduce(elliptic, Nfields, values.data());
+
+    dfloat rdotrSum = 0;
+    for (int fld = 0; fld < Nfields; fld++) {
+      rdotrField[fld] = sqrt(values[fld] * elliptic->resNormFactor);
+      rdotrSum += values[fld];
+      converged[fld] = converged[fld] || (rdotrField[fld] <= tolField[fld]);
+    }
+    rdotr = sqrt(rdotrSum * elliptic->resNormFactor);
+
+    if (platform->comm.mpiRank == 0)
+      nrsCheck(std::isnan(rdotr), MPI_COMM_SELF, EXIT_FAILURE,
+               "%s\n", "Detected invalid resiual norm while running linear solver!");
+
+    if (verbose && (platform->comm.mpiRank == 0)) {
+      printf("it %d r norm %.15e", iter, rdotr);
+      for (int fld = 0; fld < Nfields; fld++)
+        printf(" %.4e", rdotrField[fld]);
+      printf("\n");
+    }
+  }
+
+  return iter;
+}
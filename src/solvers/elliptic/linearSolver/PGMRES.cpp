@@ -143,7 +143,7 @@ int pgmres(elliptic_t *elliptic,
   const int flexible = elliptic->options.compareArgs("SOLVER", "FLEXIBLE");
 
   const bool verbose = platform->options.compareArgs("VERBOSE", "TRUE");
-  const bool serial = platform->device.mode() == "Serial" || platform->device.mode() == "OpenMP";
+  const bool serial = platform->serial;
 
   int Nblock = (mesh->Nlocal + BLOCKSIZE - 1) / BLOCKSIZE;
   const dlong Nbytes = Nblock * sizeof(dfloat);